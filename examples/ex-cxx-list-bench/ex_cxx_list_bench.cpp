@@ -0,0 +1,167 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Measures the number of heap allocations and the time per construct + start + stop
+// of a runtime-configurable component_list. The components of a component_list are
+// stored inline (aligned slots + an active bitmask) and the default initializer
+// is resolved once into a bitmask. The "heap" mode emulates the former layout
+// where each enabled component was allocated with new and released with delete.
+//
+
+#include "timemory/timemory.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <tuple>
+
+using namespace tim::component;
+
+using list_t  = tim::component_list<wall_clock, cpu_clock, peak_rss, user_clock>;
+using tuple_t = tim::component_tuple<wall_clock, cpu_clock, peak_rss, user_clock>;
+using heap_t  = std::tuple<wall_clock*, cpu_clock*, peak_rss*>;
+
+//--------------------------------------------------------------------------------------//
+//  count every allocation made through the global operator new
+//
+static std::atomic<int64_t> num_allocs{ 0 };
+
+void*
+operator new(size_t _n)
+{
+    ++num_allocs;
+    if(void* _ptr = std::malloc(_n))
+        return _ptr;
+    throw std::bad_alloc{};
+}
+
+void
+operator delete(void* _ptr) noexcept
+{
+    std::free(_ptr);
+}
+
+void
+operator delete(void* _ptr, size_t) noexcept
+{
+    std::free(_ptr);
+}
+
+//--------------------------------------------------------------------------------------//
+
+struct result
+{
+    double allocs = 0.0;
+    double nsec   = 0.0;
+};
+
+template <typename FuncT>
+result
+run(int64_t nitr, FuncT&& _func)
+{
+    using clock_type = std::chrono::steady_clock;
+    // warm-up: storage, hash-ids and the resolved initializer are created here
+    for(int64_t i = 0; i < 100; ++i)
+        _func();
+    auto _allocs = num_allocs.load();
+    auto _beg    = clock_type::now();
+    for(int64_t i = 0; i < nitr; ++i)
+        _func();
+    auto _end = clock_type::now();
+    auto _ns  = std::chrono::duration_cast<std::chrono::nanoseconds>(_end - _beg).count();
+    return result{ static_cast<double>(num_allocs.load() - _allocs) / nitr,
+                   static_cast<double>(_ns) / nitr };
+}
+
+//--------------------------------------------------------------------------------------//
+
+void
+print(const std::string& _label, bool _store, const result& _res)
+{
+    printf("%32s %8s %16.3f %16.1f\n", _label.c_str(), (_store) ? "true" : "false",
+           _res.allocs, _res.nsec);
+}
+
+//--------------------------------------------------------------------------------------//
+
+int
+main(int argc, char** argv)
+{
+    // the default initializer of the component_list reads this variable
+    tim::set_env("TIMEMORY_COMPONENT_LIST_INIT", "wall_clock,cpu_clock,peak_rss", 0);
+
+    tim::settings::cout_output() = false;
+    tim::settings::text_output() = false;
+    tim::settings::json_output() = false;
+    tim::timemory_init(argc, argv);
+
+    int64_t nitr  = (argc > 1) ? atol(argv[1]) : 1000000;
+    auto    _hash = tim::add_hash_id("list_bench");
+
+    auto _replay = [](list_t& cl) { cl.initialize<wall_clock, cpu_clock, peak_rss>(); };
+
+    printf("%32s %8s %16s %16s\n", "mode", "store", "allocs/region", "nsec/region");
+    for(bool _store : { false, true })
+    {
+        print("component_list (resolved init)", _store, run(nitr, [&]() {
+                  list_t _obj(_hash, _store);
+                  _obj.start();
+                  _obj.stop();
+              }));
+
+        print("component_list (replayed init)", _store, run(nitr, [&]() {
+                  list_t _obj(_hash, _store, tim::scope::get_default(), _replay);
+                  _obj.start();
+                  _obj.stop();
+              }));
+
+        print("component_tuple", _store, run(nitr, [&]() {
+                  tuple_t _obj(_hash, _store);
+                  _obj.start();
+                  _obj.stop();
+              }));
+
+        // emulates the pointer layout: one new and one delete per enabled component
+        print("heap-allocated components", _store, run(nitr, [&]() {
+                  heap_t _data{ new wall_clock{}, new cpu_clock{}, new peak_rss{} };
+                  if(_store)
+                      tim::invoke::push(_data, tim::scope::get_default(), _hash);
+                  tim::invoke::start(_data);
+                  tim::invoke::stop(_data);
+                  if(_store)
+                      tim::invoke::pop(_data);
+                  tim::invoke::destroy(_data);
+              }));
+    }
+
+    puts("\nAllocations which remain with store = true are made by the call-stack "
+         "bookkeeping\nof the storage and are identical for all of the layouts");
+
+    tim::timemory_finalize();
+    return 0;
+}
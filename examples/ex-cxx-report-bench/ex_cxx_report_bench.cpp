@@ -0,0 +1,159 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Measures the cost of generating the report of a synthetic deep call-graph. Each level
+// of the graph has WIDTH leaf regions and one region which recurses into the next
+// level, i.e. the graph has DEPTH * (WIDTH + 1) nodes. The exclusive values of the
+// nodes are computed in a single pass over the results. The "forward scan" mode is
+// the former computation which, for every node, walked forward through the results
+// until the next sibling and has a cost proportional to the size of the sub-tree.
+//
+
+#include "timemory/timemory.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace tim::component;
+
+using bundle_t     = tim::component_tuple<wall_clock>;
+using print_t      = tim::operation::finalize::print<wall_clock, true>;
+using results_t    = typename print_t::result_type;
+using clock_type   = std::chrono::steady_clock;
+using hash_array_t = std::vector<uint64_t>;
+
+//--------------------------------------------------------------------------------------//
+
+void
+build(int64_t _level, int64_t _depth, uint64_t _hash, const hash_array_t& _leaves)
+{
+    if(_level >= _depth)
+        return;
+    bundle_t _obj(_hash);
+    _obj.start();
+    for(auto itr : _leaves)
+    {
+        bundle_t _leaf(itr);
+        _leaf.start();
+        _leaf.stop();
+    }
+    build(_level + 1, _depth, _hash, _leaves);
+    _obj.stop();
+}
+
+//--------------------------------------------------------------------------------------//
+
+template <typename FuncT>
+double
+run(FuncT&& _func)
+{
+    auto _beg = clock_type::now();
+    _func();
+    auto _end = clock_type::now();
+    return std::chrono::duration_cast<std::chrono::duration<double>>(_end - _beg).count();
+}
+
+//--------------------------------------------------------------------------------------//
+
+void
+print(const std::string& _label, double _sec)
+{
+    printf("%36s %16.4f\n", _label.c_str(), _sec);
+}
+
+//--------------------------------------------------------------------------------------//
+
+int
+main(int argc, char** argv)
+{
+    tim::settings::cout_output() = false;
+    tim::settings::text_output() = false;
+    tim::settings::json_output() = false;
+    tim::timemory_init(argc, argv);
+
+    int64_t _depth = (argc > 1) ? atol(argv[1]) : 2000;
+    int64_t _width = (argc > 2) ? atol(argv[2]) : 150;
+
+    auto         _hash = tim::add_hash_id("level");
+    hash_array_t _leaves{};
+    for(int64_t i = 0; i < _width; ++i)
+        _leaves.emplace_back(tim::add_hash_id("leaf_" + std::to_string(i)));
+
+    auto* _storage = tim::storage<wall_clock>::instance();
+    build(0, _depth, _hash, _leaves);
+
+    printf("%36s %16s\n", "mode", "seconds");
+
+    results_t _results{};
+    print("graph to results", run([&]() { _results = results_t{ _storage->get() }; }));
+
+    auto _nodes = _results.front().size();
+
+    print_t                       _printer(wall_clock::get_label(), _storage);
+    typename print_t::stream_type _stream{};
+    print("text report (single pass)",
+          run([&]() { _printer.write_stream(_stream, _results); }));
+
+    std::stringstream _ss{};
+    print("text render", run([&]() { _ss << *_stream; }));
+
+    // the former computation of the sum of the values of the direct children
+    double _sum = 0.0;
+    print("exclusive values (forward scan)", run([&]() {
+              const auto& _nodes_v = _results.front();
+              for(auto itr = _nodes_v.begin(); itr != _nodes_v.end(); ++itr)
+              {
+                  auto _eitr = itr;
+                  for(++_eitr; _eitr != _nodes_v.end(); ++_eitr)
+                  {
+                      if(_eitr->depth() <= itr->depth())
+                          break;
+                      if(_eitr->depth() == itr->depth() + 1)
+                          _sum += _eitr->data().get();
+                  }
+              }
+          }));
+
+    print("exclusive values (single pass)", run([&]() {
+              tim::node::compute_exclusive(_results.front());
+              for(const auto& itr : _results.front())
+                  _sum += itr.exclusive().get();
+          }));
+
+    std::string _json = "ex_cxx_report_bench.json";
+    print("json", run([&]() { _printer.print_json(_json, _results, 1); }));
+    std::remove(_json.c_str());
+
+    printf("\n%lu nodes, %lu characters of text (checksum: %g)\n",
+           static_cast<unsigned long>(_nodes),
+           static_cast<unsigned long>(_ss.str().length()), _sum);
+
+    tim::timemory_finalize();
+    return 0;
+}
@@ -0,0 +1,135 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+// Measures the cost of the settings checks performed on the hot path. The
+// "accessor" modes read every value through the settings::X() accessors which
+// return a reference into the settings instance (and bump the settings epoch
+// because the value may be modified through that reference). The "hot" modes
+// read the thread-local, cache-line-sized snapshot returned by settings::hot()
+// which is only refreshed when the epoch changed.
+//
+
+#include "timemory/timemory.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using namespace tim::component;
+
+using bundle_t = tim::auto_tuple<wall_clock>;
+
+//--------------------------------------------------------------------------------------//
+
+template <typename FuncT>
+double
+run(int64_t nitr, FuncT&& _func)
+{
+    using clock_type = std::chrono::steady_clock;
+    // warm-up: storage, hash-ids and the thread-local snapshot are created here
+    for(int64_t i = 0; i < 100; ++i)
+        _func(i);
+    auto _beg = clock_type::now();
+    for(int64_t i = 0; i < nitr; ++i)
+        _func(i);
+    auto _end = clock_type::now();
+    auto _ns  = std::chrono::duration_cast<std::chrono::nanoseconds>(_end - _beg).count();
+    return static_cast<double>(_ns) / nitr;
+}
+
+//--------------------------------------------------------------------------------------//
+
+void
+print(const std::string& _label, double _nsec)
+{
+    printf("%40s %16.2f\n", _label.c_str(), _nsec);
+}
+
+//--------------------------------------------------------------------------------------//
+
+int
+main(int argc, char** argv)
+{
+    tim::settings::cout_output() = false;
+    tim::settings::text_output() = false;
+    tim::settings::json_output() = false;
+    tim::timemory_init(argc, argv);
+
+    int64_t nitr    = (argc > 1) ? atol(argv[1]) : 1000000;
+    int64_t nchecks = (argc > 2) ? atol(argv[2]) : 16;
+    int64_t _sum    = 0;
+
+    printf("%40s %16s\n", "mode", "nsec/iteration");
+
+    print("settings checks (accessor)", run(nitr, [&](int64_t) {
+              for(int64_t j = 0; j < nchecks; ++j)
+              {
+                  if(tim::settings::enabled() && !tim::settings::debug())
+                      _sum += tim::settings::verbose();
+              }
+          }));
+
+    print("settings checks (hot)", run(nitr, [&](int64_t) {
+              for(int64_t j = 0; j < nchecks; ++j)
+              {
+                  const auto& _hot = tim::settings::hot();
+                  if(_hot.enabled && !_hot.debug)
+                      _sum += _hot.verbose;
+              }
+          }));
+
+    // the bundle reads enabled, debug, verbose, add_secondary and destructor_report
+    // from the snapshot on construction, start, stop and destruction
+    print("auto_tuple<wall_clock> + checks (accessor)", run(nitr, [&](int64_t) {
+              bundle_t _obj("settings_bench");
+              for(int64_t j = 0; j < nchecks; ++j)
+              {
+                  if(tim::settings::enabled() && !tim::settings::debug())
+                      _sum += tim::settings::verbose();
+              }
+          }));
+
+    print("auto_tuple<wall_clock> + checks (hot)", run(nitr, [&](int64_t) {
+              bundle_t _obj("settings_bench");
+              for(int64_t j = 0; j < nchecks; ++j)
+              {
+                  const auto& _hot = tim::settings::hot();
+                  if(_hot.enabled && !_hot.debug)
+                      _sum += _hot.verbose;
+              }
+          }));
+
+    // an update through an accessor is picked up by the next snapshot read
+    tim::settings::verbose() += 1;
+    int _verbose = tim::settings::hot().verbose;
+    tim::settings::verbose() -= 1;
+
+    printf("\n%lld checks per iteration, verbose after update = %i (checksum: %lld)\n",
+           static_cast<long long>(nchecks), _verbose, static_cast<long long>(_sum));
+
+    tim::timemory_finalize();
+    return 0;
+}
@@ -0,0 +1,145 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+// Measures the time per call of a function in a shared library when it is called
+// directly, through a gotcha wrapper which starts/stops a trip_count component,
+// and through a gotcha replacement. The wrappers construct the components from the
+// hash of the function name which is computed once when the wrapper is generated.
+//
+
+#include "ex_gotcha_lib.hpp"
+#include "timemory/timemory.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using namespace tim::component;
+
+//======================================================================================//
+
+namespace tim
+{
+namespace component
+{
+struct noop_intercept : public base<noop_intercept, void>
+{
+    int operator()(int val) { return val + 1; }
+};
+}  // namespace component
+}  // namespace tim
+
+//======================================================================================//
+
+using trip_bundle_t = tim::component_tuple<trip_count>;
+using wrap_t        = gotcha<1, trip_bundle_t>;
+using replace_t     = gotcha<1, std::tuple<>, noop_intercept>;
+using wrap_tuple_t  = tim::component_tuple<wrap_t>;
+using repl_tuple_t  = tim::component_tuple<replace_t>;
+
+//--------------------------------------------------------------------------------------//
+
+template <typename FuncT>
+double
+run(int64_t nitr, FuncT&& _func)
+{
+    using clock_type = std::chrono::steady_clock;
+    int _val         = 0;
+    // warm-up: the storage and the hash-ids of the thread are created here
+    for(int64_t i = 0; i < 100; ++i)
+        _val = _func(_val);
+    auto _beg = clock_type::now();
+    for(int64_t i = 0; i < nitr; ++i)
+        _val = _func(_val);
+    auto _end = clock_type::now();
+    auto _ns  = std::chrono::duration_cast<std::chrono::nanoseconds>(_end - _beg).count();
+    if(_val == 0)
+        puts("");
+    return static_cast<double>(_ns) / nitr;
+}
+
+//--------------------------------------------------------------------------------------//
+
+void
+print(const std::string& _label, double _nsec, double _base)
+{
+    printf("%24s %16.1f %16.1f\n", _label.c_str(), _nsec, _nsec - _base);
+}
+
+//======================================================================================//
+
+int
+main(int argc, char** argv)
+{
+    tim::settings::cout_output() = false;
+    tim::settings::text_output() = false;
+    tim::settings::json_output() = false;
+    tim::timemory_init(argc, argv);
+
+    int64_t nitr = (argc > 1) ? atol(argv[1]) : 1000000;
+
+    wrap_t::get_initializer()    = []() { TIMEMORY_C_GOTCHA(wrap_t, 0, ex_gotcha_noop); };
+    replace_t::get_initializer() = []() {
+        TIMEMORY_C_GOTCHA(replace_t, 0, ex_gotcha_noop);
+    };
+
+    auto _call = [](int _val) { return ex_gotcha_noop(_val); };
+
+    printf("%24s %16s %16s\n", "mode", "nsec/call", "overhead");
+
+    auto _base = run(nitr, _call);
+    print("unwrapped", _base, _base);
+
+    {
+        wrap_tuple_t _obj("ex_gotcha_bench/wrap", false);
+        _obj.start();
+        print("wrapped (trip_count)", run(nitr, _call), _base);
+        _obj.stop();
+    }
+
+    {
+        repl_tuple_t _obj("ex_gotcha_bench/replace", false);
+        _obj.start();
+        print("replaced", run(nitr, _call), _base);
+        _obj.stop();
+    }
+
+    {
+        // the wrapper is still installed but forwards directly to the original
+        wrap_tuple_t _obj("ex_gotcha_bench/disabled", false);
+        _obj.start();
+        tim::settings::enabled() = false;
+        print("wrapped (disabled)", run(nitr, _call), _base);
+        tim::settings::enabled() = true;
+        _obj.stop();
+    }
+
+    tim::timemory_finalize();
+    return 0;
+}
+
+//======================================================================================//
@@ -109,3 +109,11 @@ sum_exp(const std::vector<float>& data)
 }
 //
 //--------------------------------------------------------------------------------------//
+//
+int
+ex_gotcha_noop(int val)
+{
+    return val + 1;
+}
+//
+//--------------------------------------------------------------------------------------//
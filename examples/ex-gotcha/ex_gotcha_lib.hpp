@@ -35,3 +35,7 @@ tuple_t
 do_exp_work(int);
 
 }  // namespace ext
+
+// does nothing: used to measure the cost of a call through a gotcha wrapper
+extern "C" int
+ex_gotcha_noop(int);
@@ -0,0 +1,106 @@
+#!@PYTHON_EXECUTABLE@
+#
+# Compares the overhead of the native (C++) profiler callback against the
+# pure-python sys.setprofile callback in timemory.profiler using a small set
+# of call-heavy, pyperformance-style workloads.
+#
+
+import sys
+import time
+import argparse
+import timemory
+from timemory.profiler import profile
+
+
+def fib(n):
+    return n if n < 2 else (fib(n - 1) + fib(n - 2))
+
+
+def nqueens(n):
+    def solve(row, cols, diag1, diag2):
+        if row == n:
+            return 1
+        count = 0
+        for col in range(n):
+            if col in cols or (row + col) in diag1 or (row - col) in diag2:
+                continue
+            count += solve(row + 1, cols | {col}, diag1 | {row + col},
+                           diag2 | {row - col})
+        return count
+    return solve(0, set(), set(), set())
+
+
+def richards(n):
+    class Task(object):
+        def __init__(self, value):
+            self.value = value
+
+        def run(self, other):
+            return self.value + other.get()
+
+        def get(self):
+            return self.value
+
+    tasks = [Task(i) for i in range(16)]
+    total = 0
+    for i in range(n):
+        total += tasks[i % 16].run(tasks[(i + 1) % 16])
+    return total
+
+
+benchmarks = {
+    "fib": (fib, 22),
+    "nqueens": (nqueens, 7),
+    "richards": (richards, 100000),
+}
+
+
+def run_bench(func, arg, mode, components, nitr):
+    """
+    Returns the list of wall-clock times for each iteration
+    """
+    times = []
+    for i in range(nitr):
+        if mode == "none":
+            t0 = time.perf_counter()
+            func(arg)
+            times.append(time.perf_counter() - t0)
+        else:
+            with profile(components, native=(mode == "native")):
+                t0 = time.perf_counter()
+                func(arg)
+                times.append(time.perf_counter() - t0)
+    return times
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("-n", "--iterations", type=int, default=5,
+                        help="Number of iterations per benchmark")
+    parser.add_argument("-c", "--components", nargs="+", default=["wall_clock"],
+                        help="Components used by the profiler")
+    parser.add_argument("-b", "--benchmarks", nargs="+",
+                        default=list(benchmarks.keys()),
+                        choices=list(benchmarks.keys()),
+                        help="Benchmarks to run")
+    args = parser.parse_args()
+
+    timemory.settings.text_output = False
+    timemory.settings.json_output = False
+    timemory.settings.cout_output = False
+
+    print("{:>12} {:>10} {:>14} {:>14} {:>10}".format(
+        "benchmark", "mode", "min [sec]", "mean [sec]", "slowdown"))
+    for name in args.benchmarks:
+        func, arg = benchmarks[name]
+        base = None
+        for mode in ["none", "python", "native"]:
+            times = run_bench(func, arg, mode, args.components, args.iterations)
+            tmin = min(times)
+            tmean = sum(times) / len(times)
+            if base is None:
+                base = tmin
+            print("{:>12} {:>10} {:>14.6f} {:>14.6f} {:>9.2f}x".format(
+                name, mode, tmin, tmean, tmin / base))
+
+    timemory.finalize()
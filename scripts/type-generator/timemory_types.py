@@ -34,6 +34,8 @@ components = [
     "cuda_profiler",
     "papi_array_t",
     "papi_vector",
+    "perf_counters",
+    "numa_locality",
     "caliper",
     "trip_count",
     "read_bytes",
@@ -64,6 +66,8 @@ components = [
     "kernel_mode_time",
     "current_peak_rss",
     "malloc_gotcha",
+    "lock_gotcha",
+    "io_gotcha",
     "user_mpip_bundle",
     "user_ompt_bundle",
     "ompt_handle",
@@ -95,6 +99,10 @@ mangled_strings = {
     "system_clock": ["sys_clock"],
     "papi_array_t": ["papi_array"],
     "papi_vector": ["papi"],
+    "perf_counters": ["perf_event", "perf"],
+    "numa_locality": ["numa"],
+    "lock_gotcha": ["lock_contention"],
+    "io_gotcha": ["io_trace"],
     "cpu_roofline_flops": ["cpu_roofline"],
     "gpu_roofline_flops": ["gpu_roofline"],
     "cpu_roofline_sp_flops": ["cpu_roofline_sp", "cpu_roofline_single"],
@@ -160,6 +168,7 @@ traits = {
                                "read_bytes",
                                "written_bytes",
                                "virtual_memory",
+                               "numa_locality",
                            ]),
     "uses_timing_units": ("std::true_type",
                           [
@@ -183,6 +192,7 @@ traits = {
                               "read_bytes",
                               "written_bytes",
                               "virtual_memory",
+                              "numa_locality",
                           ]),
 }
 
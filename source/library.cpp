@@ -208,7 +208,7 @@ extern "C"
             return;
         get_library_state()[0] = true;
 
-        if(tim::settings::verbose() > 0)
+        if(tim::settings::hot().verbose > 0)
         {
             printf("%s\n", spacer.c_str());
             printf("\tInitialization of timemory library...\n");
@@ -218,6 +218,17 @@ extern "C"
         tim::timemory_init(argc, argv);
         library_manager_handle->update_metadata_prefix();
         // tim::settings::parse();
+
+        // measure the cost of an empty region with the configured components. The
+        // region functions acquire the lock
+        if(tim::settings::overhead_compensation())
+        {
+            lk.release();
+            tim::overhead::calibrate("timemory_push_region", [](const std::string& _l) {
+                timemory_push_region(_l.c_str());
+                timemory_pop_region(_l.c_str());
+            });
+        }
     }
 
     //----------------------------------------------------------------------------------//
@@ -227,12 +238,12 @@ extern "C"
         auto lk                = tim::trace::lock<tim::trace::library>();
         get_library_state()[1] = true;
 
-        if(tim::settings::enabled() == false && get_record_map().empty())
+        if(tim::settings::hot().enabled == false && get_record_map().empty())
             return;
 
         auto& _record_map = get_record_map();
 
-        if(tim::settings::verbose() > 0)
+        if(tim::settings::hot().verbose > 0)
         {
             printf("\n%s\n", spacer.c_str());
             printf("\tFinalization of timemory library...\n");
@@ -361,7 +372,7 @@ extern "C"
     void timemory_begin_record(const char* name, uint64_t* id)
     {
         auto lk = tim::trace::lock<tim::trace::library>();
-        if(!lk || tim::settings::enabled() == false)
+        if(!lk || tim::settings::hot().enabled == false)
         {
             *id = std::numeric_limits<uint64_t>::max();
             return;
@@ -370,7 +381,7 @@ extern "C"
         timemory_create_record(name, id, comp.size(), (int*) (comp.data()));
 
 #if defined(DEBUG)
-        if(tim::settings::verbose() > 2)
+        if(tim::settings::hot().verbose > 2)
             printf("beginning record for '%s' (id = %lli)...\n", name,
                    (long long int) *id);
 #endif
@@ -381,7 +392,7 @@ extern "C"
     void timemory_begin_record_types(const char* name, uint64_t* id, const char* ctypes)
     {
         auto lk = tim::trace::lock<tim::trace::library>();
-        if(!lk || tim::settings::enabled() == false)
+        if(!lk || tim::settings::hot().enabled == false)
         {
             *id = std::numeric_limits<uint64_t>::max();
             return;
@@ -391,7 +402,7 @@ extern "C"
         timemory_create_record(name, id, comp.size(), (int*) (comp.data()));
 
 #if defined(DEBUG)
-        if(tim::settings::verbose() > 2)
+        if(tim::settings::hot().verbose > 2)
             printf("beginning record for '%s' (id = %lli)...\n", name,
                    (long long int) *id);
 #endif
@@ -402,7 +413,7 @@ extern "C"
     void timemory_begin_record_enum(const char* name, uint64_t* id, ...)
     {
         auto lk = tim::trace::lock<tim::trace::library>();
-        if(!lk || tim::settings::enabled() == false)
+        if(!lk || tim::settings::hot().enabled == false)
         {
             *id = std::numeric_limits<uint64_t>::max();
             return;
@@ -423,7 +434,7 @@ extern "C"
         timemory_create_record(name, id, comp.size(), (int*) (comp.data()));
 
 #if defined(DEBUG)
-        if(tim::settings::verbose() > 2)
+        if(tim::settings::hot().verbose > 2)
             printf("beginning record for '%s' (id = %lli)...\n", name,
                    (long long int) *id);
 #endif
@@ -434,7 +445,7 @@ extern "C"
     uint64_t timemory_get_begin_record(const char* name)
     {
         auto lk = tim::trace::lock<tim::trace::library>();
-        if(!lk || tim::settings::enabled() == false)
+        if(!lk || tim::settings::hot().enabled == false)
             return std::numeric_limits<uint64_t>::max();
 
         uint64_t id   = 0;
@@ -442,7 +453,7 @@ extern "C"
         timemory_create_record(name, &id, comp.size(), (int*) (comp.data()));
 
 #if defined(DEBUG)
-        if(tim::settings::verbose() > 2)
+        if(tim::settings::hot().verbose > 2)
             printf("beginning record for '%s' (id = %lli)...\n", name,
                    (long long int) id);
 #endif
@@ -455,7 +466,7 @@ extern "C"
     uint64_t timemory_get_begin_record_types(const char* name, const char* ctypes)
     {
         auto lk = tim::trace::lock<tim::trace::library>();
-        if(!lk || tim::settings::enabled() == false)
+        if(!lk || tim::settings::hot().enabled == false)
             return std::numeric_limits<uint64_t>::max();
 
         uint64_t id   = 0;
@@ -463,7 +474,7 @@ extern "C"
         timemory_create_record(name, &id, comp.size(), (int*) (comp.data()));
 
 #if defined(DEBUG)
-        if(tim::settings::verbose() > 2)
+        if(tim::settings::hot().verbose > 2)
             printf("beginning record for '%s' (id = %lli)...\n", name,
                    (long long int) id);
 #endif
@@ -476,7 +487,7 @@ extern "C"
     uint64_t timemory_get_begin_record_enum(const char* name, ...)
     {
         auto lk = tim::trace::lock<tim::trace::library>();
-        if(!lk || tim::settings::enabled() == false)
+        if(!lk || tim::settings::hot().enabled == false)
             return std::numeric_limits<uint64_t>::max();
 
         uint64_t id = 0;
@@ -496,7 +507,7 @@ extern "C"
         timemory_create_record(name, &id, comp.size(), (int*) (comp.data()));
 
 #if defined(DEBUG)
-        if(tim::settings::verbose() > 2)
+        if(tim::settings::hot().verbose > 2)
             printf("beginning record for '%s' (id = %lli)...\n", name,
                    (long long int) id);
 #endif
@@ -515,7 +526,7 @@ extern "C"
         timemory_delete_record(id);
 
 #if defined(DEBUG)
-        if(tim::settings::verbose() > 2)
+        if(tim::settings::hot().verbose > 2)
             printf("ending record for %lli...\n", (long long int) id);
 #endif
     }
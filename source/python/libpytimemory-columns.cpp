@@ -0,0 +1,359 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#if !defined(TIMEMORY_PYCOLUMNS_SOURCE)
+#    define TIMEMORY_PYCOLUMNS_SOURCE
+#endif
+
+#include "libpytimemory-components.hpp"
+#include "timemory/storage/binary.hpp"
+#include "timemory/timemory.hpp"
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+//======================================================================================//
+//
+//  Columnar export of the storage. The results of each component are traversed once and
+//  every field is appended to a contiguous buffer. The buffers are handed to NumPy
+//  through the buffer protocol: the array references the memory of the buffer and a
+//  capsule releases it, so no element is copied after the traversal.
+//
+namespace pycolumns
+{
+//
+//--------------------------------------------------------------------------------------//
+//
+inline const char*
+get_format(tim::binary::elem_type _type)
+{
+    using tim::binary::elem_type;
+    switch(_type)
+    {
+        case elem_type::boolean: return "?";
+        case elem_type::int8: return "b";
+        case elem_type::uint8: return "B";
+        case elem_type::int16: return "h";
+        case elem_type::uint16: return "H";
+        case elem_type::int32: return "i";
+        case elem_type::uint32: return "I";
+        case elem_type::int64: return "q";
+        case elem_type::uint64: return "Q";
+        case elem_type::float32: return "f";
+        case elem_type::float64: return "d";
+        case elem_type::float128: return "g";
+        case elem_type::opaque: break;
+    }
+    return "B";
+}
+//
+//--------------------------------------------------------------------------------------//
+/// transfer the ownership of the buffer to a numpy array
+///
+template <typename Tp>
+py::array
+to_array(std::vector<Tp>&& _data, std::vector<ssize_t> _shape,
+         const std::string& _format = py::format_descriptor<Tp>::format())
+{
+    auto* _buffer = new std::vector<Tp>(std::move(_data));
+    auto  _owner  = py::capsule(
+        _buffer, [](void* _ptr) { delete static_cast<std::vector<Tp>*>(_ptr); });
+    return py::array(py::dtype(_format), std::move(_shape), _buffer->data(), _owner);
+}
+//
+template <typename Tp>
+py::array
+to_array(std::vector<Tp>&& _data)
+{
+    auto _size = static_cast<ssize_t>(_data.size());
+    return to_array(std::move(_data), { _size });
+}
+//
+//--------------------------------------------------------------------------------------//
+/// a column of values with a fixed-size binary representation (arithmetic types and
+/// std::array/std::pair of arithmetic types). Everything else is not exported
+///
+template <typename Tp, bool IsFixed = (tim::binary::column_traits<Tp>::is_fixed &&
+                                       !tim::binary::column_traits<Tp>::is_empty)>
+struct array_column
+{
+    void reserve(size_t) {}
+    void push_back(const Tp&) {}
+    void emplace(py::dict&, const char*, ssize_t) {}
+};
+//
+template <typename Tp>
+struct array_column<Tp, true>
+{
+    using traits_type = tim::binary::column_traits<Tp>;
+
+    static size_t stride()
+    {
+        return traits_type::count * tim::binary::get_size(traits_type::type);
+    }
+
+    void reserve(size_t _nrows) { m_data.reserve(_nrows * stride()); }
+
+    void push_back(const Tp& _val)
+    {
+        auto _offset = m_data.size();
+        m_data.resize(_offset + stride());
+        traits_type::write(m_data.data() + _offset, _val);
+    }
+
+    void emplace(py::dict& _dict, const char* _name, ssize_t _nrows)
+    {
+        std::vector<ssize_t> _shape = { _nrows };
+        if(traits_type::count > 1)
+            _shape.push_back(static_cast<ssize_t>(traits_type::count));
+        _dict[_name] =
+            to_array(std::move(m_data), std::move(_shape), get_format(traits_type::type));
+    }
+
+private:
+    std::vector<char> m_data = {};
+};
+//
+//--------------------------------------------------------------------------------------//
+/// the columns of the statistics (when the statistics are accumulated)
+///
+template <typename StatsT>
+struct has_mean
+{
+    template <typename Up>
+    static auto test(int)
+        -> decltype(std::declval<const Up&>().get_mean(), std::true_type{});
+
+    template <typename Up>
+    static std::false_type test(long);
+
+    static constexpr bool value = decltype(test<StatsT>(0))::value;
+};
+//
+template <typename StatsT, bool HasMean = has_mean<StatsT>::value>
+struct stats_columns
+{
+    void reserve(size_t) {}
+    void push_back(const StatsT&) {}
+    void emplace(py::dict&, ssize_t) {}
+};
+//
+template <typename StatsT>
+struct stats_columns<StatsT, true>
+{
+    using value_type = tim::decay_t<decltype(std::declval<const StatsT&>().get_mean())>;
+
+    void reserve(size_t _nrows)
+    {
+        m_mean.reserve(_nrows);
+        m_min.reserve(_nrows);
+        m_max.reserve(_nrows);
+        m_stddev.reserve(_nrows);
+    }
+
+    void push_back(const StatsT& _stats)
+    {
+        m_mean.push_back(_stats.get_mean());
+        m_min.push_back(_stats.get_min());
+        m_max.push_back(_stats.get_max());
+        m_stddev.push_back(_stats.get_stddev());
+    }
+
+    void emplace(py::dict& _dict, ssize_t _nrows)
+    {
+        m_mean.emplace(_dict, "mean", _nrows);
+        m_min.emplace(_dict, "min", _nrows);
+        m_max.emplace(_dict, "max", _nrows);
+        m_stddev.emplace(_dict, "stddev", _nrows);
+    }
+
+private:
+    array_column<value_type> m_mean   = {};
+    array_column<value_type> m_min    = {};
+    array_column<value_type> m_max    = {};
+    array_column<value_type> m_stddev = {};
+};
+//
+//--------------------------------------------------------------------------------------//
+/// convert the results of the storage of a component into a dictionary of numpy arrays
+///
+template <typename Tp,
+          bool HasStorage = tim::implements_storage<Tp, tim::type_list<>>::value>
+struct columns
+{
+    static void add(py::dict&, const std::set<std::string>&) {}
+};
+//
+template <typename Tp>
+struct columns<Tp, true>
+{
+    using storage_type = typename Tp::storage_type;
+    using result_node  = typename storage_type::result_node;
+    using value_type   = typename Tp::value_type;
+    using accum_type   = tim::decay_t<decltype(std::declval<Tp>().get_accum())>;
+    using stats_type   = tim::decay_t<decltype(std::declval<result_node>().stats())>;
+
+    static void add(py::dict& _dict, const std::set<std::string>& _filter)
+    {
+        auto _label = Tp::get_label();
+        if(!_filter.empty() && _filter.count(_label) == 0)
+            return;
+
+        auto _storage = storage_type::noninit_instance();
+        if(!_storage || _storage->empty())
+            return;
+
+        // the same (merged, compensated) results as the text/json output: one array of
+        // results per process with the depth relative to the head node and the
+        // exclusive value already computed
+        auto   _results = _storage->dmp_get();
+        size_t _nrows   = 0;
+        for(const auto& itr : _results)
+            _nrows += itr.size();
+        if(_nrows == 0)
+            return;
+
+        std::vector<uint64_t> _hash{};
+        std::vector<int64_t>  _parent{};
+        std::vector<int64_t>  _depth{};
+        std::vector<int64_t>  _tid{};
+        std::vector<int64_t>  _pid{};
+        std::vector<int64_t>  _laps{};
+        std::vector<int64_t>  _label_idx{};
+
+        array_column<value_type>  _value{};
+        array_column<accum_type>  _accum{};
+        array_column<value_type>  _exclusive{};
+        stats_columns<stats_type> _stats{};
+
+        _hash.reserve(_nrows);
+        for(auto* itr : { &_parent, &_depth, &_tid, &_pid, &_laps, &_label_idx })
+            itr->reserve(_nrows);
+        _value.reserve(_nrows);
+        _accum.reserve(_nrows);
+        _exclusive.reserve(_nrows);
+        _stats.reserve(_nrows);
+
+        // the labels are stored once in a string table and referenced by index
+        std::vector<std::string>              _labels{};
+        std::unordered_map<uint64_t, int64_t> _label_map{};
+
+        for(const auto& ritr : _results)
+        {
+            // the collapsed duplicates (e.g. the same call-path on other threads) append
+            // their new children at the end, i.e. the results are not in pre-order. The
+            // parent is the most recent row at the previous depth whose rolling hash (sum
+            // of the ids of the call-path) is the rolling hash of the node minus its id
+            std::map<std::pair<int64_t, uint64_t>, int64_t> _rows{};
+            for(const auto& itr : ritr)
+            {
+                auto        _row  = static_cast<int64_t>(_hash.size());
+                auto        _d    = static_cast<int64_t>(itr.depth());
+                const auto& _obj  = itr.data();
+                auto        _litr = _label_map.find(itr.hash());
+                if(_litr == _label_map.end())
+                {
+                    _litr = _label_map.emplace(itr.hash(), _labels.size()).first;
+                    _labels.emplace_back(tim::get_hash_identifier(itr.hash()));
+                }
+
+                auto _pitr = _rows.find({ _d - 1, itr.rolling_hash() - itr.hash() });
+                _rows[std::make_pair(_d, itr.rolling_hash())] = _row;
+
+                _hash.emplace_back(itr.hash());
+                _parent.emplace_back((_pitr != _rows.end()) ? _pitr->second : -1);
+                _depth.emplace_back(_d);
+                _tid.emplace_back(itr.tid());
+                _pid.emplace_back(itr.pid());
+                _laps.emplace_back(_obj.get_laps());
+                _label_idx.emplace_back(_litr->second);
+                _value.push_back(_obj.get_value());
+                _accum.push_back(_obj.get_accum());
+                _exclusive.push_back(itr.exclusive().get_value());
+                _stats.push_back(itr.stats());
+            }
+        }
+
+        auto     _n     = static_cast<ssize_t>(_hash.size());
+        py::dict _cols  = {};
+        _cols["hash"]   = to_array(std::move(_hash));
+        _cols["parent"] = to_array(std::move(_parent));
+        _cols["depth"]  = to_array(std::move(_depth));
+        _cols["tid"]    = to_array(std::move(_tid));
+        _cols["pid"]    = to_array(std::move(_pid));
+        _cols["laps"]   = to_array(std::move(_laps));
+        _cols["label"]  = to_array(std::move(_label_idx));
+        _value.emplace(_cols, "value", _n);
+        _accum.emplace(_cols, "accum", _n);
+        _exclusive.emplace(_cols, "exclusive", _n);
+        _stats.emplace(_cols, _n);
+
+        py::dict _entry        = {};
+        _entry["columns"]      = _cols;
+        _entry["labels"]       = py::array(py::cast(_labels));
+        _entry["unit"]         = Tp::get_unit();
+        _entry["display_unit"] = Tp::get_display_unit();
+        _entry["description"]  = Tp::get_description();
+        _dict[_label.c_str()]  = _entry;
+    }
+};
+//
+template <template <typename...> class TupleT, typename... Tp>
+void
+add_columns(py::dict& _dict, const std::set<std::string>& _filter, TupleT<Tp...>*)
+{
+    TIMEMORY_FOLD_EXPRESSION(columns<Tp>::add(_dict, _filter));
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+void
+generate(py::module& _pymod)
+{
+    auto _get_columns = [](std::set<std::string> _components) {
+        using tuple_type = typename tim::available_auto_list_t::tuple_type;
+        py::dict _dict   = {};
+        add_columns(_dict, _components, static_cast<tuple_type*>(nullptr));
+        return _dict;
+    };
+
+    _pymod.def(
+        "get_columns", _get_columns,
+        "Get the storage data of each component as a dictionary of NumPy arrays "
+        "(one element per call-graph node). The arrays reference the memory filled "
+        "during a single traversal of the results. 'label' and 'parent' are indices "
+        "into 'labels' and the rows, respectively",
+        py::arg("components") = std::set<std::string>{});
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+}  // namespace pycolumns
+//
+//======================================================================================//
@@ -216,6 +216,30 @@ generate(py::module& _pymod);
 //
 //--------------------------------------------------------------------------------------//
 //
+//                                      PROFILER
+//
+//--------------------------------------------------------------------------------------//
+//
+namespace pyprofile
+{
+py::module
+generate(py::module& _pymod);
+}  // namespace pyprofile
+//
+//--------------------------------------------------------------------------------------//
+//
+//                                       COLUMNS
+//
+//--------------------------------------------------------------------------------------//
+//
+namespace pycolumns
+{
+void
+generate(py::module& _pymod);
+}  // namespace pycolumns
+//
+//--------------------------------------------------------------------------------------//
+//
 //                                      AUTO_TIMER
 //
 //--------------------------------------------------------------------------------------//
@@ -0,0 +1,356 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#if !defined(TIMEMORY_PYPROFILE_SOURCE)
+#    define TIMEMORY_PYPROFILE_SOURCE
+#endif
+
+#include "libpytimemory-components.hpp"
+#include "timemory/containers/definition.hpp"
+#include "timemory/containers/extern.hpp"
+#include "timemory/runtime/initialize.hpp"
+#include "timemory/runtime/properties.hpp"
+#include "timemory/variadic/definition.hpp"
+
+#include <frameobject.h>
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+using namespace tim::component;
+
+using pybundle_t         = tim::component::user_global_bundle;
+using component_bundle_t = tim::component_bundle<TIMEMORY_API, pybundle_t>;
+
+//======================================================================================//
+//
+//  Native replacement for the sys.setprofile callback in timemory.profiler. The
+//  callback is installed with PyEval_SetProfile and each PyCodeObject is resolved to
+//  a label + hash exactly once (per thread) so that every subsequent call/return only
+//  performs a pointer lookup and a start/stop of the bundle.
+//
+namespace pyprofile
+{
+//
+//--------------------------------------------------------------------------------------//
+//
+struct config
+{
+    bool                  include_line     = true;
+    bool                  include_filepath = true;
+    bool                  full_filepath    = false;
+    std::set<std::string> skip_functions   = { "__exit__" };
+    std::set<std::string> skip_filenames   = { "__init__.py" };
+};
+//
+inline config&
+get_config()
+{
+    static config _instance{};
+    return _instance;
+}
+//
+//  incremented when the configuration changes so that every thread drops the labels
+//  it cached with the previous configuration on its next call event
+//
+inline std::atomic<uint64_t>&
+get_generation()
+{
+    static std::atomic<uint64_t> _instance{ 0 };
+    return _instance;
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+struct code_entry
+{
+    bool   skip = true;
+    size_t hash = 0;
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+struct thread_data
+{
+    using code_map_t   = std::unordered_map<PyCodeObject*, code_entry>;
+    using bundle_vec_t = std::deque<component_bundle_t>;
+    using active_vec_t = std::vector<bool>;
+
+    // the destructor runs at thread exit without the GIL (and possibly after the
+    // interpreter was finalized) so the references to the cached code objects are
+    // intentionally leaked instead of decremented
+    ~thread_data()
+    {
+        stop_bundles();
+        codes.clear();
+    }
+
+    void stop_bundles()
+    {
+        while(!bundles.empty())
+        {
+            bundles.back().stop();
+            bundles.pop_back();
+        }
+        active.clear();
+    }
+
+    // the code objects are kept alive while they are cached so that a freed
+    // code object cannot be recycled at the same address with a stale label.
+    // Requires the GIL
+    void clear_codes()
+    {
+        for(auto& itr : codes)
+            Py_DECREF(itr.first);
+        codes.clear();
+        generation = get_generation().load(std::memory_order_acquire);
+    }
+
+    // requires the GIL
+    void clear()
+    {
+        stop_bundles();
+        clear_codes();
+    }
+
+    uint64_t     generation = get_generation().load(std::memory_order_acquire);
+    code_map_t   codes      = {};
+    bundle_vec_t bundles    = {};
+    active_vec_t active     = {};
+};
+//
+inline thread_data&
+get_thread_data()
+{
+    static thread_local thread_data _instance{};
+    return _instance;
+}
+//
+inline std::string
+get_utf8(PyObject* _obj)
+{
+    if(!_obj)
+        return std::string{};
+    auto _str = PyUnicode_AsUTF8(_obj);
+    if(!_str)
+    {
+        PyErr_Clear();
+        return std::string{};
+    }
+    return std::string{ _str };
+}
+//
+inline std::string
+get_basename(const std::string& _fname)
+{
+    auto _pos = _fname.find_last_of("/\\");
+    return (_pos == std::string::npos) ? _fname : _fname.substr(_pos + 1);
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+//  only invoked the first time a code object is seen on a thread
+//
+code_entry
+get_code_entry(PyCodeObject* _code)
+{
+    auto&       _config = get_config();
+    code_entry  _entry{};
+    std::string _func = get_utf8(_code->co_name);
+    std::string _file = get_utf8(_code->co_filename);
+    int         _line = (_config.include_line) ? _code->co_firstlineno : -1;
+
+    if(_config.skip_functions.count(_func) > 0)
+        return _entry;
+
+    if(!_file.empty())
+    {
+        auto _base = get_basename(_file);
+        if(_config.skip_filenames.count(_base) > 0 ||
+           _config.skip_filenames.count(_file) > 0)
+            return _entry;
+        if(!_config.full_filepath)
+            _file = _base;
+    }
+
+    if(!_config.include_filepath)
+        _file = "";
+
+    using mode  = tim::source_location::mode;
+    auto&& _loc = tim::source_location(mode::complete, _func.c_str(), _line,
+                                       _file.c_str(), std::string{});
+    _entry.skip = false;
+    _entry.hash = _loc.get_captured(std::string{}).get_hash();
+    return _entry;
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+int
+profiler_function(PyObject*, PyFrameObject* _frame, int _what, PyObject*)
+{
+    switch(_what)
+    {
+        case PyTrace_CALL:
+        {
+            auto& _data = get_thread_data();
+            if(!tim::settings::enabled() || !_frame)
+            {
+                _data.active.push_back(false);
+                return 0;
+            }
+
+            // the labels were cached with a previous configuration
+            if(_data.generation != get_generation().load(std::memory_order_acquire))
+                _data.clear_codes();
+
+#if PY_VERSION_HEX >= 0x030900B1
+            auto _code = PyFrame_GetCode(_frame);
+            Py_XDECREF(_code);
+#else
+            auto _code = _frame->f_code;
+#endif
+            auto itr = _data.codes.find(_code);
+            if(itr == _data.codes.end())
+            {
+                Py_INCREF(_code);
+                itr = _data.codes.emplace(_code, get_code_entry(_code)).first;
+            }
+
+            if(itr->second.skip)
+            {
+                _data.active.push_back(false);
+                return 0;
+            }
+
+            _data.bundles.emplace_back(itr->second.hash, true);
+            _data.bundles.back().start();
+            _data.active.push_back(true);
+            break;
+        }
+        case PyTrace_RETURN:
+        {
+            auto& _data = get_thread_data();
+            // returns from frames entered before the profiler was activated
+            if(_data.active.empty())
+                return 0;
+            bool _active = _data.active.back();
+            _data.active.pop_back();
+            if(_active && !_data.bundles.empty())
+            {
+                _data.bundles.back().stop();
+                _data.bundles.pop_back();
+            }
+            break;
+        }
+        default: break;
+    }
+    return 0;
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+void
+start()
+{
+    PyEval_SetProfile(&profiler_function, nullptr);
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+void
+stop()
+{
+    PyEval_SetProfile(nullptr, nullptr);
+    get_thread_data().stop_bundles();
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+py::module
+generate(py::module& _pymod)
+{
+    py::module _prof = _pymod.def_submodule(
+        "profiler", "Native (C++) implementation of the python function profiler");
+
+    auto _configure = [](bool _include_line, bool _include_filepath, bool _full_filepath,
+                         std::set<std::string> _skip_funcs,
+                         std::set<std::string> _skip_files) {
+        auto& _config = get_config();
+        bool  _changed =
+            (_config.include_line != _include_line ||
+             _config.include_filepath != _include_filepath ||
+             _config.full_filepath != _full_filepath ||
+             _config.skip_functions != _skip_funcs || _config.skip_filenames != _skip_files);
+        if(!_changed)
+            return;
+        _config.include_line     = _include_line;
+        _config.include_filepath = _include_filepath;
+        _config.full_filepath    = _full_filepath;
+        _config.skip_functions   = _skip_funcs;
+        _config.skip_filenames   = _skip_files;
+        // labels depend on the configuration so invalidate the cache of every thread
+        get_generation().fetch_add(1, std::memory_order_acq_rel);
+        get_thread_data().clear();
+    };
+
+    auto _get_config = []() {
+        auto&    _config         = get_config();
+        py::dict _dict           = {};
+        _dict["include_line"]     = _config.include_line;
+        _dict["include_filepath"] = _config.include_filepath;
+        _dict["full_filepath"]    = _config.full_filepath;
+        _dict["skip_functions"]   = _config.skip_functions;
+        _dict["skip_filenames"]   = _config.skip_filenames;
+        return _dict;
+    };
+
+    _prof.def("start", &start,
+              "Install the native profiler on the current thread (PyEval_SetProfile)");
+    _prof.def("stop", &stop,
+              "Remove the native profiler from the current thread and stop any "
+              "in-flight regions");
+    _prof.def("clear", []() { get_thread_data().clear(); },
+              "Clear the per-thread cache of code object labels");
+    _prof.def("configure", _configure, "Configure the native profiler",
+              py::arg("include_line") = true, py::arg("include_filepath") = true,
+              py::arg("full_filepath") = false,
+              py::arg("skip_functions") = std::set<std::string>{ "__exit__" },
+              py::arg("skip_filenames") = std::set<std::string>{ "__init__.py" });
+    _prof.def("get_config", _get_config, "Get the native profiler configuration");
+    _prof.def("size", []() { return get_thread_data().bundles.size(); },
+              "Number of in-flight regions on the current thread");
+
+    return _prof;
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+}  // namespace pyprofile
+//
+//======================================================================================//
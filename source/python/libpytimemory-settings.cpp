@@ -33,7 +33,8 @@ using string_t = std::string;
 
 #define SETTING_PROPERTY(TYPE, FUNC)                                                     \
     settings.def_property_static(                                                        \
-        TIMEMORY_STRINGIZE(FUNC), [](py::object) { return tim::settings::FUNC(); },      \
+        TIMEMORY_STRINGIZE(FUNC),                                                        \
+        [](py::object) -> TYPE { return tim::settings::FUNC(); },                        \
         [](py::object, TYPE v) { tim::settings::FUNC() = v; },                           \
         "Binds to 'tim::settings::" TIMEMORY_STRINGIZE(FUNC) "()'")
 
@@ -63,6 +64,7 @@ generate(py::module& _pymod)
     SETTING_PROPERTY(bool, file_output);
     SETTING_PROPERTY(bool, text_output);
     SETTING_PROPERTY(bool, json_output);
+    SETTING_PROPERTY(bool, binary_output);
     SETTING_PROPERTY(bool, dart_output);
     SETTING_PROPERTY(bool, time_output);
     SETTING_PROPERTY(bool, plot_output);
@@ -75,6 +77,7 @@ generate(py::module& _pymod)
     SETTING_PROPERTY(bool, timeline_profile);
     SETTING_PROPERTY(bool, collapse_threads);
     SETTING_PROPERTY(bool, collapse_processes);
+    SETTING_PROPERTY(uint64_t, finalize_threads);
     SETTING_PROPERTY(bool, destructor_report);
     SETTING_PROPERTY(uint16_t, max_depth);
     SETTING_PROPERTY(string_t, time_format);
@@ -82,6 +85,7 @@ generate(py::module& _pymod)
     SETTING_PROPERTY(strvector_t, command_line);
     SETTING_PROPERTY(size_t, throttle_count);
     SETTING_PROPERTY(size_t, throttle_value);
+    SETTING_PROPERTY(bool, overhead_compensation);
     // width/precision
     SETTING_PROPERTY(int16_t, precision);
     SETTING_PROPERTY(int16_t, width);
@@ -108,12 +112,18 @@ generate(py::module& _pymod)
     SETTING_PROPERTY(bool, mpi_finalize);
     SETTING_PROPERTY(bool, mpi_thread);
     SETTING_PROPERTY(string_t, mpi_thread_type);
+    SETTING_PROPERTY(bool, mpi_imbalance);
+    SETTING_PROPERTY(bool, mpi_output_per_rank);
+    SETTING_PROPERTY(bool, mpi_output_per_node);
     SETTING_PROPERTY(bool, upcxx_init);
     SETTING_PROPERTY(bool, upcxx_finalize);
     SETTING_PROPERTY(int32_t, node_count);
     // misc
     SETTING_PROPERTY(bool, stack_clearing);
     SETTING_PROPERTY(bool, add_secondary);
+    SETTING_PROPERTY(string_t, live_socket);
+    SETTING_PROPERTY(uint64_t, checkpoint_interval);
+    SETTING_PROPERTY(int32_t, checkpoint_signal);
     SETTING_PROPERTY(tim::process::id_t, target_pid);
     // components
     SETTING_PROPERTY(string_t, global_components);
@@ -131,6 +141,11 @@ generate(py::module& _pymod)
     SETTING_PROPERTY(string_t, papi_events);
     SETTING_PROPERTY(bool, papi_attach);
     SETTING_PROPERTY(int, papi_overflow);
+    // perf_event
+    SETTING_PROPERTY(string_t, perf_events);
+    SETTING_PROPERTY(bool, perf_rdpmc);
+    // numa
+    SETTING_PROPERTY(uint64_t, numa_max_pages);
     // cuda/nvtx/cupti
     SETTING_PROPERTY(uint64_t, cuda_event_batch_size);
     SETTING_PROPERTY(bool, nvtx_marker_device_sync);
@@ -164,6 +179,13 @@ generate(py::module& _pymod)
     SETTING_PROPERTY(uint64_t, ert_max_data_size_cpu);
     SETTING_PROPERTY(uint64_t, ert_max_data_size_gpu);
     SETTING_PROPERTY(string_t, ert_skip_ops);
+    SETTING_PROPERTY(string_t, ert_simd_isa);
+    SETTING_PROPERTY(bool, ert_cache);
+    SETTING_PROPERTY(string_t, ert_cache_path);
+    SETTING_PROPERTY(bool, ert_cache_refresh);
+    SETTING_PROPERTY(uint64_t, ert_cache_max_age);
+    // memory
+    SETTING_PROPERTY(uint64_t, heap_sample_rate);
     // signals
     SETTING_PROPERTY(bool, allow_signal_handler);
     SETTING_PROPERTY(bool, enable_signal_handler);
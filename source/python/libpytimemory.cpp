@@ -102,6 +102,8 @@ PYBIND11_MODULE(libpytimemory, tim)
     pyauto_timer::generate(tim);
     pycomponent_list::generate(tim);
     pycomponent_bundle::generate(tim);
+    pyprofile::generate(tim);
+    pycolumns::generate(tim);
     pyhardware_counters::generate(tim);
     auto pyunit = pyunits::generate(tim);
     auto pycomp = pycomponents::generate(tim);
@@ -380,10 +382,10 @@ PYBIND11_MODULE(libpytimemory, tim)
     //----------------------------------------------------------------------------------//
     tim.def("disable", []() { tim::settings::enabled() = false; }, "Disable timemory");
     //----------------------------------------------------------------------------------//
-    tim.def("is_enabled", []() { return tim::settings::enabled(); },
+    tim.def("is_enabled", []() -> bool { return tim::settings::enabled(); },
             "Return if timemory is enabled or disabled");
     //----------------------------------------------------------------------------------//
-    tim.def("enabled", []() { return tim::settings::enabled(); },
+    tim.def("enabled", []() -> bool { return tim::settings::enabled(); },
             "Return if timemory is enabled or disabled");
     //----------------------------------------------------------------------------------//
     tim.def("has_mpi_support", []() { return tim::mpi::is_supported(); },
@@ -407,7 +409,9 @@ PYBIND11_MODULE(libpytimemory, tim)
     tim.def("finalize", _finalize,
             "Finalize timemory (generate output) -- important to call if using MPI");
     //----------------------------------------------------------------------------------//
-    tim.def("get", _as_json, "Get the storage data");
+    tim.def("get", _as_json,
+            "Get the storage data (see also get_columns for the storage data as "
+            "NumPy arrays)");
     //----------------------------------------------------------------------------------//
     tim.def(
         "init_mpip", _start_mpip,
@@ -0,0 +1,272 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "gtest/gtest.h"
+
+#include "timemory/timemory.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tim::component;
+using string_t = std::string;
+using bundle_t = tim::component_tuple<wall_clock>;
+using region_t = tim::async_region<wall_clock>;
+
+static int    _argc = 0;
+static char** _argv = nullptr;
+
+//--------------------------------------------------------------------------------------//
+namespace details
+{
+//  Get the current tests name
+inline std::string
+get_test_name()
+{
+    return ::testing::UnitTest::GetInstance()->current_test_info()->name();
+}
+
+// this function consumes approximately "n" milliseconds of real time
+inline void
+do_sleep(long n)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(n));
+}
+
+// the results with the given label
+inline auto
+find(const string_t& _label)
+{
+    std::vector<tim::node::result<wall_clock>> _ret{};
+    for(const auto& itr : tim::storage<wall_clock>::instance()->get())
+    {
+        auto _prefix = itr.prefix();
+        if(_prefix.length() >= _label.length() &&
+           _prefix.substr(_prefix.length() - _label.length()) == _label)
+            _ret.emplace_back(itr);
+    }
+    return _ret;
+}
+
+}  // namespace details
+
+//--------------------------------------------------------------------------------------//
+
+class async_region_tests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        static bool configured = false;
+        if(!configured)
+        {
+            configured                   = true;
+            tim::settings::verbose()     = 0;
+            tim::settings::debug()       = false;
+            tim::settings::json_output() = false;
+            tim::settings::mpi_thread()  = false;
+            tim::mpi::initialize(_argc, _argv);
+            tim::timemory_init(_argc, _argv);
+            tim::settings::file_output() = false;
+        }
+    }
+};
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(async_region_tests, same_thread)
+{
+    auto _label = details::get_test_name();
+
+    region_t _region{ _label };
+    EXPECT_FALSE(_region.is_running());
+    _region.start();
+    EXPECT_TRUE(_region.is_running());
+    details::do_sleep(10);
+    _region.stop();
+    EXPECT_FALSE(_region.is_running());
+    EXPECT_GT(_region.get<0>().get(), 0.009);
+
+    auto _results = details::find(_label);
+    ASSERT_EQ(_results.size(), 1);
+    EXPECT_EQ(_results.front().data().get_laps(), 1);
+    EXPECT_NEAR(_results.front().data().get(), _region.get<0>().get(), 1.0e-9);
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(async_region_tests, cross_thread)
+{
+    auto _outer_label   = details::get_test_name() + "/outer";
+    auto _region_label  = details::get_test_name() + "/region";
+    auto _sibling_label = details::get_test_name() + "/sibling";
+
+    bundle_t _outer{ _outer_label };
+    _outer.start();
+
+    region_t _region{ _region_label };
+    _region.start();
+
+    // the async region is not the parent of the regions started afterwards
+    bundle_t _sibling{ _sibling_label };
+    _sibling.start();
+    _sibling.stop();
+
+    std::thread _thread{ [&_region]() {
+        details::do_sleep(50);
+        _region.stop();
+    } };
+    _thread.join();
+
+    // the stop of the outer region applies the measurement posted by the thread
+    _outer.stop();
+
+    auto _outer_results   = details::find(_outer_label);
+    auto _region_results  = details::find(_region_label);
+    auto _sibling_results = details::find(_sibling_label);
+
+    ASSERT_EQ(_outer_results.size(), 1);
+    ASSERT_EQ(_region_results.size(), 1);
+    ASSERT_EQ(_sibling_results.size(), 1);
+
+    auto _depth = _outer_results.front().depth();
+    EXPECT_EQ(_region_results.front().depth(), _depth + 1);
+    EXPECT_EQ(_sibling_results.front().depth(), _depth + 1);
+    EXPECT_EQ(_region_results.front().data().get_laps(), 1);
+    EXPECT_GT(_region_results.front().data().get(), 0.049);
+    EXPECT_LT(_region_results.front().data().get(),
+              _outer_results.front().data().get() + 1.0e-9);
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(async_region_tests, many_threads)
+{
+    constexpr int64_t _nthreads = 4;
+    constexpr int64_t _nregions = 64;
+
+    auto _label = details::get_test_name();
+
+    std::vector<std::vector<region_t>> _regions(_nthreads);
+    for(int64_t i = 0; i < _nregions; ++i)
+    {
+        region_t _region{ _label };
+        _region.start();
+        _regions.at(i % _nthreads).emplace_back(std::move(_region));
+    }
+
+    std::vector<std::thread> _threads{};
+    for(auto& itr : _regions)
+    {
+        _threads.emplace_back([&itr]() {
+            for(auto& ritr : itr)
+                ritr.stop();
+        });
+    }
+    for(auto& itr : _threads)
+        itr.join();
+
+    auto _results = details::find(_label);
+    ASSERT_EQ(_results.size(), 1);
+    EXPECT_EQ(_results.front().data().get_laps(), _nregions);
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(async_region_tests, origin_exited)
+{
+    auto _label = details::get_test_name();
+
+    // the storage of this thread is the master instance
+    tim::storage<wall_clock>::instance();
+
+    region_t _region{};
+    std::thread{ [&_region, &_label]() {
+        _region = region_t{ _label };
+        _region.start();
+        // merging the storage of this thread at exit closes the inbox
+    } }.join();
+
+    // the measurement is recorded by this thread
+    EXPECT_TRUE(_region.is_running());
+    _region.stop();
+
+    int64_t _laps = 0;
+    for(const auto& itr : details::find(_label))
+        _laps += itr.data().get_laps();
+    EXPECT_EQ(_laps, 1);
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(async_region_tests, storage_reset)
+{
+    auto _label = details::get_test_name();
+
+    region_t _region{ _label };
+    _region.start();
+    EXPECT_EQ(details::find(_label).size(), 1);
+
+    // erases the node of the region which is still running
+    tim::storage<wall_clock>::instance()->reset();
+    EXPECT_EQ(details::find(_label).size(), 0);
+
+    // the post to the inbox which was replaced fails and the stopping thread records
+    // the measurement (merged into this thread when it exits)
+    std::thread{ [&_region]() { _region.stop(); } }.join();
+    EXPECT_FALSE(_region.is_running());
+
+    // a pop on this thread does not apply a post to an erased node
+    bundle_t _bundle{ _label + "/after" };
+    _bundle.start();
+    _bundle.stop();
+
+    int64_t _laps = 0;
+    for(const auto& itr : details::find(_label))
+        _laps += itr.data().get_laps();
+    EXPECT_EQ(_laps, 1);
+}
+
+//--------------------------------------------------------------------------------------//
+
+int
+main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    _argc = argc;
+    _argv = argv;
+
+    auto ret = RUN_ALL_TESTS();
+
+    tim::timemory_finalize();
+    tim::dmp::finalize();
+    return ret;
+}
+
+//--------------------------------------------------------------------------------------//
@@ -0,0 +1,285 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "gtest/gtest.h"
+
+#include "timemory/storage/binary.hpp"
+#include "timemory/timemory.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace binary = tim::binary;
+using string_t   = std::string;
+
+static int    _argc = 0;
+static char** _argv = nullptr;
+
+//--------------------------------------------------------------------------------------//
+namespace details
+{
+//  Get the current tests name
+inline std::string
+get_test_name()
+{
+    return ::testing::UnitTest::GetInstance()->current_test_info()->name();
+}
+
+// a file with one table, a fixed column of doubles and a blob column
+inline string_t
+get_file_contents(uint64_t _nrows = 8)
+{
+    binary::writer _writer{};
+    _writer.add_metadata("test", "binary_tests");
+
+    auto& _table = _writer.add_table(0, _nrows);
+    auto& _fixed = _table.add(binary::column::make_fixed<double>("value"));
+    auto* _data  = _fixed.resize(_nrows);
+    for(uint64_t i = 0; i < _nrows; ++i)
+        binary::column_traits<double>::write(_data + i * sizeof(double), 1.5 * i);
+
+    auto& _blob = _table.add(binary::column::make_blob("prefix"));
+    for(uint64_t i = 0; i < _nrows; ++i)
+    {
+        auto _prefix = "prefix-" + std::to_string(i);
+        _blob.push_back(_prefix.c_str(), _prefix.length());
+    }
+
+    std::stringstream ss;
+    EXPECT_TRUE(_writer.write(ss));
+    return ss.str();
+}
+
+template <typename Tp>
+Tp*
+get(string_t& _contents, uint64_t _offset)
+{
+    return reinterpret_cast<Tp*>(&_contents[_offset]);
+}
+
+inline binary::file_header*
+get_file_header(string_t& _contents)
+{
+    return get<binary::file_header>(_contents, 0);
+}
+
+inline binary::table_header*
+get_table_header(string_t& _contents)
+{
+    return get<binary::table_header>(_contents, get_file_header(_contents)->table_offset);
+}
+
+inline binary::column_header*
+get_column_header(string_t& _contents, uint64_t _idx)
+{
+    auto _offset = get_table_header(_contents)->column_offset;
+    return get<binary::column_header>(_contents, _offset) + _idx;
+}
+
+inline string_t
+write_file(const string_t& _contents)
+{
+    auto _fname = get_test_name() + binary::get_extension();
+    std::ofstream ofs(_fname.c_str(), std::ios::out | std::ios::binary);
+    ofs.write(_contents.data(), _contents.size());
+    return _fname;
+}
+
+// true if the reader rejects the contents
+inline bool
+is_rejected(const string_t& _contents)
+{
+    auto _fname = write_file(_contents);
+    bool _ret   = false;
+    try
+    {
+        binary::reader _reader{ _fname };
+    } catch(std::runtime_error&)
+    {
+        _ret = true;
+    }
+    std::remove(_fname.c_str());
+    return _ret;
+}
+
+}  // namespace details
+
+//--------------------------------------------------------------------------------------//
+
+class binary_tests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        static bool configured = false;
+        if(!configured)
+        {
+            configured                   = true;
+            tim::settings::verbose()     = 0;
+            tim::settings::debug()       = false;
+            tim::settings::json_output() = false;
+            tim::timemory_init(_argc, _argv);
+            tim::settings::file_output() = false;
+        }
+    }
+};
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(binary_tests, round_trip)
+{
+    auto _contents = details::get_file_contents();
+    auto _fname    = details::write_file(_contents);
+
+    binary::reader _reader{ _fname };
+    ASSERT_EQ(_reader.num_tables(), 1);
+    EXPECT_EQ(_reader.get_metadata("test"), string_t{ "binary_tests" });
+
+    auto _table = _reader.get_table(0);
+    ASSERT_EQ(_table.size(), 8);
+
+    auto _value = _table.find("value");
+    ASSERT_TRUE(_value);
+    EXPECT_TRUE(_value.holds<double>());
+    EXPECT_FALSE(_value.holds<float>());
+    EXPECT_FALSE(_value.holds<int64_t>());
+    ASSERT_NE(_value.as<double>(), nullptr);
+    for(uint64_t i = 0; i < _table.size(); ++i)
+        EXPECT_EQ(_value.as<double>()[i], 1.5 * i);
+
+    auto _prefix = _table.find("prefix");
+    ASSERT_TRUE(_prefix);
+    for(uint64_t i = 0; i < _table.size(); ++i)
+    {
+        EXPECT_EQ(string_t(_prefix.row(i), _prefix.row_size(i)),
+                  "prefix-" + std::to_string(i));
+    }
+
+    std::remove(_fname.c_str());
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(binary_tests, truncated)
+{
+    auto _contents = details::get_file_contents();
+    EXPECT_FALSE(details::is_rejected(_contents));
+    EXPECT_TRUE(details::is_rejected(_contents.substr(0, _contents.length() - 64)));
+    EXPECT_TRUE(details::is_rejected(_contents.substr(0, sizeof(binary::file_header))));
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(binary_tests, interior_index)
+{
+    // the last offset is still the size of the data but an interior row points past it
+    auto _contents = details::get_file_contents();
+    auto _col      = details::get_column_header(_contents, 1);
+    auto _idx      = details::get<uint64_t>(_contents, _col->index_offset);
+    ASSERT_EQ(_col->kind, static_cast<uint32_t>(binary::column_kind::blob));
+    _idx[3] = std::numeric_limits<uint64_t>::max() - 16;
+    EXPECT_TRUE(details::is_rejected(_contents));
+
+    // rows with a negative size
+    _contents = details::get_file_contents();
+    _col      = details::get_column_header(_contents, 1);
+    _idx      = details::get<uint64_t>(_contents, _col->index_offset);
+    std::swap(_idx[2], _idx[3]);
+    EXPECT_TRUE(details::is_rejected(_contents));
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(binary_tests, overflow)
+{
+    // stride * rows wraps around to the size of the data
+    auto _contents      = details::get_file_contents();
+    auto _table         = details::get_table_header(_contents);
+    auto _col           = details::get_column_header(_contents, 0);
+    _col->stride        = 2;
+    _col->data_size     = 8;
+    _table->num_rows    = (std::numeric_limits<uint64_t>::max() / 2) + 5;
+    _table->num_columns = 1;
+    EXPECT_TRUE(details::is_rejected(_contents));
+
+    // num_meta * sizeof(metadata_entry) wraps around to zero
+    _contents         = details::get_file_contents();
+    auto _header      = details::get_file_header(_contents);
+    _header->num_meta = uint64_t{ 1 } << 60;
+    EXPECT_TRUE(details::is_rejected(_contents));
+
+    // the number of index entries (rows + 1) wraps around to zero
+    _contents             = details::get_file_contents();
+    _table                = details::get_table_header(_contents);
+    _table->num_rows      = std::numeric_limits<uint64_t>::max();
+    _table->column_offset = _table->column_offset + sizeof(binary::column_header);
+    _table->num_columns   = 1;
+    EXPECT_TRUE(details::is_rejected(_contents));
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(binary_tests, bad_column)
+{
+    auto _contents = details::get_file_contents();
+    auto _col      = details::get_column_header(_contents, 0);
+    _col->kind     = 7;
+    EXPECT_TRUE(details::is_rejected(_contents));
+
+    _contents  = details::get_file_contents();
+    _col       = details::get_column_header(_contents, 0);
+    _col->type = 1000;
+    EXPECT_TRUE(details::is_rejected(_contents));
+
+    _contents = details::get_file_contents();
+    _col      = details::get_column_header(_contents, 0);
+    _col->data_offset += 1;
+    EXPECT_TRUE(details::is_rejected(_contents));
+}
+
+//--------------------------------------------------------------------------------------//
+
+int
+main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    _argc = argc;
+    _argv = argv;
+
+    auto ret = RUN_ALL_TESTS();
+
+    tim::timemory_finalize();
+    tim::dmp::finalize();
+    return ret;
+}
+
+//--------------------------------------------------------------------------------------//
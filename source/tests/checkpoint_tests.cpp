@@ -0,0 +1,223 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "gtest/gtest.h"
+
+#include "timemory/timemory.hpp"
+#include "timemory/utility/checkpoint.hpp"
+
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tim::component;
+using string_t = std::string;
+
+static int    _argc = 0;
+static char** _argv = nullptr;
+
+//--------------------------------------------------------------------------------------//
+namespace details
+{
+//  Get the current tests name
+inline std::string
+get_test_name()
+{
+    return ::testing::UnitTest::GetInstance()->current_test_info()->name();
+}
+
+inline string_t
+get_filename()
+{
+    return "/tmp/timemory-checkpoint-tests-" + std::to_string(tim::process::get_id()) +
+           "-" + get_test_name() + ".ckpt";
+}
+
+// an outer region with an inner region
+inline void
+run(const string_t& _label, int64_t _nlaps)
+{
+    using bundle_t = tim::component_tuple<wall_clock>;
+    for(int64_t i = 0; i < _nlaps; ++i)
+    {
+        bundle_t _outer{ _label };
+        _outer.start();
+        {
+            bundle_t _inner{ _label + "/inner" };
+            _inner.start();
+            _inner.stop();
+        }
+        _outer.stop();
+    }
+}
+
+// the laps of the rows with the given label
+inline int64_t
+get_laps(const std::vector<tim::checkpoint::record::row>& _rows, const string_t& _label)
+{
+    int64_t _laps = 0;
+    for(const auto& itr : _rows)
+    {
+        if(itr.label.find(_label) != string_t::npos)
+            _laps += itr.laps;
+    }
+    return _laps;
+}
+
+}  // namespace details
+
+//--------------------------------------------------------------------------------------//
+
+class checkpoint_tests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        static bool configured = false;
+        if(!configured)
+        {
+            configured                   = true;
+            tim::settings::verbose()     = 0;
+            tim::settings::debug()       = false;
+            tim::settings::json_output() = false;
+            tim::settings::mpi_thread()  = false;
+            tim::mpi::initialize(_argc, _argv);
+            tim::timemory_init(_argc, _argv);
+            tim::settings::file_output() = false;
+        }
+    }
+
+    void TearDown() override
+    {
+        tim::checkpoint::writer::instance().stop();
+        std::remove(details::get_filename().c_str());
+    }
+};
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(checkpoint_tests, incremental)
+{
+    auto& _writer = tim::checkpoint::writer::instance();
+    ASSERT_TRUE(_writer.start(details::get_filename(), 0));
+
+    auto _label = details::get_test_name() + "/inner";
+    details::run(details::get_test_name(), 10);
+    _writer.write();
+    details::run(details::get_test_name(), 15);
+    _writer.write();
+    // writes the final checkpoint
+    _writer.stop();
+
+    auto _records = tim::checkpoint::read(details::get_filename());
+    ASSERT_EQ(_records.size(), 3);
+    for(size_t i = 0; i < _records.size(); ++i)
+        EXPECT_EQ(_records.at(i).index, i);
+    EXPECT_LE(_records.at(0).timestamp, _records.at(1).timestamp);
+
+    // the records hold the change since the previous record
+    EXPECT_EQ(details::get_laps(_records.at(0).rows, _label), 10);
+    EXPECT_EQ(details::get_laps(_records.at(1).rows, _label), 15);
+    EXPECT_EQ(details::get_laps(_records.at(2).rows, _label), 0);
+
+    EXPECT_EQ(details::get_laps(tim::checkpoint::accumulate(_records), _label), 25);
+    EXPECT_EQ(details::get_laps(tim::checkpoint::accumulate(_records, 1), _label), 15);
+    EXPECT_EQ(details::get_laps(tim::checkpoint::accumulate(_records, 0, 1), _label), 10);
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(checkpoint_tests, truncated)
+{
+    auto& _writer = tim::checkpoint::writer::instance();
+    ASSERT_TRUE(_writer.start(details::get_filename(), 0));
+
+    details::run(details::get_test_name(), 5);
+    _writer.write();
+    details::run(details::get_test_name(), 5);
+    _writer.write();
+    _writer.stop();
+
+    auto _nrecords = tim::checkpoint::read(details::get_filename()).size();
+    ASSERT_EQ(_nrecords, 3);
+
+    // remove the last bytes as if the job was killed while the last record was written
+    std::string _data{};
+    {
+        std::ifstream ifs(details::get_filename().c_str(), std::ios::binary);
+        _data.assign(std::istreambuf_iterator<char>(ifs),
+                     std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream ofs(details::get_filename().c_str(),
+                          std::ios::binary | std::ios::trunc);
+        ofs.write(_data.data(), _data.size() - 4);
+    }
+
+    EXPECT_EQ(tim::checkpoint::read(details::get_filename()).size(), _nrecords - 1);
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(checkpoint_tests, signal)
+{
+    auto& _writer = tim::checkpoint::writer::instance();
+    ASSERT_TRUE(_writer.start(details::get_filename(), 0, SIGUSR1));
+
+    details::run(details::get_test_name(), 5);
+    raise(SIGUSR1);
+
+    // the checkpoint is written by the background thread
+    size_t _nrecords = 0;
+    for(int i = 0; i < 100 && _nrecords == 0; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        _nrecords = tim::checkpoint::read(details::get_filename()).size();
+    }
+    EXPECT_EQ(_nrecords, 1);
+}
+
+//--------------------------------------------------------------------------------------//
+
+int
+main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    _argc = argc;
+    _argv = argv;
+
+    auto ret = RUN_ALL_TESTS();
+
+    tim::timemory_finalize();
+    tim::dmp::finalize();
+    return ret;
+}
+
+//--------------------------------------------------------------------------------------//
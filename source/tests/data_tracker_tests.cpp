@@ -205,6 +205,105 @@ TEST_F(empty_tests, iteration_tracker)
 
 //--------------------------------------------------------------------------------------//
 
+TEST_F(empty_tests, hashed_secondary)
+{
+    struct secondary_tag
+    {};
+
+    using secondary_tracker_t = data_tracker<uint64_t, secondary_tag>;
+    using tuple_t             = tim::component_tuple<secondary_tracker_t>;
+
+    secondary_tracker_t::label()       = "secondary_count";
+    secondary_tracker_t::description() = "Secondary count tracker";
+
+    auto _even = secondary_tracker_t::get_secondary_key("secondary_even");
+    auto _odd  = secondary_tracker_t::get_secondary_key("secondary_odd");
+
+    auto bsize = tim::storage<secondary_tracker_t>::instance()->size();
+
+    tuple_t t(details::get_test_name());
+    t.start();
+    for(uint64_t i = 0; i < 10; ++i)
+    {
+        t.store(std::plus<uint64_t>{}, 1);
+        t.add_secondary((i % 2 == 0) ? _even : _odd, std::plus<uint64_t>{}, 1);
+    }
+    // string keys are a thin wrapper around the hashed keys
+    t.add_secondary(std::string{ "secondary_odd" }, std::plus<uint64_t>{}, 1);
+
+    auto* _obj = t.get<secondary_tracker_t>();
+    ASSERT_EQ(_obj->get_secondary().size(), 2);
+    EXPECT_EQ(_obj->get_secondary().at(0).first, _even);
+    EXPECT_EQ(_obj->get_secondary().at(0).second.get(), 5);
+    EXPECT_EQ(_obj->get_secondary().at(1).first, _odd);
+    EXPECT_EQ(_obj->get_secondary().at(1).second.get(), 6);
+    t.stop();
+
+    auto esize = tim::storage<secondary_tracker_t>::instance()->size();
+    auto data  = tim::storage<secondary_tracker_t>::instance()->get();
+
+    EXPECT_EQ(esize - bsize, 3);
+    EXPECT_EQ(data.at(bsize).data().get(), 10);
+    EXPECT_NE(data.at(bsize + 1).prefix().find("secondary_even"), std::string::npos);
+    EXPECT_EQ(data.at(bsize + 1).depth(), data.at(bsize).depth() + 1);
+    EXPECT_NE(data.at(bsize + 2).prefix().find("secondary_odd"), std::string::npos);
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(empty_tests, many_secondary)
+{
+    struct many_secondary_tag
+    {};
+
+    using secondary_tracker_t = data_tracker<uint64_t, many_secondary_tag>;
+    using tuple_t             = tim::component_tuple<secondary_tracker_t>;
+
+    secondary_tracker_t::label()       = "many_secondary_count";
+    secondary_tracker_t::description() = "Secondary count tracker";
+
+    // keys created on another thread are only registered with the storage of this
+    // thread when the secondary data is appended to the graph
+    std::vector<uint64_t> _keys(40);
+    std::thread([&_keys]() {
+        for(size_t i = 0; i < _keys.size(); ++i)
+            _keys.at(i) = secondary_tracker_t::get_secondary_key(
+                TIMEMORY_JOIN("_", "many_secondary", i));
+    }).join();
+
+    auto bsize = tim::storage<secondary_tracker_t>::instance()->size();
+
+    tuple_t t(details::get_test_name());
+    t.start();
+    for(uint64_t n = 0; n < 3; ++n)
+    {
+        for(size_t i = 0; i < _keys.size(); ++i)
+            t.add_secondary(_keys.at(i), std::plus<uint64_t>{}, i);
+    }
+
+    auto* _obj = t.get<secondary_tracker_t>();
+    ASSERT_EQ(_obj->get_secondary().size(), _keys.size());
+    for(size_t i = 0; i < _keys.size(); ++i)
+    {
+        EXPECT_EQ(_obj->get_secondary().at(i).first, _keys.at(i));
+        EXPECT_EQ(_obj->get_secondary().at(i).second.get(), 3 * i);
+    }
+    t.stop();
+
+    auto esize = tim::storage<secondary_tracker_t>::instance()->size();
+    auto data  = tim::storage<secondary_tracker_t>::instance()->get();
+
+    ASSERT_EQ(esize - bsize, _keys.size() + 1);
+    for(size_t i = 0; i < _keys.size(); ++i)
+    {
+        EXPECT_NE(data.at(bsize + i + 1).prefix().find(
+                      TIMEMORY_JOIN("_", "many_secondary", i)),
+                  std::string::npos);
+    }
+}
+
+//--------------------------------------------------------------------------------------//
+
 int
 main(int argc, char** argv)
 {
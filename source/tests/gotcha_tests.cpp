@@ -29,13 +29,19 @@
 
 #include "timemory/timemory.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <cstdio>
 #include <mutex>
 #include <random>
 #include <thread>
 #include <vector>
 
+#include <fcntl.h>
+#include <unistd.h>
+
 using namespace tim::component;
 using tim::component_tuple_t;
 
@@ -450,6 +456,230 @@ TEST_F(gotcha_tests, malloc_gotcha)
 
 //======================================================================================//
 
+TEST_F(gotcha_tests, heap_sampler)
+{
+    namespace heap = tim::component::heap_sampler;
+
+    // the sum of the weights of the sampled allocations is an unbiased estimate of
+    // the number of bytes allocated
+    auto&    _sampler = heap::sampler::instance();
+    double   _weights = 0.0;
+    uint64_t _total   = 0;
+    uint64_t _samples = 0;
+    for(int64_t i = 0; i < 100 * nitr; ++i)
+    {
+        size_t _nbytes = 16 + (i % 64) * 16;
+        auto   _w      = _sampler(_nbytes);
+        _total += _nbytes;
+        _weights += _w;
+        _samples += (_w > 0.0) ? 1 : 0;
+    }
+
+    printf("[%s]> bytes = %llu, estimate = %.0f, samples = %llu\n",
+           details::get_test_name().c_str(), (unsigned long long) _total, _weights,
+           (unsigned long long) _samples);
+
+    EXPECT_GT(_samples, 0);
+    EXPECT_LT(_samples, 100 * nitr);
+    EXPECT_NEAR(_weights / _total, 1.0, 0.1);
+
+    // sampled pointers are removed from the live table when freed
+    std::vector<char> _buffer(64);
+    auto              _nlive = heap::tables::instance().num_live.load();
+    heap::record_alloc(_buffer.data(), 4096.0, 0, details::get_test_name());
+    EXPECT_EQ(heap::tables::instance().num_live.load(), _nlive + 1);
+    EXPECT_NEAR(heap::record_free(_buffer.data()), 4096.0, 1.0e-3);
+    EXPECT_EQ(heap::record_free(_buffer.data()), 0.0);
+    EXPECT_EQ(heap::tables::instance().num_live.load(), _nlive);
+}
+
+//======================================================================================//
+
+TEST_F(gotcha_tests, heap_sampler_threads)
+{
+    namespace heap = tim::component::heap_sampler;
+
+    constexpr int64_t nthreads = 4;
+    constexpr size_t  nptrs    = 256;
+    constexpr int64_t nrounds  = 200;
+
+    auto&                 _tables   = heap::tables::instance();
+    auto                  _nlive    = _tables.num_live.load();
+    auto                  _ndropped = _tables.num_dropped.load();
+    std::atomic<uint64_t> _nalloc{ 0 };
+    std::atomic<uint64_t> _nfreed{ 0 };
+
+    // concurrent inserts and erases on overlapping probe sequences must not hide
+    // any live pointer from the lookup in record_free
+    auto _worker = [&](int64_t _tid) {
+        std::vector<char>   _buffer(nptrs * 16);
+        std::mt19937        _rng(_tid);
+        std::vector<size_t> _order(nptrs);
+        for(size_t i = 0; i < nptrs; ++i)
+            _order.at(i) = i;
+        for(int64_t n = 0; n < nrounds; ++n)
+        {
+            for(size_t i = 0; i < nptrs; ++i)
+                heap::record_alloc(&_buffer.at(16 * i), 64.0, _tid,
+                                   details::get_test_name());
+            _nalloc += nptrs;
+            std::shuffle(_order.begin(), _order.end(), _rng);
+            for(auto i : _order)
+                _nfreed += (heap::record_free(&_buffer.at(16 * i)) > 0.0) ? 1 : 0;
+        }
+    };
+
+    std::vector<std::thread> _threads{};
+    for(int64_t i = 0; i < nthreads; ++i)
+        _threads.emplace_back(_worker, i);
+    for(auto& itr : _threads)
+        itr.join();
+
+    EXPECT_EQ(_tables.num_live.load(), _nlive);
+    EXPECT_EQ(_nfreed.load() + (_tables.num_dropped.load() - _ndropped), _nalloc.load());
+}
+
+//======================================================================================//
+
+TEST_F(gotcha_tests, lock_gotcha)
+{
+    namespace locks = tim::component::lock_contention;
+
+    using gotcha_t  = lock_gotcha::gotcha_type;
+    using toolset_t = tim::auto_tuple_t<wall_clock, lock_gotcha, gotcha_t>;
+    using worker_t  = tim::auto_tuple_t<wall_clock, lock_gotcha>;
+
+    lock_gotcha::configure();
+
+    constexpr int64_t nthreads = 4;
+    int64_t           counter  = 0;
+    std::mutex        mtx{};
+    {
+        toolset_t tool(details::get_test_name());
+
+        std::vector<std::thread> threads{};
+        for(int64_t i = 0; i < nthreads; ++i)
+        {
+            threads.emplace_back([&]() {
+                worker_t _worker(details::get_test_name() + "/worker");
+                for(int64_t j = 0; j < nitr; ++j)
+                {
+                    std::lock_guard<std::mutex> _lk(mtx);
+                    ++counter;
+                }
+            });
+        }
+        for(auto& itr : threads)
+            itr.join();
+    }
+
+    EXPECT_EQ(counter, nthreads * nitr);
+
+    // every acquisition is counted whether or not it was contended
+    auto     _addr         = reinterpret_cast<uintptr_t>(mtx.native_handle());
+    uint64_t _acquisitions = 0;
+    uint64_t _contended    = 0;
+    for(const auto& itr : locks::tables::instance().locks)
+    {
+        if(itr.ready.load() && itr.addr == _addr)
+        {
+            _acquisitions += itr.acquisitions.load();
+            _contended += itr.contended.load();
+        }
+    }
+
+    printf("[%s]> acquisitions = %llu, contended = %llu\n",
+           details::get_test_name().c_str(), (unsigned long long) _acquisitions,
+           (unsigned long long) _contended);
+
+    EXPECT_EQ(_acquisitions, static_cast<uint64_t>(nthreads * nitr));
+    EXPECT_LE(_contended, _acquisitions);
+    EXPECT_EQ(locks::thread_state::instance().num_held, 0UL);
+
+    locks::print(std::cout);
+}
+
+//======================================================================================//
+
+TEST_F(gotcha_tests, io_gotcha)
+{
+    namespace io = tim::component::io_trace;
+
+    using gotcha_t  = io_gotcha::gotcha_type;
+    using toolset_t = tim::auto_tuple_t<wall_clock, io_gotcha, gotcha_t>;
+
+    io_gotcha::configure();
+
+    constexpr int64_t nwrite = 64;
+    constexpr size_t  nbytes = 4096;
+    auto              _path  = details::get_test_name() + ".dat";
+    std::vector<char> _buffer(nbytes, 'x');
+    int64_t           _nread = 0;
+    {
+        toolset_t tool(details::get_test_name());
+
+        int _fd = open(_path.c_str(), O_CREAT | O_WRONLY | O_TRUNC, 0644);
+        ASSERT_GE(_fd, 0);
+        for(int64_t i = 0; i < nwrite; ++i)
+            EXPECT_EQ(write(_fd, _buffer.data(), nbytes), static_cast<ssize_t>(nbytes));
+        fsync(_fd);
+        close(_fd);
+
+        _fd = open(_path.c_str(), O_RDONLY);
+        ASSERT_GE(_fd, 0);
+        ssize_t _n = 0;
+        while((_n = read(_fd, _buffer.data(), nbytes)) > 0)
+            _nread += _n;
+        close(_fd);
+    }
+    std::remove(_path.c_str());
+
+    EXPECT_EQ(_nread, static_cast<int64_t>(nwrite * nbytes));
+
+    // the descriptors are resolved to the path when the file is opened
+    uint64_t _written = 0;
+    uint64_t _read    = 0;
+    uint64_t _calls   = 0;
+    for(const auto& itr : io::tables::instance().sites)
+    {
+        if(!itr.ready.load() || itr.file != io::get_file_id(_path))
+            continue;
+        if(itr.op == io::write_op)
+            _written += itr.bytes.load();
+        else if(itr.op == io::read_op)
+            _read += itr.bytes.load();
+        for(const auto& hitr : itr.histogram)
+            _calls += hitr.load();
+    }
+
+    printf("[%s]> written = %llu, read = %llu, calls = %llu\n",
+           details::get_test_name().c_str(), (unsigned long long) _written,
+           (unsigned long long) _read, (unsigned long long) _calls);
+
+    EXPECT_EQ(_written, static_cast<uint64_t>(nwrite * nbytes));
+    EXPECT_EQ(_read, static_cast<uint64_t>(nwrite * nbytes));
+    // open, fsync, and close + the writes + the reads (including the read at EOF)
+    EXPECT_EQ(_calls, static_cast<uint64_t>(2 * nwrite + 6));
+
+    // a failed open is recorded as an error of the open-failed entry
+    uint64_t _failed = 0;
+    {
+        toolset_t tool(details::get_test_name() + "/failed");
+        EXPECT_LT(open((_path + "/missing").c_str(), O_RDONLY), 0);
+    }
+    for(const auto& itr : io::tables::instance().sites)
+    {
+        if(itr.ready.load() && itr.file == io::get_failed_open_file() &&
+           itr.op == io::open_op)
+            _failed += itr.errors.load();
+    }
+    EXPECT_GE(_failed, 1UL);
+
+    io::print(std::cout);
+}
+
+//======================================================================================//
+
 TEST_F(gotcha_tests, member_functions)
 {
     using pair_type     = std::pair<float, double>;
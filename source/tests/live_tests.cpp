@@ -0,0 +1,334 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "gtest/gtest.h"
+
+#include "timemory/timemory.hpp"
+#include "timemory/utility/live_server.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace tim::component;
+using string_t = std::string;
+
+static int    _argc = 0;
+static char** _argv = nullptr;
+
+//--------------------------------------------------------------------------------------//
+namespace details
+{
+//  Get the current tests name
+inline std::string
+get_test_name()
+{
+    return ::testing::UnitTest::GetInstance()->current_test_info()->name();
+}
+
+inline string_t
+get_socket_path()
+{
+    return "/tmp/timemory-live-tests-" + std::to_string(tim::process::get_id()) +
+           ".sock";
+}
+
+// a connection to the live server (-1 on failure)
+inline int
+connect_socket()
+{
+    auto _path = get_socket_path();
+    int  _fd   = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(_fd < 0)
+        return -1;
+    sockaddr_un _addr{};
+    _addr.sun_family = AF_UNIX;
+    strncpy(_addr.sun_path, _path.c_str(), sizeof(_addr.sun_path) - 1);
+    if(connect(_fd, reinterpret_cast<sockaddr*>(&_addr), sizeof(_addr)) != 0)
+    {
+        close(_fd);
+        return -1;
+    }
+    return _fd;
+}
+
+// the rows of a response with the given label: { depth, laps, value, stale }
+inline std::vector<std::vector<string_t>>
+get_rows(const string_t& _response, const string_t& _label)
+{
+    std::vector<std::vector<string_t>> _ret{};
+    std::istringstream                 _iss(_response);
+    string_t                           _line{};
+    while(std::getline(_iss, _line))
+    {
+        if(_line.empty() || _line.front() == '#')
+            continue;
+        std::vector<string_t> _fields{};
+        std::istringstream    _lss(_line);
+        string_t              _field{};
+        while(std::getline(_lss, _field, '\t'))
+            _fields.emplace_back(_field);
+        if(_fields.size() == 8 && _fields.at(7).find(_label) != string_t::npos)
+            _ret.emplace_back(std::vector<string_t>{ _fields.at(2), _fields.at(3),
+                                                     _fields.at(4), _fields.at(6) });
+    }
+    return _ret;
+}
+
+// runs a region in a loop on a worker thread until the returned flag is set
+struct worker
+{
+    explicit worker(const string_t& _label)
+    {
+        m_thread = std::thread([this, _label]() {
+            using bundle_t = tim::component_tuple<wall_clock>;
+            while(!m_done.load())
+            {
+                bundle_t _outer{ _label };
+                _outer.start();
+                {
+                    bundle_t _inner{ _label + "/inner" };
+                    _inner.start();
+                    std::this_thread::sleep_for(std::chrono::microseconds(100));
+                    _inner.stop();
+                }
+                _outer.stop();
+                ++m_laps;
+            }
+        });
+        // wait for the storage of the worker to exist
+        while(m_laps.load() == 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    ~worker()
+    {
+        m_done.store(true);
+        m_thread.join();
+    }
+
+private:
+    std::atomic<bool>    m_done{ false };
+    std::atomic<int64_t> m_laps{ 0 };
+    std::thread          m_thread{};
+};
+
+}  // namespace details
+
+//--------------------------------------------------------------------------------------//
+
+class live_tests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        static bool configured = false;
+        if(!configured)
+        {
+            configured                   = true;
+            tim::settings::verbose()     = 0;
+            tim::settings::debug()       = false;
+            tim::settings::json_output() = false;
+            tim::settings::mpi_thread()  = false;
+            tim::mpi::initialize(_argc, _argv);
+            tim::timemory_init(_argc, _argv);
+            tim::settings::file_output() = false;
+        }
+        ASSERT_TRUE(tim::live::server::instance().start(details::get_socket_path()));
+    }
+
+    void TearDown() override { tim::live::server::instance().stop(); }
+};
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(live_tests, snapshot)
+{
+    details::worker _worker{ details::get_test_name() };
+
+    auto _response = tim::live::server::instance().query("snapshot 250");
+    std::cout << _response << std::flush;
+
+    EXPECT_EQ(_response.find("# timemory live snapshot"), 0) << _response;
+    auto _outer = details::get_rows(_response, details::get_test_name());
+    auto _inner = details::get_rows(_response, details::get_test_name() + "/inner");
+    // the outer label is a prefix of the inner label
+    ASSERT_EQ(_outer.size(), 2) << _response;
+    ASSERT_EQ(_inner.size(), 1) << _response;
+    EXPECT_EQ(std::stoll(_inner.front().at(0)), std::stoll(_outer.front().at(0)) + 1);
+    EXPECT_GT(std::stoll(_inner.front().at(1)), 0);
+    EXPECT_GT(std::stod(_inner.front().at(2)), 0.0);
+    EXPECT_EQ(_inner.front().at(3), "0");
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(live_tests, delta)
+{
+    details::worker _worker{ details::get_test_name() };
+
+    auto _label = details::get_test_name() + "/inner";
+    auto _first = details::get_rows(
+        tim::live::server::instance().query("snapshot 250"), _label);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    auto _total = details::get_rows(
+        tim::live::server::instance().query("delta 250"), _label);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    auto _delta = details::get_rows(
+        tim::live::server::instance().query("delta 250"), _label);
+
+    ASSERT_EQ(_first.size(), 1);
+    ASSERT_EQ(_total.size(), 1);
+    ASSERT_EQ(_delta.size(), 1);
+    // the first delta is relative to nothing, the second to the first delta
+    EXPECT_GT(std::stoll(_total.front().at(1)), std::stoll(_first.front().at(1)));
+    EXPECT_GT(std::stoll(_delta.front().at(1)), 0);
+    EXPECT_LT(std::stoll(_delta.front().at(1)), std::stoll(_total.front().at(1)));
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(live_tests, socket)
+{
+    details::worker _worker{ details::get_test_name() };
+
+    auto _path = details::get_socket_path();
+    int  _fd   = socket(AF_UNIX, SOCK_STREAM, 0);
+    ASSERT_GE(_fd, 0);
+
+    sockaddr_un _addr{};
+    _addr.sun_family = AF_UNIX;
+    strncpy(_addr.sun_path, _path.c_str(), sizeof(_addr.sun_path) - 1);
+    ASSERT_EQ(connect(_fd, reinterpret_cast<sockaddr*>(&_addr), sizeof(_addr)), 0);
+
+    string_t _request = "snapshot 250\n";
+    ASSERT_EQ(write(_fd, _request.data(), _request.length()),
+              static_cast<ssize_t>(_request.length()));
+
+    string_t _response{};
+    char     _buffer[1024];
+    ssize_t  _n = 0;
+    while((_n = read(_fd, _buffer, sizeof(_buffer))) > 0)
+        _response.append(_buffer, static_cast<size_t>(_n));
+    close(_fd);
+
+    EXPECT_EQ(_response.find("# timemory live snapshot"), 0) << _response;
+    EXPECT_EQ(details::get_rows(_response, details::get_test_name() + "/inner").size(),
+              1)
+        << _response;
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(live_tests, unresponsive_client)
+{
+    using clock_type = std::chrono::steady_clock;
+
+    // neither sends a request nor reads the response
+    int _idle = details::connect_socket();
+    ASSERT_GE(_idle, 0);
+    // closes the connection before the response is written
+    int _closed = details::connect_socket();
+    ASSERT_GE(_closed, 0);
+    string_t _request = "snapshot 0\n";
+    ASSERT_EQ(write(_closed, _request.data(), _request.length()),
+              static_cast<ssize_t>(_request.length()));
+    close(_closed);
+
+    auto _beg = clock_type::now();
+    int  _fd  = details::connect_socket();
+    ASSERT_GE(_fd, 0);
+    ASSERT_EQ(write(_fd, _request.data(), _request.length()),
+              static_cast<ssize_t>(_request.length()));
+
+    string_t _response{};
+    char     _buffer[1024];
+    ssize_t  _n = 0;
+    while((_n = read(_fd, _buffer, sizeof(_buffer))) > 0)
+        _response.append(_buffer, static_cast<size_t>(_n));
+    close(_fd);
+    close(_idle);
+
+    auto _elapsed = std::chrono::duration<double>(clock_type::now() - _beg).count();
+    EXPECT_EQ(_response.find("# timemory live snapshot"), 0) << _response;
+    // the idle client is dropped after the read and write deadlines
+    EXPECT_LT(_elapsed, 4.0 * tim::live::server::io_timeout / 1000.0);
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(live_tests, existing_path)
+{
+    auto _path = details::get_socket_path();
+    tim::live::server::instance().stop();
+
+    // a file which is not a socket is never removed
+    {
+        std::ofstream _ofs(_path);
+        _ofs << details::get_test_name() << "\n";
+    }
+    EXPECT_FALSE(tim::live::server::instance().start(_path));
+    std::ifstream _ifs(_path);
+    EXPECT_TRUE(_ifs.good());
+    std::remove(_path.c_str());
+
+    // the socket left behind by a previous run is replaced
+    int _fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    ASSERT_GE(_fd, 0);
+    sockaddr_un _addr{};
+    _addr.sun_family = AF_UNIX;
+    strncpy(_addr.sun_path, _path.c_str(), sizeof(_addr.sun_path) - 1);
+    ASSERT_EQ(bind(_fd, reinterpret_cast<sockaddr*>(&_addr), sizeof(_addr)), 0);
+    close(_fd);
+    EXPECT_TRUE(tim::live::server::instance().start(_path));
+}
+
+//--------------------------------------------------------------------------------------//
+
+int
+main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    _argc = argc;
+    _argv = argv;
+
+    auto ret = RUN_ALL_TESTS();
+
+    tim::timemory_finalize();
+    tim::dmp::finalize();
+    return ret;
+}
+
+//--------------------------------------------------------------------------------------//
@@ -32,6 +32,8 @@
 #include <iostream>
 #include <iterator>
 #include <random>
+#include <set>
+#include <sstream>
 #include <thread>
 #include <unordered_map>
 #include <vector>
@@ -380,6 +382,135 @@ TEST_F(mpi_tests, per_thread)
 
 //--------------------------------------------------------------------------------------//
 
+TEST_F(mpi_tests, per_node)
+{
+    using bundle_t = tim::component_tuple<wall_clock>;
+
+    {
+        bundle_t _obj{ details::get_test_name() };
+        _obj.start();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        _obj.stop();
+    }
+
+    // aggregate the ranks on each node
+    auto _per_node                       = tim::settings::mpi_output_per_node();
+    tim::settings::mpi_output_per_node() = true;
+
+    auto _scope   = tim::operation::finalize::output_scope::get();
+    auto _results = tim::storage<wall_clock>::instance()->mpi_get();
+
+    tim::settings::mpi_output_per_node() = _per_node;
+
+    auto _node_comm = tim::mpi::get_node_comm();
+    EXPECT_EQ(_scope.rank, tim::mpi::rank(_node_comm));
+    EXPECT_EQ(_scope.size, tim::mpi::size(_node_comm));
+    EXPECT_GE(_scope.index, 0);
+    EXPECT_LT(_scope.index, tim::mpi::size());
+
+    // the first rank on the node has the data of every rank on the node
+    if(_scope.rank == 0)
+    {
+        ASSERT_EQ(_results.size(), _scope.size);
+        for(const auto& itr : _results)
+            EXPECT_FALSE(itr.empty());
+    }
+    else
+    {
+        EXPECT_EQ(_results.size(), 1);
+    }
+
+    // every node has a unique index
+    std::vector<int> _indexes(tim::mpi::size(), -1);
+    int              _index = (_scope.rank == 0) ? _scope.index : -1;
+    tim::mpi::allgather(&_index, 1, MPI_INT, _indexes.data(), 1, MPI_INT);
+    std::set<int> _unique{};
+    for(auto itr : _indexes)
+    {
+        if(itr < 0)
+            continue;
+        EXPECT_EQ(_unique.count(itr), 0) << "duplicate node index " << itr;
+        _unique.insert(itr);
+    }
+    if(!_unique.empty())
+        EXPECT_EQ(*_unique.rbegin() + 1, (int) _unique.size());
+
+    auto _fname = _scope.compose_output_filename("wall", ".json");
+    EXPECT_NE(_fname.find("wall_node_" + std::to_string(_scope.index) + ".json"),
+              std::string::npos)
+        << _fname;
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(mpi_tests, imbalance)
+{
+    using bundle_t    = tim::component_tuple<wall_clock>;
+    using imbalance_t = tim::operation::finalize::mpi_imbalance<wall_clock, true>;
+
+    auto mpi_rank = tim::mpi::rank();
+    auto mpi_size = tim::mpi::size();
+
+    // every rank runs the work region for a time proportional to the rank and one
+    // region which only exists on that rank
+    auto _work_label = details::get_test_name() + "/work";
+    auto _rank_label = details::get_test_name() + "/rank-" + std::to_string(mpi_rank);
+    {
+        bundle_t _work{ _work_label };
+        _work.start();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20 * (mpi_rank + 1)));
+        _work.stop();
+
+        bundle_t _rank{ _rank_label };
+        _rank.start();
+        _rank.stop();
+    }
+
+    std::vector<tim::operation::finalize::imbalance_region> _report{};
+    imbalance_t(tim::storage<wall_clock>::instance()->get(), _report);
+
+    if(mpi_rank != 0)
+    {
+        EXPECT_TRUE(_report.empty());
+        return;
+    }
+
+    std::stringstream ss;
+    imbalance_t::write(ss, _report);
+    std::cout << ss.str() << std::endl;
+
+    auto _find = [&_report](const std::string& _label) {
+        for(const auto& itr : _report)
+        {
+            if(itr.label.find(_label) != std::string::npos &&
+               itr.label.find(_label + "-") == std::string::npos)
+                return &itr;
+        }
+        return static_cast<const tim::operation::finalize::imbalance_region*>(nullptr);
+    };
+
+    auto* _work = _find(_work_label);
+    ASSERT_NE(_work, nullptr) << ss.str();
+    EXPECT_EQ(_work->ranks, mpi_size);
+    EXPECT_EQ(_work->argmin, 0);
+    EXPECT_EQ(_work->argmax, mpi_size - 1);
+    EXPECT_LE(_work->min, _work->mean());
+    EXPECT_LE(_work->mean(), _work->max);
+    EXPECT_GE(_work->ratio(), 1.0);
+
+    // the labels of the regions which are not on rank zero are sent by the owner
+    for(int i = 0; i < mpi_size; ++i)
+    {
+        auto* _rank = _find(details::get_test_name() + "/rank-" + std::to_string(i));
+        ASSERT_NE(_rank, nullptr) << "rank " << i << "\n" << ss.str();
+        EXPECT_EQ(_rank->ranks, 1);
+        EXPECT_EQ(_rank->argmin, i);
+        EXPECT_EQ(_rank->argmax, i);
+    }
+}
+
+//--------------------------------------------------------------------------------------//
+
 int
 main(int argc, char** argv)
 {
@@ -0,0 +1,181 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "gtest/gtest.h"
+
+#include "timemory/timemory.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+using namespace tim::component;
+using string_t = std::string;
+
+static int    _argc = 0;
+static char** _argv = nullptr;
+
+#define CHECK_AVAILABLE(type)                                                            \
+    if(!tim::trait::is_available<type>::value)                                           \
+        return;
+
+//--------------------------------------------------------------------------------------//
+namespace details
+{
+//  Get the current tests name
+inline std::string
+get_test_name()
+{
+    return ::testing::UnitTest::GetInstance()->current_test_info()->name();
+}
+
+// touch every page of a buffer so that it becomes resident
+inline int64_t
+touch_pages(std::vector<char>& _buffer)
+{
+    memset(_buffer.data(), 1, _buffer.size());
+    int64_t _sum = 0;
+    for(size_t i = 0; i < _buffer.size(); i += 4096)
+        _sum += _buffer[i];
+    return _sum;
+}
+
+}  // namespace details
+
+//--------------------------------------------------------------------------------------//
+
+class numa_locality_tests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        static bool configured = false;
+        if(!configured)
+        {
+            configured                   = true;
+            tim::settings::verbose()     = 0;
+            tim::settings::debug()       = false;
+            tim::settings::json_output() = true;
+            tim::settings::mpi_thread()  = false;
+            tim::mpi::initialize(_argc, _argv);
+            tim::timemory_init(_argc, _argv);
+            tim::settings::file_output() = false;
+        }
+    }
+};
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(numa_locality_tests, topology)
+{
+    auto _cpus = tim::numa::parse_cpu_list("0-3,8,10-11");
+    EXPECT_EQ(_cpus, std::vector<int>({ 0, 1, 2, 3, 8, 10, 11 }));
+    EXPECT_TRUE(tim::numa::parse_cpu_list("").empty());
+
+    auto _nodes = tim::numa::get_num_nodes();
+    auto _node  = tim::numa::get_node(tim::numa::get_cpu());
+    EXPECT_GE(_nodes, 1);
+    EXPECT_GE(_node, 0);
+    EXPECT_LT(_node, _nodes);
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(numa_locality_tests, resident_memory)
+{
+    CHECK_AVAILABLE(numa_locality);
+
+    const size_t nbytes = 64 * tim::units::megabyte;
+
+    numa_locality _obj{};
+    _obj.start();
+    std::vector<char> _buffer(nbytes, 0);
+    auto              _touch = details::touch_pages(_buffer);
+    _obj.stop();
+
+    std::cout << _obj << " (checksum = " << _touch << ")" << std::endl;
+
+    auto _val   = _obj.get<int64_t>();
+    auto _nodes = numa_locality::num_nodes();
+    ASSERT_EQ(_val.size(), _nodes + 1);
+    ASSERT_EQ(_obj.label_array().size(), _nodes + 1);
+    EXPECT_EQ(_obj.label_array().front(), string_t("node0"));
+    EXPECT_EQ(_obj.label_array().back(), string_t("remote"));
+
+    // the estimate is from a sample of the pages so allow a generous tolerance
+    auto _total = std::accumulate(_val.begin(), _val.begin() + _nodes, int64_t{ 0 });
+    auto _mb    = static_cast<int64_t>(nbytes / tim::units::megabyte);
+    EXPECT_GE(_total, _mb / 2) << _obj;
+    EXPECT_LE(_total, 2 * _mb) << _obj;
+
+    EXPECT_GE(_obj.get_local_percent(), 0.0);
+    EXPECT_LE(_obj.get_local_percent(), 100.0);
+    if(_nodes == 1)
+    {
+        EXPECT_EQ(_val.back(), 0);
+        EXPECT_DOUBLE_EQ(_obj.get_local_percent(), 100.0);
+    }
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(numa_locality_tests, bundle)
+{
+    CHECK_AVAILABLE(numa_locality);
+
+    using bundle_t = tim::component_tuple<wall_clock, numa_locality>;
+
+    bundle_t _obj{ details::get_test_name() };
+    _obj.start();
+    _obj.stop();
+
+    auto* _numa = _obj.get<numa_locality>();
+    ASSERT_NE(_numa, nullptr);
+    EXPECT_EQ(_numa->get_laps(), 1);
+    EXPECT_GE(_numa->get_node(), 0);
+    EXPECT_LT(_numa->get_node(), tim::numa::get_num_nodes());
+    if(numa_locality::num_nodes() == 1)
+        EXPECT_DOUBLE_EQ(_numa->get_local_percent(), 100.0);
+}
+
+//--------------------------------------------------------------------------------------//
+
+int
+main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    _argc = argc;
+    _argv = argv;
+
+    auto ret = RUN_ALL_TESTS();
+
+    tim::timemory_finalize();
+    tim::dmp::finalize();
+    return ret;
+}
+
+//--------------------------------------------------------------------------------------//
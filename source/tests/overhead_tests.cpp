@@ -0,0 +1,330 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "gtest/gtest.h"
+
+#include "timemory/timemory.hpp"
+#include "timemory/utility/overhead.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tim::component;
+using string_t = std::string;
+using bundle_t = tim::component_tuple<wall_clock>;
+
+static int    _argc = 0;
+static char** _argv = nullptr;
+
+//--------------------------------------------------------------------------------------//
+namespace details
+{
+//  Get the current tests name
+inline std::string
+get_test_name()
+{
+    return ::testing::UnitTest::GetInstance()->current_test_info()->name();
+}
+
+// the result of the first entry with the given label
+template <typename Tp>
+const tim::node::result<Tp>*
+find(const std::vector<tim::node::result<Tp>>& _results, const string_t& _label)
+{
+    for(const auto& itr : _results)
+    {
+        auto _prefix = itr.prefix();
+        if(_prefix.length() >= _label.length() &&
+           _prefix.substr(_prefix.length() - _label.length()) == _label)
+            return &itr;
+    }
+    return nullptr;
+}
+
+// the results with and without the compensation
+inline auto
+get_results()
+{
+    auto _data = tim::storage<wall_clock>::instance();
+
+    tim::settings::overhead_compensation() = false;
+    auto _raw                              = _data->get();
+    tim::settings::overhead_compensation() = true;
+    auto _compensated                      = _data->get();
+    tim::settings::overhead_compensation() = false;
+
+    return std::make_pair(_raw, _compensated);
+}
+
+}  // namespace details
+
+//--------------------------------------------------------------------------------------//
+
+class overhead_tests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        static bool configured = false;
+        if(!configured)
+        {
+            configured                   = true;
+            tim::settings::verbose()     = 0;
+            tim::settings::debug()       = false;
+            tim::settings::json_output() = false;
+            tim::settings::mpi_thread()  = false;
+            tim::mpi::initialize(_argc, _argv);
+            tim::timemory_init(_argc, _argv);
+            tim::settings::file_output() = false;
+            tim::overhead::calibrate<bundle_t>();
+        }
+    }
+};
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(overhead_tests, calibration)
+{
+    const auto& _calib = tim::overhead::get_calibration();
+    EXPECT_TRUE(_calib.valid);
+    EXPECT_GT(_calib.per_call, 0.0);
+    EXPECT_LT(_calib.per_call, 1.0e-3);
+    EXPECT_EQ(_calib.samples, 1000);
+    EXPECT_EQ(_calib.bundle, tim::demangle<bundle_t>());
+
+    EXPECT_TRUE(tim::overhead::is_compensated<wall_clock>());
+    EXPECT_FALSE(tim::overhead::is_compensated<peak_rss>());
+
+    // the region recorded during the calibration is not in the results
+    auto _results = tim::storage<wall_clock>::instance()->get();
+    EXPECT_EQ(details::find(_results, tim::overhead::get_label()), nullptr);
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(overhead_tests, nested)
+{
+    constexpr int64_t _nchild = 500;
+    constexpr int64_t _ngrand = 2;
+
+    auto _parent_label = details::get_test_name() + "/parent";
+    auto _child_label  = details::get_test_name() + "/child";
+    auto _grand_label  = details::get_test_name() + "/grandchild";
+
+    {
+        bundle_t _parent{ _parent_label };
+        _parent.start();
+        for(int64_t i = 0; i < _nchild; ++i)
+        {
+            bundle_t _child{ _child_label };
+            _child.start();
+            for(int64_t j = 0; j < _ngrand; ++j)
+            {
+                bundle_t _grand{ _grand_label };
+                _grand.start();
+                _grand.stop();
+            }
+            _child.stop();
+        }
+        _parent.stop();
+    }
+
+    auto _results = details::get_results();
+    auto _per_call =
+        tim::overhead::get_calibration().per_call * std::nano::den / std::nano::num;
+
+    auto* _raw_parent  = details::find(_results.first, _parent_label);
+    auto* _raw_child   = details::find(_results.first, _child_label);
+    auto* _raw_grand   = details::find(_results.first, _grand_label);
+    auto* _comp_parent = details::find(_results.second, _parent_label);
+    auto* _comp_child  = details::find(_results.second, _child_label);
+    auto* _comp_grand  = details::find(_results.second, _grand_label);
+
+    ASSERT_NE(_raw_parent, nullptr);
+    ASSERT_NE(_raw_child, nullptr);
+    ASSERT_NE(_raw_grand, nullptr);
+    ASSERT_NE(_comp_parent, nullptr);
+    ASSERT_NE(_comp_child, nullptr);
+    ASSERT_NE(_comp_grand, nullptr);
+
+    // the parent is compensated for the children and the grandchildren, the children
+    // for the grandchildren and the grandchildren are not compensated
+    auto _expected = [_per_call](double _raw, int64_t _nested) {
+        return std::max<double>(_raw - static_cast<int64_t>(_nested * _per_call), 0.0);
+    };
+
+    auto _raw_parent_ns  = _raw_parent->data().get_accum();
+    auto _raw_child_ns   = _raw_child->data().get_accum();
+    auto _comp_parent_ns = _comp_parent->data().get_accum();
+    auto _comp_child_ns  = _comp_child->data().get_accum();
+
+    EXPECT_NEAR(_comp_parent_ns,
+                _expected(_raw_parent_ns, _nchild + _nchild * _ngrand), 1.0);
+    EXPECT_NEAR(_comp_child_ns, _expected(_raw_child_ns, _nchild * _ngrand), 1.0);
+    EXPECT_EQ(_comp_grand->data().get_accum(), _raw_grand->data().get_accum());
+    EXPECT_LT(_comp_parent_ns, _raw_parent_ns);
+
+    // the value (last lap) is corrected for the pairs nested in a single lap
+    EXPECT_NEAR(_comp_child->data().get_value(),
+                _expected(_raw_child->data().get_value(), _ngrand), 1.0);
+
+    // the laps are not modified and the exclusive value is consistent
+    EXPECT_EQ(_comp_parent->data().get_laps(), 1);
+    EXPECT_EQ(_comp_child->data().get_laps(), _nchild);
+    EXPECT_EQ(_comp_parent->exclusive().get_accum(),
+              _comp_parent_ns - _comp_child_ns);
+
+    std::cout << "calibrated overhead : " << _per_call << " ns\n"
+              << "parent (raw)        : " << _raw_parent_ns << " ns\n"
+              << "parent (compensated): " << _comp_parent_ns << " ns\n"
+              << std::endl;
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(overhead_tests, threads)
+{
+    constexpr int64_t _nthread = 4;
+    constexpr int64_t _nchild  = 200;
+    constexpr int64_t _ngrand  = 2;
+
+    auto _parent_label = details::get_test_name() + "/parent";
+    auto _other_label  = details::get_test_name() + "/other";
+    auto _child_label  = details::get_test_name() + "/child";
+    auto _grand_label  = details::get_test_name() + "/grandchild";
+    auto _extra_label  = details::get_test_name() + "/extra";
+
+    // the workers enter "other" before "child" and "extra" within "child" so the
+    // collapsed results are not in pre-order: "extra" is appended after "other"
+    auto _run = [&](bool _worker) {
+        bundle_t _parent{ _parent_label };
+        _parent.start();
+        if(_worker)
+        {
+            bundle_t _other{ _other_label };
+            _other.start();
+            _other.stop();
+        }
+        for(int64_t i = 0; i < _nchild; ++i)
+        {
+            bundle_t _child{ _child_label };
+            _child.start();
+            for(int64_t j = 0; j < _ngrand; ++j)
+            {
+                bundle_t _grand{ _grand_label };
+                _grand.start();
+                _grand.stop();
+            }
+            if(_worker)
+            {
+                bundle_t _extra{ _extra_label };
+                _extra.start();
+                _extra.stop();
+            }
+            _child.stop();
+        }
+        _parent.stop();
+    };
+
+    _run(false);
+    std::vector<std::thread> _threads{};
+    for(int64_t i = 0; i < _nthread; ++i)
+        _threads.emplace_back(_run, true);
+    for(auto& itr : _threads)
+        itr.join();
+
+    auto _results = details::get_results();
+    auto _per_call =
+        tim::overhead::get_calibration().per_call * std::nano::den / std::nano::num;
+
+    auto* _raw_parent  = details::find(_results.first, _parent_label);
+    auto* _raw_child   = details::find(_results.first, _child_label);
+    auto* _comp_parent = details::find(_results.second, _parent_label);
+    auto* _comp_child  = details::find(_results.second, _child_label);
+
+    ASSERT_NE(_raw_parent, nullptr);
+    ASSERT_NE(_raw_child, nullptr);
+    ASSERT_NE(_comp_parent, nullptr);
+    ASSERT_NE(_comp_child, nullptr);
+
+    // the threads are collapsed into a single entry
+    EXPECT_EQ(_comp_parent->data().get_laps(), _nthread + 1);
+    EXPECT_EQ(_comp_child->data().get_laps(), (_nthread + 1) * _nchild);
+
+    // the nested pairs of every thread are compensated, incl. the pairs which are
+    // only on the workers. Each thread is truncated to a whole ns separately
+    auto _parent_nested =
+        _nchild * (1 + _ngrand) + _nthread * (1 + _nchild * (2 + _ngrand));
+    auto _child_nested = _nchild * _ngrand + _nthread * _nchild * (1 + _ngrand);
+    auto _expected     = [_per_call](double _raw, int64_t _nested) {
+        return std::max<double>(_raw - _nested * _per_call, 0.0);
+    };
+
+    EXPECT_NEAR(_comp_parent->data().get_accum(),
+                _expected(_raw_parent->data().get_accum(), _parent_nested),
+                _nthread + 1.0);
+    EXPECT_NEAR(_comp_child->data().get_accum(),
+                _expected(_raw_child->data().get_accum(), _child_nested),
+                _nthread + 1.0);
+
+    // the exclusive value only excludes the direct children
+    auto* _comp_other = details::find(_results.second, _other_label);
+    auto* _comp_grand = details::find(_results.second, _grand_label);
+    auto* _comp_extra = details::find(_results.second, _extra_label);
+
+    ASSERT_NE(_comp_other, nullptr);
+    ASSERT_NE(_comp_grand, nullptr);
+    ASSERT_NE(_comp_extra, nullptr);
+
+    EXPECT_EQ(_comp_parent->exclusive().get_accum(),
+              _comp_parent->data().get_accum() - _comp_child->data().get_accum() -
+                  _comp_other->data().get_accum());
+    EXPECT_EQ(_comp_child->exclusive().get_accum(),
+              _comp_child->data().get_accum() - _comp_grand->data().get_accum() -
+                  _comp_extra->data().get_accum());
+    EXPECT_EQ(_comp_other->exclusive().get_accum(), _comp_other->data().get_accum());
+}
+
+//--------------------------------------------------------------------------------------//
+
+int
+main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    _argc = argc;
+    _argv = argv;
+
+    auto ret = RUN_ALL_TESTS();
+
+    tim::timemory_finalize();
+    tim::dmp::finalize();
+    return ret;
+}
+
+//--------------------------------------------------------------------------------------//
@@ -0,0 +1,277 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "gtest/gtest.h"
+
+#include "timemory/timemory.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <time.h>
+#include <vector>
+
+using namespace tim::component;
+using string_t = std::string;
+
+static int    _argc = 0;
+static char** _argv = nullptr;
+
+#define CHECK_AVAILABLE(type)                                                            \
+    if(!tim::trait::is_available<type>::value)                                           \
+        return;
+
+#define CHECK_WORKING()                                                                  \
+    CHECK_AVAILABLE(perf_counters);                                                      \
+    if(!perf_counters::get_group().is_open())                                            \
+    {                                                                                    \
+        printf("Skipping test because perf_event_open is not permitted\n");              \
+        return;                                                                          \
+    }
+
+//--------------------------------------------------------------------------------------//
+namespace details
+{
+// the indexes of the events in TIMEMORY_PERF_EVENTS below
+enum
+{
+    task_clock = 0,
+    context_switches,
+    page_faults
+};
+
+inline int64_t
+thread_cpu_now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000000000L + ts.tv_nsec;
+}
+
+inline string_t
+get_test_name()
+{
+    return ::testing::UnitTest::GetInstance()->current_test_info()->name();
+}
+
+// this function consumes an unknown number of cpu resources
+long
+fibonacci(long n)
+{
+    return (n < 2) ? n : (fibonacci(n - 1) + fibonacci(n - 2));
+}
+
+// touches a new page of memory every iteration to generate page faults
+size_t
+touch_pages(size_t npages)
+{
+    auto              _page = tim::units::get_page_size();
+    std::vector<char> _data(npages * _page, 0);
+    size_t            _sum = 0;
+    for(size_t i = 0; i < _data.size(); i += _page)
+    {
+        _data[i] = static_cast<char>(i);
+        _sum += _data[i];
+    }
+    return _sum;
+}
+
+}  // namespace details
+
+//--------------------------------------------------------------------------------------//
+
+class perf_counters_tests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        static bool configured = false;
+        if(!configured)
+        {
+            configured                   = true;
+            tim::settings::verbose()     = 0;
+            tim::settings::debug()       = false;
+            tim::settings::json_output() = true;
+            tim::settings::mpi_thread()  = false;
+            tim::mpi::initialize(_argc, _argv);
+            tim::timemory_init(_argc, _argv);
+            tim::settings::file_output() = false;
+            // software events are available on any linux kernel
+            tim::settings::perf_events() = "task-clock,context-switches,page-faults";
+        }
+    }
+};
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(perf_counters_tests, event_info)
+{
+    tim::perf::event_info _info{};
+
+    ASSERT_TRUE(tim::perf::get_event_info("task-clock", _info));
+    EXPECT_EQ(_info.type, tim::perf::software_type);
+    EXPECT_EQ(_info.units, string_t("nsec"));
+    EXPECT_FALSE(_info.exclude_user);
+    EXPECT_TRUE(_info.exclude_kernel);
+
+    ASSERT_TRUE(tim::perf::get_event_info("r01c7:uk", _info));
+    EXPECT_EQ(_info.type, tim::perf::raw_type);
+    EXPECT_EQ(_info.config, 0x01c7UL);
+    EXPECT_FALSE(_info.exclude_user);
+    EXPECT_FALSE(_info.exclude_kernel);
+    EXPECT_TRUE(_info.exclude_hv);
+
+    EXPECT_FALSE(tim::perf::get_event_info("not-an-event", _info));
+    EXPECT_FALSE(tim::perf::get_event_info("r01zz", _info));
+
+    EXPECT_EQ(tim::perf::get_event_name(PAPI_TOT_INS), string_t("instructions"));
+    EXPECT_EQ(tim::perf::get_event_name(PAPI_DP_OPS), string_t(""));
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(perf_counters_tests, software_events)
+{
+    CHECK_WORKING();
+
+    ASSERT_EQ(perf_counters::get_events().size(), 3UL);
+
+    const size_t npages = 1000;
+
+    perf_counters _obj{};
+    auto          _beg = details::thread_cpu_now();
+    _obj.start();
+    auto _fib   = details::fibonacci(30);
+    auto _touch = details::touch_pages(npages);
+    _obj.stop();
+    auto _end = details::thread_cpu_now();
+
+    auto _val     = _obj.get();
+    auto _elapsed = static_cast<double>(_end - _beg);
+    std::cout << _obj << " (fibonacci = " << _fib << ", checksum = " << _touch << ")"
+              << std::endl;
+
+    ASSERT_EQ(_val.size(), 3UL);
+    EXPECT_NEAR(_val.at(details::task_clock), _elapsed, 0.25 * _elapsed + 1.0e6);
+    EXPECT_GE(_val.at(details::context_switches), 0);
+    EXPECT_GE(_val.at(details::page_faults), npages / 2);
+    // software events are never multiplexed
+    EXPECT_DOUBLE_EQ(_obj.get_scaling(), 1.0);
+
+    auto _labels = _obj.label_array();
+    ASSERT_EQ(_labels.size(), 3UL);
+    EXPECT_EQ(_labels.at(details::task_clock), string_t("task_clock"));
+    EXPECT_EQ(_labels.at(details::page_faults), string_t("page_faults"));
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(perf_counters_tests, threads)
+{
+    CHECK_WORKING();
+
+    const size_t         nthreads = 4;
+    std::vector<int64_t> _clocks(nthreads, 0);
+    std::vector<int64_t> _faults(nthreads, 0);
+
+    auto _run = [&](size_t i) {
+        perf_counters _obj{};
+        _obj.start();
+        details::fibonacci(25 + i);
+        details::touch_pages(100 * (i + 1));
+        _obj.stop();
+        _clocks.at(i) = _obj.get_value().at(details::task_clock);
+        _faults.at(i) = _obj.get_value().at(details::page_faults);
+    };
+
+    std::vector<std::thread> _threads;
+    for(size_t i = 0; i < nthreads; ++i)
+        _threads.emplace_back(_run, i);
+    for(auto& itr : _threads)
+        itr.join();
+
+    // each thread opens its own event group so the counts only reflect that thread
+    for(size_t i = 0; i < nthreads; ++i)
+    {
+        EXPECT_GT(_clocks.at(i), 0) << "thread " << i;
+        EXPECT_GE(_faults.at(i), static_cast<int64_t>(50 * (i + 1))) << "thread " << i;
+    }
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(perf_counters_tests, reopen)
+{
+    CHECK_WORKING();
+
+    // the group closed by the thread finalization is reopened on the next use
+    perf_counters::thread_finalize(nullptr);
+    EXPECT_TRUE(perf_counters::get_group().is_open());
+
+    perf_counters _obj{};
+    _obj.start();
+    details::fibonacci(25);
+    _obj.stop();
+    EXPECT_GT(_obj.get_value().at(details::task_clock), 0);
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(perf_counters_tests, bundle)
+{
+    CHECK_WORKING();
+
+    using bundle_t = tim::component_tuple<wall_clock, perf_counters>;
+
+    bundle_t _obj{ details::get_test_name() };
+    _obj.start();
+    details::fibonacci(28);
+    _obj.stop();
+
+    auto* _perf = _obj.get<perf_counters>();
+    ASSERT_NE(_perf, nullptr);
+    EXPECT_GT(_perf->get().at(details::task_clock), 0.0);
+    EXPECT_EQ(_perf->get_laps(), 1);
+}
+
+//--------------------------------------------------------------------------------------//
+
+int
+main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    _argc = argc;
+    _argv = argv;
+
+    auto ret = RUN_ALL_TESTS();
+
+    tim::timemory_finalize();
+    tim::dmp::finalize();
+    return ret;
+}
+
+//--------------------------------------------------------------------------------------//
@@ -0,0 +1,278 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "gtest/gtest.h"
+
+#include "timemory/data/stream.hpp"
+#include "timemory/timemory.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <ios>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using string_t     = std::string;
+using format_flags = std::ios_base::fmtflags;
+
+static int    _argc = 0;
+static char** _argv = nullptr;
+
+//--------------------------------------------------------------------------------------//
+namespace details
+{
+// the value formatted the way the stream formatted every value before
+template <typename Tp>
+string_t
+stringstream_format(const Tp& _val, format_flags _fmt, int _prec)
+{
+    std::stringstream ss;
+    ss.setf(_fmt);
+    ss << std::setprecision(_prec) << _val;
+    return ss.str();
+}
+
+// the value formatted by the fixed buffer or an empty string if it is not supported
+template <typename Tp>
+string_t
+buffer_format(const Tp& _val, format_flags _fmt, int _prec)
+{
+    char _buf[128];
+    auto _n = tim::utility::base::format_number(_buf, sizeof(_buf), _val, _fmt, _prec);
+    return string_t(_buf, _n);
+}
+
+// the value formatted by a cell of the stream
+template <typename Tp>
+string_t
+entry_format(const Tp& _val, format_flags _fmt, int _prec)
+{
+    return tim::utility::header(_val, _fmt, 0, _prec).get();
+}
+
+inline std::vector<format_flags>
+get_flags()
+{
+    using ios_t = std::ios_base;
+    return { format_flags{},
+             ios_t::fixed,
+             ios_t::scientific,
+             ios_t::fixed | ios_t::dec | ios_t::showpoint,
+             ios_t::scientific | ios_t::showpoint,
+             ios_t::showpoint,
+             ios_t::fixed | ios_t::showpos };
+}
+
+}  // namespace details
+
+//--------------------------------------------------------------------------------------//
+
+class stream_tests : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        static bool configured = false;
+        if(!configured)
+        {
+            configured                   = true;
+            tim::settings::verbose()     = 0;
+            tim::settings::debug()       = false;
+            tim::settings::json_output() = false;
+            tim::timemory_init(_argc, _argv);
+            tim::settings::file_output() = false;
+        }
+        tim::settings::max_width() = 0;
+    }
+};
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(stream_tests, format_integer)
+{
+    std::vector<int64_t> _values = { 0,
+                                     1,
+                                     -1,
+                                     42,
+                                     -1000000,
+                                     std::numeric_limits<int64_t>::min(),
+                                     std::numeric_limits<int64_t>::max() };
+
+    auto _umax = std::numeric_limits<uint64_t>::max();
+    auto _smin = std::numeric_limits<int16_t>::min();
+
+    for(auto fitr : details::get_flags())
+    {
+        for(auto itr : _values)
+            EXPECT_EQ(details::entry_format(itr, fitr, 3),
+                      details::stringstream_format(itr, fitr, 3));
+        EXPECT_EQ(details::entry_format(_umax, fitr, 0),
+                  details::stringstream_format(_umax, fitr, 0));
+        EXPECT_EQ(details::entry_format(_smin, fitr, 0),
+                  details::stringstream_format(_smin, fitr, 0));
+        EXPECT_EQ(details::entry_format(true, fitr, 0),
+                  details::stringstream_format(true, fitr, 0));
+    }
+
+    // the flags of the components do not need the stringstream
+    auto _fmt = std::ios_base::fixed | std::ios_base::dec | std::ios_base::showpoint;
+    for(auto itr : _values)
+        EXPECT_EQ(details::buffer_format(itr, _fmt, 3),
+                  details::stringstream_format(itr, _fmt, 3));
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(stream_tests, format_floating)
+{
+    std::vector<double> _values = { 0.0,      -0.0,     0.125,    0.5,
+                                    1.5,      2.5,      -1.0e-9,  1.0e-5,
+                                    999.9995, 1.0e15,   -1.0e300, 3.14159265358979 };
+
+    for(auto fitr : details::get_flags())
+    {
+        for(int p = 0; p < 17; ++p)
+        {
+            for(auto itr : _values)
+            {
+                EXPECT_EQ(details::entry_format(itr, fitr, p),
+                          details::stringstream_format(itr, fitr, p))
+                    << "value: " << itr << ", precision: " << p << ", flags: " << fitr;
+                auto _fval = static_cast<float>(itr);
+                EXPECT_EQ(details::entry_format(_fval, fitr, p),
+                          details::stringstream_format(_fval, fitr, p))
+                    << "value: " << _fval << ", precision: " << p << ", flags: " << fitr;
+            }
+        }
+    }
+
+    // the flags of the components do not need the stringstream
+    auto _fmt = std::ios_base::fixed | std::ios_base::dec | std::ios_base::showpoint;
+    for(int p = 0; p < 17; ++p)
+    {
+        for(auto itr : { 0.0, 0.125, -1.0e-9, 999.9995, 1.0e15 })
+            EXPECT_EQ(details::buffer_format(itr, _fmt, p),
+                      details::stringstream_format(itr, _fmt, p));
+    }
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(stream_tests, format_fallback)
+{
+    using ios_t = std::ios_base;
+
+    auto _hex   = ios_t::hex;
+    auto _upper = ios_t::scientific | ios_t::uppercase;
+    auto _alpha = ios_t::boolalpha;
+
+    // flags which are not handled by the buffer still produce the stream output
+    EXPECT_TRUE(details::buffer_format(255, _hex, 0).empty());
+    EXPECT_TRUE(details::buffer_format(1.5, _upper, 2).empty());
+    EXPECT_TRUE(details::buffer_format(true, _alpha, 0).empty());
+    EXPECT_TRUE(details::buffer_format('c', format_flags{}, 0).empty());
+
+    EXPECT_EQ(tim::utility::header(255, _hex, 0, 0).get(),
+              details::stringstream_format(255, _hex, 0));
+    EXPECT_EQ(tim::utility::header(1.5, _upper, 0, 2).get(),
+              details::stringstream_format(1.5, _upper, 2));
+    EXPECT_EQ(tim::utility::header(true, _alpha, 0, 0).get(), string_t{ "true" });
+    EXPECT_EQ(tim::utility::header('c', format_flags{}, 0, 0).get(), string_t{ "c" });
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(stream_tests, max_width)
+{
+    tim::settings::max_width() = 24;
+    tim::utility::header _hdr{ 1.0e20, std::ios_base::fixed, 0, 6 };
+    EXPECT_EQ(_hdr.get(), string_t{ "100000000000000000000..." });
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(stream_tests, table)
+{
+    auto _fmt = std::ios_base::fixed | std::ios_base::dec | std::ios_base::showpoint;
+
+    tim::utility::stream _os{ '|', '-', _fmt, 6, 3 };
+    tim::utility::write_header(_os, "LABEL");
+    tim::utility::write_header(_os, "COUNT");
+    tim::utility::write_header(_os, "VALUE", _fmt, 6, 3);
+    for(int i = 0; i < 12; ++i)
+    {
+        tim::utility::write_entry(_os, "LABEL", string_t(i % 3 + 1, 'a' + i));
+        tim::utility::write_entry(_os, "COUNT", 100 * i - 50);
+        tim::utility::write_entry(_os, "VALUE", 1.25 * i * i);
+        _os.add_row();
+    }
+    _os.set_banner("[test] report");
+
+    // the layout generated when every cell was padded by a std::stringstream
+    string_t _expected = "|-------------------------|\n"
+                         "|       [test] report     |\n"
+                         "|-------------------------|\n"
+                         "| LABEL | COUNT | VALUE   |\n"
+                         "|-------|-------|---------|\n"
+                         "| a     |   -50 |   0.000 |\n"
+                         "| bb    |    50 |   1.250 |\n"
+                         "| ccc   |   150 |   5.000 |\n"
+                         "| d     |   250 |  11.250 |\n"
+                         "| ee    |   350 |  20.000 |\n"
+                         "| fff   |   450 |  31.250 |\n"
+                         "| g     |   550 |  45.000 |\n"
+                         "| hh    |   650 |  61.250 |\n"
+                         "| iii   |   750 |  80.000 |\n"
+                         "| j     |   850 | 101.250 |\n"
+                         "|-------|-------|---------|\n"
+                         "| kk    |   950 | 125.000 |\n"
+                         "| lll   |  1050 | 151.250 |\n"
+                         "|-------------------------|\n";
+
+    std::stringstream ss;
+    ss << _os;
+    EXPECT_EQ(ss.str(), _expected);
+}
+
+//--------------------------------------------------------------------------------------//
+
+int
+main(int argc, char** argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    _argc = argc;
+    _argv = argv;
+
+    auto ret = RUN_ALL_TESTS();
+
+    tim::timemory_finalize();
+    tim::dmp::finalize();
+    return ret;
+}
+
+//--------------------------------------------------------------------------------------//
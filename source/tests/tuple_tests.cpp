@@ -670,6 +670,149 @@ TEST_F(tuple_tests, auto_start)
 
 //--------------------------------------------------------------------------------------//
 
+TEST_F(tuple_tests, stack_clear)
+{
+    using tuple_t = tim::component_tuple<wall_clock>;
+
+    auto* _storage = tim::storage<wall_clock>::instance();
+    auto  _depth   = _storage->depth();
+
+    tuple_t _outer(details::get_test_name() + "/outer");
+    tuple_t _inner(details::get_test_name() + "/inner");
+    _outer.start();
+    _inner.start();
+    details::do_sleep(10);
+
+    EXPECT_EQ(_storage->depth(), _depth + 2);
+
+    // stops + pops the components which are still in-flight, inner-most first
+    _storage->stack_clear();
+
+    EXPECT_EQ(_storage->depth(), _depth);
+    EXPECT_EQ(_outer.get<wall_clock>()->get_laps(), 1);
+    EXPECT_EQ(_inner.get<wall_clock>()->get_laps(), 1);
+    EXPECT_GT(_outer.get<wall_clock>()->get(), _inner.get<wall_clock>()->get());
+
+    // popping components which were already cleared is a no-op
+    _inner.stop();
+    _outer.stop();
+    EXPECT_EQ(_storage->depth(), _depth);
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(tuple_tests, exclusive)
+{
+    using tuple_t = tim::component_tuple<wall_clock>;
+
+    auto _outer_label = details::get_test_name() + "/outer";
+    auto _inner_label = details::get_test_name() + "/inner";
+    {
+        tuple_t _outer(_outer_label);
+        _outer.start();
+        details::do_sleep(50);
+        for(int i = 0; i < 2; ++i)
+        {
+            tuple_t _inner(_inner_label);
+            _inner.start();
+            details::do_sleep(50);
+            _inner.stop();
+        }
+        _outer.stop();
+    }
+
+    auto _results = tim::storage<wall_clock>::instance()->get();
+    auto _find    = [&](const std::string& _label) {
+        for(auto& itr : _results)
+            if(itr.prefix().find(_label) != std::string::npos)
+                return &itr;
+        return static_cast<decltype(&_results.front())>(nullptr);
+    };
+
+    auto* _outer = _find(_outer_label);
+    auto* _inner = _find(_inner_label);
+    ASSERT_TRUE(_outer != nullptr);
+    ASSERT_TRUE(_inner != nullptr);
+
+    // the exclusive value of a node excludes the values of the children
+    EXPECT_NEAR(_inner->exclusive().get(), _inner->data().get(), 1.0e-9);
+    EXPECT_NEAR(_outer->exclusive().get(), _outer->data().get() - _inner->data().get(),
+                1.0e-9);
+    EXPECT_NEAR(_outer->exclusive().get(), 0.05, 2.5e-2);
+    EXPECT_EQ(_outer->exclusive().get_laps(), 1);
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(tuple_tests, reset_ids)
+{
+    using submap_t = std::unordered_map<int64_t, int>;
+    using map_t    = std::unordered_map<int64_t, submap_t>;
+
+    // every entry except for the head is erased, including the entries at depth zero
+    // which are visited before and after the head
+    map_t _ids{};
+    for(int64_t d = 0; d < 4; ++d)
+    {
+        for(int64_t i = 0; i < 64; ++i)
+            _ids[d][i * 7919 % 64] = static_cast<int>(d * 64 + i);
+    }
+    auto _head = _ids.at(0).at(0);
+
+    tim::node::reset_ids(_ids);
+
+    ASSERT_EQ(_ids.size(), 4);
+    ASSERT_EQ(_ids.at(0).size(), 1);
+    EXPECT_EQ(_ids.at(0).at(0), _head);
+    for(int64_t d = 1; d < 4; ++d)
+        EXPECT_TRUE(_ids.at(d).empty()) << "depth " << d;
+
+    // a map without the head is cleared
+    map_t _empty{ { 0, submap_t{ { 1, 1 }, { 2, 2 } } } };
+    tim::node::reset_ids(_empty);
+    EXPECT_TRUE(_empty.at(0).empty());
+}
+
+//--------------------------------------------------------------------------------------//
+
+TEST_F(tuple_tests, storage_reset)
+{
+    struct reset_tag
+    {};
+
+    using tracker_t = data_tracker<int64_t, reset_tag>;
+    using tuple_t   = tim::component_tuple<tracker_t>;
+
+    tracker_t::label()       = "reset_tracker";
+    tracker_t::description() = "Tracker which is reset";
+
+    auto* _storage = tim::storage<tracker_t>::instance();
+    for(int64_t n = 0; n < 3; ++n)
+    {
+        for(int64_t i = 0; i < 8; ++i)
+        {
+            tuple_t _outer(details::get_test_name() + "/" + std::to_string(i));
+            tuple_t _inner(details::get_test_name() + "/inner");
+            _outer.start();
+            _inner.start();
+            _inner.store(std::plus<int64_t>{}, n + i);
+            _inner.stop();
+            _outer.stop();
+        }
+        EXPECT_EQ(_storage->size(), 16) << "round " << n;
+
+        // the nodes inserted after a reset do not accumulate the erased nodes
+        auto _data = _storage->get();
+        ASSERT_EQ(_data.size(), 16) << "round " << n;
+        EXPECT_EQ(_data.at(1).data().get(), n);
+
+        _storage->reset();
+        EXPECT_EQ(_storage->size(), 0) << "round " << n;
+    }
+}
+
+//--------------------------------------------------------------------------------------//
+
 int
 main(int argc, char** argv)
 {
@@ -132,7 +132,7 @@ get_error(const error_t& err)
 inline error_t
 set_priority(const std::string& _tool, int _priority = 0)
 {
-    if(settings::debug())
+    if(settings::hot().debug)
         printf("[gotcha::%s]> Setting priority for tool: %s to %i...\n", __FUNCTION__,
                _tool.c_str(), _priority);
 #if defined(TIMEMORY_USE_GOTCHA)
@@ -144,7 +144,7 @@ set_priority(const std::string& _tool, int _priority = 0)
                get_error(_ret).c_str());
     return _ret;
 #else
-    if(settings::debug())
+    if(settings::hot().debug)
         printf("[gotcha::%s]> Warning! GOTCHA not truly enabled!", __FUNCTION__);
     return GOTCHA_SUCCESS;
 #endif
@@ -155,7 +155,7 @@ set_priority(const std::string& _tool, int _priority = 0)
 inline error_t
 get_priority(const std::string& _tool, int& _priority)
 {
-    if(settings::debug())
+    if(settings::hot().debug)
         printf("[gotcha::%s]> Getting priority for tool: %s to %i...\n", __FUNCTION__,
                _tool.c_str(), _priority);
 #if defined(TIMEMORY_USE_GOTCHA)
@@ -167,7 +167,7 @@ get_priority(const std::string& _tool, int& _priority)
                get_error(_ret).c_str());
     return _ret;
 #else
-    if(settings::debug())
+    if(settings::hot().debug)
         printf("[gotcha::%s]> Warning! GOTCHA not truly enabled!", __FUNCTION__);
     return GOTCHA_SUCCESS;
 #endif
@@ -180,14 +180,14 @@ wrap(binding_t& _bind, std::string& _label)
 {
     error_t _ret = GOTCHA_SUCCESS;
 
-    if(settings::debug())
+    if(settings::hot().debug)
         printf("[gotcha::%s]> Adding tool: %s...\n", __FUNCTION__, _label.c_str());
 
 #if defined(TIMEMORY_USE_GOTCHA)
     if(_ret == GOTCHA_SUCCESS)
         _ret = gotcha_wrap(&_bind, 1, _label.c_str());
 #else
-    if(settings::debug())
+    if(settings::hot().debug)
         printf("[gotcha::%s]> Warning! GOTCHA not truly enabled!", __FUNCTION__);
     consume_parameters(_bind);
 #endif
@@ -83,6 +83,8 @@ using comm_t                            = MPI_Comm;
 using info_t                            = MPI_Info;
 using data_type_t                       = MPI_Datatype;
 using status_t                          = MPI_Status;
+using op_t                              = MPI_Op;
+using win_t                             = MPI_Win;
 static const comm_t  comm_world_v       = MPI_COMM_WORLD;
 static const info_t  info_null_v        = MPI_INFO_NULL;
 static const int32_t comm_type_shared_v = MPI_COMM_TYPE_SHARED;
@@ -116,6 +118,8 @@ using comm_t                            = int32_t;
 using info_t                            = int32_t;
 using data_type_t                       = int32_t;
 using status_t                          = int32_t;
+using op_t                              = int32_t;
+using win_t                             = int32_t;
 static const comm_t  comm_world_v       = 0;
 static const info_t  info_null_v        = 0;
 static const int32_t comm_type_shared_v = 0;
@@ -471,6 +475,32 @@ get_node_index()
     return rank() / get_num_ranks_per_node();
 }
 
+//--------------------------------------------------------------------------------------//
+/// returns the index of the node in the range [0, number of nodes) ordered by the lowest
+/// rank on each node. Unlike get_node_index(), this does not assume the ranks are
+/// assigned to the nodes in contiguous blocks. The first call is collective
+inline int32_t
+get_node_id()
+{
+    if(!is_initialized())
+        return 0;
+    auto _get_node_id = []() {
+        auto   _node_comm   = get_node_comm();
+        auto   _is_leader   = (rank(_node_comm) == 0);
+        comm_t _leader_comm = comm_world_v;
+        // the first rank of each node is numbered within the group of the first ranks
+        comm_split(comm_world_v, (_is_leader) ? 0 : 1, rank(), &_leader_comm);
+        int _id = rank(_leader_comm);
+#if defined(TIMEMORY_USE_MPI)
+        MPI_Bcast(&_id, 1, MPI_INT, 0, _node_comm);
+        MPI_Comm_free(&_leader_comm);
+#endif
+        return static_cast<int32_t>(_id);
+    };
+    static int32_t _instance = _get_node_id();
+    return _instance;
+}
+
 //--------------------------------------------------------------------------------------//
 
 inline void
@@ -530,6 +560,128 @@ gather(const void* sendbuf, int sendcount, data_type_t sendtype, void* recvbuf,
 
 //--------------------------------------------------------------------------------------//
 
+inline void
+allgather(const void* sendbuf, int sendcount, data_type_t sendtype, void* recvbuf,
+          int recvcount, data_type_t recvtype, comm_t comm = mpi::comm_world_v)
+{
+#if defined(TIMEMORY_USE_MPI)
+    if(is_initialized())
+        TIMEMORY_MPI_ERROR_CHECK(MPI_Allgather(sendbuf, sendcount, sendtype, recvbuf,
+                                               recvcount, recvtype, comm));
+#else
+    consume_parameters(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm);
+#endif
+}
+
+//--------------------------------------------------------------------------------------//
+
+inline void
+allgatherv(const void* sendbuf, int sendcount, data_type_t sendtype, void* recvbuf,
+           const int* recvcounts, const int* displs, data_type_t recvtype,
+           comm_t comm = mpi::comm_world_v)
+{
+#if defined(TIMEMORY_USE_MPI)
+    if(is_initialized())
+        TIMEMORY_MPI_ERROR_CHECK(MPI_Allgatherv(sendbuf, sendcount, sendtype, recvbuf,
+                                                recvcounts, displs, recvtype, comm));
+#else
+    consume_parameters(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs,
+                       recvtype, comm);
+#endif
+}
+
+//--------------------------------------------------------------------------------------//
+
+inline void
+reduce(const void* sendbuf, void* recvbuf, int count, data_type_t datatype, op_t op,
+       int root, comm_t comm = mpi::comm_world_v)
+{
+#if defined(TIMEMORY_USE_MPI)
+    if(is_initialized())
+        TIMEMORY_MPI_ERROR_CHECK(
+            MPI_Reduce(sendbuf, recvbuf, count, datatype, op, root, comm));
+#else
+    consume_parameters(sendbuf, recvbuf, count, datatype, op, root, comm);
+#endif
+}
+
+//--------------------------------------------------------------------------------------//
+
+inline void
+bcast(void* buffer, int count, data_type_t datatype, int root,
+      comm_t comm = mpi::comm_world_v)
+{
+#if defined(TIMEMORY_USE_MPI)
+    if(is_initialized())
+        TIMEMORY_MPI_ERROR_CHECK(MPI_Bcast(buffer, count, datatype, root, comm));
+#else
+    consume_parameters(buffer, count, datatype, root, comm);
+#endif
+}
+
+//--------------------------------------------------------------------------------------//
+/// allocates a window of shared memory on the ranks of comm (which must be a
+/// communicator of ranks on the same node). The segment of each rank may have a
+/// different size (including zero)
+inline void
+win_allocate_shared(size_t size, comm_t comm, void* baseptr, win_t* win)
+{
+#if defined(TIMEMORY_USE_MPI)
+    if(is_initialized())
+        TIMEMORY_MPI_ERROR_CHECK(
+            MPI_Win_allocate_shared(size, 1, info_null_v, comm, baseptr, win));
+#else
+    consume_parameters(size, comm, baseptr, win);
+#endif
+}
+
+//--------------------------------------------------------------------------------------//
+/// queries the size and the local address of the segment of another rank
+inline void
+win_shared_query(win_t win, int rank, size_t* size, void* baseptr)
+{
+#if defined(TIMEMORY_USE_MPI)
+    if(is_initialized())
+    {
+        MPI_Aint _size = 0;
+        int      _disp = 1;
+        TIMEMORY_MPI_ERROR_CHECK(
+            MPI_Win_shared_query(win, rank, &_size, &_disp, baseptr));
+        *size = _size;
+    }
+#else
+    consume_parameters(win, rank, size, baseptr);
+#endif
+}
+
+//--------------------------------------------------------------------------------------//
+
+inline void
+win_fence(win_t win)
+{
+#if defined(TIMEMORY_USE_MPI)
+    if(is_initialized())
+        TIMEMORY_MPI_ERROR_CHECK(MPI_Win_fence(0, win));
+#else
+    consume_parameters(win);
+#endif
+}
+
+//--------------------------------------------------------------------------------------//
+
+inline void
+win_free(win_t* win)
+{
+#if defined(TIMEMORY_USE_MPI)
+    if(is_initialized())
+        TIMEMORY_MPI_ERROR_CHECK(MPI_Win_free(win));
+#else
+    consume_parameters(win);
+#endif
+}
+
+//--------------------------------------------------------------------------------------//
+
 inline void
 comm_spawn_multiple(int count, char** commands, char*** argv, const int* maxprocs,
                     const info_t* info, int root, comm_t comm, comm_t* intercomm,
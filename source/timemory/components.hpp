@@ -39,6 +39,8 @@
 #include "timemory/variadic/types.hpp"
 
 #include "timemory/components/data_tracker/components.hpp"
+#include "timemory/components/numa/components.hpp"
+#include "timemory/components/perf/components.hpp"
 #include "timemory/components/rusage/components.hpp"
 #include "timemory/components/timing/components.hpp"
 #include "timemory/components/trip_count/components.hpp"
@@ -115,7 +117,7 @@
 //--------------------------------------------------------------------------------------//
 //
 // Roofline components
-#if defined(TIMEMORY_USE_CUPTI) || defined(TIMEMORY_USE_PAPI)
+#if defined(TIMEMORY_USE_CUPTI) || defined(TIMEMORY_USE_PAPI) || defined(_LINUX)
 #    include "timemory/components/roofline/components.hpp"
 #endif
 //
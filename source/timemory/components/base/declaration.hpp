@@ -330,16 +330,17 @@ protected:
     static Type dummy();  // create an instance
 
 protected:
-    bool           is_running   = false;
-    bool           is_on_stack  = false;
-    bool           is_transient = false;
-    bool           is_flat      = false;
-    bool           depth_change = false;
-    int64_t        laps         = 0;
-    value_type     value        = value_type{};
-    accum_type     accum        = accum_type{};
-    last_type      last         = last_type{};
-    graph_iterator graph_itr    = graph_iterator{ nullptr };
+    bool                  is_running    = false;
+    bool                  is_on_stack   = false;
+    bool                  is_transient  = false;
+    bool                  is_flat       = false;
+    bool                  depth_change  = false;
+    node::in_flight_index in_flight_idx = {};  // slot in the in-flight record
+    int64_t               laps          = 0;
+    value_type            value         = value_type{};
+    accum_type            accum         = accum_type{};
+    last_type             last          = last_type{};
+    graph_iterator        graph_itr     = graph_iterator{ nullptr };
 
 public:
     static constexpr bool timing_category_v = trait::is_timing_category<Type>::value;
@@ -39,10 +39,13 @@
 #include <cassert>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 //======================================================================================//
 //
@@ -72,21 +75,39 @@ namespace component
 ///             // ... do something ...
 ///         }
 ///
+/// Secondary data is stored per-instance in a flat hash map from the hash of the label
+/// to the accumulated value. Hot code paths should pre-compute the key once:
+///
+///         static auto _key = tracker_type::get_secondary_key("converged");
+///         t.add_secondary(_key, std::plus<uint64_t>{}, 1);
+///
 template <typename InpT, typename Tag, typename Handler, typename StoreT>
 struct data_tracker : public base<data_tracker<InpT, Tag, Handler, StoreT>, StoreT>
 {
-    using value_type      = StoreT;
-    using this_type       = data_tracker<InpT, Tag, Handler, StoreT>;
-    using base_type       = base<this_type, value_type>;
-    using handler_type    = Handler;
-    using secondary_map_t = std::unordered_map<std::string, this_type>;
-    using secondary_ptr_t = std::shared_ptr<secondary_map_t>;
-    using string_t        = std::string;
+    using value_type            = StoreT;
+    using this_type             = data_tracker<InpT, Tag, Handler, StoreT>;
+    using base_type             = base<this_type, value_type>;
+    using handler_type          = Handler;
+    using string_t              = std::string;
+    using secondary_key_t       = hash_result_type;
+    using secondary_map_t       = std::vector<std::pair<secondary_key_t, this_type>>;
+    using secondary_label_map_t = std::unordered_map<secondary_key_t, string_t>;
     using start_t =
         operation::generic_operator<this_type, operation::start<this_type>, Tag>;
     using stop_t =
         operation::generic_operator<this_type, operation::stop<this_type>, Tag>;
 
+    /// the entries are stored densely in insertion order and the index is an
+    /// open-addressing table (linear probing, load factor <= 0.5) from the key to the
+    /// position of the entry. Empty slots are -1
+    struct secondary_data
+    {
+        secondary_map_t      entries = {};
+        std::vector<int32_t> index   = {};
+    };
+
+    using secondary_ptr_t = std::shared_ptr<secondary_data>;
+
     static std::string& label()
     {
         static std::string _instance = []() {
@@ -176,58 +197,68 @@ struct data_tracker : public base<data_tracker<InpT, Tag, Handler, StoreT>, Stor
 
     void set_value(const value_type& v) { value = v; }
 
+    /// register the label of a secondary entry and return the key for the hashed
+    /// add_secondary overloads. The key can be stored (e.g. in a static variable) and
+    /// the label is only resolved when the data is output
+    static secondary_key_t get_secondary_key(const string_t& _label)
+    {
+        auto _key = ::tim::add_hash_id(_label);
+        std::unique_lock<std::mutex> _lk(get_secondary_mutex());
+        get_secondary_labels().emplace(_key, _label);
+        return _key;
+    }
+
     template <typename T,
               enable_if_t<(concepts::is_acceptable_conversion<T, InpT>::value), int> = 0>
-    this_type* add_secondary(const string_t& _key, const T& val)
+    this_type* add_secondary(secondary_key_t _key, const T& val)
     {
         this_type _tmp;
         start_t   _start(_tmp);
         _tmp.store(val);
         stop_t _stop(_tmp);
-        auto&  _map = *get_secondary_map();
-        _map.insert({ _key, _tmp });
-        return &(_map[_key]);
+        return insert_secondary(_key, std::move(_tmp));
     }
 
     template <typename T,
               enable_if_t<(concepts::is_acceptable_conversion<T, InpT>::value), int> = 0>
-    this_type* add_secondary(const string_t& _key, handler_type&& h, const T& val)
+    this_type* add_secondary(secondary_key_t _key, handler_type&& h, const T& val)
     {
         this_type _tmp;
         start_t   _start(_tmp);
         _tmp.store(std::forward<handler_type>(h), val);
         stop_t _stop(_tmp);
-        auto&  _map = *get_secondary_map();
-        _map.insert({ _key, _tmp });
-        return &(_map[_key]);
+        return insert_secondary(_key, std::move(_tmp));
     }
 
     template <typename Func, typename T,
               enable_if_t<(concepts::is_acceptable_conversion<T, InpT>::value), int> = 0>
-    this_type* add_secondary(const string_t& _key, Func&& f, const T& val)
+    this_type* add_secondary(secondary_key_t _key, Func&& f, const T& val)
     {
-        PRINT_HERE("%s :: adding secondary", demangle<this_type>().c_str());
         this_type _tmp;
         start_t   _start(_tmp);
         _tmp.store(std::forward<Func>(f), val);
         stop_t _stop(_tmp);
-        auto&  _map = *get_secondary_map();
-        _map.insert({ _key, _tmp });
-        return &(_map[_key]);
+        return insert_secondary(_key, std::move(_tmp));
     }
 
     template <typename Func, typename T,
               enable_if_t<(concepts::is_acceptable_conversion<T, InpT>::value), int> = 0>
-    this_type* add_secondary(const string_t& _key, handler_type&& h, Func&& f,
+    this_type* add_secondary(secondary_key_t _key, handler_type&& h, Func&& f,
                              const T& val)
     {
         this_type _tmp;
         start_t   _start(_tmp);
         _tmp.store(std::forward<handler_type>(h), std::forward<Func>(f), val);
         stop_t _stop(_tmp);
-        auto&  _map = *get_secondary_map();
-        _map.insert({ _key, _tmp });
-        return &(_map[_key]);
+        return insert_secondary(_key, std::move(_tmp));
+    }
+
+    /// the key of the label is cached per-thread so that only the first call with a
+    /// given label on a thread registers the label
+    template <typename... Args>
+    this_type* add_secondary(const string_t& _key, Args&&... args)
+    {
+        return add_secondary(get_thread_secondary_key(_key), std::forward<Args>(args)...);
     }
 
     using base_type::get_unit;
@@ -237,11 +268,86 @@ struct data_tracker : public base<data_tracker<InpT, Tag, Handler, StoreT>, Stor
     auto get_secondary_map()
     {
         if(!m_secondary)
-            m_secondary = std::make_shared<secondary_map_t>();
+            m_secondary = std::make_shared<secondary_data>();
         return m_secondary;
     }
 
-    auto get_secondary() { return (m_secondary) ? *m_secondary : secondary_map_t{}; }
+    /// the labels of the keys are registered in the hash-ids of the storage by
+    /// operation::add_secondary when the entries are appended to the graph
+    const secondary_map_t& get_secondary() const
+    {
+        static const secondary_map_t _empty{};
+        return (m_secondary) ? m_secondary->entries : _empty;
+    }
+
+    static string_t get_secondary_label(secondary_key_t _key)
+    {
+        std::unique_lock<std::mutex> _lk(get_secondary_mutex());
+        auto                         itr = get_secondary_labels().find(_key);
+        return (itr != get_secondary_labels().end()) ? itr->second : string_t{};
+    }
+
+private:
+    /// accumulate into the existing entry for the key or append a new entry. The
+    /// returned pointer is invalidated by the next insertion of a new key
+    this_type* insert_secondary(secondary_key_t _key, this_type&& _obj)
+    {
+        auto& _data = *get_secondary_map();
+        if(2 * (_data.entries.size() + 1) > _data.index.size())
+            rehash_secondary(_data, (_data.index.empty()) ? 8 : 2 * _data.index.size());
+
+        size_t _mask = _data.index.size() - 1;
+        for(size_t i = _key & _mask;; i = (i + 1) & _mask)
+        {
+            auto& _slot = _data.index[i];
+            if(_slot < 0)
+            {
+                _slot = static_cast<int32_t>(_data.entries.size());
+                _data.entries.emplace_back(_key, std::move(_obj));
+                return &_data.entries.back().second;
+            }
+            auto& _entry = _data.entries[_slot];
+            if(_entry.first == _key)
+            {
+                _entry.second += _obj;
+                return &_entry.second;
+            }
+        }
+    }
+
+    static void rehash_secondary(secondary_data& _data, size_t _size)
+    {
+        _data.index.assign(_size, -1);
+        size_t _mask = _size - 1;
+        for(size_t n = 0; n < _data.entries.size(); ++n)
+        {
+            size_t i = _data.entries[n].first & _mask;
+            while(_data.index[i] >= 0)
+                i = (i + 1) & _mask;
+            _data.index[i] = static_cast<int32_t>(n);
+        }
+    }
+
+    static secondary_key_t get_thread_secondary_key(const string_t& _label)
+    {
+        static thread_local std::unordered_map<string_t, secondary_key_t> _keys{};
+        auto itr = _keys.find(_label);
+        if(itr == _keys.end())
+            itr = _keys.emplace(_label, get_secondary_key(_label)).first;
+        return itr->second;
+    }
+
+    static std::mutex& get_secondary_mutex()
+    {
+        static std::mutex _instance;
+        return _instance;
+    }
+
+    static secondary_label_map_t& get_secondary_labels()
+    {
+        static secondary_label_map_t _instance{};
+        return _instance;
+    }
 
 private:
     secondary_ptr_t m_secondary{ nullptr };
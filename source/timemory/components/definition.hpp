@@ -33,8 +33,10 @@
 #include "timemory/components/gotcha/components.hpp"
 #include "timemory/components/gperftools/components.hpp"
 #include "timemory/components/likwid/components.hpp"
+#include "timemory/components/numa/components.hpp"
 #include "timemory/components/ompt/components.hpp"
 #include "timemory/components/papi/components.hpp"
+#include "timemory/components/perf/components.hpp"
 #include "timemory/components/roofline/components.hpp"
 #include "timemory/components/rusage/components.hpp"
 #include "timemory/components/tau_marker/components.hpp"
@@ -80,6 +80,18 @@
 //
 //--------------------------------------------------------------------------------------//
 //
+#if defined(TIMEMORY_USE_PERF_EXTERN)
+#    include "timemory/components/perf/extern.hpp"
+#endif
+//
+//--------------------------------------------------------------------------------------//
+//
+#if defined(TIMEMORY_USE_NUMA_EXTERN)
+#    include "timemory/components/numa/extern.hpp"
+#endif
+//
+//--------------------------------------------------------------------------------------//
+//
 #if defined(TIMEMORY_USE_PAPI_EXTERN) || defined(TIMEMORY_USE_CUPTI_EXTERN)
 #    include "timemory/components/roofline/extern.hpp"
 #endif
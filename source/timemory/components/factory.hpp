@@ -103,9 +103,11 @@ TIMEMORY_EXTERN_FACTORY_TEMPLATE(gpu_roofline_dp_flops)
 TIMEMORY_EXTERN_FACTORY_TEMPLATE(gpu_roofline_flops)
 TIMEMORY_EXTERN_FACTORY_TEMPLATE(gpu_roofline_hp_flops)
 TIMEMORY_EXTERN_FACTORY_TEMPLATE(gpu_roofline_sp_flops)
+TIMEMORY_EXTERN_FACTORY_TEMPLATE(io_gotcha)
 TIMEMORY_EXTERN_FACTORY_TEMPLATE(kernel_mode_time)
 TIMEMORY_EXTERN_FACTORY_TEMPLATE(likwid_marker)
 TIMEMORY_EXTERN_FACTORY_TEMPLATE(likwid_nvmarker)
+TIMEMORY_EXTERN_FACTORY_TEMPLATE(lock_gotcha)
 TIMEMORY_EXTERN_FACTORY_TEMPLATE(malloc_gotcha)
 TIMEMORY_EXTERN_FACTORY_TEMPLATE(monotonic_clock)
 TIMEMORY_EXTERN_FACTORY_TEMPLATE(monotonic_raw_clock)
@@ -117,12 +119,14 @@ TIMEMORY_EXTERN_FACTORY_TEMPLATE(num_msg_recv)
 TIMEMORY_EXTERN_FACTORY_TEMPLATE(num_msg_sent)
 TIMEMORY_EXTERN_FACTORY_TEMPLATE(num_signals)
 TIMEMORY_EXTERN_FACTORY_TEMPLATE(num_swap)
+TIMEMORY_EXTERN_FACTORY_TEMPLATE(numa_locality)
 TIMEMORY_EXTERN_FACTORY_TEMPLATE(nvtx_marker)
 TIMEMORY_EXTERN_FACTORY_TEMPLATE(ompt_native_handle)
 TIMEMORY_EXTERN_FACTORY_TEMPLATE(page_rss)
 TIMEMORY_EXTERN_FACTORY_TEMPLATE(papi_array_t)
 TIMEMORY_EXTERN_FACTORY_TEMPLATE(papi_vector)
 TIMEMORY_EXTERN_FACTORY_TEMPLATE(peak_rss)
+TIMEMORY_EXTERN_FACTORY_TEMPLATE(perf_counters)
 TIMEMORY_EXTERN_FACTORY_TEMPLATE(priority_context_switch)
 TIMEMORY_EXTERN_FACTORY_TEMPLATE(process_cpu_clock)
 TIMEMORY_EXTERN_FACTORY_TEMPLATE(process_cpu_util)
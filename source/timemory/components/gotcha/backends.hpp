@@ -113,6 +113,19 @@ public:
 //
 //======================================================================================//
 ///
+/// \typedef component::gotcha_index
+/// \brief Tag passed to the replacement component of a gotcha when it provides
+///
+///     Ret operator()(gotcha_index<N>, Ret (*)(Args...), Args...)
+///
+/// The tag is the index of the wrapper and the second argument is the original
+/// function so one component can replace several functions with the same signature
+///
+template <size_t N>
+using gotcha_index = std::integral_constant<size_t, N>;
+//
+//======================================================================================//
+///
 /// \struct component::gotcha_invoker
 ///
 ///
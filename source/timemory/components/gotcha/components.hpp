@@ -29,8 +29,12 @@
 
 #pragma once
 
+#include "timemory/backends/dmp.hpp"
 #include "timemory/components/base.hpp"
 #include "timemory/components/gotcha/backends.hpp"
+#include "timemory/components/gotcha/heap_sampler.hpp"
+#include "timemory/components/gotcha/io_trace.hpp"
+#include "timemory/components/gotcha/lock_contention.hpp"
 #include "timemory/components/gotcha/types.hpp"
 #include "timemory/macros.hpp"
 #include "timemory/mpl/apply.hpp"
@@ -39,6 +43,18 @@
 #include "timemory/units.hpp"
 #include "timemory/variadic/types.hpp"
 
+#include <fstream>
+#include <iostream>
+
+#if defined(_UNIX)
+#    include <cstdio>
+#    include <fcntl.h>
+#    include <pthread.h>
+#    include <sys/types.h>
+#    include <sys/uio.h>
+#    include <unistd.h>
+#endif
+
 //======================================================================================//
 //
 namespace tim
@@ -167,8 +183,9 @@ struct gotcha : public base<gotcha<Nt, Components, Differentiator>, void>
                     _label.erase(_label.find("//"), 1);
             }
 
-            // ensure the hash to string pairing is stored
-            storage_type::instance()->add_hash_id(_label);
+            // ensure the hash to string pairing is stored. The wrappers construct
+            // the components from the hash so the label is only hashed here
+            _data.tool_hash = storage_type::instance()->add_hash_id(_label);
 
             _data.filled   = true;
             _data.priority = _priority;
@@ -244,6 +261,21 @@ struct gotcha : public base<gotcha<Nt, Components, Differentiator>, void>
 
     static std::mutex& get_mutex() { return get_persistent_data().m_mutex; }
 
+    //----------------------------------------------------------------------------------//
+    /// the original function of wrapper N, i.e. calling it never enters the wrapper.
+    /// nullptr when the function has not been wrapped
+    template <size_t N, typename FuncT>
+    static FuncT get_original()
+    {
+        static_assert(N < Nt, "Error! N must be less than Nt!");
+#if defined(TIMEMORY_USE_GOTCHA)
+        auto& _data = get_data()[N];
+        if(_data.wrappee)
+            return (FuncT) gotcha_get_wrappee(_data.wrappee);
+#endif
+        return nullptr;
+    }
+
     //----------------------------------------------------------------------------------//
 
     static void configure()
@@ -445,6 +477,7 @@ private:
         wrappee_t     wrappee      = 0x0;      /// the func pointer being wrapped
         wrappid_t     wrap_id      = "";       /// the function name (possibly mangled)
         wrappid_t     tool_id      = "";       /// the function name (unmangled)
+        size_t        tool_hash    = 0;        /// the hash of tool_id
         constructor_t constructor  = []() {};  /// wrap the function
         destructor_t  destructor   = []() {};  /// unwrap the function
         bool*         suppression  = nullptr;  /// turn on/off some suppression variable
@@ -494,6 +527,61 @@ private:
         return _instance;
     }
 
+    //----------------------------------------------------------------------------------//
+    /// \struct thread_state
+    /// \brief Per-thread state of the wrappers. Bit N of \a active is set while the
+    /// components of wrapper N are being invoked on the thread, i.e. the wrapper
+    /// calls the original function directly when it is re-entered on the same thread
+    /// without affecting the other threads. Bit N of \a registered is set once the
+    /// tool id of wrapper N has been added to the hash-ids of the thread.
+    struct thread_state
+    {
+        static constexpr size_t num_words = (Nt + 63) / 64;
+        using words_t                     = std::array<uint64_t, num_words>;
+
+        template <size_t N>
+        static constexpr uint64_t mask()
+        {
+            return (1ULL << (N % 64));
+        }
+
+        template <size_t N>
+        bool is_active() const
+        {
+            return (active[N / 64] & mask<N>()) != 0;
+        }
+
+        template <size_t N>
+        void set_active(bool _v)
+        {
+            active[N / 64] = (_v) ? (active[N / 64] | mask<N>())
+                                  : (active[N / 64] & ~mask<N>());
+        }
+
+        template <size_t N>
+        size_t get_hash(const gotcha_data& _data)
+        {
+            if((registered[N / 64] & mask<N>()) == 0)
+            {
+                add_hash_id(_data.tool_id);
+                registered[N / 64] |= mask<N>();
+            }
+            return _data.tool_hash;
+        }
+
+        words_t active     = {};
+        words_t registered = {};
+    };
+
+    //----------------------------------------------------------------------------------//
+    /// \fn get_thread_state()
+    /// \brief Thread-local state of the wrappers
+    static thread_state& get_thread_state()
+    {
+        static thread_local thread_state _instance{};
+        return _instance;
+    }
+
     //----------------------------------------------------------------------------------//
     /// \fn get_suppresses()
     /// \brief global suppression when being used
@@ -750,6 +838,32 @@ private:
         _func(std::forward<Args>(_args)...);
     }
 
+    //----------------------------------------------------------------------------------//
+    //  Call:
+    //
+    //      Ret operator_type::operator()(gotcha_index<N>, Ret (*)(Args...), Args...)
+    //
+    //  when the replacement component provides it, otherwise fall back to invoke
+    //
+    template <size_t N, typename Comp, typename Ret, typename... Args>
+    static auto invoke_replacement(Comp& _comp, int, Ret (*_func)(Args...),
+                                   Args&&... _args)
+        -> decltype((*_comp.template get<operator_type>())(
+            gotcha_index<N>{}, _func, std::forward<Args>(_args)...))
+    {
+        auto& _obj = *_comp.template get<operator_type>();
+        return _obj(gotcha_index<N>{}, _func, std::forward<Args>(_args)...);
+    }
+
+    //----------------------------------------------------------------------------------//
+
+    template <size_t N, typename Comp, typename Ret, typename... Args>
+    static Ret invoke_replacement(Comp& _comp, long, Ret (*_func)(Args...),
+                                  Args&&... _args)
+    {
+        return invoke(_comp, _func, std::forward<Args>(_args)...);
+    }
+
     //----------------------------------------------------------------------------------//
 
     template <size_t N, typename Ret, typename... Args>
@@ -765,10 +879,13 @@ private:
         typedef Ret (*func_t)(Args...);
         func_t _orig = (func_t)(gotcha_get_wrappee(_data.wrappee));
 
+        auto& _state           = get_thread_state();
+        auto& _hot             = settings::hot();
         auto& _global_suppress = gotcha_suppression::get();
-        if(!_data.ready || _global_suppress || !settings::enabled())
+        if(_state.template is_active<N>() || !_data.ready || _global_suppress ||
+           !_hot.enabled)
         {
-            if(settings::debug())
+            if(_hot.debug)
             {
                 static std::atomic<int64_t> _tcount(0);
                 static thread_local int64_t _tid = _tcount++;
@@ -776,7 +893,7 @@ private:
                 ss << "[T" << _tid << "]> " << _data.tool_id << " is either not ready ("
                    << std::boolalpha << !_data.ready << "), is globally suppressed ("
                    << _global_suppress << "), or timemory is disabled ("
-                   << settings::enabled() << "...\n";
+                   << _hot.enabled << "...\n";
                 std::cout << ss.str() << std::flush;
             }
             return (_orig) ? (*_orig)(_args...) : Ret{};
@@ -803,37 +920,38 @@ private:
 
         if(_orig)
         {
-            // make sure the function is not recursively entered
+            // make sure the function is not recursively entered on this thread
             // (important for allocation-based wrappers)
-            _data.ready = false;
-            toggle_suppress_on(_data.suppression, did_data_toggle);
+            bool* _data_suppress = (_data.suppression) ? &_global_suppress : nullptr;
+            _state.template set_active<N>(true);
+            toggle_suppress_on(_data_suppress, did_data_toggle);
 
             // component_type is always: component_{tuple,list,hybrid}
-            toggle_suppress_on(&gotcha_suppression::get(), did_glob_toggle);
-            component_type _obj(_data.tool_id, true);
+            toggle_suppress_on(&_global_suppress, did_glob_toggle);
+            component_type _obj(_state.template get_hash<N>(_data), true);
             _obj.construct(_args...);
             _obj.start();
             _obj.audit(_data.tool_id, _args...);
-            toggle_suppress_off(&gotcha_suppression::get(), did_glob_toggle);
+            toggle_suppress_off(&_global_suppress, did_glob_toggle);
 
-            _data.ready = true;
-            Ret _ret    = invoke<component_type>(_obj, _data.ready, _orig,
+            _state.template set_active<N>(false);
+            Ret _ret = invoke<component_type>(_obj, _data.ready, _orig,
                                               std::forward<Args>(_args)...);
-            _data.ready = false;
+            _state.template set_active<N>(true);
 
-            toggle_suppress_on(&gotcha_suppression::get(), did_glob_toggle);
+            toggle_suppress_on(&_global_suppress, did_glob_toggle);
             _obj.audit(_data.tool_id, _ret);
             _obj.stop();
-            toggle_suppress_off(&gotcha_suppression::get(), did_glob_toggle);
+            toggle_suppress_off(&_global_suppress, did_glob_toggle);
 
             // allow re-entrance into wrapper
-            toggle_suppress_off(_data.suppression, did_data_toggle);
-            _data.ready = true;
+            toggle_suppress_off(_data_suppress, did_data_toggle);
+            _state.template set_active<N>(false);
 
             return _ret;
         }
 
-        if(settings::debug())
+        if(_hot.debug)
             PRINT_HERE("%s", "nullptr to original function!");
 #else
         consume_parameters(_args...);
@@ -856,10 +974,13 @@ private:
 
         auto _orig = (void (*)(Args...)) gotcha_get_wrappee(_data.wrappee);
 
+        auto& _state           = get_thread_state();
+        auto& _hot             = settings::hot();
         auto& _global_suppress = gotcha_suppression::get();
-        if(!_data.ready || _global_suppress || !settings::enabled())
+        if(_state.template is_active<N>() || !_data.ready || _global_suppress ||
+           !_hot.enabled)
         {
-            if(settings::debug())
+            if(_hot.debug)
             {
                 static std::atomic<int64_t> _tcount(0);
                 static thread_local int64_t _tid = _tcount++;
@@ -867,7 +988,7 @@ private:
                 ss << "[T" << _tid << "]> " << _data.tool_id << " is either not ready ("
                    << std::boolalpha << !_data.ready << ") or is globally suppressed ("
                    << _global_suppress << "), or timemory is disabled ("
-                   << settings::enabled() << "...\n";
+                   << _hot.enabled << "...\n";
                 std::cout << ss.str() << std::flush;
             }
             if(_orig)
@@ -894,38 +1015,39 @@ private:
             }
         };
 
-        // make sure the function is not recursively entered
+        // make sure the function is not recursively entered on this thread
         // (important for allocation-based wrappers)
-        _data.ready = false;
-        toggle_suppress_on(_data.suppression, did_data_toggle);
-        toggle_suppress_on(&gotcha_suppression::get(), did_glob_toggle);
+        bool* _data_suppress = (_data.suppression) ? &_global_suppress : nullptr;
+        _state.template set_active<N>(true);
+        toggle_suppress_on(_data_suppress, did_data_toggle);
+        toggle_suppress_on(&_global_suppress, did_glob_toggle);
 
         if(_orig)
         {
-            component_type _obj(_data.tool_id, true);
+            component_type _obj(_state.template get_hash<N>(_data), true);
             _obj.construct(_args...);
             _obj.start();
             _obj.audit(_data.tool_id, _args...);
-            toggle_suppress_off(&gotcha_suppression::get(), did_glob_toggle);
+            toggle_suppress_off(&_global_suppress, did_glob_toggle);
 
-            _data.ready = true;
+            _state.template set_active<N>(false);
             invoke<component_type>(_obj, _data.ready, _orig,
                                    std::forward<Args>(_args)...);
-            _data.ready = false;
+            _state.template set_active<N>(true);
 
-            toggle_suppress_on(&gotcha_suppression::get(), did_glob_toggle);
+            toggle_suppress_on(&_global_suppress, did_glob_toggle);
             _obj.audit(_data.tool_id);
             _obj.stop();
         }
-        else if(settings::debug())
+        else if(_hot.debug)
         {
             PRINT_HERE("%s", "nullptr to original function!");
         }
 
         // allow re-entrance into wrapper
-        toggle_suppress_off(&gotcha_suppression::get(), did_glob_toggle);
-        toggle_suppress_off(_data.suppression, did_data_toggle);
-        _data.ready = true;
+        toggle_suppress_off(&_global_suppress, did_glob_toggle);
+        toggle_suppress_off(_data_suppress, did_data_toggle);
+        _state.template set_active<N>(false);
 
 #else
         consume_parameters(_args...);
@@ -950,14 +1072,18 @@ private:
         static constexpr bool void_operator = std::is_same<operator_type, void>::value;
         static_assert(!void_operator, "operator_type cannot be void!");
 
-        auto _orig = (func_t) gotcha_get_wrappee(_data.wrappee);
-        if(!_data.ready || !settings::enabled())
+        // the guard is thread-local so that while one thread is inside the
+        // replacement, the other threads are not routed to the original function
+        auto& _state = get_thread_state();
+        auto& _hot   = settings::hot();
+        auto  _orig  = (func_t) gotcha_get_wrappee(_data.wrappee);
+        if(_state.template is_active<N>() || !_data.ready || !_hot.enabled)
             return (*_orig)(_args...);
 
-        _data.ready = false;
-        static thread_local wrap_type _obj(_data.tool_id, false);
-        Ret _ret    = invoke(_obj, _orig, std::forward<Args>(_args)...);
-        _data.ready = true;
+        _state.template set_active<N>(true);
+        static thread_local wrap_type _obj(_state.template get_hash<N>(_data), false);
+        Ret _ret = invoke_replacement<N>(_obj, 0, _orig, std::forward<Args>(_args)...);
+        _state.template set_active<N>(false);
         return _ret;
 #else
         consume_parameters(_args...);
@@ -981,15 +1107,18 @@ private:
         static constexpr bool void_operator = std::is_same<operator_type, void>::value;
         static_assert(!void_operator, "operator_type cannot be void!");
 
-        auto _orig = (func_t) gotcha_get_wrappee(_data.wrappee);
-        if(!_data.ready || !settings::enabled())
+        auto& _state = get_thread_state();
+        auto& _hot   = settings::hot();
+        auto  _orig  = (func_t) gotcha_get_wrappee(_data.wrappee);
+        if(_state.template is_active<N>() || !_data.ready || !_hot.enabled)
             (*_orig)(_args...);
         else
         {
-            _data.ready = false;
-            static thread_local wrap_type _obj(_data.tool_id, false);
-            invoke(_obj, _orig, std::forward<Args>(_args)...);
-            _data.ready = true;
+            _state.template set_active<N>(true);
+            static thread_local wrap_type _obj(_state.template get_hash<N>(_data),
+                                               false);
+            invoke_replacement<N>(_obj, 0, _orig, std::forward<Args>(_args)...);
+            _state.template set_active<N>(false);
         }
 #else
         consume_parameters(_args...);
@@ -1030,7 +1159,6 @@ struct malloc_gotcha : base<malloc_gotcha, double>
     using this_type    = malloc_gotcha;
     using base_type    = base<this_type, value_type>;
     using storage_type = typename base_type::storage_type;
-    using string_hash  = std::hash<std::string>;
 
     // formatting
     static const short precision = 3;
@@ -1069,23 +1197,25 @@ public:
 
     //----------------------------------------------------------------------------------//
 
-    static uintmax_t get_index(uintmax_t _hash)
+    /// the gotcha wrappers pass the function name to the audit functions so the
+    /// index is resolved by comparing against the wrapped function names instead of
+    /// hashing the name on every call
+    static uintmax_t get_index(const std::string& _name)
     {
-        uintmax_t idx = std::numeric_limits<uintmax_t>::max();
-        for(uintmax_t i = 0; i < get_hash_array().size(); ++i)
+        const auto& _names = get_function_names();
+        for(uintmax_t i = 0; i < _names.size(); ++i)
         {
-            if(_hash == get_hash_array()[i])
-                idx = i;
+            if(_name.length() == _names[i].second && _name == _names[i].first)
+                return i;
         }
-        return idx;
+        return std::numeric_limits<uintmax_t>::max();
     }
 
 public:
     //----------------------------------------------------------------------------------//
 
     malloc_gotcha(const std::string& _prefix)
-    : prefix_hash(string_hash()(_prefix))
-    , prefix_idx(get_index(prefix_hash))
+    : prefix_idx(get_index(_prefix))
     , prefix(_prefix)
     {
         value = 0.0;
@@ -1102,6 +1232,30 @@ public:
 public:
     //----------------------------------------------------------------------------------//
 
+    static void global_finalize(storage_type*)
+    {
+        if(heap_sampler::tables::instance().num_samples.load() == 0)
+            return;
+
+        if(settings::file_output() && settings::text_output())
+        {
+            auto _fname = settings::compose_output_filename("heap_profile", ".txt");
+            std::ofstream ofs(_fname.c_str());
+            if(ofs)
+            {
+                if(settings::verbose() >= 0)
+                    printf("[%s]|%i> Outputting '%s'...\n", get_label().c_str(),
+                           dmp::rank(), _fname.c_str());
+                heap_sampler::print(ofs);
+            }
+        }
+
+        if(settings::cout_output())
+            heap_sampler::print(std::cout);
+    }
+
+    //----------------------------------------------------------------------------------//
+
     void start()
     {
         set_started();
@@ -1126,38 +1280,19 @@ public:
     double get() const { return accum / base_type::get_unit(); }
 
     //----------------------------------------------------------------------------------//
-
+    //  the allocations are sampled so the value of this component is the estimated
+    //  number of bytes allocated (malloc, calloc) or freed (free)
+    //
     void audit(const std::string& fname, size_t nbytes)
     {
         DEBUG_PRINT_HERE("%s(%i)", fname.c_str(), (int) nbytes);
 
-        auto _hash = string_hash()(fname);
-        auto idx   = get_index(_hash);
-
-        DEBUG_PRINT_HERE("hash: %lu, index: %i", (unsigned long) _hash, (int) idx);
-
-        if(idx > get_hash_array().size())
-        {
-            if(settings::verbose() > 1 || settings::debug())
-                printf("[%s]> unknown function: '%s'\n", this_type::get_label().c_str(),
-                       fname.c_str());
-            return;
-        }
-
-        if(_hash == prefix_hash)
-        {
-            // malloc
-            value = (nbytes);
-            accum += (nbytes);
-            DEBUG_PRINT_HERE("value: %12.8f, accum: %12.8f", value, accum);
-        }
-        else
-        {
-            if(settings::verbose() > 1 || settings::debug())
-                printf("[%s]> skipped function '%s with hash %llu'\n",
-                       this_type::get_label().c_str(), fname.c_str(),
-                       (long long unsigned) _hash);
-        }
+        auto idx = get_index(fname);
+        if(idx < num_alloc && idx == prefix_idx)
+            m_weight = heap_sampler::sampler::instance()(nbytes);
+        else if(idx >= data_size && (settings::verbose() > 1 || settings::debug()))
+            printf("[%s]> unknown function: '%s'\n", this_type::get_label().c_str(),
+                   fname.c_str());
     }
 
     //----------------------------------------------------------------------------------//
@@ -1166,31 +1301,12 @@ public:
     {
         DEBUG_PRINT_HERE("%s(%i, %i)", fname.c_str(), (int) nmemb, (int) size);
 
-        auto _hash = string_hash()(fname);
-        auto idx   = get_index(_hash);
-
-        if(idx > get_hash_array().size())
-        {
-            if(settings::verbose() > 1 || settings::debug())
-                printf("[%s]> unknown function: '%s'\n", this_type::get_label().c_str(),
-                       fname.c_str());
-            return;
-        }
-
-        if(_hash == prefix_hash)
-        {
-            // calloc
-            value = (nmemb * size);
-            accum += (nmemb * size);
-            DEBUG_PRINT_HERE("value: %12.8f, accum: %12.8f", value, accum);
-        }
-        else
-        {
-            if(settings::verbose() > 1 || settings::debug())
-                printf("[%s]> skipped function '%s with hash %llu'\n",
-                       this_type::get_label().c_str(), fname.c_str(),
-                       (long long unsigned) _hash);
-        }
+        auto idx = get_index(fname);
+        if(idx < num_alloc && idx == prefix_idx)
+            m_weight = heap_sampler::sampler::instance()(nmemb * size);
+        else if(idx >= data_size && (settings::verbose() > 1 || settings::debug()))
+            printf("[%s]> unknown function: '%s'\n", this_type::get_label().c_str(),
+                   fname.c_str());
     }
 
     //----------------------------------------------------------------------------------//
@@ -1202,10 +1318,8 @@ public:
         if(!ptr)
             return;
 
-        auto _hash = string_hash()(fname);
-        auto idx   = get_index(_hash);
-
-        if(idx > get_hash_array().size())
+        auto idx = get_index(fname);
+        if(idx >= data_size)
         {
             if(settings::verbose() > 1 || settings::debug())
                 printf("[%s]> unknown function: '%s'\n", this_type::get_label().c_str(),
@@ -1213,29 +1327,19 @@ public:
             return;
         }
 
-        // malloc
         if(idx < num_alloc)
         {
-            get_allocation_map()[ptr] = value;
-            DEBUG_PRINT_HERE("value: %12.8f, accum: %12.8f", value, accum);
+            // return value of malloc/calloc
+            if(m_weight > 0.0)
+                record_sample(ptr);
         }
         else
         {
-            auto itr = get_allocation_map().find(ptr);
-            if(itr != get_allocation_map().end())
-            {
-                value = itr->second;
-                accum += itr->second;
-                DEBUG_PRINT_HERE("value: %12.8f, accum: %12.8f", value, accum);
-                get_allocation_map().erase(itr);
-            }
-            else
-            {
-                if(settings::verbose() > 1 || settings::debug())
-                    printf("[%s]> free of unknown pointer size: %p\n",
-                           this_type::get_label().c_str(), ptr);
-            }
+            // free
+            value = heap_sampler::record_free(ptr);
+            accum += value;
         }
+        DEBUG_PRINT_HERE("value: %12.8f, accum: %12.8f", value, accum);
     }
 
     //----------------------------------------------------------------------------------//
@@ -1246,68 +1350,32 @@ public:
 
     void audit(const std::string& fname, void** devPtr, size_t size)
     {
-        auto _hash = string_hash()(fname);
-        auto idx   = get_index(_hash);
-
-        if(idx > get_hash_array().size())
+        auto idx = get_index(fname);
+        if(idx < num_alloc && idx == prefix_idx)
         {
-            if(settings::verbose() > 1 || settings::debug())
-                printf("[%s]> unknown function: '%s'\n", this_type::get_label().c_str(),
-                       fname.c_str());
-            return;
-        }
-
-        if(_hash == prefix_hash)
-        {
-            // malloc
-            value = (size);
-            accum += (size);
+            // cudaMalloc
+            m_weight    = heap_sampler::sampler::instance()(size);
             m_last_addr = devPtr;
         }
-        else
-        {
-            if(settings::verbose() > 1 || settings::debug())
-                printf("[%s]> skipped function '%s with hash %llu'\n",
-                       this_type::get_label().c_str(), fname.c_str(),
-                       (long long unsigned) _hash);
-        }
+        else if(idx >= data_size && (settings::verbose() > 1 || settings::debug()))
+            printf("[%s]> unknown function: '%s'\n", this_type::get_label().c_str(),
+                   fname.c_str());
     }
 
     //----------------------------------------------------------------------------------//
 
     void audit(const std::string& fname, cuda::error_t)
     {
-        auto _hash = string_hash()(fname);
-        auto idx   = get_index(_hash);
-
-        if(idx > get_hash_array().size())
-        {
-            if(settings::verbose() > 1 || settings::debug())
-                printf("[%s]> unknown function: '%s'\n", this_type::get_label().c_str(),
-                       fname.c_str());
-            return;
-        }
-
-        if(_hash == prefix_hash && idx < num_alloc)
+        auto idx = get_index(fname);
+        if(idx < num_alloc && idx == prefix_idx && m_last_addr && m_weight > 0.0)
         {
             // cudaMalloc
-            if(m_last_addr)
-            {
-                void* ptr                 = (void*) ((char**) (m_last_addr)[0]);
-                get_allocation_map()[ptr] = value;
-            }
-        }
-        else if(_hash == prefix_hash && idx >= num_alloc)
-        {
-            // cudaFree
-        }
-        else
-        {
-            if(settings::verbose() > 1 || settings::debug())
-                printf("[%s]> skipped function '%s with hash %llu'\n",
-                       this_type::get_label().c_str(), fname.c_str(),
-                       (long long unsigned) _hash);
+            void* ptr = (void*) ((char**) (m_last_addr)[0]);
+            record_sample(ptr);
         }
+        else if(idx >= data_size && (settings::verbose() > 1 || settings::debug()))
+            printf("[%s]> unknown function: '%s'\n", this_type::get_label().c_str(),
+                   fname.c_str());
     }
 
     //----------------------------------------------------------------------------------//
@@ -1318,13 +1386,8 @@ public:
 
     void set_prefix(const std::string& _prefix)
     {
-        prefix      = _prefix;
-        prefix_hash = add_hash_id(prefix);
-        for(uintmax_t i = 0; i < get_hash_array().size(); ++i)
-        {
-            if(prefix_hash == get_hash_array()[i])
-                prefix_idx = i;
-        }
+        prefix     = _prefix;
+        prefix_idx = get_index(prefix);
     }
 
     //----------------------------------------------------------------------------------//
@@ -1350,47 +1413,46 @@ public:
     }
 
 private:
-    using alloc_map_t  = std::unordered_map<void*, size_t>;
-    using vaddr_map_t  = std::unordered_map<void**, size_t>;
-    using hash_array_t = std::array<uintmax_t, data_size>;
+    using name_array_t = std::array<std::pair<const char*, size_t>, data_size>;
 
-    static alloc_map_t& get_allocation_map()
+    static const name_array_t& get_function_names()
     {
-        static thread_local alloc_map_t _instance;
-        return _instance;
-    }
-
-    static vaddr_map_t& get_void_address_map()
-    {
-        static thread_local vaddr_map_t _instance;
-        return _instance;
-    }
-
-    static hash_array_t& get_hash_array()
-    {
-        static hash_array_t _instance = []() {
+        static name_array_t _instance = []() {
 #if defined(TIMEMORY_USE_CUDA)
-            hash_array_t _tmp = {
-                { string_hash()("malloc"),
-                  string_hash()("calloc"),
-                  string_hash()("cudaMalloc"),
-                  string_hash()("free"),
-                  string_hash()("cudaFree") }
-            };
+            name_array_t _tmp = { { { "malloc", 6 },
+                                    { "calloc", 6 },
+                                    { "cudaMalloc", 10 },
+                                    { "free", 4 },
+                                    { "cudaFree", 8 } } };
 #else
-            hash_array_t _tmp = { { string_hash()("malloc"), string_hash()("calloc"),
-                                    string_hash()("free") } };
+            name_array_t _tmp = { { { "malloc", 6 }, { "calloc", 6 }, { "free", 4 } } };
 #endif
-
             return _tmp;
         }();
         return _instance;
     }
 
+    // sampled allocations are attributed to the region which is the parent of the
+    // node of this component in the call-graph
+    void record_sample(void* ptr)
+    {
+        uint64_t    _region = 0;
+        std::string _label  = "unknown";
+        if(graph_itr.node && graph_itr.node->parent && graph_itr.node->parent->parent)
+        {
+            _region = graph_itr.node->parent->data.id();
+            _label  = get_hash_identifier(_region);
+        }
+        heap_sampler::record_alloc(ptr, m_weight, _region, _label);
+        value = m_weight;
+        accum += m_weight;
+        m_weight = 0.0;
+    }
+
 private:
-    uintmax_t   prefix_hash = string_hash()("");
-    uintmax_t   prefix_idx  = std::numeric_limits<uintmax_t>::max();
-    std::string prefix      = "";
+    uintmax_t   prefix_idx = std::numeric_limits<uintmax_t>::max();
+    std::string prefix     = "";
+    double      m_weight   = 0.0;
 #if defined(TIMEMORY_USE_CUDA)
     void** m_last_addr = nullptr;
 #endif
@@ -1432,6 +1494,442 @@ malloc_gotcha::configure()
 //
 #endif
 //
+//======================================================================================//
+///
+/// \struct component::lock_gotcha
+/// \brief Lock-contention profiler. The value is the time the thread spent waiting on
+/// contended pthread mutexes and rwlocks within the region. The wait time, hold time
+/// and acquisition count of each lock are reported at finalization, ranked by the
+/// total wait time. The wrappers are provided by lock_gotcha::gotcha_type after
+/// lock_gotcha::configure() is called.
+///
+struct lock_gotcha : base<lock_gotcha, int64_t>
+{
+    static constexpr size_t data_size = 9;
+
+    using ratio_t      = std::nano;
+    using value_type   = int64_t;
+    using this_type    = lock_gotcha;
+    using base_type    = base<this_type, value_type>;
+    using storage_type = typename base_type::storage_type;
+    using lock_kind    = lock_contention::lock_kind;
+    using gotcha_type  = gotcha<data_size, component_tuple<>, this_type>;
+
+    static std::string label() { return "lock_gotcha"; }
+    static std::string description()
+    {
+        return "GOTCHA wrapper for pthread lock functions recording contended wait "
+               "time";
+    }
+    static value_type record()
+    {
+        return lock_contention::thread_state::instance().wait_ns;
+    }
+
+    using base_type::accum;
+    using base_type::is_transient;
+    using base_type::set_started;
+    using base_type::set_stopped;
+    using base_type::value;
+
+    static void configure();
+
+    //----------------------------------------------------------------------------------//
+
+    static void global_finalize(storage_type*)
+    {
+        if(lock_contention::tables::instance().num_locks.load() == 0)
+            return;
+
+        if(settings::file_output() && settings::text_output())
+        {
+            auto _fname = settings::compose_output_filename("lock_contention", ".txt");
+            std::ofstream ofs(_fname.c_str());
+            if(ofs)
+            {
+                if(settings::verbose() >= 0)
+                    printf("[%s]|%i> Outputting '%s'...\n", get_label().c_str(),
+                           dmp::rank(), _fname.c_str());
+                lock_contention::print(ofs);
+            }
+        }
+
+        if(settings::cout_output())
+            lock_contention::print(std::cout);
+    }
+
+    //----------------------------------------------------------------------------------//
+    //  the locks acquired between start() and stop() are attributed to the region
+    //  of this component in the call-graph
+    //
+    void start()
+    {
+        bool     _valid  = (graph_itr.node != nullptr);
+        uint64_t _region = (_valid) ? graph_itr.node->data.id() : 0;
+        lock_contention::push_region(_region, [_valid, _region]() {
+            return (_valid) ? get_hash_identifier(_region) : std::string{ "unknown" };
+        });
+        set_started();
+        value = record();
+    }
+
+    void stop()
+    {
+        lock_contention::pop_region();
+        value = (record() - value);
+        accum += value;
+        set_stopped();
+    }
+
+    //----------------------------------------------------------------------------------//
+
+    double get_display() const { return get(); }
+
+    double get() const
+    {
+        auto val = (is_transient) ? accum : value;
+        return static_cast<double>(val) / ratio_t::den * get_unit();
+    }
+
+#if defined(_UNIX)
+    //----------------------------------------------------------------------------------//
+    //  replacements for the wrapped functions. The indices match configure()
+    //
+    using mutex_func_t  = int (*)(pthread_mutex_t*);
+    using rwlock_func_t = int (*)(pthread_rwlock_t*);
+    using cond_func_t   = int (*)(pthread_cond_t*, pthread_mutex_t*);
+
+    /// the non-blocking probe of the blocking wrappers calls the original try-lock
+    /// function: calling it by name would enter (and be recorded by) its wrapper
+    template <size_t N, typename FuncT>
+    static FuncT get_original(FuncT _func)
+    {
+        auto _orig = gotcha_type::get_original<N, FuncT>();
+        return (_orig) ? _orig : _func;
+    }
+
+    int operator()(gotcha_index<0>, mutex_func_t _func, pthread_mutex_t* _lock)
+    {
+        auto _try = get_original<1>(&pthread_mutex_trylock);
+        return lock_contention::acquire(
+            _lock, lock_kind::mutex, [_try, _lock]() { return (*_try)(_lock); },
+            [_func, _lock]() { return (*_func)(_lock); });
+    }
+
+    int operator()(gotcha_index<1>, mutex_func_t _func, pthread_mutex_t* _lock)
+    {
+        return lock_contention::try_acquire(_lock, lock_kind::mutex,
+                                            [_func, _lock]() { return (*_func)(_lock); });
+    }
+
+    int operator()(gotcha_index<2>, mutex_func_t _func, pthread_mutex_t* _lock)
+    {
+        return lock_contention::release(_lock,
+                                        [_func, _lock]() { return (*_func)(_lock); });
+    }
+
+    int operator()(gotcha_index<3>, rwlock_func_t _func, pthread_rwlock_t* _lock)
+    {
+        auto _try = get_original<4>(&pthread_rwlock_tryrdlock);
+        return lock_contention::acquire(
+            _lock, lock_kind::rwlock_read, [_try, _lock]() { return (*_try)(_lock); },
+            [_func, _lock]() { return (*_func)(_lock); });
+    }
+
+    int operator()(gotcha_index<4>, rwlock_func_t _func, pthread_rwlock_t* _lock)
+    {
+        return lock_contention::try_acquire(_lock, lock_kind::rwlock_read,
+                                            [_func, _lock]() { return (*_func)(_lock); });
+    }
+
+    int operator()(gotcha_index<5>, rwlock_func_t _func, pthread_rwlock_t* _lock)
+    {
+        auto _try = get_original<6>(&pthread_rwlock_trywrlock);
+        return lock_contention::acquire(
+            _lock, lock_kind::rwlock_write, [_try, _lock]() { return (*_try)(_lock); },
+            [_func, _lock]() { return (*_func)(_lock); });
+    }
+
+    int operator()(gotcha_index<6>, rwlock_func_t _func, pthread_rwlock_t* _lock)
+    {
+        return lock_contention::try_acquire(_lock, lock_kind::rwlock_write,
+                                            [_func, _lock]() { return (*_func)(_lock); });
+    }
+
+    int operator()(gotcha_index<7>, rwlock_func_t _func, pthread_rwlock_t* _lock)
+    {
+        return lock_contention::release(_lock,
+                                        [_func, _lock]() { return (*_func)(_lock); });
+    }
+
+    int operator()(gotcha_index<8>, cond_func_t _func, pthread_cond_t* _cond,
+                   pthread_mutex_t* _lock)
+    {
+        return lock_contention::cond_wait(
+            _lock, [_func, _cond, _lock]() { return (*_func)(_cond, _lock); });
+    }
+#endif
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+#if defined(TIMEMORY_USE_GOTCHA) && defined(_UNIX)
+//
+inline void
+lock_gotcha::configure()
+{
+    gotcha_type::get_initializer() = []() {
+        TIMEMORY_C_GOTCHA(gotcha_type, 0, pthread_mutex_lock);
+        TIMEMORY_C_GOTCHA(gotcha_type, 1, pthread_mutex_trylock);
+        TIMEMORY_C_GOTCHA(gotcha_type, 2, pthread_mutex_unlock);
+        TIMEMORY_C_GOTCHA(gotcha_type, 3, pthread_rwlock_rdlock);
+        TIMEMORY_C_GOTCHA(gotcha_type, 4, pthread_rwlock_tryrdlock);
+        TIMEMORY_C_GOTCHA(gotcha_type, 5, pthread_rwlock_wrlock);
+        TIMEMORY_C_GOTCHA(gotcha_type, 6, pthread_rwlock_trywrlock);
+        TIMEMORY_C_GOTCHA(gotcha_type, 7, pthread_rwlock_unlock);
+        TIMEMORY_C_GOTCHA(gotcha_type, 8, pthread_cond_wait);
+    };
+}
+//
+#else
+//
+inline void
+lock_gotcha::configure()
+{}
+//
+#endif
+//
+//======================================================================================//
+///
+/// \struct component::io_gotcha
+/// \brief POSIX I/O tracer. The value is the time the thread spent in the wrapped I/O
+/// functions within the region. The calls, bytes, and latency histograms for each
+/// file and function are reported at finalization, ranked by the time spent in I/O.
+/// The wrappers are provided by io_gotcha::gotcha_type after io_gotcha::configure()
+/// is called. The stdio fread and fwrite functions are only wrapped when requested.
+///
+struct io_gotcha : base<io_gotcha, int64_t>
+{
+    static constexpr size_t data_size = 11;
+
+    using ratio_t      = std::nano;
+    using value_type   = int64_t;
+    using this_type    = io_gotcha;
+    using base_type    = base<this_type, value_type>;
+    using storage_type = typename base_type::storage_type;
+    using gotcha_type  = gotcha<data_size, component_tuple<>, this_type>;
+
+    static std::string label() { return "io_gotcha"; }
+    static std::string description()
+    {
+        return "GOTCHA wrapper for POSIX I/O functions recording bytes and latencies "
+               "per file";
+    }
+    static value_type record() { return io_trace::thread_state::instance().time_ns; }
+
+    using base_type::accum;
+    using base_type::is_transient;
+    using base_type::set_started;
+    using base_type::set_stopped;
+    using base_type::value;
+
+    static void configure(bool _stdio = false);
+
+    //----------------------------------------------------------------------------------//
+
+    static void global_finalize(storage_type*)
+    {
+        if(io_trace::tables::instance().num_sites.load() == 0)
+            return;
+
+        if(settings::file_output() && settings::text_output())
+        {
+            auto _fname = settings::compose_output_filename("io_trace", ".txt");
+            std::ofstream ofs(_fname.c_str());
+            if(ofs)
+            {
+                if(settings::verbose() >= 0)
+                    printf("[%s]|%i> Outputting '%s'...\n", get_label().c_str(),
+                           dmp::rank(), _fname.c_str());
+                io_trace::print(ofs);
+            }
+        }
+
+        if(settings::cout_output())
+            io_trace::print(std::cout);
+    }
+
+    //----------------------------------------------------------------------------------//
+    //  the I/O between start() and stop() is attributed to the region of this
+    //  component in the call-graph
+    //
+    void start()
+    {
+        bool     _valid  = (graph_itr.node != nullptr);
+        uint64_t _region = (_valid) ? graph_itr.node->data.id() : 0;
+        io_trace::push_region(_region, [_valid, _region]() {
+            return (_valid) ? get_hash_identifier(_region) : std::string{ "unknown" };
+        });
+        set_started();
+        value = record();
+    }
+
+    void stop()
+    {
+        io_trace::pop_region();
+        value = (record() - value);
+        accum += value;
+        set_stopped();
+    }
+
+    //----------------------------------------------------------------------------------//
+
+    double get_display() const { return get(); }
+
+    double get() const
+    {
+        auto val = (is_transient) ? accum : value;
+        return static_cast<double>(val) / ratio_t::den * get_unit();
+    }
+
+#if defined(_UNIX)
+    //----------------------------------------------------------------------------------//
+    //  replacements for the wrapped functions. The indices match configure()
+    //
+    using open_func_t   = int (*)(const char*, int, mode_t);
+    using fd_func_t     = int (*)(int);
+    using read_func_t   = ssize_t (*)(int, void*, size_t);
+    using write_func_t  = ssize_t (*)(int, const void*, size_t);
+    using pread_func_t  = ssize_t (*)(int, void*, size_t, off_t);
+    using pwrite_func_t = ssize_t (*)(int, const void*, size_t, off_t);
+    using iov_func_t    = ssize_t (*)(int, const struct iovec*, int);
+    using fread_func_t  = size_t (*)(void*, size_t, size_t, FILE*);
+    using fwrite_func_t = size_t (*)(const void*, size_t, size_t, FILE*);
+
+    static int64_t get_bytes(ssize_t _ret) { return static_cast<int64_t>(_ret); }
+    static int64_t get_status(int _ret) { return (_ret < 0) ? -1 : 0; }
+
+    int operator()(gotcha_index<0>, open_func_t _func, const char* _path, int _flags,
+                   mode_t _mode)
+    {
+        return io_trace::open_file(
+            _path, [=]() { return (*_func)(_path, _flags, _mode); });
+    }
+
+    int operator()(gotcha_index<1>, fd_func_t _func, int _fd)
+    {
+        return io_trace::close_file(_fd, [=]() { return (*_func)(_fd); });
+    }
+
+    ssize_t operator()(gotcha_index<2>, read_func_t _func, int _fd, void* _buf,
+                       size_t _n)
+    {
+        return io_trace::invoke(
+            _fd, io_trace::read_op, [=]() { return (*_func)(_fd, _buf, _n); },
+            &get_bytes);
+    }
+
+    ssize_t operator()(gotcha_index<3>, write_func_t _func, int _fd, const void* _buf,
+                       size_t _n)
+    {
+        return io_trace::invoke(
+            _fd, io_trace::write_op, [=]() { return (*_func)(_fd, _buf, _n); },
+            &get_bytes);
+    }
+
+    ssize_t operator()(gotcha_index<4>, pread_func_t _func, int _fd, void* _buf,
+                       size_t _n, off_t _off)
+    {
+        return io_trace::invoke(
+            _fd, io_trace::pread_op, [=]() { return (*_func)(_fd, _buf, _n, _off); },
+            &get_bytes);
+    }
+
+    ssize_t operator()(gotcha_index<5>, pwrite_func_t _func, int _fd, const void* _buf,
+                       size_t _n, off_t _off)
+    {
+        return io_trace::invoke(
+            _fd, io_trace::pwrite_op, [=]() { return (*_func)(_fd, _buf, _n, _off); },
+            &get_bytes);
+    }
+
+    ssize_t operator()(gotcha_index<6>, iov_func_t _func, int _fd,
+                       const struct iovec* _iov, int _n)
+    {
+        return io_trace::invoke(
+            _fd, io_trace::readv_op, [=]() { return (*_func)(_fd, _iov, _n); },
+            &get_bytes);
+    }
+
+    ssize_t operator()(gotcha_index<7>, iov_func_t _func, int _fd,
+                       const struct iovec* _iov, int _n)
+    {
+        return io_trace::invoke(
+            _fd, io_trace::writev_op, [=]() { return (*_func)(_fd, _iov, _n); },
+            &get_bytes);
+    }
+
+    int operator()(gotcha_index<8>, fd_func_t _func, int _fd)
+    {
+        return io_trace::invoke(
+            _fd, io_trace::fsync_op, [=]() { return (*_func)(_fd); }, &get_status);
+    }
+
+    size_t operator()(gotcha_index<9>, fread_func_t _func, void* _ptr, size_t _size,
+                      size_t _n, FILE* _stream)
+    {
+        return io_trace::invoke(
+            (_stream) ? fileno(_stream) : -1, io_trace::fread_op,
+            [=]() { return (*_func)(_ptr, _size, _n, _stream); },
+            [_size](size_t _ret) { return static_cast<int64_t>(_ret * _size); });
+    }
+
+    size_t operator()(gotcha_index<10>, fwrite_func_t _func, const void* _ptr,
+                      size_t _size, size_t _n, FILE* _stream)
+    {
+        return io_trace::invoke(
+            (_stream) ? fileno(_stream) : -1, io_trace::fwrite_op,
+            [=]() { return (*_func)(_ptr, _size, _n, _stream); },
+            [_size](size_t _ret) { return static_cast<int64_t>(_ret * _size); });
+    }
+#endif
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+#if defined(TIMEMORY_USE_GOTCHA) && defined(_UNIX)
+//
+inline void
+io_gotcha::configure(bool _stdio)
+{
+    gotcha_type::get_initializer() = [_stdio]() {
+        // open is variadic so the signature is specified explicitly, the mode is
+        // only read by the original function when a file is created
+        gotcha_type::configure<0, int, const char*, int, mode_t>("open");
+        TIMEMORY_C_GOTCHA(gotcha_type, 1, close);
+        TIMEMORY_C_GOTCHA(gotcha_type, 2, read);
+        TIMEMORY_C_GOTCHA(gotcha_type, 3, write);
+        TIMEMORY_C_GOTCHA(gotcha_type, 4, pread);
+        TIMEMORY_C_GOTCHA(gotcha_type, 5, pwrite);
+        TIMEMORY_C_GOTCHA(gotcha_type, 6, readv);
+        TIMEMORY_C_GOTCHA(gotcha_type, 7, writev);
+        TIMEMORY_C_GOTCHA(gotcha_type, 8, fsync);
+        if(_stdio)
+        {
+            TIMEMORY_C_GOTCHA(gotcha_type, 9, fread);
+            TIMEMORY_C_GOTCHA(gotcha_type, 10, fwrite);
+        }
+    };
+}
+//
+#else
+//
+inline void
+io_gotcha::configure(bool)
+{}
+//
+#endif
+//
 }  // namespace component
 }  // namespace tim
 //
@@ -64,6 +64,8 @@ namespace component
 {
 //
 TIMEMORY_EXTERN_TEMPLATE(struct base<malloc_gotcha, double>)
+TIMEMORY_EXTERN_TEMPLATE(struct base<lock_gotcha, int64_t>)
+TIMEMORY_EXTERN_TEMPLATE(struct base<io_gotcha, int64_t>)
 //
 }  // namespace component
 }  // namespace tim
@@ -71,10 +73,14 @@ TIMEMORY_EXTERN_TEMPLATE(struct base<malloc_gotcha, double>)
 //======================================================================================//
 //
 TIMEMORY_EXTERN_OPERATIONS(component::malloc_gotcha, true)
+TIMEMORY_EXTERN_OPERATIONS(component::lock_gotcha, true)
+TIMEMORY_EXTERN_OPERATIONS(component::io_gotcha, true)
 //
 //======================================================================================//
 //
 TIMEMORY_EXTERN_STORAGE(component::malloc_gotcha, malloc_gotcha)
+TIMEMORY_EXTERN_STORAGE(component::lock_gotcha, lock_gotcha)
+TIMEMORY_EXTERN_STORAGE(component::io_gotcha, io_gotcha)
 //
 //======================================================================================//
 
@@ -0,0 +1,426 @@
+//  MIT License
+//
+//  Copyright (c) 2020, The Regents of the University of California,
+//  through Lawrence Berkeley National Laboratory (subject to receipt of any
+//  required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+
+/**
+ * \file timemory/components/gotcha/heap_sampler.hpp
+ * \brief Sampled heap profiler used by malloc_gotcha. Allocations are sampled at
+ * geometrically distributed byte intervals (mean == TIMEMORY_HEAP_SAMPLE_RATE) and
+ * only the sampled allocations capture a call-stack and are recorded in a lock-free
+ * table of live pointers. Each sample carries a weight which is the unbiased estimate
+ * of the number of bytes it represents.
+ */
+
+#pragma once
+
+#include "timemory/components/gotcha/trace_tables.hpp"
+#include "timemory/hash/declaration.hpp"
+#include "timemory/settings/declaration.hpp"
+#include "timemory/units.hpp"
+#include "timemory/utility/utility.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace tim
+{
+namespace component
+{
+namespace heap_sampler
+{
+//
+//--------------------------------------------------------------------------------------//
+//
+static constexpr size_t max_frames    = 8;
+static constexpr size_t skip_frames   = 3;
+static constexpr size_t max_probe     = 32;
+static constexpr size_t live_capacity = (1 << 16);
+static constexpr size_t site_capacity = (1 << 12);
+
+using frames_t = std::array<void*, max_frames>;
+//
+//--------------------------------------------------------------------------------------//
+/// per-thread geometric-interval byte sampler. The number of bytes until the next
+/// sample is drawn from an exponential distribution so every byte allocated has the
+/// same probability of being sampled, independent of the allocation size
+///
+struct sampler
+{
+    static sampler& instance()
+    {
+        static thread_local sampler _instance{};
+        return _instance;
+    }
+
+    static uint64_t period() { return settings::heap_sample_rate(); }
+
+    /// the estimated number of bytes represented by a sampled allocation
+    static double weight(size_t nbytes)
+    {
+        auto _period = period();
+        if(_period == 0 || nbytes == 0)
+            return static_cast<double>(nbytes);
+        auto _prob = 1.0 - std::exp(-static_cast<double>(nbytes) / _period);
+        return static_cast<double>(nbytes) / _prob;
+    }
+
+    /// returns the weight of the allocation if it was sampled, zero otherwise
+    double operator()(size_t nbytes)
+    {
+        if(nbytes < m_bytes_left)
+        {
+            m_bytes_left -= nbytes;
+            return 0.0;
+        }
+        m_bytes_left = next_interval();
+        return weight(nbytes);
+    }
+
+private:
+    uint64_t next_random()
+    {
+        // xorshift64*
+        m_state ^= m_state >> 12;
+        m_state ^= m_state << 25;
+        m_state ^= m_state >> 27;
+        return m_state * 2685821657736338717ULL;
+    }
+
+    uint64_t next_interval()
+    {
+        auto _period = period();
+        if(_period == 0)
+            return 0;
+        // uniform in (0, 1]
+        double _u = ((next_random() >> 11) + 1) * (1.0 / 9007199254740992.0);
+        return static_cast<uint64_t>(-std::log(_u) * _period) + 1;
+    }
+
+    uint64_t m_state =
+        std::hash<std::thread::id>{}(std::this_thread::get_id()) ^
+        static_cast<uint64_t>(
+            std::chrono::steady_clock::now().time_since_epoch().count()) ^
+        0x9e3779b97f4a7c15ULL;
+    uint64_t m_bytes_left = next_interval();
+};
+//
+//--------------------------------------------------------------------------------------//
+/// an allocation call-site within a region. The entries are never removed so the
+/// index of a site is stable for the lifetime of the process
+///
+struct site_entry
+{
+    std::atomic<uint64_t> key{ 0 };
+    std::atomic<uint64_t> total_bytes{ 0 };
+    std::atomic<uint64_t> total_count{ 0 };
+    std::atomic<int64_t>  live_bytes{ 0 };
+    std::atomic<int64_t>  live_count{ 0 };
+    std::atomic<bool>     ready{ false };
+    uint64_t              region = 0;
+    size_t                depth  = 0;
+    frames_t              frames = {};
+};
+//
+/// a sampled allocation which has not been freed. A key of zero is an empty slot.
+/// The probe length is the number of slots, starting at this (home) slot, which hold
+/// the pointers hashed to this slot, i.e. the bound of the lookup in record_free
+///
+struct live_entry
+{
+    std::atomic<uintptr_t> key{ 0 };
+    std::atomic<uint32_t>  probe{ 0 };
+    uint64_t               bytes = 0;
+    uint32_t               site  = 0;
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+struct tables
+{
+    static tables& instance()
+    {
+        static tables* _instance = new tables{};
+        return *_instance;
+    }
+
+    std::array<site_entry, site_capacity> sites{};
+    std::array<live_entry, live_capacity> live{};
+    std::atomic<int64_t>                  num_live{ 0 };
+    std::atomic<uint64_t>                 num_samples{ 0 };
+    std::atomic<uint64_t>                 num_dropped{ 0 };
+
+    // only modified when a new site is created
+    trace_tables::label_map region_labels{};
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+using trace_tables::mix;
+//
+//--------------------------------------------------------------------------------------//
+/// find or create the entry for the call-stack and region. Returns site_capacity
+/// if the table is full
+///
+inline uint32_t
+get_site(const frames_t& _frames, size_t _depth, uint64_t _region,
+         const std::string& _region_label)
+{
+    auto&    _tables = tables::instance();
+    uint64_t _key    = mix(_region + 1);
+    for(size_t i = 0; i < _depth; ++i)
+        _key = mix(_key ^ reinterpret_cast<uintptr_t>(_frames[i]));
+    _key = (_key == 0) ? 1 : _key;
+
+    auto* _entry = trace_tables::probe_insert<max_probe>(
+        _tables.sites, _key, [&](site_entry& _new) {
+            _new.region = _region;
+            _new.depth  = _depth;
+            _new.frames = _frames;
+            _tables.region_labels.emplace(_region, _region_label);
+        });
+    return (_entry) ? static_cast<uint32_t>(_entry - _tables.sites.data())
+                    : static_cast<uint32_t>(site_capacity);
+}
+//
+//--------------------------------------------------------------------------------------//
+/// record a sampled allocation. The call-stack is only captured here, i.e. for the
+/// sampled allocations
+///
+inline void
+record_alloc(void* _ptr, double _weight, uint64_t _region,
+             const std::string& _region_label)
+{
+    if(!_ptr)
+        return;
+
+    auto& _tables = tables::instance();
+    _tables.num_samples.fetch_add(1, std::memory_order_relaxed);
+
+    static thread_local std::array<void*, max_frames + skip_frames> _buffer{};
+    frames_t                                                       _frames{};
+    size_t                                                         _depth = 0;
+#if defined(_UNIX)
+    auto _n = backtrace(_buffer.data(), static_cast<int>(_buffer.size()));
+    for(int i = skip_frames; i < _n && _depth < max_frames; ++i)
+        _frames[_depth++] = _buffer[i];
+#endif
+
+    auto _site = get_site(_frames, _depth, _region, _region_label);
+    if(_site >= site_capacity)
+    {
+        _tables.num_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    auto  _bytes = static_cast<uint64_t>(_weight + 0.5);
+    auto& _entry = _tables.sites[_site];
+    _entry.total_bytes.fetch_add(_bytes, std::memory_order_relaxed);
+    _entry.total_count.fetch_add(1, std::memory_order_relaxed);
+
+    auto  _key  = reinterpret_cast<uintptr_t>(_ptr);
+    auto  _beg  = mix(_key);
+    auto& _home = _tables.live[_beg & (live_capacity - 1)];
+    for(size_t i = 0; i < max_probe; ++i)
+    {
+        auto&     _slot = _tables.live[(_beg + i) & (live_capacity - 1)];
+        uintptr_t _cur  = _slot.key.load(std::memory_order_relaxed);
+        if(_cur != 0)
+            continue;
+        // the probe length only grows and is extended before the pointer is stored
+        // so the lookup of the pointer (after it is returned) always reaches it
+        auto _len = _home.probe.load(std::memory_order_relaxed);
+        auto _req = static_cast<uint32_t>(i + 1);
+        while(_len < _req &&
+              !_home.probe.compare_exchange_weak(_len, _req, std::memory_order_relaxed))
+            continue;
+        if(_slot.key.compare_exchange_strong(_cur, _key, std::memory_order_acq_rel))
+        {
+            // the pointer cannot be freed before it is returned to the caller so
+            // the remaining fields are not read before they are written
+            _slot.bytes = _bytes;
+            _slot.site  = _site;
+            _entry.live_bytes.fetch_add(static_cast<int64_t>(_bytes),
+                                        std::memory_order_relaxed);
+            _entry.live_count.fetch_add(1, std::memory_order_relaxed);
+            _tables.num_live.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+    _tables.num_dropped.fetch_add(1, std::memory_order_relaxed);
+}
+//
+//--------------------------------------------------------------------------------------//
+/// remove the pointer from the live table. Returns the weight of the allocation if
+/// it was sampled and zero otherwise. The lookup is bounded by the probe length of the
+/// home slot, so the erased slots are emptied and an unsampled free only visits the
+/// few slots ever used by the samples hashed to the same slot
+///
+inline double
+record_free(void* _ptr)
+{
+    auto& _tables = tables::instance();
+    if(!_ptr || _tables.num_live.load(std::memory_order_relaxed) == 0)
+        return 0.0;
+
+    auto _key = reinterpret_cast<uintptr_t>(_ptr);
+    auto _beg = mix(_key);
+    auto _len = _tables.live[_beg & (live_capacity - 1)].probe.load(
+        std::memory_order_relaxed);
+    for(size_t i = 0; i < _len; ++i)
+    {
+        auto& _slot = _tables.live[(_beg + i) & (live_capacity - 1)];
+        if(_slot.key.load(std::memory_order_acquire) != _key)
+            continue;
+
+        auto  _bytes = static_cast<int64_t>(_slot.bytes);
+        auto& _entry = _tables.sites[_slot.site];
+        _entry.live_bytes.fetch_sub(_bytes, std::memory_order_relaxed);
+        _entry.live_count.fetch_sub(1, std::memory_order_relaxed);
+        _tables.num_live.fetch_sub(1, std::memory_order_relaxed);
+        // the lookup does not stop at an empty slot so emptying the slot cannot hide
+        // a pointer which a concurrent record_alloc placed further along the sequence
+        _slot.key.store(0, std::memory_order_release);
+        return static_cast<double>(_bytes);
+    }
+    return 0.0;
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+inline std::string
+get_site_label(const site_entry& _entry)
+{
+    if(_entry.depth == 0)
+        return "unknown";
+    std::stringstream ss;
+#if defined(_UNIX)
+    char** _syms = backtrace_symbols(_entry.frames.data(), _entry.depth);
+    for(size_t i = 0; i < _entry.depth; ++i)
+    {
+        std::string _sym = (_syms) ? _syms[i] : "";
+        auto        _beg = _sym.find('(');
+        auto        _end = _sym.find('+', _beg);
+        if(_beg != std::string::npos && _end != std::string::npos && _end > _beg + 1)
+            _sym = demangle(_sym.substr(_beg + 1, _end - _beg - 1));
+        if(i > 0)
+            ss << " <- ";
+        ss << _sym;
+    }
+    if(_syms)
+        free(_syms);
+#else
+    ss << _entry.frames.front();
+#endif
+    return ss.str();
+}
+//
+//--------------------------------------------------------------------------------------//
+/// print the live-heap and total allocated bytes by region and by call-site. The
+/// symbols of the call-sites are only resolved here
+///
+inline void
+print(std::ostream& os)
+{
+    auto& _tables = tables::instance();
+
+    struct summary
+    {
+        uint64_t total_bytes = 0;
+        uint64_t total_count = 0;
+        int64_t  live_bytes  = 0;
+        int64_t  live_count  = 0;
+    };
+
+    using site_label_t = std::pair<std::string, std::string>;
+
+    std::map<std::string, summary>                _regions{};
+    std::vector<std::pair<summary, site_label_t>> _sites{};
+    auto                                          _labels = _tables.region_labels.get();
+
+    for(const auto& itr : _tables.sites)
+    {
+        if(!itr.ready.load(std::memory_order_acquire))
+            continue;
+        summary _s{ itr.total_bytes.load(), itr.total_count.load(), itr.live_bytes.load(),
+                    itr.live_count.load() };
+        auto&   _region = _labels[itr.region];
+        auto&   _r      = _regions[_region];
+        _r.total_bytes += _s.total_bytes;
+        _r.total_count += _s.total_count;
+        _r.live_bytes += _s.live_bytes;
+        _r.live_count += _s.live_count;
+        _sites.emplace_back(_s, std::make_pair(_region, get_site_label(itr)));
+    }
+
+    std::sort(_sites.begin(), _sites.end(), [](const auto& lhs, const auto& rhs) {
+        return (lhs.first.live_bytes == rhs.first.live_bytes)
+                   ? (lhs.first.total_bytes > rhs.first.total_bytes)
+                   : (lhs.first.live_bytes > rhs.first.live_bytes);
+    });
+
+    auto _mb = [](double _val) { return _val / units::megabyte; };
+
+    os << "[malloc_gotcha]> sampled heap profile :: sample rate = "
+       << sampler::period() << " bytes, samples = " << _tables.num_samples.load()
+       << ", dropped = " << _tables.num_dropped.load() << "\n\n";
+
+    os << std::setw(14) << "TOTAL [MB]" << std::setw(14) << "LIVE [MB]" << std::setw(10)
+       << "SAMPLES" << std::setw(10) << "LIVE" << "  REGION\n";
+    for(const auto& itr : _regions)
+    {
+        os << std::fixed << std::setprecision(3) << std::setw(14)
+           << _mb(itr.second.total_bytes) << std::setw(14) << _mb(itr.second.live_bytes)
+           << std::setw(10) << itr.second.total_count << std::setw(10)
+           << itr.second.live_count << "  " << itr.first << "\n";
+    }
+
+    os << "\n"
+       << std::setw(14) << "TOTAL [MB]" << std::setw(14) << "LIVE [MB]" << std::setw(10)
+       << "SAMPLES" << std::setw(10) << "LIVE"
+       << "  REGION :: CALL-SITE\n";
+    for(const auto& itr : _sites)
+    {
+        os << std::fixed << std::setprecision(3) << std::setw(14)
+           << _mb(itr.first.total_bytes) << std::setw(14) << _mb(itr.first.live_bytes)
+           << std::setw(10) << itr.first.total_count << std::setw(10)
+           << itr.first.live_count << "  " << itr.second.first
+           << " :: " << itr.second.second << "\n";
+    }
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+}  // namespace heap_sampler
+}  // namespace component
+}  // namespace tim
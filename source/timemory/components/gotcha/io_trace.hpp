@@ -0,0 +1,526 @@
+//  MIT License
+//
+//  Copyright (c) 2020, The Regents of the University of California,
+//  through Lawrence Berkeley National Laboratory (subject to receipt of any
+//  required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+
+/**
+ * \file timemory/components/gotcha/io_trace.hpp
+ * \brief POSIX I/O tables used by io_gotcha. Each call is timed and added to the
+ * entry for the file, the region of the calling thread and the function, along with
+ * the bytes transferred and a log2 histogram of the latencies. File descriptors are
+ * resolved to paths when they are opened (or on first use if they were opened
+ * before the wrappers were installed) so the hot path never touches a string.
+ */
+
+#pragma once
+
+#include "timemory/components/gotcha/trace_tables.hpp"
+#include "timemory/units.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <iomanip>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(_UNIX)
+#    include <unistd.h>
+#endif
+
+namespace tim
+{
+namespace component
+{
+namespace io_trace
+{
+//
+//--------------------------------------------------------------------------------------//
+//
+static constexpr size_t max_probe     = 32;
+static constexpr size_t max_fds       = (1 << 12);
+static constexpr size_t num_buckets   = 32;
+static constexpr size_t site_capacity = (1 << 11);
+
+enum io_op : uint8_t
+{
+    open_op = 0,
+    close_op,
+    read_op,
+    write_op,
+    pread_op,
+    pwrite_op,
+    readv_op,
+    writev_op,
+    fsync_op,
+    fread_op,
+    fwrite_op,
+    num_ops
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+inline const char*
+get_op_label(uint8_t _op)
+{
+    static const char* _labels[num_ops] = { "open",  "close",  "read",  "write",
+                                            "pread", "pwrite", "readv", "writev",
+                                            "fsync", "fread",  "fwrite" };
+    return (_op < num_ops) ? _labels[_op] : "unknown";
+}
+//
+//--------------------------------------------------------------------------------------//
+/// the statistics of a function on a file within a region. Bucket i of the
+/// histogram counts the calls with a latency in [2^(i-1), 2^i) nanoseconds and the
+/// last bucket includes every longer call. The number of calls is the sum of the
+/// histogram so a call is three relaxed atomic increments. The entries are never
+/// removed
+///
+struct site_entry
+{
+    std::atomic<uint64_t>                          key{ 0 };
+    std::atomic<uint64_t>                          errors{ 0 };
+    std::atomic<uint64_t>                          bytes{ 0 };
+    std::atomic<uint64_t>                          time_ns{ 0 };
+    std::array<std::atomic<uint64_t>, num_buckets> histogram{};
+    std::atomic<bool>                              ready{ false };
+    uint64_t                                       file   = 0;
+    uint64_t                                       region = 0;
+    uint8_t                                        op     = num_ops;
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+struct tables
+{
+    static tables& instance()
+    {
+        static tables* _instance = new tables{};
+        return *_instance;
+    }
+
+    std::array<site_entry, site_capacity>      sites{};
+    std::array<std::atomic<uint64_t>, max_fds> fds{};
+    std::atomic<uint64_t>                      num_sites{ 0 };
+    std::atomic<uint64_t>                      num_dropped{ 0 };
+
+    // only modified when a file is opened or a region is entered
+    trace_tables::label_map file_labels{};
+    trace_tables::label_map region_labels{};
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+struct thread_state : trace_tables::thread_state_base
+{
+    static thread_state& instance()
+    {
+        static thread_local thread_state _instance{};
+        return _instance;
+    }
+
+    int64_t time_ns = 0;
+};
+//
+/// prevents the I/O performed by the profiler itself from being recorded
+using scoped_suppress = trace_tables::scoped_suppress<thread_state>;
+using trace_tables::mix;
+using trace_tables::now;
+//
+//--------------------------------------------------------------------------------------//
+//
+inline size_t
+get_bucket(int64_t _ns)
+{
+    size_t _idx = 0;
+    for(auto _val = static_cast<uint64_t>(std::max<int64_t>(_ns, 0)); _val > 0;
+        _val >>= 1)
+        ++_idx;
+    return std::min<size_t>(_idx, num_buckets - 1);
+}
+//
+//--------------------------------------------------------------------------------------//
+/// enter a region. The label is generated the first time the thread enters the region
+///
+template <typename LabelFuncT>
+inline void
+push_region(uint64_t _region, LabelFuncT&& _label)
+{
+    trace_tables::push_region<thread_state>(tables::instance().region_labels, _region,
+                                            std::forward<LabelFuncT>(_label));
+}
+//
+inline void
+pop_region()
+{
+    trace_tables::pop_region<thread_state>();
+}
+//
+//--------------------------------------------------------------------------------------//
+/// the id of a file is the hash of the path. A file id of zero is unassigned
+///
+inline uint64_t
+get_file_id(const std::string& _path)
+{
+    return std::max<uint64_t>(mix(std::hash<std::string>{}(_path)), 1);
+}
+//
+//--------------------------------------------------------------------------------------//
+/// associate the file descriptor with a path
+///
+inline uint64_t
+set_file(int _fd, const std::string& _path)
+{
+    scoped_suppress _suppress{};
+    auto&           _tables = tables::instance();
+    auto            _file   = get_file_id(_path);
+    _tables.file_labels.emplace(_file, _path);
+    if(_fd >= 0 && static_cast<size_t>(_fd) < max_fds)
+        _tables.fds[_fd].store(_file, std::memory_order_release);
+    return _file;
+}
+//
+inline void
+reset_file(int _fd)
+{
+    if(_fd >= 0 && static_cast<size_t>(_fd) < max_fds)
+        tables::instance().fds[_fd].store(0, std::memory_order_release);
+}
+//
+//--------------------------------------------------------------------------------------//
+/// the file of the calls on an invalid descriptor and of the failed opens
+///
+inline uint64_t
+get_invalid_file()
+{
+    static auto _file = set_file(-1, "invalid fd");
+    return _file;
+}
+//
+inline uint64_t
+get_failed_open_file()
+{
+    static auto _file = set_file(-1, "open failed");
+    return _file;
+}
+//
+/// the descriptors beyond the table are aggregated into a single file
+///
+inline uint64_t
+get_overflow_file()
+{
+    static auto _file = set_file(-1, "fd >= " + std::to_string(max_fds));
+    return _file;
+}
+//
+//--------------------------------------------------------------------------------------//
+/// the descriptors which were opened before the wrappers were installed (including
+/// stdin, stdout, and stderr) are resolved via /proc the first time they are used
+///
+inline uint64_t
+get_file(int _fd)
+{
+    if(_fd < 0)
+        return get_invalid_file();
+    if(static_cast<size_t>(_fd) >= max_fds)
+        return get_overflow_file();
+
+    auto _file = tables::instance().fds[_fd].load(std::memory_order_acquire);
+    if(_file != 0)
+        return _file;
+
+    std::string _path = "fd " + std::to_string(_fd);
+#if defined(_LINUX)
+    char _buff[4096];
+    auto _link = "/proc/self/fd/" + std::to_string(_fd);
+    auto _n    = readlink(_link.c_str(), _buff, sizeof(_buff) - 1);
+    if(_n > 0)
+        _path = std::string(_buff, _n);
+#endif
+    return set_file(_fd, _path);
+}
+//
+//--------------------------------------------------------------------------------------//
+/// find or create the entry for the file, region, and function. Returns nullptr if
+/// the table is full
+///
+inline site_entry*
+get_site(uint64_t _file, uint64_t _region, uint8_t _op)
+{
+    auto&    _tables = tables::instance();
+    uint64_t _key    = mix(mix(_file ^ (_region + 1)) + _op);
+    _key             = (_key == 0) ? 1 : _key;
+
+    auto* _entry = trace_tables::probe_insert<max_probe>(
+        _tables.sites, _key, [&](site_entry& _new) {
+            _new.file   = _file;
+            _new.region = _region;
+            _new.op     = _op;
+            _tables.num_sites.fetch_add(1, std::memory_order_relaxed);
+        });
+    if(!_entry)
+        _tables.num_dropped.fetch_add(1, std::memory_order_relaxed);
+    return _entry;
+}
+//
+//--------------------------------------------------------------------------------------//
+/// record a call on a file. A negative number of bytes is a failed call and the
+/// number of bytes of the functions which do not transfer data is zero
+///
+inline void
+record_file(uint64_t _file, uint8_t _op, int64_t _bytes, int64_t _ns)
+{
+    auto& _state = thread_state::instance();
+    if(_state.suppress)
+        return;
+
+    _state.time_ns += _ns;
+    auto* _entry = get_site(_file, _state.region(), _op);
+    if(!_entry)
+        return;
+
+    _entry->time_ns.fetch_add(static_cast<uint64_t>(_ns), std::memory_order_relaxed);
+    _entry->histogram[get_bucket(_ns)].fetch_add(1, std::memory_order_relaxed);
+    if(_bytes < 0)
+        _entry->errors.fetch_add(1, std::memory_order_relaxed);
+    else if(_bytes > 0)
+        _entry->bytes.fetch_add(static_cast<uint64_t>(_bytes), std::memory_order_relaxed);
+}
+//
+inline void
+record(int _fd, uint8_t _op, int64_t _bytes, int64_t _ns)
+{
+    if(!thread_state::instance().suppress)
+        record_file(get_file(_fd), _op, _bytes, _ns);
+}
+//
+//--------------------------------------------------------------------------------------//
+/// time the call and record it. BytesT converts the return value into the number of
+/// bytes transferred
+///
+template <typename FuncT, typename BytesT>
+auto
+invoke(int _fd, uint8_t _op, FuncT&& _func, BytesT&& _get_bytes) -> decltype(_func())
+{
+    if(thread_state::instance().suppress)
+        return _func();
+
+    auto _beg = now();
+    auto _ret = _func();
+    auto _end = now();
+    record(_fd, _op, _get_bytes(_ret), _end - _beg);
+    return _ret;
+}
+//
+//--------------------------------------------------------------------------------------//
+/// the path is associated with the descriptor before the call is recorded. The failed
+/// opens are not associated with the path since no descriptor refers to it
+///
+template <typename FuncT>
+int
+open_file(const char* _path, FuncT&& _func)
+{
+    if(thread_state::instance().suppress)
+        return _func();
+
+    auto _beg = now();
+    int  _fd  = _func();
+    auto _end = now();
+    if(_fd >= 0)
+        record_file(set_file(_fd, (_path) ? _path : ""), open_op, 0, _end - _beg);
+    else
+        record_file(get_failed_open_file(), open_op, -1, _end - _beg);
+    return _fd;
+}
+//
+//--------------------------------------------------------------------------------------//
+/// the descriptor is unassigned after the call is recorded since it may be reused
+///
+template <typename FuncT>
+int
+close_file(int _fd, FuncT&& _func)
+{
+    if(thread_state::instance().suppress)
+        return _func();
+
+    auto _beg = now();
+    int  _ret = _func();
+    auto _end = now();
+    record(_fd, close_op, (_ret < 0) ? -1 : 0, _end - _beg);
+    reset_file(_fd);
+    return _ret;
+}
+//
+//--------------------------------------------------------------------------------------//
+/// print the files ranked by the time spent in I/O followed by the breakdown of
+/// each file by region and function with the latency histograms. Bucket labels are
+/// the upper bound of the latencies
+///
+inline void
+print(std::ostream& os)
+{
+    auto&           _tables = tables::instance();
+    scoped_suppress _suppress{};
+
+    using histogram_t = std::array<uint64_t, num_buckets>;
+
+    struct summary
+    {
+        uint64_t    calls   = 0;
+        uint64_t    errors  = 0;
+        uint64_t    read    = 0;
+        uint64_t    written = 0;
+        uint64_t    time_ns = 0;
+        histogram_t hist    = {};
+    };
+
+    struct site_summary
+    {
+        summary     data   = {};
+        std::string file   = {};
+        std::string region = {};
+        uint8_t     op     = num_ops;
+    };
+
+    auto _files   = _tables.file_labels.get();
+    auto _regions = _tables.region_labels.get();
+    _regions.emplace(0, "unknown");
+
+    std::map<std::string, summary> _by_file{};
+    std::vector<site_summary>      _sites{};
+    for(const auto& itr : _tables.sites)
+    {
+        if(!itr.ready.load(std::memory_order_acquire))
+            continue;
+        summary _s{};
+        _s.errors  = itr.errors.load();
+        _s.time_ns = itr.time_ns.load();
+        switch(itr.op)
+        {
+            case read_op:
+            case pread_op:
+            case readv_op:
+            case fread_op: _s.read = itr.bytes.load(); break;
+            case write_op:
+            case pwrite_op:
+            case writev_op:
+            case fwrite_op: _s.written = itr.bytes.load(); break;
+            default: break;
+        }
+        for(size_t i = 0; i < num_buckets; ++i)
+        {
+            _s.hist[i] = itr.histogram[i].load();
+            _s.calls += _s.hist[i];
+        }
+
+        auto& _file = _files[itr.file];
+        auto& _f    = _by_file[_file];
+        _f.calls += _s.calls;
+        _f.errors += _s.errors;
+        _f.read += _s.read;
+        _f.written += _s.written;
+        _f.time_ns += _s.time_ns;
+        _sites.emplace_back(site_summary{ _s, _file, _regions[itr.region], itr.op });
+    }
+
+    std::vector<std::pair<std::string, summary>> _ranked(_by_file.begin(),
+                                                         _by_file.end());
+    std::sort(_ranked.begin(), _ranked.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.second.time_ns > rhs.second.time_ns;
+    });
+    std::sort(_sites.begin(), _sites.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.data.time_ns > rhs.data.time_ns;
+    });
+
+    auto _sec = [](uint64_t _val) { return static_cast<double>(_val) / units::nsec; };
+    auto _mb  = [](uint64_t _val) { return static_cast<double>(_val) / units::megabyte; };
+
+    // the upper bound of the bucket, the last bucket has no upper bound
+    auto _bucket_label = [](size_t _idx) {
+        bool              _last = (_idx + 1 == num_buckets);
+        uint64_t          _ns   = (1ULL << ((_last) ? (_idx - 1) : _idx));
+        std::stringstream ss;
+        ss << ((_last) ? ">=" : "<");
+        if(_ns < 1000)
+            ss << _ns << "ns";
+        else if(_ns < 1000000)
+            ss << (_ns / 1000) << "us";
+        else
+            ss << (_ns / 1000000) << "ms";
+        return ss.str();
+    };
+
+    auto _header = [&os](const char* _last) {
+        os << std::setw(14) << "TIME [sec]" << std::setw(12) << "CALLS" << std::setw(8)
+           << "ERRORS" << std::setw(14) << "READ [MB]" << std::setw(14) << "WRITE [MB]"
+           << "  " << _last << "\n";
+    };
+
+    auto _row = [&os, &_sec, &_mb](const summary& _s) {
+        os << std::fixed << std::setprecision(6) << std::setw(14) << _sec(_s.time_ns)
+           << std::setw(12) << _s.calls << std::setw(8) << _s.errors
+           << std::setprecision(3) << std::setw(14) << _mb(_s.read) << std::setw(14)
+           << _mb(_s.written);
+    };
+
+    os << "[io_gotcha]> POSIX I/O trace :: files = " << _ranked.size()
+       << ", entries = " << _sites.size() << ", dropped = " << _tables.num_dropped.load()
+       << "\n\n";
+
+    _header("FILE");
+    for(const auto& itr : _ranked)
+    {
+        _row(itr.second);
+        os << "  " << itr.first << "\n";
+    }
+
+    os << "\n";
+    _header("FILE :: REGION :: FUNCTION [LATENCY HISTOGRAM]");
+    for(const auto& itr : _sites)
+    {
+        _row(itr.data);
+        os << "  " << itr.file << " :: " << itr.region << " :: " << get_op_label(itr.op)
+           << " [";
+        bool _first = true;
+        for(size_t i = 0; i < num_buckets; ++i)
+        {
+            if(itr.data.hist[i] == 0)
+                continue;
+            os << ((_first) ? "" : " ") << _bucket_label(i) << ":"
+               << itr.data.hist[i];
+            _first = false;
+        }
+        os << "]\n";
+    }
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+}  // namespace io_trace
+}  // namespace component
+}  // namespace tim
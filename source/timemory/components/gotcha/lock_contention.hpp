@@ -0,0 +1,450 @@
+//  MIT License
+//
+//  Copyright (c) 2020, The Regents of the University of California,
+//  through Lawrence Berkeley National Laboratory (subject to receipt of any
+//  required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+
+/**
+ * \file timemory/components/gotcha/lock_contention.hpp
+ * \brief Lock-contention tables used by lock_gotcha. Every acquisition first tries
+ * the lock and only an acquisition which finds the lock held is timed, so the
+ * uncontended path is a try-lock and a few relaxed atomic increments. The hold time
+ * of the uncontended acquisitions is sampled and weighted by the sampling period.
+ */
+
+#pragma once
+
+#include "timemory/components/gotcha/trace_tables.hpp"
+#include "timemory/units.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <iomanip>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tim
+{
+namespace component
+{
+namespace lock_contention
+{
+//
+//--------------------------------------------------------------------------------------//
+//
+static constexpr size_t   max_probe     = 32;
+static constexpr size_t   max_held      = 32;
+static constexpr size_t   lock_capacity = (1 << 12);
+static constexpr uint32_t hold_period   = 64;
+
+enum class lock_kind : uint8_t
+{
+    mutex = 0,
+    rwlock_read,
+    rwlock_write
+};
+//
+//--------------------------------------------------------------------------------------//
+/// the statistics of a lock within a region. The entries are never removed
+///
+struct lock_entry
+{
+    std::atomic<uint64_t> key{ 0 };
+    std::atomic<uint64_t> acquisitions{ 0 };
+    std::atomic<uint64_t> contended{ 0 };
+    std::atomic<uint64_t> wait_ns{ 0 };
+    std::atomic<uint64_t> hold_ns{ 0 };
+    std::atomic<uint64_t> cond_waits{ 0 };
+    std::atomic<uint64_t> cond_wait_ns{ 0 };
+    std::atomic<bool>     ready{ false };
+    uintptr_t             addr   = 0;
+    uint64_t              region = 0;
+    lock_kind             kind   = lock_kind::mutex;
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+struct tables
+{
+    static tables& instance()
+    {
+        static tables* _instance = new tables{};
+        return *_instance;
+    }
+
+    std::array<lock_entry, lock_capacity> locks{};
+    std::atomic<uint64_t>                 num_locks{ 0 };
+    std::atomic<uint64_t>                 num_dropped{ 0 };
+
+    // only modified when a region is entered
+    trace_tables::label_map region_labels{};
+};
+//
+//--------------------------------------------------------------------------------------//
+/// a lock held by the calling thread. A weight of zero is an untimed hold
+///
+struct held_lock
+{
+    uintptr_t   addr   = 0;
+    lock_entry* entry  = nullptr;
+    int64_t     start  = 0;
+    uint32_t    weight = 0;
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+struct thread_state : trace_tables::thread_state_base
+{
+    static thread_state& instance()
+    {
+        static thread_local thread_state _instance{};
+        return _instance;
+    }
+
+    uint32_t                        countdown = hold_period;
+    size_t                          num_held  = 0;
+    int64_t                         wait_ns   = 0;
+    std::array<held_lock, max_held> held      = {};
+};
+//
+/// prevents the locks acquired by the profiler itself from being recorded
+using scoped_suppress = trace_tables::scoped_suppress<thread_state>;
+using trace_tables::mix;
+using trace_tables::now;
+//
+//--------------------------------------------------------------------------------------//
+//
+/// enter a region. The label is generated the first time the thread enters the
+/// region. Called when a region is entered, never when a lock is acquired
+///
+template <typename LabelFuncT>
+inline void
+push_region(uint64_t _region, LabelFuncT&& _label)
+{
+    trace_tables::push_region<thread_state>(tables::instance().region_labels, _region,
+                                            std::forward<LabelFuncT>(_label));
+}
+//
+inline void
+pop_region()
+{
+    trace_tables::pop_region<thread_state>();
+}
+//
+//--------------------------------------------------------------------------------------//
+/// find or create the entry for the lock in the region of the calling thread.
+/// Returns nullptr if the table is full
+///
+inline lock_entry*
+get_entry(const void* _addr, lock_kind _kind, uint64_t _region)
+{
+    auto&    _tables = tables::instance();
+    auto     _addr_v = reinterpret_cast<uintptr_t>(_addr);
+    uint64_t _key    = mix(mix(_addr_v) ^ (_region + 1)) + static_cast<uint64_t>(_kind);
+    _key             = (_key == 0) ? 1 : _key;
+
+    auto* _entry = trace_tables::probe_insert<max_probe>(
+        _tables.locks, _key, [&](lock_entry& _new) {
+            _new.addr   = _addr_v;
+            _new.region = _region;
+            _new.kind   = _kind;
+            _tables.num_locks.fetch_add(1, std::memory_order_relaxed);
+        });
+    if(!_entry)
+        _tables.num_dropped.fetch_add(1, std::memory_order_relaxed);
+    return _entry;
+}
+//
+//--------------------------------------------------------------------------------------//
+/// the hold of an uncontended acquisition is timed once every hold_period
+/// acquisitions and weighted by hold_period. Contended acquisitions are always timed
+///
+inline void
+push_held(thread_state& _state, const void* _addr, lock_entry* _entry, int64_t _start)
+{
+    uint32_t _weight = (_start > 0) ? 1 : 0;
+    if(_weight == 0 && --_state.countdown == 0)
+    {
+        _state.countdown = hold_period;
+        _start           = now();
+        _weight          = hold_period;
+    }
+    if(_state.num_held < max_held)
+        _state.held[_state.num_held++] = { reinterpret_cast<uintptr_t>(_addr), _entry,
+                                           _start, _weight };
+}
+//
+//--------------------------------------------------------------------------------------//
+/// locks are mostly released in the reverse order of acquisition so the search
+/// starts at the most recently acquired lock
+///
+inline void
+pop_held(thread_state& _state, const void* _addr)
+{
+    auto _addr_v = reinterpret_cast<uintptr_t>(_addr);
+    for(size_t i = _state.num_held; i > 0; --i)
+    {
+        auto& _held = _state.held[i - 1];
+        if(_held.addr != _addr_v)
+            continue;
+        if(_held.weight > 0 && _held.entry)
+            _held.entry->hold_ns.fetch_add(
+                static_cast<uint64_t>(now() - _held.start) * _held.weight,
+                std::memory_order_relaxed);
+        for(size_t j = i; j < _state.num_held; ++j)
+            _state.held[j - 1] = _state.held[j];
+        --_state.num_held;
+        return;
+    }
+}
+//
+//--------------------------------------------------------------------------------------//
+/// acquire a lock. The try-lock function is called first and the blocking lock
+/// function is only called (and timed) when the lock is busy. Any other error of the
+/// try-lock (e.g. EINVAL, EAGAIN) is returned to the caller unchanged
+///
+template <typename TryFuncT, typename LockFuncT>
+int
+acquire(const void* _addr, lock_kind _kind, TryFuncT&& _try_lock, LockFuncT&& _lock)
+{
+    auto& _state = thread_state::instance();
+    if(_state.suppress)
+        return _lock();
+
+    scoped_suppress _suppress{};
+    auto*           _entry = get_entry(_addr, _kind, _state.region());
+    int64_t         _start = 0;
+    int             _ret   = _try_lock();
+    if(_ret == EBUSY)
+    {
+        auto _beg = now();
+        _ret      = _lock();
+        _start    = now();
+        auto _dt  = _start - _beg;
+        _state.wait_ns += _dt;
+        if(_entry)
+        {
+            _entry->contended.fetch_add(1, std::memory_order_relaxed);
+            _entry->wait_ns.fetch_add(static_cast<uint64_t>(_dt),
+                                      std::memory_order_relaxed);
+        }
+    }
+
+    if(_ret == 0)
+    {
+        if(_entry)
+            _entry->acquisitions.fetch_add(1, std::memory_order_relaxed);
+        push_held(_state, _addr, _entry, _start);
+    }
+    return _ret;
+}
+//
+//--------------------------------------------------------------------------------------//
+/// an explicit try-lock by the application. A failed attempt counts as contended
+/// but is not an acquisition
+///
+template <typename TryFuncT>
+int
+try_acquire(const void* _addr, lock_kind _kind, TryFuncT&& _try_lock)
+{
+    auto& _state = thread_state::instance();
+    if(_state.suppress)
+        return _try_lock();
+
+    scoped_suppress _suppress{};
+    auto*           _entry = get_entry(_addr, _kind, _state.region());
+    int             _ret   = _try_lock();
+    if(_entry)
+        ((_ret == 0) ? _entry->acquisitions : _entry->contended)
+            .fetch_add(1, std::memory_order_relaxed);
+    if(_ret == 0)
+        push_held(_state, _addr, _entry, 0);
+    return _ret;
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+template <typename UnlockFuncT>
+int
+release(const void* _addr, UnlockFuncT&& _unlock)
+{
+    auto& _state = thread_state::instance();
+    if(!_state.suppress && _state.num_held > 0)
+        pop_held(_state, _addr);
+    return _unlock();
+}
+//
+//--------------------------------------------------------------------------------------//
+/// the mutex is released for the duration of the wait so the hold ends before the
+/// wait and a new (timed) hold starts when the wait returns
+///
+template <typename WaitFuncT>
+int
+cond_wait(const void* _mutex, WaitFuncT&& _wait)
+{
+    auto& _state = thread_state::instance();
+    if(_state.suppress)
+        return _wait();
+
+    scoped_suppress _suppress{};
+    pop_held(_state, _mutex);
+    auto* _entry = get_entry(_mutex, lock_kind::mutex, _state.region());
+    auto  _beg   = now();
+    int   _ret   = _wait();
+    auto  _end   = now();
+    if(_entry)
+    {
+        _entry->cond_waits.fetch_add(1, std::memory_order_relaxed);
+        _entry->cond_wait_ns.fetch_add(static_cast<uint64_t>(_end - _beg),
+                                       std::memory_order_relaxed);
+    }
+    push_held(_state, _mutex, _entry, _end);
+    return _ret;
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+inline std::string
+get_lock_label(uintptr_t _addr, lock_kind _kind)
+{
+    std::stringstream ss;
+    switch(_kind)
+    {
+        case lock_kind::mutex: ss << "mutex"; break;
+        case lock_kind::rwlock_read: ss << "rwlock(read)"; break;
+        case lock_kind::rwlock_write: ss << "rwlock(write)"; break;
+    }
+    ss << " " << reinterpret_cast<void*>(_addr);
+    return ss.str();
+}
+//
+//--------------------------------------------------------------------------------------//
+/// print the locks ranked by the total wait time followed by the breakdown of each
+/// lock by region
+///
+inline void
+print(std::ostream& os)
+{
+    auto& _tables = tables::instance();
+
+    struct summary
+    {
+        uint64_t acquisitions = 0;
+        uint64_t contended    = 0;
+        uint64_t wait_ns      = 0;
+        uint64_t hold_ns      = 0;
+        uint64_t cond_waits   = 0;
+        uint64_t cond_wait_ns = 0;
+
+        summary& operator+=(const summary& rhs)
+        {
+            acquisitions += rhs.acquisitions;
+            contended += rhs.contended;
+            wait_ns += rhs.wait_ns;
+            hold_ns += rhs.hold_ns;
+            cond_waits += rhs.cond_waits;
+            cond_wait_ns += rhs.cond_wait_ns;
+            return *this;
+        }
+    };
+
+    using label_pair_t = std::pair<std::string, std::string>;
+
+    std::map<std::string, summary>                _locks{};
+    std::vector<std::pair<summary, label_pair_t>> _regions{};
+    auto                                          _labels = _tables.region_labels.get();
+    _labels.emplace(0, "unknown");
+
+    for(const auto& itr : _tables.locks)
+    {
+        if(!itr.ready.load(std::memory_order_acquire))
+            continue;
+        summary _s{ itr.acquisitions.load(), itr.contended.load(),
+                    itr.wait_ns.load(),      itr.hold_ns.load(),
+                    itr.cond_waits.load(),   itr.cond_wait_ns.load() };
+        auto    _lock = get_lock_label(itr.addr, itr.kind);
+        _locks[_lock] += _s;
+        _regions.emplace_back(_s, std::make_pair(_lock, _labels[itr.region]));
+    }
+
+    auto _rank = [](const summary& lhs, const summary& rhs) {
+        return (lhs.wait_ns == rhs.wait_ns) ? (lhs.contended > rhs.contended)
+                                            : (lhs.wait_ns > rhs.wait_ns);
+    };
+
+    std::vector<std::pair<std::string, summary>> _ranked(_locks.begin(), _locks.end());
+    std::sort(_ranked.begin(), _ranked.end(), [&_rank](const auto& lhs, const auto& rhs) {
+        return _rank(lhs.second, rhs.second);
+    });
+    std::sort(_regions.begin(), _regions.end(),
+              [&_rank](const auto& lhs, const auto& rhs) {
+                  return _rank(lhs.first, rhs.first);
+              });
+
+    auto _sec = [](uint64_t _val) { return static_cast<double>(_val) / units::nsec; };
+
+    auto _header = [&os](const char* _last) {
+        os << std::setw(14) << "WAIT [sec]" << std::setw(14) << "HOLD [sec]"
+           << std::setw(12) << "ACQUIRED" << std::setw(12) << "CONTENDED"
+           << std::setw(12) << "COND-WAITS" << std::setw(16) << "COND-WAIT [sec]"
+           << "  " << _last << "\n";
+    };
+
+    auto _row = [&os, &_sec](const summary& _s) {
+        os << std::fixed << std::setprecision(6) << std::setw(14) << _sec(_s.wait_ns)
+           << std::setw(14) << _sec(_s.hold_ns) << std::setw(12) << _s.acquisitions
+           << std::setw(12) << _s.contended << std::setw(12) << _s.cond_waits
+           << std::setw(16) << _sec(_s.cond_wait_ns);
+    };
+
+    os << "[lock_gotcha]> lock contention profile :: locks = " << _ranked.size()
+       << ", hold sampling period = " << hold_period
+       << ", dropped = " << _tables.num_dropped.load() << "\n\n";
+
+    _header("LOCK");
+    for(const auto& itr : _ranked)
+    {
+        _row(itr.second);
+        os << "  " << itr.first << "\n";
+    }
+
+    os << "\n";
+    _header("LOCK :: REGION");
+    for(const auto& itr : _regions)
+    {
+        _row(itr.first);
+        os << "  " << itr.second.first << " :: " << itr.second.second << "\n";
+    }
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+}  // namespace lock_contention
+}  // namespace component
+}  // namespace tim
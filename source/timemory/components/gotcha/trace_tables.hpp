@@ -0,0 +1,204 @@
+//  MIT License
+//
+//  Copyright (c) 2020, The Regents of the University of California,
+//  through Lawrence Berkeley National Laboratory (subject to receipt of any
+//  required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+
+
+/**
+ * \file timemory/components/gotcha/trace_tables.hpp
+ * \brief The building blocks shared by the tables of the gotcha-based profilers
+ * (heap_sampler, lock_contention, io_trace): the hash mixing, the clock, the
+ * per-thread region stack with the flag which suppresses the recording of the
+ * profiler itself, the region labels, and the lock-free insertion into a fixed-size
+ * open-addressing table.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace tim
+{
+namespace component
+{
+namespace trace_tables
+{
+//
+//--------------------------------------------------------------------------------------//
+//
+inline uint64_t
+mix(uint64_t _val)
+{
+    // splitmix64 finalizer
+    _val ^= _val >> 30;
+    _val *= 0xbf58476d1ce4e5b9ULL;
+    _val ^= _val >> 27;
+    _val *= 0x94d049bb133111ebULL;
+    _val ^= _val >> 31;
+    return _val;
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+inline int64_t
+now()
+{
+    using clock_type = std::chrono::steady_clock;
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               clock_type::now().time_since_epoch())
+        .count();
+}
+//
+//--------------------------------------------------------------------------------------//
+/// labels of the ids stored in the tables. Only modified when a new id is created
+/// (e.g. a file is opened or a thread enters a region for the first time), never on
+/// the hot path
+///
+struct label_map
+{
+    using map_type = std::unordered_map<uint64_t, std::string>;
+
+    void emplace(uint64_t _id, const std::string& _label)
+    {
+        std::unique_lock<std::mutex> _lk(m_mutex);
+        m_data.emplace(_id, _label);
+    }
+
+    map_type get() const
+    {
+        std::unique_lock<std::mutex> _lk(m_mutex);
+        return m_data;
+    }
+
+private:
+    mutable std::mutex m_mutex = {};
+    map_type           m_data  = {};
+};
+//
+//--------------------------------------------------------------------------------------//
+/// the part of the per-thread state which is common to the profilers. The state of
+/// each profiler derives from this and provides a static instance()
+///
+struct thread_state_base
+{
+    uint64_t region() const { return (regions.empty()) ? 0 : regions.back(); }
+
+    bool                         suppress = false;
+    std::vector<uint64_t>        regions  = {};
+    std::unordered_set<uint64_t> labeled  = {};  /// regions with a stored label
+};
+//
+//--------------------------------------------------------------------------------------//
+/// prevents the calls made by the profiler itself from being recorded
+///
+template <typename StateT>
+struct scoped_suppress
+{
+    scoped_suppress()
+    : m_state(StateT::instance())
+    , m_prev(m_state.suppress)
+    {
+        m_state.suppress = true;
+    }
+
+    ~scoped_suppress() { m_state.suppress = m_prev; }
+
+    scoped_suppress(const scoped_suppress&) = delete;
+    scoped_suppress(scoped_suppress&&)      = delete;
+    scoped_suppress& operator=(const scoped_suppress&) = delete;
+    scoped_suppress& operator=(scoped_suppress&&) = delete;
+
+private:
+    StateT& m_state;
+    bool    m_prev;
+};
+//
+//--------------------------------------------------------------------------------------//
+/// enter the region on the calling thread. The label is only generated and stored
+/// the first time the thread enters the region so the (locked) map of the labels is
+/// not modified every time
+///
+template <typename StateT, typename LabelFuncT>
+inline void
+push_region(label_map& _labels, uint64_t _region, LabelFuncT&& _get_label)
+{
+    scoped_suppress<StateT> _suppress{};
+    auto&                   _state = StateT::instance();
+    if(_state.labeled.insert(_region).second)
+        _labels.emplace(_region, _get_label());
+    _state.regions.emplace_back(_region);
+}
+//
+template <typename StateT>
+inline void
+pop_region()
+{
+    auto& _state = StateT::instance();
+    if(!_state.regions.empty())
+        _state.regions.pop_back();
+}
+//
+//--------------------------------------------------------------------------------------//
+/// find or create the entry for the (non-zero) key in a table of entries with an
+/// atomic `key` (zero is an empty slot) and an atomic `ready` flag. The thread which
+/// claims a slot calls the init function on the entry before it is marked ready.
+/// Returns nullptr if the key is not within the first MaxProbe slots and none of
+/// them are empty. The entries are never removed
+///
+template <size_t MaxProbe, typename EntryT, size_t N, typename InitT>
+inline EntryT*
+probe_insert(std::array<EntryT, N>& _table, uint64_t _key, InitT&& _init)
+{
+    static_assert((N & (N - 1)) == 0, "The capacity of the table must be a power of 2");
+
+    for(size_t i = 0; i < MaxProbe; ++i)
+    {
+        auto& _entry = _table[(_key + i) & (N - 1)];
+        auto  _cur   = _entry.key.load(std::memory_order_acquire);
+        if(_cur == _key)
+            return &_entry;
+        if(_cur == 0 && _entry.key.compare_exchange_strong(_cur, _key))
+        {
+            _init(_entry);
+            _entry.ready.store(true, std::memory_order_release);
+            return &_entry;
+        }
+        // lost the race for the slot to the same key
+        if(_cur == _key)
+            return &_entry;
+    }
+    return nullptr;
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+}  // namespace trace_tables
+}  // namespace component
+}  // namespace tim
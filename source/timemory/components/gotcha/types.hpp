@@ -43,6 +43,8 @@ TIMEMORY_DECLARE_TEMPLATE_COMPONENT(gotcha, size_t Nt, typename Components,
                                     typename Differentiator = void)
 //
 TIMEMORY_DECLARE_COMPONENT(malloc_gotcha)
+TIMEMORY_DECLARE_COMPONENT(lock_gotcha)
+TIMEMORY_DECLARE_COMPONENT(io_gotcha)
 //
 TIMEMORY_DECLARE_TEMPLATE_COMPONENT(mpip_handle, typename Toolset, typename Tag)
 //
@@ -53,6 +55,8 @@ TIMEMORY_DECLARE_TEMPLATE_COMPONENT(mpip_handle, typename Toolset, typename Tag)
 //--------------------------------------------------------------------------------------//
 //
 TIMEMORY_STATISTICS_TYPE(component::malloc_gotcha, double)
+TIMEMORY_STATISTICS_TYPE(component::lock_gotcha, double)
+TIMEMORY_STATISTICS_TYPE(component::io_gotcha, double)
 //
 //--------------------------------------------------------------------------------------//
 //
@@ -63,6 +67,8 @@ TIMEMORY_STATISTICS_TYPE(component::malloc_gotcha, double)
 #if !defined(TIMEMORY_USE_GOTCHA)
 //
 TIMEMORY_DEFINE_CONCRETE_TRAIT(is_available, component::malloc_gotcha, false_type)
+TIMEMORY_DEFINE_CONCRETE_TRAIT(is_available, component::lock_gotcha, false_type)
+TIMEMORY_DEFINE_CONCRETE_TRAIT(is_available, component::io_gotcha, false_type)
 //
 namespace tim
 {
@@ -104,6 +110,18 @@ TIMEMORY_DEFINE_CONCRETE_TRAIT(uses_memory_units, component::malloc_gotcha, true
 //
 //--------------------------------------------------------------------------------------//
 //
+//                              IS TIMING CATEGORY
+//                              USES TIMING UNITS
+//
+//--------------------------------------------------------------------------------------//
+//
+TIMEMORY_DEFINE_CONCRETE_TRAIT(is_timing_category, component::lock_gotcha, true_type)
+TIMEMORY_DEFINE_CONCRETE_TRAIT(uses_timing_units, component::lock_gotcha, true_type)
+TIMEMORY_DEFINE_CONCRETE_TRAIT(is_timing_category, component::io_gotcha, true_type)
+TIMEMORY_DEFINE_CONCRETE_TRAIT(uses_timing_units, component::io_gotcha, true_type)
+//
+//--------------------------------------------------------------------------------------//
+//
 //                              IS GOTCHA
 //                              START PRIORITY
 //                              STOP PRIORITY
@@ -156,6 +174,9 @@ struct has_gotcha<Tuple<T...>>
 //======================================================================================//
 //
 TIMEMORY_PROPERTY_SPECIALIZATION(malloc_gotcha, MALLOC_GOTCHA, "malloc_gotcha", "")
+TIMEMORY_PROPERTY_SPECIALIZATION(lock_gotcha, LOCK_GOTCHA, "lock_gotcha",
+                                 "lock_contention")
+TIMEMORY_PROPERTY_SPECIALIZATION(io_gotcha, IO_GOTCHA, "io_gotcha", "io_trace")
 //
 //======================================================================================//
 //
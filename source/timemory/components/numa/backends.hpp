@@ -0,0 +1,518 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+/**
+ * \file timemory/components/numa/backends.hpp
+ * \brief Implementation of the NUMA topology and page-placement utilities
+ */
+
+#pragma once
+
+#include "timemory/utility/macros.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(_LINUX)
+#    include <dirent.h>
+#    include <sched.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#endif
+
+namespace tim
+{
+namespace numa
+{
+//--------------------------------------------------------------------------------------//
+//
+//      topology
+//
+//--------------------------------------------------------------------------------------//
+//
+/// parse a sysfs cpu list, e.g. "0-3,8,10-11"
+inline std::vector<int>
+parse_cpu_list(const std::string& _list)
+{
+    std::vector<int>  _cpus{};
+    std::stringstream ss(_list);
+    std::string       _range{};
+    while(std::getline(ss, _range, ','))
+    {
+        if(_range.empty() || !isdigit(_range.front()))
+            continue;
+        auto _dash = _range.find('-');
+        int  _beg  = atoi(_range.substr(0, _dash).c_str());
+        int  _end  = _beg;
+        if(_dash != std::string::npos)
+            _end = atoi(_range.substr(_dash + 1).c_str());
+        for(int i = _beg; i <= _end; ++i)
+            _cpus.emplace_back(i);
+    }
+    return _cpus;
+}
+//
+//--------------------------------------------------------------------------------------//
+/// the NUMA topology of the machine as seen in /sys/devices/system/node. A machine
+/// without that directory (or a non-Linux OS) is reported as a single node with
+/// every CPU on node 0
+///
+struct topology
+{
+    int              num_nodes   = 1;
+    std::vector<int> cpu_to_node = {};
+
+    int get_node(int _cpu) const
+    {
+        return (_cpu >= 0 && _cpu < (int) cpu_to_node.size()) ? cpu_to_node[_cpu] : 0;
+    }
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+inline const topology&
+get_topology()
+{
+    static topology _instance = []() {
+        topology _topo{};
+#if defined(_LINUX)
+        const char* _path = "/sys/devices/system/node";
+        if(DIR* _dir = opendir(_path))
+        {
+            while(struct dirent* _entry = readdir(_dir))
+            {
+                const char* _name = _entry->d_name;
+                if(strncmp(_name, "node", 4) != 0 || !isdigit(_name[4]))
+                    continue;
+                int _node       = atoi(_name + 4);
+                _topo.num_nodes = std::max(_topo.num_nodes, _node + 1);
+
+                std::ifstream ifs(std::string(_path) + "/" + _name + "/cpulist");
+                std::string   _list{};
+                if(!ifs || !std::getline(ifs, _list))
+                    continue;
+                for(auto itr : parse_cpu_list(_list))
+                {
+                    if(itr >= (int) _topo.cpu_to_node.size())
+                        _topo.cpu_to_node.resize(itr + 1, 0);
+                    _topo.cpu_to_node[itr] = _node;
+                }
+            }
+            closedir(_dir);
+        }
+#endif
+        return _topo;
+    }();
+    return _instance;
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+inline int
+get_num_nodes()
+{
+    return get_topology().num_nodes;
+}
+//
+//--------------------------------------------------------------------------------------//
+/// the CPU the calling thread is currently running on
+///
+inline int
+get_cpu()
+{
+#if defined(_LINUX)
+    return std::max(sched_getcpu(), 0);
+#else
+    return 0;
+#endif
+}
+//
+//--------------------------------------------------------------------------------------//
+/// the node of the CPU the calling thread is currently running on
+///
+inline int
+get_node(int _cpu)
+{
+    return get_topology().get_node(_cpu);
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+//      page placement
+//
+//--------------------------------------------------------------------------------------//
+//
+/// query the node of each page via the query mode of move_pages (nodes == NULL).
+/// The status of a page which is not resident is negative (-ENOENT). Returns false
+/// when the system call is not available (e.g. blocked by a seccomp profile)
+///
+inline bool
+query_pages(std::vector<void*>& _pages, std::vector<int>& _status)
+{
+    _status.assign(_pages.size(), -ENOENT);
+    if(_pages.empty())
+        return true;
+#if defined(_LINUX) && defined(SYS_move_pages)
+    auto _ret = syscall(SYS_move_pages, 0, (unsigned long) _pages.size(), _pages.data(),
+                        nullptr, _status.data(), 0);
+    return (_ret >= 0);
+#else
+    return false;
+#endif
+}
+//
+//--------------------------------------------------------------------------------------//
+/// resident bytes of the process per node as reported by /proc/self/numa_maps. This
+/// is exact but the kernel walks every resident page so it is only used when the
+/// move_pages query is not available
+///
+inline std::vector<int64_t>
+read_numa_maps(int _num_nodes)
+{
+    std::vector<int64_t> _bytes(_num_nodes, 0);
+#if defined(_LINUX)
+    std::ifstream ifs("/proc/self/numa_maps");
+    std::string   _line{};
+    while(ifs && std::getline(ifs, _line))
+    {
+        using count_t = std::pair<int, int64_t>;
+
+        int64_t              _page_kb = 4;
+        std::vector<count_t> _counts{};
+        std::stringstream    ss(_line);
+        std::string          _field{};
+        while(ss >> _field)
+        {
+            if(_field.length() > 1 && _field[0] == 'N' && isdigit(_field[1]))
+            {
+                auto _eq = _field.find('=');
+                if(_eq != std::string::npos)
+                    _counts.emplace_back(atoi(_field.c_str() + 1),
+                                         atoll(_field.c_str() + _eq + 1));
+            }
+            else if(_field.find("kernelpagesize_kB=") == 0)
+            {
+                _page_kb = atoll(_field.c_str() + strlen("kernelpagesize_kB="));
+            }
+        }
+        for(const auto& itr : _counts)
+        {
+            if(itr.first >= 0 && itr.first < _num_nodes)
+                _bytes[itr.first] += itr.second * _page_kb * 1024;
+        }
+    }
+#endif
+    return _bytes;
+}
+//
+//--------------------------------------------------------------------------------------//
+/// resident bytes of the process (used when there is a single node and the page
+/// query is not available: all of the memory is on node 0)
+///
+inline int64_t
+read_resident_bytes()
+{
+#if defined(_LINUX)
+    int64_t _size = 0;
+    int64_t _rss  = 0;
+    FILE*   _fp   = fopen("/proc/self/statm", "r");
+    if(_fp)
+    {
+        if(fscanf(_fp, "%ld %ld", &_size, &_rss) != 2)
+            _rss = 0;
+        fclose(_fp);
+    }
+    return _rss * sysconf(_SC_PAGESIZE);
+#else
+    return 0;
+#endif
+}
+//
+//--------------------------------------------------------------------------------------//
+/// \struct tim::numa::page_sampler
+/// \brief Estimates the resident bytes of the process on each node from a bounded
+/// sample of the pages in the writable mappings of /proc/self/maps. The sampled
+/// addresses are aligned to a power-of-two stride of pages so that a sample point
+/// keeps its address when a mapping grows or shrinks. A snapshot is incremental:
+/// only the points which were not resident in the previous snapshot plus a
+/// round-robin slice of the resident points are queried, so the cost of a snapshot
+/// is bounded by the maximum number of pages regardless of the size of the process.
+/// The mappings are re-read from /proc/self/maps at most once per refresh interval
+/// and a thread which finds another thread taking a snapshot returns the last
+/// published snapshot instead of waiting for the lock.
+///
+class page_sampler
+{
+public:
+    using bytes_t = std::vector<int64_t>;
+
+    static page_sampler& instance()
+    {
+        static page_sampler _instance{};
+        return _instance;
+    }
+
+    /// minimum interval between two reads of /proc/self/maps
+    static constexpr int64_t refresh_interval_ns = 10000000;
+
+    /// the estimated resident bytes of the process on each node
+    bytes_t snapshot(size_t _max_pages)
+    {
+        auto _nodes = get_num_nodes();
+        std::unique_lock<std::mutex> _lk(m_mutex, std::try_to_lock);
+        if(!_lk.owns_lock())
+        {
+            if(m_published.load(std::memory_order_acquire))
+                return get_published(_nodes);
+            _lk.lock();
+        }
+
+        auto _bytes = (m_query) ? sample(_nodes, _max_pages) : fallback(_nodes);
+        publish(_bytes);
+        return _bytes;
+    }
+
+    /// whether the snapshots come from the page query (vs. numa_maps or statm)
+    bool is_sampling() const { return m_query; }
+
+private:
+    struct point
+    {
+        uintptr_t addr  = 0;
+        int64_t   pages = 0;  // number of pages represented by the point
+        int       node  = -1;
+    };
+
+    struct mapping
+    {
+        uintptr_t beg = 0;
+        uintptr_t end = 0;
+    };
+
+    using atomic_bytes_t = std::vector<std::atomic<int64_t>>;
+
+    page_sampler()
+#if defined(_LINUX)
+    : m_page_size(sysconf(_SC_PAGESIZE))
+#endif
+    {}
+
+    static int64_t now()
+    {
+        using clock_type = std::chrono::steady_clock;
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   clock_type::now().time_since_epoch())
+            .count();
+    }
+
+    /// the values of the nodes are published individually so the result may mix
+    /// two consecutive snapshots, which is within the accuracy of the sampling
+    void publish(const bytes_t& _bytes)
+    {
+        for(size_t i = 0; i < _bytes.size() && i < m_published_bytes.size(); ++i)
+            m_published_bytes[i].store(_bytes[i], std::memory_order_relaxed);
+        m_published.store(true, std::memory_order_release);
+    }
+
+    bytes_t get_published(int _nodes) const
+    {
+        bytes_t _bytes(_nodes, 0);
+        for(size_t i = 0; i < _bytes.size() && i < m_published_bytes.size(); ++i)
+            _bytes[i] = m_published_bytes[i].load(std::memory_order_relaxed);
+        return _bytes;
+    }
+
+    /// requires the lock
+    bytes_t sample(int _nodes, size_t _max_pages)
+    {
+        _max_pages = std::max<size_t>(_max_pages, 1);
+        auto _now  = now();
+        if(m_points.empty() || _max_pages != m_max_pages ||
+           _now - m_refreshed >= refresh_interval_ns)
+        {
+            update_points(_max_pages);
+            m_max_pages = _max_pages;
+            m_refreshed = _now;
+        }
+
+        // query the points which were not resident and a slice of the resident ones
+        size_t _revalidate = std::max<size_t>(_max_pages / 8, 1);
+        m_index.clear();
+        m_pages.clear();
+        for(size_t i = 0; i < m_points.size() && m_pages.size() < _max_pages; ++i)
+        {
+            if(m_points[i].node < 0)
+                push(i);
+        }
+        for(size_t i = 0; i < m_points.size() && _revalidate > 0; ++i)
+        {
+            auto _idx = (m_offset + i) % m_points.size();
+            if(m_points[_idx].node >= 0 && m_pages.size() < _max_pages)
+            {
+                push(_idx);
+                --_revalidate;
+                m_offset = _idx + 1;
+            }
+        }
+
+        if(!query_pages(m_pages, m_status))
+        {
+            m_query = false;
+            return fallback(_nodes);
+        }
+
+        for(size_t i = 0; i < m_index.size(); ++i)
+            m_points[m_index[i]].node = (m_status[i] >= 0) ? m_status[i] : -1;
+
+        bytes_t _bytes(_nodes, 0);
+        for(const auto& itr : m_points)
+        {
+            if(itr.node >= 0 && itr.node < _nodes)
+                _bytes[itr.node] += itr.pages * m_page_size;
+        }
+        return _bytes;
+    }
+
+    void push(size_t _idx)
+    {
+        m_index.emplace_back(_idx);
+        m_pages.emplace_back(reinterpret_cast<void*>(m_points[_idx].addr));
+    }
+
+    bytes_t fallback(int _nodes)
+    {
+        if(_nodes > 1)
+            return read_numa_maps(_nodes);
+        return bytes_t(1, read_resident_bytes());
+    }
+
+    /// the writable mappings of the process excluding the kernel-provided ones
+    std::vector<mapping> read_mappings() const
+    {
+        std::vector<mapping> _maps{};
+#if defined(_LINUX)
+        FILE* _fp = fopen("/proc/self/maps", "r");
+        if(!_fp)
+            return _maps;
+        char _line[4096];
+        while(fgets(_line, sizeof(_line), _fp))
+        {
+            unsigned long _beg     = 0;
+            unsigned long _end     = 0;
+            char          _perm[5] = { 0 };
+            if(sscanf(_line, "%lx-%lx %4s", &_beg, &_end, _perm) != 3)
+                continue;
+            if(_perm[1] != 'w' || strstr(_line, "[vvar]") || strstr(_line, "[vsyscall]"))
+                continue;
+            _maps.emplace_back(mapping{ _beg, _end });
+        }
+        fclose(_fp);
+#endif
+        return _maps;
+    }
+
+    /// rebuild the sample points from the current mappings. Points which keep their
+    /// address keep the node of the previous query
+    void update_points(size_t _max_pages)
+    {
+        auto    _maps  = read_mappings();
+        int64_t _total = 0;
+        for(const auto& itr : _maps)
+            _total += (itr.end - itr.beg) / m_page_size;
+
+        uintptr_t _stride = 1;
+        while(_total / (int64_t) _stride > (int64_t) _max_pages)
+            _stride *= 2;
+
+        // the mappings are sorted by address so the points of the previous snapshot
+        // are matched to the new points with a single merge pass
+        std::swap(m_points, m_prev);
+        if(_stride != m_stride)
+            m_prev.clear();
+        m_stride = _stride;
+        m_points.clear();
+        size_t _p = 0;
+
+        auto _step = _stride * m_page_size;
+        for(const auto& itr : _maps)
+        {
+            auto      _npages = (int64_t)((itr.end - itr.beg) / m_page_size);
+            uintptr_t _first  = ((itr.beg + _step - 1) / _step) * _step;
+            size_t    _n      = m_points.size();
+            for(auto _addr = _first; _addr < itr.end; _addr += _step)
+                m_points.emplace_back(point{ _addr, 0, -1 });
+            // a mapping smaller than the stride is represented by its first page
+            if(m_points.size() == _n)
+                m_points.emplace_back(point{ itr.beg, 0, -1 });
+            auto _cnt = (int64_t)(m_points.size() - _n);
+            for(size_t i = _n; i < m_points.size(); ++i)
+            {
+                // distribute the pages of the mapping over its points
+                auto _rem         = ((int64_t)(i - _n) < _npages % _cnt) ? 1 : 0;
+                m_points[i].pages = _npages / _cnt + _rem;
+                while(_p < m_prev.size() && m_prev[_p].addr < m_points[i].addr)
+                    ++_p;
+                if(_p < m_prev.size() && m_prev[_p].addr == m_points[i].addr)
+                    m_points[i].node = m_prev[_p].node;
+            }
+        }
+        if(m_offset >= m_points.size())
+            m_offset = 0;
+    }
+
+private:
+    bool                              m_query           = true;
+    int64_t                           m_page_size       = 4096;
+    uintptr_t                         m_stride          = 0;
+    size_t                            m_offset          = 0;
+    size_t                            m_max_pages       = 0;
+    int64_t                           m_refreshed       = 0;
+    std::atomic<bool>                 m_published       = { false };
+    atomic_bytes_t                    m_published_bytes = atomic_bytes_t(
+        static_cast<size_t>(std::max<int>(get_num_nodes(), 1)));
+    std::mutex                        m_mutex{};
+    std::vector<point>  m_points{};
+    std::vector<point>  m_prev{};
+    std::vector<size_t> m_index{};
+    std::vector<void*>  m_pages{};
+    std::vector<int>    m_status{};
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+}  // namespace numa
+}  // namespace tim
@@ -0,0 +1,350 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+/**
+ * \file timemory/components/numa/components.hpp
+ * \brief Implementation of the numa component(s)
+ */
+
+#pragma once
+
+#include "timemory/components/base.hpp"
+#include "timemory/mpl/apply.hpp"
+#include "timemory/mpl/types.hpp"
+#include "timemory/settings/declaration.hpp"
+#include "timemory/units.hpp"
+
+#include "timemory/components/numa/backends.hpp"
+#include "timemory/components/numa/types.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+//======================================================================================//
+//
+namespace tim
+{
+namespace component
+{
+//
+//--------------------------------------------------------------------------------------//
+//
+//                      NUMA placement of the memory touched by a region
+//
+//--------------------------------------------------------------------------------------//
+/// \struct tim::component::numa_locality
+/// \brief Reports the memory which became resident on each NUMA node during a region
+/// and how much of it is remote, i.e. on a node other than the node of the CPU the
+/// thread was running on when the region was started or stopped. The per-node
+/// resident memory of the process is estimated at start and stop from a bounded,
+/// incremental sample of pages queried with `move_pages` (at most
+/// `TIMEMORY_NUMA_MAX_PAGES` pages per snapshot). When that query is not permitted
+/// the snapshot is read from `/proc/self/numa_maps`. Like \ref page_rss, the
+/// measurement is process-wide. On a single-node machine everything is local.
+///
+/// The values are the bytes on each node followed by the remote bytes. The CPU and
+/// node of the thread at the end of the last interval and the number of intervals
+/// where the thread changed node are also recorded.
+///
+struct numa_locality : public base<numa_locality, std::vector<int64_t>>
+{
+    template <typename Tp>
+    using vector_t = std::vector<Tp>;
+
+    using size_type  = size_t;
+    using value_type = vector_t<int64_t>;
+    using entry_type = typename value_type::value_type;
+    using this_type  = numa_locality;
+    using base_type  = base<this_type, value_type>;
+
+    static const short precision = 3;
+    static const short width     = 8;
+
+    //----------------------------------------------------------------------------------//
+
+    static size_t num_nodes() { return numa::get_num_nodes(); }
+
+    /// the estimated resident bytes of the process on each node
+    static value_type record()
+    {
+        auto _max  = settings::numa_max_pages();
+        auto _snap = numa::page_sampler::instance().snapshot(_max);
+        _snap.resize(num_nodes(), 0);
+        return _snap;
+    }
+
+    //----------------------------------------------------------------------------------//
+
+    numa_locality()
+    : base_type()
+    {
+        value.resize(size(), 0);
+        accum.resize(size(), 0);
+    }
+
+    ~numa_locality()                        = default;
+    numa_locality(const numa_locality& rhs) = default;
+    numa_locality(numa_locality&& rhs)      = default;
+    this_type& operator=(const this_type&) = default;
+    this_type& operator=(this_type&&) = default;
+
+    /// the number of nodes plus the entry for the remote bytes
+    size_t size() const { return num_nodes() + 1; }
+
+    //----------------------------------------------------------------------------------//
+
+    void start()
+    {
+        set_started();
+        m_cpu   = numa::get_cpu();
+        m_node  = numa::get_node(m_cpu);
+        m_start = record();
+    }
+
+    void stop()
+    {
+        auto _stop  = record();
+        auto _cpu   = numa::get_cpu();
+        auto _node  = numa::get_node(_cpu);
+        auto _nodes = num_nodes();
+
+        value.assign(size(), 0);
+        accum.resize(size(), 0);
+        entry_type _remote = 0;
+        for(size_type i = 0; i < _nodes && i < m_start.size(); ++i)
+        {
+            // memory which was released during the region is not counted
+            value[i] = std::max<entry_type>(_stop[i] - m_start[i], 0);
+            if((int) i != m_node && (int) i != _node)
+                _remote += value[i];
+        }
+        value[_nodes] = _remote;
+        for(size_type i = 0; i < size(); ++i)
+            accum[i] += value[i];
+
+        if(_node != m_node)
+            ++m_migrations;
+        m_cpu  = _cpu;
+        m_node = _node;
+        set_stopped();
+    }
+
+    //----------------------------------------------------------------------------------//
+
+    /// bytes on each node (converted to the memory units) followed by the remote bytes
+    template <typename Tp = double>
+    vector_t<Tp> get() const
+    {
+        auto&        _data = (is_transient) ? accum : value;
+        vector_t<Tp> _ret(_data.begin(), _data.end());
+        _ret.resize(size());
+        for(auto& itr : _ret)
+            itr /= static_cast<Tp>(base_type::get_unit());
+        return _ret;
+    }
+
+    /// percentage of the memory which was local: 100 when no memory was touched
+    double get_local_percent() const
+    {
+        auto&      _data  = (is_transient) ? accum : value;
+        entry_type _total = 0;
+        for(size_type i = 0; i + 1 < _data.size(); ++i)
+            _total += _data[i];
+        if(_total == 0 || _data.empty())
+            return 100.0;
+        return 100.0 * (_total - _data.back()) / static_cast<double>(_total);
+    }
+
+    int     get_cpu() const { return m_cpu; }
+    int     get_node() const { return m_node; }
+    int64_t get_migrations() const { return m_migrations; }
+
+    //----------------------------------------------------------------------------------//
+
+    this_type& operator+=(const this_type& rhs)
+    {
+        value += rhs.value;
+        accum += rhs.accum;
+        m_migrations += rhs.m_migrations;
+        if(rhs.is_transient)
+            is_transient = rhs.is_transient;
+        return *this;
+    }
+
+    this_type& operator-=(const this_type& rhs)
+    {
+        value -= rhs.value;
+        accum -= rhs.accum;
+        m_migrations -= std::min(m_migrations, rhs.m_migrations);
+        if(rhs.is_transient)
+            is_transient = rhs.is_transient;
+        return *this;
+    }
+
+public:
+    //==================================================================================//
+    //
+    //      data representation
+    //
+    //==================================================================================//
+
+    static std::string label() { return "numa_locality"; }
+
+    static std::string description()
+    {
+        return "Memory which became resident on each NUMA node and the amount which is "
+               "remote to the node of the thread";
+    }
+
+    double get_display(int _idx) const
+    {
+        auto& _data = (is_transient) ? accum : value;
+        if(_idx < 0 || _idx >= (int) _data.size())
+            return 0.0;
+        return _data[_idx] / static_cast<double>(base_type::get_unit());
+    }
+
+    //----------------------------------------------------------------------------------//
+    // load
+    //
+    template <typename Archive>
+    void CEREAL_LOAD_FUNCTION_NAME(Archive& ar, const unsigned int)
+    {
+        ar(cereal::make_nvp("is_transient", is_transient), cereal::make_nvp("laps", laps),
+           cereal::make_nvp("value", value), cereal::make_nvp("accum", accum),
+           cereal::make_nvp("cpu", m_cpu), cereal::make_nvp("node", m_node),
+           cereal::make_nvp("migrations", m_migrations));
+    }
+
+    //----------------------------------------------------------------------------------//
+    // save
+    //
+    template <typename Archive>
+    void CEREAL_SAVE_FUNCTION_NAME(Archive& ar, const unsigned int) const
+    {
+        auto             sz = std::min<size_type>(size(), value.size());
+        vector_t<double> _disp(sz, 0.0);
+        for(size_type i = 0; i < sz; ++i)
+            _disp[i] = get_display(i);
+        ar(cereal::make_nvp("is_transient", is_transient), cereal::make_nvp("laps", laps),
+           cereal::make_nvp("repr_data", _disp), cereal::make_nvp("value", value),
+           cereal::make_nvp("accum", accum), cereal::make_nvp("display", _disp),
+           cereal::make_nvp("cpu", m_cpu), cereal::make_nvp("node", m_node),
+           cereal::make_nvp("migrations", m_migrations),
+           cereal::make_nvp("local_percent", get_local_percent()),
+           cereal::make_nvp("labels", label_array()));
+    }
+
+    //----------------------------------------------------------------------------------//
+    // array of labels
+    //
+    vector_t<std::string> label_array() const
+    {
+        vector_t<std::string> arr{};
+        for(size_type i = 0; i < num_nodes(); ++i)
+            arr.emplace_back("node" + std::to_string(i));
+        arr.emplace_back("remote");
+        return arr;
+    }
+
+    //----------------------------------------------------------------------------------//
+    // array of descriptions
+    //
+    vector_t<std::string> description_array() const
+    {
+        vector_t<std::string> arr{};
+        for(size_type i = 0; i < num_nodes(); ++i)
+            arr.emplace_back("Memory which became resident on node " +
+                             std::to_string(i));
+        arr.emplace_back("Memory which became resident on a remote node");
+        return arr;
+    }
+
+    //----------------------------------------------------------------------------------//
+    // array of unit
+    //
+    vector_t<std::string> display_unit_array() const
+    {
+        return vector_t<std::string>(size(), base_type::get_display_unit());
+    }
+
+    //----------------------------------------------------------------------------------//
+    // array of unit values
+    //
+    vector_t<int64_t> unit_array() const
+    {
+        return vector_t<int64_t>(size(), base_type::get_unit());
+    }
+
+    //----------------------------------------------------------------------------------//
+
+    string_t get_display() const
+    {
+        auto _labels = label_array();
+        auto _unit   = base_type::get_display_unit();
+        auto _n      = std::min<size_type>(_labels.size(), value.size());
+        auto _prec   = base_type::get_precision();
+        auto _width  = base_type::get_width();
+        auto _flags  = base_type::get_format_flags();
+
+        std::stringstream ss;
+        for(size_type i = 0; i < _n; ++i)
+        {
+            std::stringstream ssv;
+            ssv.setf(_flags);
+            ssv << std::setw(_width) << std::setprecision(_prec) << get_display(i);
+            if(!_unit.empty())
+                ssv << " " << _unit;
+            ss << ssv.str() << " " << _labels.at(i) << ", ";
+        }
+        std::stringstream ssp;
+        ssp.setf(std::ios::fixed);
+        ssp << std::setprecision(1) << get_local_percent() << " % local";
+        ss << ssp.str();
+        return ss.str();
+    }
+
+    //----------------------------------------------------------------------------------//
+
+    friend std::ostream& operator<<(std::ostream& os, const this_type& obj)
+    {
+        os << obj.get_display();
+        return os;
+    }
+
+private:
+    int        m_cpu        = 0;
+    int        m_node       = 0;
+    int64_t    m_migrations = 0;
+    value_type m_start      = {};
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+}  // namespace component
+}  // namespace tim
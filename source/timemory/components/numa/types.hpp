@@ -0,0 +1,91 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+/**
+ * \file timemory/components/numa/types.hpp
+ * \brief Declare the numa component types
+ */
+
+#pragma once
+
+#include "timemory/components/macros.hpp"
+#include "timemory/enum.h"
+#include "timemory/mpl/type_traits.hpp"
+#include "timemory/mpl/types.hpp"
+
+//======================================================================================//
+//
+TIMEMORY_DECLARE_COMPONENT(numa_locality)
+//
+//======================================================================================//
+//
+//                              STATISTICS
+//
+//--------------------------------------------------------------------------------------//
+//
+TIMEMORY_STATISTICS_TYPE(component::numa_locality, std::vector<double>)
+//
+//--------------------------------------------------------------------------------------//
+//
+//                              IS AVAILABLE
+//
+//--------------------------------------------------------------------------------------//
+//
+#if !defined(_LINUX)
+TIMEMORY_DEFINE_CONCRETE_TRAIT(is_available, component::numa_locality, false_type)
+#endif
+//
+//--------------------------------------------------------------------------------------//
+//
+//                              UNITS
+//
+//--------------------------------------------------------------------------------------//
+//
+TIMEMORY_DEFINE_CONCRETE_TRAIT(is_memory_category, component::numa_locality, true_type)
+TIMEMORY_DEFINE_CONCRETE_TRAIT(uses_memory_units, component::numa_locality, true_type)
+//
+//--------------------------------------------------------------------------------------//
+//
+//                              ARRAY SERIALIZATION
+//
+//--------------------------------------------------------------------------------------//
+//
+TIMEMORY_DEFINE_CONCRETE_TRAIT(array_serialization, component::numa_locality, true_type)
+//
+//--------------------------------------------------------------------------------------//
+//
+//                              CUSTOM SERIALIZATION
+//
+//--------------------------------------------------------------------------------------//
+//
+TIMEMORY_DEFINE_CONCRETE_TRAIT(custom_serialization, component::numa_locality, true_type)
+//
+//--------------------------------------------------------------------------------------//
+//
+//                              PROPERTIES
+//
+//--------------------------------------------------------------------------------------//
+//
+TIMEMORY_PROPERTY_SPECIALIZATION(numa_locality, NUMA_LOCALITY, "numa_locality", "numa")
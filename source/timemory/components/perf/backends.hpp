@@ -0,0 +1,539 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+/**
+ * \file timemory/components/perf/backends.hpp
+ * \brief Implementation of the perf_event_open functions/utilities
+ */
+
+#pragma once
+
+#include "timemory/backends/types/papi.hpp"
+#include "timemory/settings/declaration.hpp"
+#include "timemory/utility/macros.hpp"
+#include "timemory/utility/utility.hpp"
+
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#if defined(_LINUX)
+#    include <linux/perf_event.h>
+#    include <sys/ioctl.h>
+#    include <sys/mman.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#endif
+
+namespace tim
+{
+namespace perf
+{
+//--------------------------------------------------------------------------------------//
+//
+//      event descriptions
+//
+//--------------------------------------------------------------------------------------//
+//
+#if defined(_LINUX)
+using event_type_t = uint32_t;
+enum : event_type_t
+{
+    hardware_type = PERF_TYPE_HARDWARE,
+    software_type = PERF_TYPE_SOFTWARE,
+    cache_type    = PERF_TYPE_HW_CACHE,
+    raw_type      = PERF_TYPE_RAW
+};
+#    define TIMEMORY_PERF_CACHE_CONFIG(CACHE, OP, RESULT)                                \
+        (PERF_COUNT_HW_CACHE_##CACHE | (PERF_COUNT_HW_CACHE_OP_##OP << 8) |              \
+         (PERF_COUNT_HW_CACHE_RESULT_##RESULT << 16))
+#else
+using event_type_t = uint32_t;
+enum : event_type_t
+{
+    hardware_type = 0,
+    software_type = 1,
+    cache_type    = 3,
+    raw_type      = 4
+};
+#endif
+//
+//--------------------------------------------------------------------------------------//
+//
+struct event_info
+{
+    std::string  name           = "";
+    std::string  description    = "";
+    std::string  units          = "";
+    event_type_t type           = software_type;
+    uint64_t     config         = 0;
+    bool         exclude_user   = false;
+    bool         exclude_kernel = true;
+    bool         exclude_hv     = true;
+};
+//
+//--------------------------------------------------------------------------------------//
+/// table of the generic events which the kernel exposes on every architecture
+///
+inline const std::vector<event_info>&
+get_event_table()
+{
+    static std::vector<event_info> _instance = []() {
+        std::vector<event_info> _table{};
+#if defined(_LINUX)
+        auto _add = [&_table](const char* _name, const char* _desc, const char* _units,
+                              event_type_t _type, uint64_t _config) {
+            event_info _info{};
+            _info.name        = _name;
+            _info.description = _desc;
+            _info.units       = _units;
+            _info.type        = _type;
+            _info.config      = _config;
+            _table.emplace_back(_info);
+        };
+        // hardware events
+        _add("cycles", "Total cycles", "", hardware_type, PERF_COUNT_HW_CPU_CYCLES);
+        _add("instructions", "Instructions retired", "", hardware_type,
+             PERF_COUNT_HW_INSTRUCTIONS);
+        _add("cache-references", "Last-level cache accesses", "", hardware_type,
+             PERF_COUNT_HW_CACHE_REFERENCES);
+        _add("cache-misses", "Last-level cache misses", "", hardware_type,
+             PERF_COUNT_HW_CACHE_MISSES);
+        _add("branches", "Branch instructions retired", "", hardware_type,
+             PERF_COUNT_HW_BRANCH_INSTRUCTIONS);
+        _add("branch-misses", "Mispredicted branch instructions", "", hardware_type,
+             PERF_COUNT_HW_BRANCH_MISSES);
+        _add("bus-cycles", "Bus cycles", "", hardware_type, PERF_COUNT_HW_BUS_CYCLES);
+        _add("stalled-cycles-frontend", "Stalled cycles during issue", "",
+             hardware_type, PERF_COUNT_HW_STALLED_CYCLES_FRONTEND);
+        _add("stalled-cycles-backend", "Stalled cycles during retirement", "",
+             hardware_type, PERF_COUNT_HW_STALLED_CYCLES_BACKEND);
+        _add("ref-cycles", "Total reference cycles", "", hardware_type,
+             PERF_COUNT_HW_REF_CPU_CYCLES);
+        // software events
+        _add("cpu-clock", "CPU clock timer", "nsec", software_type,
+             PERF_COUNT_SW_CPU_CLOCK);
+        _add("task-clock", "Clock count specific to the task", "nsec", software_type,
+             PERF_COUNT_SW_TASK_CLOCK);
+        _add("page-faults", "Page faults", "", software_type,
+             PERF_COUNT_SW_PAGE_FAULTS);
+        _add("minor-faults", "Minor page faults", "", software_type,
+             PERF_COUNT_SW_PAGE_FAULTS_MIN);
+        _add("major-faults", "Major page faults", "", software_type,
+             PERF_COUNT_SW_PAGE_FAULTS_MAJ);
+        _add("context-switches", "Context switches", "", software_type,
+             PERF_COUNT_SW_CONTEXT_SWITCHES);
+        _add("cpu-migrations", "Migrations to a new CPU", "", software_type,
+             PERF_COUNT_SW_CPU_MIGRATIONS);
+        _add("alignment-faults", "Alignment faults", "", software_type,
+             PERF_COUNT_SW_ALIGNMENT_FAULTS);
+        _add("emulation-faults", "Emulation faults", "", software_type,
+             PERF_COUNT_SW_EMULATION_FAULTS);
+        // hardware cache events
+        _add("L1-dcache-loads", "L1 data cache loads", "", cache_type,
+             TIMEMORY_PERF_CACHE_CONFIG(L1D, READ, ACCESS));
+        _add("L1-dcache-load-misses", "L1 data cache load misses", "", cache_type,
+             TIMEMORY_PERF_CACHE_CONFIG(L1D, READ, MISS));
+        _add("L1-dcache-stores", "L1 data cache stores", "", cache_type,
+             TIMEMORY_PERF_CACHE_CONFIG(L1D, WRITE, ACCESS));
+        _add("L1-icache-load-misses", "L1 instruction cache load misses", "",
+             cache_type, TIMEMORY_PERF_CACHE_CONFIG(L1I, READ, MISS));
+        _add("LLC-loads", "Last-level cache loads", "", cache_type,
+             TIMEMORY_PERF_CACHE_CONFIG(LL, READ, ACCESS));
+        _add("LLC-load-misses", "Last-level cache load misses", "", cache_type,
+             TIMEMORY_PERF_CACHE_CONFIG(LL, READ, MISS));
+        _add("LLC-stores", "Last-level cache stores", "", cache_type,
+             TIMEMORY_PERF_CACHE_CONFIG(LL, WRITE, ACCESS));
+        _add("dTLB-loads", "Data TLB loads", "", cache_type,
+             TIMEMORY_PERF_CACHE_CONFIG(DTLB, READ, ACCESS));
+        _add("dTLB-load-misses", "Data TLB load misses", "", cache_type,
+             TIMEMORY_PERF_CACHE_CONFIG(DTLB, READ, MISS));
+        _add("iTLB-load-misses", "Instruction TLB load misses", "", cache_type,
+             TIMEMORY_PERF_CACHE_CONFIG(ITLB, READ, MISS));
+#endif
+        return _table;
+    }();
+    return _instance;
+}
+//
+//--------------------------------------------------------------------------------------//
+/// parse an event in the same syntax as `perf stat -e`: a generic name (e.g. `cycles`),
+/// a raw hexadecimal PMU code (e.g. `r01c7`), optionally followed by the privilege
+/// modifiers `:u`, `:k`, and/or `:h`. Without modifiers, only user-space is counted.
+///
+inline bool
+get_event_info(const std::string& _event, event_info& _info)
+{
+    auto _name = _event;
+    auto _mods = std::string{};
+    auto _pos  = _event.find(':');
+    if(_pos != std::string::npos)
+    {
+        _name = _event.substr(0, _pos);
+        _mods = _event.substr(_pos + 1);
+    }
+
+    bool _found = false;
+    for(const auto& itr : get_event_table())
+    {
+        if(itr.name == _name)
+        {
+            _info  = itr;
+            _found = true;
+            break;
+        }
+    }
+
+    if(!_found && _name.length() > 1 && _name[0] == 'r')
+    {
+        char* _end   = nullptr;
+        auto  _code  = strtoull(_name.c_str() + 1, &_end, 16);
+        _found       = (_end && *_end == '\0');
+        _info        = event_info{};
+        _info.type   = raw_type;
+        _info.config = _code;
+        _info.description = "Raw PMU event 0x" + _name.substr(1);
+    }
+
+    if(!_found)
+        return false;
+
+    _info.name = _event;
+    if(!_mods.empty())
+    {
+        _info.exclude_user   = (_mods.find('u') == std::string::npos);
+        _info.exclude_kernel = (_mods.find('k') == std::string::npos);
+        _info.exclude_hv     = (_mods.find('h') == std::string::npos);
+    }
+    return true;
+}
+//
+//--------------------------------------------------------------------------------------//
+/// map a PAPI preset onto the equivalent generic perf event (if there is one) so
+/// that components expressed in terms of PAPI presets, e.g. cpu_roofline, can use
+/// perf_event_open as the counter backend
+///
+inline std::string
+get_event_name(int _papi_preset)
+{
+    switch(_papi_preset)
+    {
+        case PAPI_TOT_INS: return "instructions";
+        case PAPI_TOT_CYC: return "cycles";
+        case PAPI_REF_CYC: return "ref-cycles";
+        case PAPI_BR_INS: return "branches";
+        case PAPI_BR_MSP: return "branch-misses";
+        case PAPI_LD_INS: return "L1-dcache-loads";
+        case PAPI_SR_INS: return "L1-dcache-stores";
+        case PAPI_L1_DCM: return "L1-dcache-load-misses";
+        case PAPI_L1_ICM: return "L1-icache-load-misses";
+        case PAPI_L3_TCM: return "cache-misses";
+        case PAPI_TLB_DM: return "dTLB-load-misses";
+        default: break;
+    }
+    return "";
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+//      event group
+//
+//--------------------------------------------------------------------------------------//
+/// a set of counters opened for the calling thread as a single perf_event group so
+/// that every member is scheduled onto the PMU together. The whole group is read
+/// with a single `read()` or, when the kernel permits it and none of the counters
+/// has been multiplexed, with `rdpmc` through the mmap'd control page of each event.
+///
+struct group
+{
+    struct sample
+    {
+        std::vector<long long> values       = {};
+        uint64_t               time_enabled = 0;
+        uint64_t               time_running = 0;
+    };
+
+    group()                 = default;
+    group(const group&)     = delete;
+    group(group&&)          = delete;
+    group& operator=(const group&) = delete;
+    group& operator=(group&&) = delete;
+
+    ~group() { close(); }
+
+    bool   is_open() const { return m_leader >= 0; }
+    size_t size() const { return m_fds.size(); }
+
+    /// returns the number of events successfully added to the group. Events which
+    /// could not be opened keep their slot and always read as zero.
+    size_t open(const std::vector<event_info>& _events, bool _rdpmc);
+    void   close();
+    bool   read(sample& _sample) const;
+
+private:
+    bool read_rdpmc(sample& _sample) const;
+
+private:
+    int                m_leader      = -1;
+    void*              m_leader_page = nullptr;
+    std::vector<int>   m_fds         = {};
+    std::vector<void*> m_pages       = {};
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+#if defined(_LINUX)
+//
+inline long
+perf_event_open(struct perf_event_attr* _attr, pid_t _pid, int _cpu, int _group_fd,
+                unsigned long _flags)
+{
+    return syscall(__NR_perf_event_open, _attr, _pid, _cpu, _group_fd, _flags);
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+inline size_t
+group::open(const std::vector<event_info>& _events, bool _rdpmc)
+{
+    close();
+    m_fds.resize(_events.size(), -1);
+    m_pages.resize(_events.size(), nullptr);
+
+    auto _page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    auto _read_fmt  = PERF_FORMAT_GROUP | PERF_FORMAT_ID |
+                     PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    size_t _nopen = 0;
+    for(size_t i = 0; i < _events.size(); ++i)
+    {
+        struct perf_event_attr _attr;
+        memset(&_attr, 0, sizeof(_attr));
+        _attr.size           = sizeof(_attr);
+        _attr.type           = _events.at(i).type;
+        _attr.config         = _events.at(i).config;
+        _attr.read_format    = _read_fmt;
+        _attr.disabled       = (m_leader < 0) ? 1 : 0;
+        _attr.exclude_user   = (_events.at(i).exclude_user) ? 1 : 0;
+        _attr.exclude_kernel = (_events.at(i).exclude_kernel) ? 1 : 0;
+        _attr.exclude_hv     = (_events.at(i).exclude_hv) ? 1 : 0;
+
+        auto _fd = static_cast<int>(perf_event_open(&_attr, 0, -1, m_leader, 0));
+        if(_fd < 0)
+        {
+            if(settings::debug() || settings::verbose() > 0)
+                fprintf(stderr, "[perf]> Warning! Unable to open event '%s': %s\n",
+                        _events.at(i).name.c_str(), strerror(errno));
+            continue;
+        }
+
+        if(m_leader < 0)
+            m_leader = _fd;
+        m_fds.at(i) = _fd;
+        ++_nopen;
+
+        if(_rdpmc)
+        {
+            auto _page = mmap(nullptr, _page_size, PROT_READ, MAP_SHARED, _fd, 0);
+            if(_page != MAP_FAILED)
+                m_pages.at(i) = _page;
+            if(_page != MAP_FAILED && _fd == m_leader)
+                m_leader_page = _page;
+        }
+    }
+
+    if(m_leader >= 0)
+    {
+        ioctl(m_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(m_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    return _nopen;
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+inline void
+group::close()
+{
+    auto _page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    if(m_leader >= 0)
+        ioctl(m_leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    for(auto& itr : m_pages)
+    {
+        if(itr)
+            munmap(itr, _page_size);
+    }
+    // close the members before the leader
+    for(auto itr = m_fds.rbegin(); itr != m_fds.rend(); ++itr)
+    {
+        if(*itr >= 0)
+            ::close(*itr);
+    }
+    m_leader      = -1;
+    m_leader_page = nullptr;
+    m_fds.clear();
+    m_pages.clear();
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+inline bool
+group::read_rdpmc(sample& _sample) const
+{
+#    if defined(__x86_64__) || defined(__i386__)
+    uint64_t _enabled = 0;
+    uint64_t _running = 0;
+    for(size_t i = 0; i < m_fds.size(); ++i)
+    {
+        if(m_fds.at(i) < 0)
+            continue;
+
+        auto* _pc = static_cast<volatile perf_event_mmap_page*>(m_pages.at(i));
+        if(!_pc)
+            return false;
+
+        uint32_t _seq   = 0;
+        int64_t  _count = 0;
+        do
+        {
+            _seq = _pc->lock;
+            __asm__ __volatile__("" ::: "memory");
+            auto _idx = _pc->index;
+            // not currently on the PMU (e.g. software event) or not permitted
+            if(!_pc->cap_user_rdpmc || _idx == 0)
+                return false;
+            // the scaling would need to be extrapolated so use read() instead
+            if(_pc->time_enabled != _pc->time_running)
+                return false;
+            _enabled = _pc->time_enabled;
+            _running = _pc->time_running;
+
+            uint32_t _lo = 0;
+            uint32_t _hi = 0;
+            __asm__ __volatile__("rdpmc" : "=a"(_lo), "=d"(_hi) : "c"(_idx - 1));
+            auto _pmc   = static_cast<int64_t>((static_cast<uint64_t>(_hi) << 32) | _lo);
+            auto _shift = 64 - _pc->pmc_width;
+            _pmc        = static_cast<int64_t>(static_cast<uint64_t>(_pmc) << _shift);
+            _count      = _pc->offset + (_pmc >> _shift);
+            __asm__ __volatile__("" ::: "memory");
+        } while(_pc->lock != _seq);
+
+        _sample.values.at(i) = _count;
+    }
+    _sample.time_enabled = _enabled;
+    _sample.time_running = _running;
+    return true;
+#    else
+    consume_parameters(_sample);
+    return false;
+#    endif
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+inline bool
+group::read(sample& _sample) const
+{
+    _sample.values.assign(m_fds.size(), 0);
+    if(m_leader < 0)
+        return false;
+
+    // the first event may have failed to open so the leader is not necessarily the
+    // first slot
+    if(m_leader_page && read_rdpmc(_sample))
+        return true;
+
+    // layout for PERF_FORMAT_GROUP | PERF_FORMAT_ID | PERF_FORMAT_TOTAL_TIME_*:
+    //      { nr, time_enabled, time_running, { value, id }[nr] }
+    std::vector<uint64_t> _buffer(3 + 2 * m_fds.size(), 0);
+    auto _nbytes = ::read(m_leader, _buffer.data(), _buffer.size() * sizeof(uint64_t));
+    if(_nbytes < static_cast<ssize_t>(3 * sizeof(uint64_t)))
+        return false;
+
+    _sample.time_enabled = _buffer.at(1);
+    _sample.time_running = _buffer.at(2);
+    // the members of the group are reported in the order they were opened
+    size_t _n = 0;
+    for(size_t i = 0; i < m_fds.size() && _n < _buffer.at(0); ++i)
+    {
+        if(m_fds.at(i) < 0)
+            continue;
+        _sample.values.at(i) = static_cast<long long>(_buffer.at(3 + 2 * _n));
+        ++_n;
+    }
+    return true;
+}
+//
+#else
+//
+inline size_t
+group::open(const std::vector<event_info>& _events, bool _rdpmc)
+{
+    consume_parameters(_events, _rdpmc);
+    return 0;
+}
+inline void
+group::close()
+{}
+inline bool
+group::read_rdpmc(sample& _sample) const
+{
+    consume_parameters(_sample);
+    return false;
+}
+inline bool
+group::read(sample& _sample) const
+{
+    _sample.values.assign(m_fds.size(), 0);
+    return false;
+}
+//
+#endif
+//
+//--------------------------------------------------------------------------------------//
+/// the multiplexing correction for an interval: the fraction of the interval the
+/// group was enabled divided by the fraction it was actually counting on the PMU.
+/// Returns NaN when the group was enabled but never scheduled onto the PMU since the
+/// counts of that interval cannot be extrapolated
+///
+inline double
+get_scaling(uint64_t _enabled, uint64_t _running)
+{
+    if(_running == 0)
+        return (_enabled == 0) ? 1.0 : std::numeric_limits<double>::quiet_NaN();
+    return static_cast<double>(_enabled) / static_cast<double>(_running);
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+}  // namespace perf
+}  // namespace tim
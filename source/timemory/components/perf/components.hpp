@@ -0,0 +1,452 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+/**
+ * \file timemory/components/perf/components.hpp
+ * \brief Implementation of the perf component(s)
+ */
+
+#pragma once
+
+#include "timemory/components/base.hpp"
+#include "timemory/mpl/apply.hpp"
+#include "timemory/mpl/types.hpp"
+#include "timemory/units.hpp"
+
+#include "timemory/components/perf/backends.hpp"
+#include "timemory/components/perf/types.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+//======================================================================================//
+//
+namespace tim
+{
+namespace component
+{
+//
+//--------------------------------------------------------------------------------------//
+//
+//                      Group of perf_event_open counters
+//
+//--------------------------------------------------------------------------------------//
+/// \struct tim::component::perf_counters
+/// \brief Hardware and software counters read through the Linux `perf_event_open`
+/// interface without any third-party library. The events are selected via
+/// `TIMEMORY_PERF_EVENTS` (e.g. `"task-clock,context-switches,cycles,r01c7"`) and/or
+/// \ref perf_counters::add_event and are opened as a single event group per thread
+/// so that the whole set is read with one `read()` (or with `rdpmc` from user-space
+/// when possible). When the PMU multiplexes the group, the values of each interval
+/// are scaled by `time_enabled / time_running` and the accumulated correction is
+/// reported by \ref perf_counters::get_scaling.
+///
+struct perf_counters : public base<perf_counters, std::vector<long long>>
+{
+    template <typename Tp>
+    using vector_t = std::vector<Tp>;
+
+    using size_type    = size_t;
+    using event_list   = vector_t<perf::event_info>;
+    using value_type   = vector_t<long long>;
+    using entry_type   = typename value_type::value_type;
+    using this_type    = perf_counters;
+    using base_type    = base<this_type, value_type>;
+    using storage_type = typename base_type::storage_type;
+    using sample_type  = perf::group::sample;
+
+    static const short precision = 3;
+    static const short width     = 8;
+
+    template <typename... T>
+    friend struct cpu_roofline;
+
+    //----------------------------------------------------------------------------------//
+    /// add an event in `perf stat -e` syntax. Must be called before the first
+    /// instance is constructed (i.e. before the event list is configured).
+    static void add_event(const std::string& _evt)
+    {
+        auto& _events = private_events();
+        if(std::find(_events.begin(), _events.end(), _evt) == _events.end())
+            _events.push_back(_evt);
+    }
+
+    /// add the generic perf event equivalent to a PAPI preset
+    static void add_event(int _papi_preset)
+    {
+        auto _evt = perf::get_event_name(_papi_preset);
+        if(!_evt.empty())
+            add_event(_evt);
+        else
+            fprintf(stderr,
+                    "[perf_counters]> No generic perf event for PAPI preset %i. Use "
+                    "the raw PMU code via TIMEMORY_PERF_EVENTS instead\n",
+                    _papi_preset);
+    }
+
+    static const event_list& get_events()
+    {
+        configure();
+        return events();
+    }
+
+    static void configure()
+    {
+        static std::once_flag _once{};
+        std::call_once(_once, []() {
+            auto& _events  = events();
+            auto  _entries = private_events();
+            for(const auto& itr : delimit(settings::perf_events(), ",; "))
+            {
+                if(std::find(_entries.begin(), _entries.end(), itr) == _entries.end())
+                    _entries.push_back(itr);
+            }
+
+            if(settings::debug() || settings::verbose() > 1)
+                printf("[perf_counters]> TIMEMORY_PERF_EVENTS: '%s'...\n",
+                       settings::perf_events().c_str());
+
+            for(const auto& itr : _entries)
+            {
+                perf::event_info _info{};
+                if(perf::get_event_info(itr, _info))
+                    _events.emplace_back(_info);
+                else
+                    fprintf(stderr, "[perf_counters]> Unknown perf event '%s'\n",
+                            itr.c_str());
+            }
+        });
+    }
+
+    static void global_init(storage_type*) { configure(); }
+    static void thread_init(storage_type*) { get_group(); }
+    static void thread_finalize(storage_type*)
+    {
+        auto& _state = get_thread_group();
+        _state.group.close();
+        _state.opened = false;
+    }
+
+    //----------------------------------------------------------------------------------//
+    /// the counters are opened for the calling thread the first time they are used,
+    /// and again the first time they are used after thread_finalize closed them. An
+    /// attempt which failed to open any event is not repeated on every read
+    static perf::group& get_group()
+    {
+        auto& _state = get_thread_group();
+        if(!_state.opened)
+        {
+            _state.opened = true;
+            auto _n       = _state.group.open(get_events(), settings::perf_rdpmc());
+            if(_n < get_events().size() && (settings::debug() || settings::verbose() > 0))
+                fprintf(stderr, "[perf_counters]> Opened %i of %i events\n", (int) _n,
+                        (int) get_events().size());
+        }
+        return _state.group;
+    }
+
+    //----------------------------------------------------------------------------------//
+
+    perf_counters()
+    {
+        auto _n = get_events().size();
+        value.resize(_n, 0);
+        accum.resize(_n, 0);
+    }
+
+    ~perf_counters()                        = default;
+    perf_counters(const perf_counters& rhs) = default;
+    perf_counters(perf_counters&& rhs)      = default;
+    this_type& operator=(const this_type&) = default;
+    this_type& operator=(this_type&&) = default;
+
+    //----------------------------------------------------------------------------------//
+
+    size_t size() const { return get_events().size(); }
+
+    /// the counts since the group was opened, corrected for multiplexing. All zero
+    /// if the group has never been scheduled onto the PMU
+    value_type record()
+    {
+        sample_type _sample{};
+        get_group().read(_sample);
+        auto       _scale = perf::get_scaling(_sample.time_enabled, _sample.time_running);
+        value_type _ret(_sample.values.size(), 0);
+        if(!std::isfinite(_scale))
+            return _ret;
+        for(size_type i = 0; i < _ret.size(); ++i)
+            _ret[i] = std::llround(_sample.values[i] * _scale);
+        return _ret;
+    }
+
+    //----------------------------------------------------------------------------------//
+
+    template <typename Tp = double>
+    vector_t<Tp> get() const
+    {
+        auto&        _data = (is_transient) ? accum : value;
+        vector_t<Tp> _ret(_data.begin(), _data.end());
+        _ret.resize(size());
+        return _ret;
+    }
+
+    /// multiplexing correction which has been applied to the accumulated values:
+    /// 1.0 when the group was counting for the entire duration
+    double get_scaling() const { return perf::get_scaling(m_enabled, m_running); }
+
+    //----------------------------------------------------------------------------------//
+
+    void start()
+    {
+        set_started();
+        get_group().read(m_start);
+    }
+
+    void stop()
+    {
+        sample_type _stop{};
+        get_group().read(_stop);
+
+        auto _enabled = _stop.time_enabled - m_start.time_enabled;
+        auto _running = _stop.time_running - m_start.time_running;
+        auto _scale   = perf::get_scaling(_enabled, _running);
+
+        // the group was never scheduled onto the PMU during the interval so the
+        // counts cannot be extrapolated: the interval is skipped
+        if(!std::isfinite(_scale))
+        {
+            std::fill(value.begin(), value.end(), 0);
+            set_stopped();
+            return;
+        }
+
+        auto _n = std::min(_stop.values.size(), m_start.values.size());
+        _n      = std::min(_n, value.size());
+        for(size_type i = 0; i < _n; ++i)
+        {
+            auto _delta = _stop.values[i] - m_start.values[i];
+            value[i]    = std::llround(_delta * _scale);
+            accum[i] += value[i];
+        }
+        m_enabled += _enabled;
+        m_running += _running;
+        set_stopped();
+    }
+
+    //----------------------------------------------------------------------------------//
+
+    this_type& operator+=(const this_type& rhs)
+    {
+        value += rhs.value;
+        accum += rhs.accum;
+        m_enabled += rhs.m_enabled;
+        m_running += rhs.m_running;
+        if(rhs.is_transient)
+            is_transient = rhs.is_transient;
+        return *this;
+    }
+
+    this_type& operator-=(const this_type& rhs)
+    {
+        value -= rhs.value;
+        accum -= rhs.accum;
+        m_enabled -= std::min(m_enabled, rhs.m_enabled);
+        m_running -= std::min(m_running, rhs.m_running);
+        if(rhs.is_transient)
+            is_transient = rhs.is_transient;
+        return *this;
+    }
+
+public:
+    //==================================================================================//
+    //
+    //      data representation
+    //
+    //==================================================================================//
+
+    static std::string label() { return "perf_counters"; }
+
+    static std::string description()
+    {
+        return "Hardware and software counters via the perf_event_open system call";
+    }
+
+    entry_type get_display(int evt_type) const
+    {
+        return (is_transient) ? accum[evt_type] : value[evt_type];
+    }
+
+    //----------------------------------------------------------------------------------//
+    // load
+    //
+    template <typename Archive>
+    void CEREAL_LOAD_FUNCTION_NAME(Archive& ar, const unsigned int)
+    {
+        ar(cereal::make_nvp("is_transient", is_transient), cereal::make_nvp("laps", laps),
+           cereal::make_nvp("value", value), cereal::make_nvp("accum", accum),
+           cereal::make_nvp("time_enabled", m_enabled),
+           cereal::make_nvp("time_running", m_running));
+    }
+
+    //----------------------------------------------------------------------------------//
+    // save
+    //
+    template <typename Archive>
+    void CEREAL_SAVE_FUNCTION_NAME(Archive& ar, const unsigned int) const
+    {
+        auto             sz = std::min<size_type>(size(), value.size());
+        vector_t<double> _disp(sz, 0.0);
+        for(size_type i = 0; i < sz; ++i)
+            _disp[i] = get_display(i);
+        ar(cereal::make_nvp("is_transient", is_transient), cereal::make_nvp("laps", laps),
+           cereal::make_nvp("repr_data", _disp), cereal::make_nvp("value", value),
+           cereal::make_nvp("accum", accum), cereal::make_nvp("display", _disp),
+           cereal::make_nvp("time_enabled", m_enabled),
+           cereal::make_nvp("time_running", m_running),
+           cereal::make_nvp("multiplex_scaling", get_scaling()),
+           cereal::make_nvp("events", label_array()));
+    }
+
+    //----------------------------------------------------------------------------------//
+    // array of labels
+    //
+    vector_t<std::string> label_array() const
+    {
+        vector_t<std::string> arr{};
+        for(const auto& itr : get_events())
+        {
+            auto _label = itr.name;
+            for(auto& c : _label)
+            {
+                if(c == '-' || c == ':')
+                    c = '_';
+            }
+            arr.emplace_back(_label);
+        }
+        return arr;
+    }
+
+    //----------------------------------------------------------------------------------//
+    // array of descriptions
+    //
+    vector_t<std::string> description_array() const
+    {
+        vector_t<std::string> arr{};
+        for(const auto& itr : get_events())
+            arr.emplace_back(itr.description);
+        return arr;
+    }
+
+    //----------------------------------------------------------------------------------//
+    // array of unit
+    //
+    vector_t<std::string> display_unit_array() const
+    {
+        vector_t<std::string> arr{};
+        for(const auto& itr : get_events())
+            arr.emplace_back(itr.units);
+        return arr;
+    }
+
+    //----------------------------------------------------------------------------------//
+    // array of unit values
+    //
+    vector_t<int64_t> unit_array() const { return vector_t<int64_t>(size(), 1); }
+
+    //----------------------------------------------------------------------------------//
+
+    string_t get_display() const
+    {
+        auto _labels = label_array();
+        auto _units  = display_unit_array();
+        auto _n      = std::min<size_type>(_labels.size(), value.size());
+        auto _prec   = base_type::get_precision();
+        auto _width  = base_type::get_width();
+        auto _flags  = base_type::get_format_flags();
+
+        std::stringstream ss;
+        for(size_type i = 0; i < _n; ++i)
+        {
+            std::stringstream ssv;
+            ssv.setf(_flags);
+            ssv << std::setw(_width) << std::setprecision(_prec) << get_display(i);
+            if(!_units.at(i).empty())
+                ssv << " " << _units.at(i);
+            ss << ssv.str() << " " << _labels.at(i);
+            if(i + 1 < _n)
+                ss << ", ";
+        }
+        return ss.str();
+    }
+
+    //----------------------------------------------------------------------------------//
+
+    friend std::ostream& operator<<(std::ostream& os, const this_type& obj)
+    {
+        os << obj.get_display();
+        return os;
+    }
+
+private:
+    static event_list& events()
+    {
+        static event_list _instance{};
+        return _instance;
+    }
+
+    static vector_t<std::string>& private_events()
+    {
+        static vector_t<std::string> _instance{};
+        return _instance;
+    }
+
+    /// the counters of the calling thread and whether they have been opened
+    struct thread_group
+    {
+        perf::group group  = {};
+        bool        opened = false;
+    };
+
+    static thread_group& get_thread_group()
+    {
+        static thread_local thread_group _instance{};
+        return _instance;
+    }
+
+private:
+    uint64_t    m_enabled = 0;
+    uint64_t    m_running = 0;
+    sample_type m_start   = {};
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+}  // namespace component
+}  // namespace tim
@@ -32,10 +32,11 @@
 
 #include "timemory/components/cupti/backends.hpp"
 #include "timemory/components/papi/backends.hpp"
+#include "timemory/components/perf/backends.hpp"
 //
 #include "timemory/ert/data.hpp"
 //
-#if defined(TIMEMORY_USE_CUPTI) || defined(TIMEMORY_USE_PAPI)
+#if defined(TIMEMORY_USE_CUPTI) || defined(TIMEMORY_USE_PAPI) || defined(_LINUX)
 //
 #    include "timemory/components/timing/components.hpp"
 #    include "timemory/ert/configuration.hpp"
@@ -39,6 +39,7 @@
 
 #include "timemory/components/cupti/components.hpp"
 #include "timemory/components/papi/components.hpp"
+#include "timemory/components/perf/components.hpp"
 
 #include "timemory/components/roofline/cpu_roofline.hpp"
 #include "timemory/components/roofline/gpu_roofline.hpp"
@@ -30,9 +30,11 @@
 #include "timemory/settings/declaration.hpp"
 
 #include "timemory/components/papi/components.hpp"
+#include "timemory/components/perf/components.hpp"
 #include "timemory/components/roofline/backends.hpp"
 #include "timemory/components/roofline/types.hpp"
 
+#include "timemory/ert/cache.hpp"
 #include "timemory/ert/configuration.hpp"
 
 #include <array>
@@ -48,6 +50,11 @@ namespace component
 {
 //--------------------------------------------------------------------------------------//
 // this computes the numerator of the roofline for a given set of PAPI counters.
+// When PAPI is not available (or TIMEMORY_CPU_ROOFLINE_PERF_COUNTERS is defined), the
+// counters are read through perf_event_open via perf_counters instead. The PAPI
+// presets are translated to generic perf events where an equivalent exists; there
+// is no generic FLOP event so, for the FLOPS roofline, the PMU-specific raw codes must
+// be provided through TIMEMORY_PERF_EVENTS.
 // e.g. for FLOPS roofline (floating point operations / second:
 //
 //  single precision:
@@ -86,6 +93,12 @@ struct cpu_roofline
     using ratio_t     = typename count_type::ratio_t;
     using types_tuple = std::tuple<Types...>;
 
+#if defined(TIMEMORY_USE_PAPI) && !defined(TIMEMORY_CPU_ROOFLINE_PERF_COUNTERS)
+    using hw_counter_type = papi_vector;
+#else
+    using hw_counter_type = perf_counters;
+#endif
+
     using ert_data_t     = ert::exec_data<count_type>;
     using ert_data_ptr_t = std::shared_ptr<ert_data_t>;
 
@@ -253,8 +266,20 @@ struct cpu_roofline
 
             is_configured() = true;
             for(auto itr : get_events())
-                papi_vector::add_event(itr);
-            papi_vector::configure();
+                hw_counter_type::add_event(itr);
+            hw_counter_type::configure();
+#if !defined(TIMEMORY_USE_PAPI) || defined(TIMEMORY_CPU_ROOFLINE_PERF_COUNTERS)
+            // e.g. the FLOP presets have no generic perf event so, unless raw PMU
+            // codes were provided via TIMEMORY_PERF_EVENTS, there is nothing to count
+            if(hw_counter_type::get_events().empty())
+            {
+                fprintf(stderr,
+                        "[%s]> None of the hardware counters are available via %s. "
+                        "Disabling %s\n",
+                        label().c_str(), hw_counter_name(), label().c_str());
+                trait::runtime_enabled<this_type>::set(false);
+            }
+#endif
         }
     }
 
@@ -290,14 +315,55 @@ struct cpu_roofline
 
     //----------------------------------------------------------------------------------//
 
+    static ert::cache::info& get_cache_info()
+    {
+        static ert::cache::info _instance{};
+        return _instance;
+    }
+
+    //----------------------------------------------------------------------------------//
+
+    static ert::cache::signature get_cache_signature()
+    {
+        return ert::cache::signature(
+            apply<std::string>::join(", ", ert_config_type<Types>::get_signature()...));
+    }
+
+    //----------------------------------------------------------------------------------//
+
     static void global_finalize(storage_type* _store)
     {
         if(_store && _store->size() > 0)
         {
-            // run roofline peak generation
-            auto ert_config = get_finalizer();
-            auto ert_data   = get_ert_data();
-            apply<void>::access<ert_executor_t>(ert_config, ert_data);
+            auto  ert_data    = get_ert_data();
+            auto& _cache_info = get_cache_info();
+            // use the roofline peaks from a previous run on identical hardware
+            if(ert_data && settings::ert_cache() && !settings::ert_cache_refresh() &&
+               ert::cache::load(get_cache_signature(), *ert_data, _cache_info))
+            {
+                if(_cache_info.stale)
+                {
+                    fprintf(stderr,
+                            "[%s]> Warning! Using stale ERT results from '%s' (age = "
+                            "%lli seconds). Set TIMEMORY_ERT_CACHE_REFRESH=ON to "
+                            "regenerate them\n",
+                            this_type::label().c_str(),
+                            _cache_info.filename.c_str(), (long long) _cache_info.age);
+                }
+                else if(settings::verbose() > 0 || settings::debug())
+                {
+                    fprintf(stderr, "[%s]> Using cached ERT results from '%s'\n",
+                            this_type::label().c_str(), _cache_info.filename.c_str());
+                }
+            }
+            else
+            {
+                // run roofline peak generation
+                auto ert_config = get_finalizer();
+                apply<void>::access<ert_executor_t>(ert_config, ert_data);
+                if(ert_data && settings::ert_cache())
+                    ert::cache::store(get_cache_signature(), *ert_data, _cache_info);
+            }
             if(ert_data && (settings::verbose() > 1 || settings::debug()))
                 std::cout << *(ert_data) << std::endl;
         }
@@ -312,6 +378,7 @@ struct cpu_roofline
         if(!_ert_data.get())  // for input
             _ert_data.reset(new ert_data_t());
         ar(cereal::make_nvp("roofline", *_ert_data.get()));
+        ar(cereal::make_nvp("roofline_cache", get_cache_info()));
     }
 
     //----------------------------------------------------------------------------------//
@@ -339,7 +406,7 @@ struct cpu_roofline
 
     display_unit_type display_unit()
     {
-        auto _units = m_papi_vector->display_unit_array();
+        auto _units = m_hw_counter->display_unit_array();
         _units.push_back(m_wall_clock->display_unit());
         return _units;
     }
@@ -375,7 +442,7 @@ struct cpu_roofline
 
     value_type record()
     {
-        auto hwcount  = m_papi_vector->record();
+        auto hwcount  = m_hw_counter->record();
         auto duration = m_wall_clock->record();
         return value_type(hwcount, duration);
     }
@@ -387,7 +454,7 @@ public:
     : base_type()
     {
         configure();
-        m_papi_vector                        = std::make_shared<papi_vector>();
+        m_hw_counter                         = std::make_shared<hw_counter_type>();
         m_wall_clock                         = std::make_shared<wall_clock>();
         std::tie(value.second, accum.second) = std::make_pair(0, 0);
     }
@@ -404,7 +471,7 @@ public:
 
     std::vector<double> get() const
     {
-        auto _data = m_papi_vector->get();
+        auto _data = m_hw_counter->get();
         _data.push_back(m_wall_clock->get());
         return _data;
     }
@@ -415,18 +482,18 @@ public:
     {
         set_started();
         m_wall_clock->start();
-        m_papi_vector->start();
-        value = value_type{ m_papi_vector->get_value(), m_wall_clock->get_value() };
+        m_hw_counter->start();
+        value = value_type{ m_hw_counter->get_value(), m_wall_clock->get_value() };
     }
 
     //----------------------------------------------------------------------------------//
 
     void stop()
     {
-        m_papi_vector->stop();
+        m_hw_counter->stop();
         m_wall_clock->stop();
-        value = value_type{ m_papi_vector->get_value(), m_wall_clock->get_value() };
-        accum += value_type{ m_papi_vector->get_accum(), m_wall_clock->get_accum() };
+        value = value_type{ m_hw_counter->get_value(), m_wall_clock->get_value() };
+        accum += value_type{ m_hw_counter->get_accum(), m_wall_clock->get_accum() };
         set_stopped();
     }
 
@@ -555,7 +622,7 @@ public:
 
         ar(cereal::make_nvp("is_transient", is_transient), cereal::make_nvp("laps", laps),
            cereal::make_nvp("labels", labels),
-           cereal::make_nvp("papi_vector", m_papi_vector));
+           cereal::make_nvp(hw_counter_name(), m_hw_counter));
         ar(cereal::make_nvp("value", value));
         ar(cereal::make_nvp("accum", accum));
     }
@@ -573,7 +640,7 @@ public:
            cereal::make_nvp("mode", get_mode_string()),
            cereal::make_nvp("type", get_type_string()),
            cereal::make_nvp("labels", labels),
-           cereal::make_nvp("papi_vector", m_papi_vector));
+           cereal::make_nvp(hw_counter_name(), m_hw_counter));
 
         auto data = get();
         ar.setNextName("repr_data");
@@ -595,7 +662,7 @@ public:
     //
     strvec_t label_array() const
     {
-        strvec_t arr = m_papi_vector->label_array();
+        strvec_t arr = m_hw_counter->label_array();
         arr.push_back("Runtime");
         return arr;
     }
@@ -605,7 +672,7 @@ public:
     //
     strvec_t description_array() const
     {
-        strvec_t arr = m_papi_vector->description_array();
+        strvec_t arr = m_hw_counter->description_array();
         arr.push_back("Runtime");
         return arr;
     }
@@ -614,7 +681,7 @@ public:
     //
     strvec_t display_unit_array() const
     {
-        strvec_t arr = m_papi_vector->display_unit_array();
+        strvec_t arr = m_hw_counter->display_unit_array();
         arr.push_back(count_type::get_display_unit());
         return arr;
     }
@@ -624,7 +691,7 @@ public:
     //
     std::vector<int64_t> unit_array() const
     {
-        auto arr = m_papi_vector->unit_array();
+        auto arr = m_hw_counter->unit_array();
         arr.push_back(count_type::get_unit());
         return arr;
     }
@@ -633,8 +700,8 @@ private:
     //----------------------------------------------------------------------------------//
     // these are needed after the global label array is destroyed
     //
-    std::shared_ptr<papi_vector> m_papi_vector{ nullptr };
-    std::shared_ptr<wall_clock>  m_wall_clock{ nullptr };
+    std::shared_ptr<hw_counter_type> m_hw_counter{ nullptr };
+    std::shared_ptr<wall_clock>      m_wall_clock{ nullptr };
 
 public:
     //----------------------------------------------------------------------------------//
@@ -649,6 +716,12 @@ private:
         static thread_local bool _instance = false;
         return _instance;
     }
+
+    static const char* hw_counter_name()
+    {
+        return (std::is_same<hw_counter_type, papi_vector>::value) ? "papi_vector"
+                                                                   : "perf_counters";
+    }
 };
 
 //--------------------------------------------------------------------------------------//
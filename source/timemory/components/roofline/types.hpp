@@ -69,9 +69,9 @@ TIMEMORY_VARIADIC_STATISTICS_TYPE(component::gpu_roofline, std::vector<double>,
 //
 //--------------------------------------------------------------------------------------//
 //
-//      PAPI
+//      PAPI or perf_event_open
 //
-#if !defined(TIMEMORY_USE_PAPI)
+#if !defined(TIMEMORY_USE_PAPI) && !defined(_LINUX)
 TIMEMORY_DEFINE_VARIADIC_TRAIT(is_available, component::cpu_roofline, false_type,
                                typename)
 TIMEMORY_DEFINE_CONCRETE_TRAIT(is_available, component::cpu_roofline_flops, false_type)
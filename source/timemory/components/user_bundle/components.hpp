@@ -295,7 +295,7 @@ public:
             {
                 if(itr > 0 && contains(itr, get_typeids()))
                 {
-                    if(settings::verbose() > 1)
+                    if(settings::hot().verbose > 1)
                         PRINT_HERE("Skipping duplicate typeid: %lu", (unsigned long) itr);
                     return;
                 }
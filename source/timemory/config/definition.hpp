@@ -36,10 +36,13 @@
 #if defined(TIMEMORY_CONFIG_SOURCE) ||                                                   \
     (!defined(TIMEMORY_USE_EXTERN) && !defined(TIMEMORY_USE_CONFIG_EXTERN))
 //
+#    include "timemory/backends/dmp.hpp"
 #    include "timemory/backends/process.hpp"
 #    include "timemory/manager/declaration.hpp"
 #    include "timemory/mpl/filters.hpp"
 #    include "timemory/settings/declaration.hpp"
+#    include "timemory/utility/checkpoint.hpp"
+#    include "timemory/utility/live_server.hpp"
 #    include "timemory/utility/signals.hpp"
 #    include "timemory/utility/utility.hpp"
 //
@@ -108,6 +111,28 @@ timemory_init(int argc, char** argv, const std::string& _prefix,
         enable_signal_detection(enabled_signals);
     }
 
+#    if !defined(_WINDOWS)
+    if(!settings::live_socket().empty())
+    {
+        // every rank serves its own call-graphs
+        auto _path = settings::live_socket();
+        if(dmp::is_initialized() && dmp::size() > 1)
+            _path += "." + std::to_string(dmp::rank());
+        if(settings::debug())
+            PRINT_HERE("starting live server on '%s'", _path.c_str());
+        live::server::instance().start(_path);
+    }
+#    endif
+
+    if(settings::checkpoint_interval() > 0 || settings::checkpoint_signal() > 0)
+    {
+        auto _fname = settings::compose_output_filename("checkpoint", ".ckpt");
+        if(settings::debug())
+            PRINT_HERE("writing checkpoints to '%s'", _fname.c_str());
+        checkpoint::writer::instance().start(_fname, settings::checkpoint_interval(),
+                                             settings::checkpoint_signal());
+    }
+
     settings::store_command_line(argc, argv);
 
     auto _manager = manager::instance();
@@ -168,6 +193,17 @@ timemory_finalize()
         disable_signal_detection();
     }
 
+#    if !defined(_WINDOWS)
+    if(settings::debug())
+        PRINT_HERE("%s", "stopping live server");
+    live::server::instance().stop();
+#    endif
+
+    // the final checkpoint is written before the storage is finalized
+    if(settings::debug())
+        PRINT_HERE("%s", "stopping checkpoints");
+    checkpoint::writer::instance().stop();
+
     if(settings::debug())
         PRINT_HERE("%s", "finalizing manager");
 
@@ -32,13 +32,23 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdio>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <set>
 #include <string>
+#include <type_traits>
 #include <vector>
 
+#if defined(__has_include)
+#    if __has_include(<charconv>) && (__cplusplus >= 201703L)
+#        include <charconv>
+#    endif
+#endif
+
 #include "timemory/mpl/types.hpp"
 #include "timemory/settings/declaration.hpp"
 #include "timemory/utility/types.hpp"
@@ -50,6 +60,159 @@ namespace utility
 {
 namespace base
 {
+//--------------------------------------------------------------------------------------//
+//
+//  The format_number overloads write a value into a fixed buffer the same way as a
+//  std::stringstream with the given flags and precision (in the classic locale) and
+//  return the number of characters written. Zero is returned when the combination of
+//  type and flags is not handled and the value has to go through a std::stringstream.
+//
+//--------------------------------------------------------------------------------------//
+
+template <typename Tp>
+using is_stream_character_t = std::integral_constant<
+    bool, std::is_same<Tp, char>::value || std::is_same<Tp, signed char>::value ||
+              std::is_same<Tp, unsigned char>::value ||
+              std::is_same<Tp, wchar_t>::value || std::is_same<Tp, char16_t>::value ||
+              std::is_same<Tp, char32_t>::value>;
+
+template <typename Tp>
+using is_stream_integer_t =
+    std::integral_constant<bool, std::is_integral<Tp>::value &&
+                                     !std::is_same<Tp, bool>::value &&
+                                     !is_stream_character_t<Tp>::value>;
+
+template <typename Tp>
+using is_stream_floating_t =
+    std::integral_constant<bool, std::is_same<Tp, float>::value ||
+                                     std::is_same<Tp, double>::value>;
+
+//--------------------------------------------------------------------------------------//
+
+template <typename Tp>
+inline bool
+is_negative(Tp _val, std::true_type)
+{
+    return _val < 0;
+}
+
+template <typename Tp>
+inline bool
+is_negative(Tp, std::false_type)
+{
+    return false;
+}
+
+//--------------------------------------------------------------------------------------//
+
+template <typename Tp, enable_if_t<is_stream_integer_t<Tp>::value, int> = 0>
+size_t
+format_number(char* _buf, size_t _len, Tp _val, std::ios_base::fmtflags _fmt, int)
+{
+    using ios_t      = std::ios_base;
+    using unsigned_t = typename std::make_unsigned<Tp>::type;
+
+    if((_fmt & (ios_t::hex | ios_t::oct | ios_t::showpos)) != 0)
+        return 0;
+
+    // the magnitude is negated in the unsigned type so the minimum value is valid
+    bool       _neg = is_negative(_val, std::is_signed<Tp>{});
+    unsigned_t _mag = static_cast<unsigned_t>(_val);
+    if(_neg)
+        _mag = static_cast<unsigned_t>(unsigned_t{ 0 } - _mag);
+
+    char  _tmp[std::numeric_limits<unsigned_t>::digits10 + 2];
+    char* _end = _tmp + sizeof(_tmp);
+    char* _pos = _end;
+    do
+    {
+        *--_pos = static_cast<char>('0' + (_mag % 10));
+        _mag    = static_cast<unsigned_t>(_mag / 10);
+    } while(_mag != 0);
+
+    if(_neg)
+        *--_pos = '-';
+
+    auto _n = static_cast<size_t>(_end - _pos);
+    if(_n > _len)
+        return 0;
+    std::memcpy(_buf, _pos, _n);
+    return _n;
+}
+
+//--------------------------------------------------------------------------------------//
+
+inline size_t
+format_number(char* _buf, size_t _len, bool _val, std::ios_base::fmtflags _fmt, int)
+{
+    if(_len < 1 || (_fmt & (std::ios_base::boolalpha | std::ios_base::showpos)) != 0)
+        return 0;
+    _buf[0] = (_val) ? '1' : '0';
+    return 1;
+}
+
+//--------------------------------------------------------------------------------------//
+//  the output of a stream is specified in terms of printf so the snprintf conversion
+//  is identical. std::to_chars is used where it produces the same characters
+//
+template <typename Tp, enable_if_t<is_stream_floating_t<Tp>::value, int> = 0>
+size_t
+format_number(char* _buf, size_t _len, Tp _val, std::ios_base::fmtflags _fmt, int _prec)
+{
+    using ios_t = std::ios_base;
+
+    auto _field = _fmt & ios_t::floatfield;
+    if(_prec < 0 || _field == ios_t::floatfield || (_fmt & ios_t::uppercase) != 0)
+        return 0;
+
+    bool _showpos   = (_fmt & ios_t::showpos) != 0;
+    bool _showpoint = (_fmt & ios_t::showpoint) != 0;
+
+#if defined(__cpp_lib_to_chars)
+    // showpoint only adds a trailing decimal point when there is no fractional part
+    if((_field == ios_t::fixed || _field == ios_t::scientific) && !_showpos &&
+       (!_showpoint || _prec > 0))
+    {
+        auto _chars = (_field == ios_t::fixed) ? std::chars_format::fixed
+                                               : std::chars_format::scientific;
+        auto _ret   = std::to_chars(_buf, _buf + _len, _val, _chars, _prec);
+        return (_ret.ec == std::errc{}) ? static_cast<size_t>(_ret.ptr - _buf) : 0;
+    }
+#endif
+
+    char  _spec[8];
+    char* _pos = _spec;
+    *_pos++    = '%';
+    if(_showpos)
+        *_pos++ = '+';
+    if(_showpoint)
+        *_pos++ = '#';
+    *_pos++ = '.';
+    *_pos++ = '*';
+    if(_field == ios_t::fixed)
+        *_pos++ = 'f';
+    else if(_field == ios_t::scientific)
+        *_pos++ = 'e';
+    else
+        *_pos++ = 'g';
+    *_pos = '\0';
+
+    auto _n = std::snprintf(_buf, _len, _spec, _prec, static_cast<double>(_val));
+    return (_n > 0 && static_cast<size_t>(_n) < _len) ? static_cast<size_t>(_n) : 0;
+}
+
+//--------------------------------------------------------------------------------------//
+
+template <typename Tp, enable_if_t<!is_stream_integer_t<Tp>::value &&
+                                       !is_stream_floating_t<Tp>::value &&
+                                       !std::is_same<Tp, bool>::value,
+                                   int> = 0>
+size_t
+format_number(char*, size_t, const Tp&, std::ios_base::fmtflags, int)
+{
+    return 0;
+}
+
 //--------------------------------------------------------------------------------------//
 //
 struct stream_entry
@@ -75,7 +238,7 @@ struct stream_entry
     stream_entry& operator=(const stream_entry&) = default;
     stream_entry& operator=(stream_entry&&) = default;
 
-    string_t get() const { return m_value; }
+    const string_t& get() const { return m_value; }
 
     bool         center() const { return m_center; }
     bool         left() const { return m_left; }
@@ -98,10 +261,30 @@ struct stream_entry
     template <typename Tp>
     void construct(const Tp& val)
     {
-        stringstream_t ss;
-        ss.setf(m_format);
-        ss << std::setprecision(m_precision) << val;
-        m_value = ss.str();
+        char _buf[128];
+        auto _n = format_number(_buf, sizeof(_buf), val, m_format, m_precision);
+        if(_n > 0)
+        {
+            m_value.assign(_buf, _n);
+        }
+        else
+        {
+            stringstream_t ss;
+            ss.setf(m_format);
+            ss << std::setprecision(m_precision) << val;
+            m_value = ss.str();
+        }
+        truncate();
+    }
+
+    void construct(const string_t& val)
+    {
+        m_value = val;
+        truncate();
+    }
+
+    void truncate()
+    {
         if(settings::max_width() > 0 && m_value.length() > (size_t) settings::max_width())
         {
             //
@@ -138,17 +321,17 @@ protected:
 
 //--------------------------------------------------------------------------------------//
 
-template <typename StreamT, typename Tp>
+//  appends the padded cell to the buffer of the table
+//
+template <typename Tp>
 static void
-write_entry(StreamT& ss, const Tp& obj)
+write_entry(std::string& _buf, const Tp& obj)
 {
-    using stringstream_t = std::stringstream;
-
-    auto itr = obj.get();
+    const auto& itr = obj.get();
+    int         _w  = obj.width();
 
     if(obj.row() == 0 || obj.center())
     {
-        int _w     = obj.width();
         int _i     = itr.length();
         int _whalf = _w / 2;
         int _ihalf = (_i + 1) / 2;
@@ -159,22 +342,24 @@ write_entry(StreamT& ss, const Tp& obj)
         // e.g. 4 leading spaces, 2 spaces at end
         if(((_wrem - itr.length()) - (_w - 2)) > 1)
             _wrem -= 1;
-        stringstream_t ssbeg;
-        ssbeg << std::setw(_wrem) << "" << itr;
-        ss << std::left << std::setw(_w - 2) << ssbeg.str();
+        _wrem = std::max<int>(_wrem, 0);
+        _buf.append(_wrem, ' ');
+        _buf.append(itr);
+        _buf.append(std::max<int>(_w - 2 - _wrem - _i, 0), ' ');
     }
     else
     {
+        int remain = _w - static_cast<int>(itr.length()) - 2;
+        remain     = std::max<int>(remain, 0);
         if(obj.column() == 0 || obj.left())
         {
-            stringstream_t _ss;
-            _ss << std::left << itr;
-            int remain = obj.width() - _ss.str().length() - 2;
-            ss << _ss.str() << std::setw(remain) << "";
+            _buf.append(itr);
+            _buf.append(remain, ' ');
         }
         else
         {
-            ss << std::right << std::setw(obj.width() - 2) << itr;
+            _buf.append(remain, ' ');
+            _buf.append(itr);
         }
     }
 }
@@ -206,7 +391,7 @@ struct header : base::stream_entry
                     bool _center = true)
     : base::stream_entry(0, -1, _fmt, _width, _prec, _center)
     {
-        base::stream_entry::construct(std::forward<Tp>(_val));
+        base::stream_entry::construct(_val);
     }
 };
 
@@ -322,8 +507,8 @@ public:
     void delim(char v) { m_delim = v; }
     void setf(format_flags v) { m_format = v; }
 
-    void set_name(string_t v) { m_name = v; }
-    void set_banner(string_t v) { m_banner = v; }
+    void set_name(string_t v) { m_name = std::move(v); }
+    void set_banner(string_t v) { m_banner = std::move(v); }
 
     static int64_t index(const string_t& _val, const vector_t<string_t>& _obj)
     {
@@ -401,7 +586,7 @@ public:
         _hdr.center(true);
         _hdr.row(0);
         _hdr.column(_n);
-        m_headers[_h].second.push_back(_hdr);
+        m_headers[_h].second.push_back(std::move(_hdr));
     }
 
     void operator()(entry _obj)
@@ -423,10 +608,14 @@ public:
         _obj.center(false);
         _obj.row(m_rows + 1);
         _obj.column(m_cols);
-        m_entries[_r].second.push_back(_obj);
+        m_entries[_r].second.push_back(std::move(_obj));
         ++m_cols;
     }
 
+    /// \fn operator<<(std::ostream&, const stream&)
+    /// \brief the table is rendered into a string which is handed to the stream in
+    /// large blocks so that writing to a file does not go through a formatted insertion
+    /// and a temporary stringstream per cell
     friend std::ostream& operator<<(std::ostream& os, const stream& obj)
     {
         // return if completely empty
@@ -437,109 +626,137 @@ public:
         if(obj.m_entries.empty())
             return os;
 
-        stringstream_t       ss;
-        map_t<string_t, int> offset;
+        constexpr size_t buffer_size = 64 * 1024;
+
+        // the header and entry columns of every position in the order, the counter of
+        // the key at the position and whether the line breaks after the position are
+        // resolved once instead of once per cell
+        size_t             _norder = obj.m_order.size();
+        vector_t<int64_t>  _hidx(_norder, -1);
+        vector_t<int64_t>  _eidx(_norder, -1);
+        vector_t<int64_t>  _kidx(_norder, -1);
+        vector_t<bool>     _breaks(_norder, false);
+        vector_t<string_t> _keys{};
+        vector_t<int64_t>  _offset{};
+        string_t           _buf{};
+        stringstream_t     _banner{};
+        stringstream_t     _outer{};
+        stringstream_t     _inner{};
+
+        for(size_t i = 0; i < _norder; ++i)
+        {
+            const auto& _key = obj.m_order.at(i);
+            _hidx[i]         = index(_key, obj.m_headers);
+            _eidx[i]         = index(_key, obj.m_entries);
+            _kidx[i]         = index(_key, _keys);
+            _breaks[i]       = obj.m_break.count((int) i + 1) > 0;
+            if(_kidx[i] < 0)
+            {
+                _kidx[i] = _keys.size();
+                _keys.push_back(_key);
+            }
+        }
 
-        obj.write_banner(ss);
+        obj.write_banner(_banner);
+        obj.write_separator(_outer, '-');
+        obj.write_separator(_inner, obj.m_delim);
 
-        obj.write_separator(ss, '-');
+        const string_t _outer_sep = _outer.str();
+        const string_t _inner_sep = _inner.str();
 
-        int64_t norder_col = 0;
-        for(const auto& itr : obj.m_order)
-        {
-            int64_t col = ++norder_col;
+        auto _flush = [&]() {
+            os.write(_buf.data(), _buf.size());
+            _buf.clear();
+        };
 
-            stringstream_t _ss;
-            auto           _key    = itr;
-            auto           _offset = offset[_key]++;
-            auto           _idx    = index(_key, obj.m_headers);
-            if(_idx < 0 ||
-               (_idx >= 0 && !(_offset < (int) obj.m_headers[_idx].second.size())))
-            {
+        _buf.reserve(buffer_size + 4096);
+        _buf.append(_banner.str());
+        _buf.append(_outer_sep);
+
+        _offset.assign(_keys.size(), 0);
+        for(size_t i = 0; i < _norder; ++i)
+        {
+            auto _off = _offset[_kidx[i]]++;
+            auto _idx = _hidx[i];
+            if(_idx < 0 || !(_off < (int64_t) obj.m_headers[_idx].second.size()))
                 throw std::runtime_error("Error! indexing issue!");
-            }
-            else
-            {
-                const auto& hitr = obj.m_headers[_idx].second.at(_offset);
-                base::write_entry(_ss, hitr);
-            }
-            ss << obj.delim() << ' ' << _ss.str() << ' ';
 
-            if(obj.m_break.count(col) > 0)
+            _buf += obj.m_delim;
+            _buf += ' ';
+            base::write_entry(_buf, obj.m_headers[_idx].second[_off]);
+            _buf += ' ';
+
+            if(_breaks[i])
                 break;
         }
 
         // end the line
-        ss << obj.delim() << '\n';
-
-        obj.write_separator(ss, obj.m_delim);
-
-        auto write_empty = [&](stringstream_t& _ss, int64_t _hidx, int64_t _offset) {
-            const auto& _hitr  = obj.m_headers[_hidx].second;
-            auto        _hsize = _hitr.size();
-            const auto& _hdr   = _hitr.at(_offset % _hsize);
-            _ss << obj.delim() << ' ' << std::setw(_hdr.width() - 2) << "" << ' ';
-        };
-
-        offset.clear();
+        _buf += obj.m_delim;
+        _buf += '\n';
+        _buf.append(_inner_sep);
 
+        _offset.assign(_keys.size(), 0);
         for(int i = 0; i < obj.m_rows; ++i)
         {
             bool just_broke = false;
-            norder_col      = 0;
-            for(const auto& itr : obj.m_order)
+            for(size_t j = 0; j < _norder; ++j)
             {
-                just_broke  = false;
-                int64_t col = ++norder_col;
-
-                stringstream_t _ss;
-                auto           _key    = itr;
-                auto           _offset = offset[_key]++;
+                just_broke = false;
+                auto _off  = _offset[_kidx[j]]++;
 
-                auto _hidx = index(_key, obj.m_headers);
-                auto _eidx = index(_key, obj.m_entries);
-
-                if(_eidx < 0 && _hidx >= 0)
+                if(_eidx[j] < 0 && _hidx[j] >= 0)
                 {
-                    write_empty(ss, _hidx, _offset);
+                    obj.write_empty(_buf, _hidx[j], _off);
                 }
                 else
                 {
-                    assert(_hidx >= 0);
-                    assert(_eidx >= 0);
-
-                    const auto& _eitr  = obj.m_entries[_eidx].second;
-                    auto        _esize = _eitr.size();
-                    const auto& _itr   = _eitr.at(_offset % _esize);
-
-                    base::write_entry(_ss, _itr);
-                    ss << obj.delim() << ' ' << _ss.str() << ' ';
+                    assert(_hidx[j] >= 0);
+                    assert(_eidx[j] >= 0);
+
+                    const auto& _eitr = obj.m_entries[_eidx[j]].second;
+                    _buf += obj.m_delim;
+                    _buf += ' ';
+                    base::write_entry(_buf, _eitr[_off % _eitr.size()]);
+                    _buf += ' ';
                 }
 
-                // printf("column: %i, order size: %i, count: %i\n", col,
-                // obj.m_order.size(),
-                //       obj.m_break.count(col));
-                if(col < (int64_t) obj.m_order.size() && obj.m_break.count(col) > 0)
+                if(j + 1 < _norder && _breaks[j])
                 {
-                    ss << obj.m_delim << '\n';
+                    _buf += obj.m_delim;
+                    _buf += '\n';
                     just_broke = true;
-                    for(auto j = obj.m_prefix_begin; j < obj.m_prefix_end; ++j)
-                        write_empty(ss, j, 0);
+                    for(auto k = obj.m_prefix_begin; k < obj.m_prefix_end; ++k)
+                        obj.write_empty(_buf, k, 0);
                 }
             }
             if(!just_broke)
-                ss << obj.m_delim << '\n';
+            {
+                _buf += obj.m_delim;
+                _buf += '\n';
+            }
 
             if((i + 1) < obj.m_rows && (i % 10) == 9)
-                obj.write_separator(ss, obj.m_delim);
-        }
+                _buf.append(_inner_sep);
 
-        obj.write_separator(ss, '-');
+            if(_buf.size() >= buffer_size)
+                _flush();
+        }
 
-        os << ss.str();
+        _buf.append(_outer_sep);
+        _flush();
         return os;
     }
 
+    void write_empty(string_t& _buf, int64_t _hidx, int64_t _offset) const
+    {
+        const auto& _hitr = m_headers[_hidx].second;
+        const auto& _hdr  = _hitr.at(_offset % _hitr.size());
+        _buf += m_delim;
+        _buf += ' ';
+        _buf.append(std::max<int>(_hdr.width() - 2, 0), ' ');
+        _buf += ' ';
+    }
+
     template <typename StreamT>
     void write_separator(StreamT& os, char _delim) const
     {
@@ -60,7 +60,7 @@
 /// \brief The number of enumerated components defined by timemory
 //
 #if !defined(TIMEMORY_NATIVE_COMPONENT_ENUM_SIZE)
-#    define TIMEMORY_NATIVE_COMPONENT_ENUM_SIZE 64
+#    define TIMEMORY_NATIVE_COMPONENT_ENUM_SIZE 96
 #endif
 //
 /// \enum TIMEMORY_NATIVE_COMPONENT
@@ -94,9 +94,11 @@ enum TIMEMORY_NATIVE_COMPONENT
     GPU_ROOFLINE_FLOPS,
     GPU_ROOFLINE_HP_FLOPS,
     GPU_ROOFLINE_SP_FLOPS,
+    IO_GOTCHA,
     KERNEL_MODE_TIME,
     LIKWID_MARKER,
     LIKWID_NVMARKER,
+    LOCK_GOTCHA,
     MALLOC_GOTCHA,
     MONOTONIC_CLOCK,
     MONOTONIC_RAW_CLOCK,
@@ -104,12 +106,14 @@ enum TIMEMORY_NATIVE_COMPONENT
     NUM_IO_OUT,
     NUM_MAJOR_PAGE_FAULTS,
     NUM_MINOR_PAGE_FAULTS,
+    NUMA_LOCALITY,
     NVTX_MARKER,
     OMPT_HANDLE,
     PAGE_RSS,
     PAPI_ARRAY,
     PAPI_VECTOR,
     PEAK_RSS,
+    PERF_COUNTERS,
     PRIORITY_CONTEXT_SWITCH,
     PROCESS_CPU_CLOCK,
     PROCESS_CPU_UTIL,
@@ -133,10 +137,17 @@ enum TIMEMORY_NATIVE_COMPONENT
     VTUNE_PROFILER,
     WALL_CLOCK,
     WRITTEN_BYTES,
+    TIMEMORY_NATIVE_COMPONENTS_END,
     TIMEMORY_USER_COMPONENT_ENUM TIMEMORY_COMPONENTS_END =
         (TIMEMORY_NATIVE_COMPONENT_ENUM_SIZE + TIMEMORY_USER_COMPONENT_ENUM_SIZE)
 };
 //
+#if defined(__cplusplus)
+static_assert(TIMEMORY_NATIVE_COMPONENTS_END <= TIMEMORY_NATIVE_COMPONENT_ENUM_SIZE,
+              "The native components overlap the user component enumerations. "
+              "Increase TIMEMORY_NATIVE_COMPONENT_ENUM_SIZE");
+#endif
+//
 //--------------------------------------------------------------------------------------//
 //
 typedef int TIMEMORY_COMPONENT;
@@ -0,0 +1,360 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/** \file timemory/ert/cache.hpp
+ * \headerfile timemory/ert/cache.hpp "timemory/ert/cache.hpp"
+ * Provides a persistent (on-disk) cache of the ERT results. The results are keyed by
+ * the CPU model, the number of cores, the frequency governor, the compiler, and the
+ * parameters of the ERT executors so that repeated runs on the same hardware do not
+ * need to re-run the roofline sweep
+ *
+ */
+
+#pragma once
+
+#include "timemory/backends/dmp.hpp"
+#include "timemory/backends/process.hpp"
+#include "timemory/environment/declaration.hpp"
+#include "timemory/settings/declaration.hpp"
+#include "timemory/utility/macros.hpp"
+#include "timemory/utility/serializer.hpp"
+#include "timemory/utility/utility.hpp"
+#include "timemory/version.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+
+#if defined(_MACOS)
+#    include <sys/sysctl.h>
+#endif
+
+namespace tim
+{
+namespace ert
+{
+namespace cache
+{
+//--------------------------------------------------------------------------------------//
+//  the CPU model, e.g. "Intel(R) Xeon(R) Gold 6148 CPU @ 2.40GHz"
+//
+inline std::string
+get_cpu_model()
+{
+#if defined(_LINUX)
+    std::ifstream ifs("/proc/cpuinfo");
+    std::string   _line;
+    while(ifs && std::getline(ifs, _line))
+    {
+        // x86 uses "model name", some ARM/POWER kernels only provide "cpu"
+        if(_line.find("model name") == 0 || _line.find("cpu\t") == 0)
+        {
+            auto _pos = _line.find(':');
+            if(_pos != std::string::npos && _pos + 2 <= _line.length())
+                return _line.substr(_pos + 2);
+        }
+    }
+#elif defined(_MACOS)
+    char   _buffer[256];
+    size_t _size = sizeof(_buffer);
+    if(sysctlbyname("machdep.cpu.brand_string", &_buffer, &_size, nullptr, 0) == 0)
+        return std::string(_buffer);
+#endif
+    return "unknown";
+}
+
+//--------------------------------------------------------------------------------------//
+//  the cpu frequency scaling governor, e.g. "performance" or "powersave"
+//
+inline std::string
+get_cpu_governor()
+{
+#if defined(_LINUX)
+    std::ifstream ifs("/sys/devices/system/cpu/cpu0/cpufreq/scaling_governor");
+    std::string   _governor;
+    if(ifs && (ifs >> _governor))
+        return _governor;
+#endif
+    return "none";
+}
+
+//--------------------------------------------------------------------------------------//
+//  the compiler and the code-generation relevant flags of the translation unit which
+//  instantiates the ERT kernels
+//
+inline std::string
+get_compiler()
+{
+    std::stringstream ss;
+#if defined(__VERSION__)
+    ss << __VERSION__;
+#elif defined(_MSC_FULL_VER)
+    ss << "msvc " << _MSC_FULL_VER;
+#else
+    ss << "unknown";
+#endif
+#if defined(__OPTIMIZE__)
+    ss << " optimize";
+#endif
+#if defined(__FAST_MATH__)
+    ss << " fast-math";
+#endif
+#if defined(__FMA__)
+    ss << " fma";
+#endif
+#if defined(__AVX512F__)
+    ss << " avx512f";
+#endif
+#if defined(__AVX2__)
+    ss << " avx2";
+#endif
+#if defined(__AVX__)
+    ss << " avx";
+#endif
+#if defined(__ARM_NEON)
+    ss << " neon";
+#endif
+    return ss.str();
+}
+
+//--------------------------------------------------------------------------------------//
+//  the key of a cache entry
+//
+struct signature
+{
+    std::string cpu_model = get_cpu_model();
+    uint64_t    num_cores = std::thread::hardware_concurrency();
+    std::string governor  = get_cpu_governor();
+    std::string compiler  = get_compiler();
+    std::string version   = TIMEMORY_VERSION_STRING;
+    std::string executors = "";
+
+    explicit signature(std::string _executors)
+    : executors(std::move(_executors))
+    {}
+
+    signature()                 = default;
+    ~signature()                = default;
+    signature(const signature&) = default;
+    signature(signature&&)      = default;
+    signature& operator=(const signature&) = default;
+    signature& operator=(signature&&) = default;
+
+    std::string str() const
+    {
+        std::stringstream ss;
+        ss << "cpu_model = " << cpu_model << ", num_cores = " << num_cores
+           << ", governor = " << governor << ", compiler = " << compiler
+           << ", version = " << version << ", executors = " << executors;
+        return ss.str();
+    }
+
+    size_t hash() const { return std::hash<std::string>{}(str()); }
+
+    friend bool operator==(const signature& lhs, const signature& rhs)
+    {
+        return lhs.str() == rhs.str();
+    }
+
+    friend bool operator!=(const signature& lhs, const signature& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template <typename Archive>
+    void serialize(Archive& ar, const unsigned int)
+    {
+        ar(cereal::make_nvp("cpu_model", cpu_model),
+           cereal::make_nvp("num_cores", num_cores),
+           cereal::make_nvp("governor", governor), cereal::make_nvp("compiler", compiler),
+           cereal::make_nvp("version", version),
+           cereal::make_nvp("executors", executors));
+    }
+};
+
+//--------------------------------------------------------------------------------------//
+//  describes where the ERT results came from. This is written alongside the roofline
+//  data so that results from a stale cache can be identified in the output
+//
+struct info
+{
+    bool        enabled   = false;  // the cache was consulted
+    bool        loaded    = false;  // the results were loaded from the cache
+    bool        stale     = false;  // the cached results are older than max-age
+    bool        refreshed = false;  // the ERT was re-run and the cache was written
+    int64_t     timestamp = 0;      // time (seconds since epoch) the ERT was run
+    int64_t     age       = 0;      // age (in seconds) of the cached results
+    std::string filename  = "";
+
+    template <typename Archive>
+    void serialize(Archive& ar, const unsigned int)
+    {
+        ar(cereal::make_nvp("enabled", enabled), cereal::make_nvp("loaded", loaded),
+           cereal::make_nvp("stale", stale), cereal::make_nvp("refreshed", refreshed),
+           cereal::make_nvp("timestamp", timestamp), cereal::make_nvp("age", age),
+           cereal::make_nvp("filename", filename));
+    }
+};
+
+//--------------------------------------------------------------------------------------//
+
+inline int64_t
+get_timestamp()
+{
+    using clock_type = std::chrono::system_clock;
+    return std::chrono::duration_cast<std::chrono::seconds>(
+               clock_type::now().time_since_epoch())
+        .count();
+}
+
+//--------------------------------------------------------------------------------------//
+
+inline std::string
+get_directory()
+{
+    if(!settings::ert_cache_path().empty())
+        return settings::ert_cache_path();
+    auto _xdg = get_env<std::string>("XDG_CACHE_HOME", "");
+    if(!_xdg.empty())
+        return _xdg + "/timemory";
+    auto _home = get_env<std::string>("HOME", "");
+    if(!_home.empty())
+        return _home + "/.cache/timemory";
+    return settings::output_path();
+}
+
+//--------------------------------------------------------------------------------------//
+
+inline std::string
+get_filename(const signature& _sig)
+{
+    std::stringstream ss;
+    ss << get_directory() << "/ert-" << std::hex << std::setw(16) << std::setfill('0')
+       << _sig.hash() << ".json";
+    return ss.str();
+}
+
+//--------------------------------------------------------------------------------------//
+/// load the ERT results for the given signature. Returns false if the cache does not
+/// exist or was generated with a different signature
+///
+template <typename DataT>
+bool
+load(const signature& _sig, DataT& _data, info& _info)
+{
+    _info.enabled  = true;
+    _info.filename = get_filename(_sig);
+
+    std::ifstream ifs(_info.filename.c_str());
+    if(!ifs)
+        return false;
+
+    signature _cached{};
+    DataT     _cached_data{};
+    try
+    {
+        cereal::JSONInputArchive ia(ifs);
+        ia(cereal::make_nvp("signature", _cached));
+        // hash collision or a different library version
+        if(_cached != _sig)
+            return false;
+        ia(cereal::make_nvp("timestamp", _info.timestamp));
+        ia(cereal::make_nvp("roofline", _cached_data));
+    } catch(std::exception& e)
+    {
+        if(settings::verbose() > 0 || settings::debug())
+            fprintf(stderr, "[ert::cache]> Error reading '%s': %s\n",
+                    _info.filename.c_str(), e.what());
+        return false;
+    }
+
+    auto _max_age = static_cast<int64_t>(settings::ert_cache_max_age());
+    _info.loaded  = true;
+    _info.age     = get_timestamp() - _info.timestamp;
+    _info.stale   = (_max_age > 0 && _info.age > _max_age);
+    _data         = std::move(_cached_data);
+    return true;
+}
+
+//--------------------------------------------------------------------------------------//
+/// store the ERT results for the given signature. The results are written to a
+/// temporary file and then renamed so that concurrent jobs never read a partial file
+///
+template <typename DataT>
+bool
+store(const signature& _sig, const DataT& _data, info& _info)
+{
+    _info.enabled   = true;
+    _info.refreshed = true;
+    _info.loaded    = false;
+    _info.stale     = false;
+    _info.age       = 0;
+    _info.timestamp = get_timestamp();
+    _info.filename  = get_filename(_sig);
+
+    // the results are identical across ranks so only the first rank writes the cache
+    if(dmp::rank() > 0)
+        return false;
+
+    makedir(get_directory());
+
+    std::stringstream _tmp;
+    _tmp << _info.filename << ".tmp." << process::get_id();
+    {
+        std::ofstream ofs(_tmp.str().c_str());
+        if(!ofs)
+        {
+            if(settings::verbose() > 0 || settings::debug())
+                fprintf(stderr, "[ert::cache]> Unable to open '%s' for writing\n",
+                        _tmp.str().c_str());
+            return false;
+        }
+        auto space = cereal::JSONOutputArchive::Options::IndentChar::space;
+        cereal::JSONOutputArchive::Options opt(16, space, 2);
+        cereal::JSONOutputArchive          oa(ofs, opt);
+        oa(cereal::make_nvp("signature", _sig));
+        oa(cereal::make_nvp("timestamp", _info.timestamp));
+        oa(cereal::make_nvp("roofline", _data));
+    }
+
+    if(std::rename(_tmp.str().c_str(), _info.filename.c_str()) != 0)
+    {
+        std::remove(_tmp.str().c_str());
+        return false;
+    }
+    return true;
+}
+
+//--------------------------------------------------------------------------------------//
+
+}  // namespace cache
+}  // namespace ert
+}  // namespace tim
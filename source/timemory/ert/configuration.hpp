@@ -43,6 +43,9 @@
 
 #include <cstdint>
 #include <functional>
+#include <set>
+#include <sstream>
+#include <string>
 
 // default vectorization width
 #if !defined(TIMEMORY_VEC)
@@ -53,6 +56,11 @@
 #    define TIMEMORY_USER_ERT_FLOPS
 #endif
 
+#if !defined(TIMEMORY_ERT_STRINGIZE)
+#    define TIMEMORY_ERT_STRINGIZE(...) TIMEMORY_ERT_STRINGIZE_IMPL(__VA_ARGS__)
+#    define TIMEMORY_ERT_STRINGIZE_IMPL(...) #__VA_ARGS__
+#endif
+
 namespace tim
 {
 namespace ert
@@ -170,6 +178,35 @@ struct configuration
         return _instance;
     }
 
+    //----------------------------------------------------------------------------------//
+    /// string identifying the parameters of the executor (used by the ERT cache)
+    static std::string get_signature()
+    {
+        auto _skip_ops = get_skip_ops()();
+        auto _isa      = simd::get_isa();
+        if(!settings::ert_simd_isa().empty() &&
+           simd::is_available(simd::from_string(settings::ert_simd_isa())))
+            _isa = simd::from_string(settings::ert_simd_isa());
+
+        std::stringstream ss;
+        ss << "[device = " << ((device::is_gpu<DeviceT>::value) ? "gpu" : "cpu")
+           << ", dtype = " << demangle(typeid(Tp).name())
+           << ", counter = " << demangle(typeid(CounterT).name())
+           << ", working-set = " << get_min_working_size()()
+           << ", max-size = " << get_max_data_size()()
+           << ", num-thread = " << get_num_threads()()
+           << ", num-stream = " << get_num_streams()()
+           << ", grid-size = " << get_grid_size()()
+           << ", block-size = " << get_block_size()()
+           << ", align-size = " << get_alignment()() << ", skip-ops = {";
+        for(const auto& itr : std::set<size_t>(_skip_ops.begin(), _skip_ops.end()))
+            ss << " " << itr;
+        ss << " }, simd-isa = " << simd::get_isa_name(_isa) << ", vec = " << TIMEMORY_VEC
+           << ", user-flops = {" << TIMEMORY_ERT_STRINGIZE(TIMEMORY_USER_ERT_FLOPS)
+           << "}]";
+        return ss.str();
+    }
+
     //----------------------------------------------------------------------------------//
     /// configure the number of threads, number of streams, block size, grid size, and
     /// alignment
@@ -232,15 +269,31 @@ struct configuration
             for(const auto& itr : _skip_ops)
                 _counter.add_skip_ops(itr);
 
+            // override the instruction set detected at runtime
+            auto _isa_name = settings::ert_simd_isa();
+            if(!_isa_name.empty())
+            {
+                auto _isa = simd::from_string(_isa_name);
+                if(simd::is_available(_isa))
+                    simd::get_isa() = _isa;
+                else
+                    fprintf(stderr,
+                            "[ert::executor]> instruction set '%s' is not available. "
+                            "Using '%s'\n",
+                            _isa_name.c_str(), simd::get_isa_name());
+            }
+
             auto dtype = demangle(typeid(Tp).name());
 
             printf(
                 "\n[ert::executor]> "
                 "working-set = %lli, max-size = %lli, num-thread = %lli, num-stream = "
                 "%lli, grid-size = %lli, block-size = %lli, align-size = %lli, data-type "
-                "= %s\n",
+                "= %s, simd-isa = %s, simd-width = %lli\n",
                 (lli) _mws_size, (lli) _max_size, (lli) _num_thread, (lli) _num_stream,
-                (lli) _grid_size, (lli) _block_size, (lli) _align_size, dtype.c_str());
+                (lli) _grid_size, (lli) _block_size, (lli) _align_size, dtype.c_str(),
+                simd::get_name<Tp, fma_op>().c_str(),
+                (lli) simd::get_width<Tp, fma_op>());
 
             return _counter;
         };
@@ -352,10 +405,12 @@ public:
         static_assert(VEC > 0, "Calculated vector size is zero");
 
         // functions
-        auto store_func = [](Tp& a, const Tp& b) { a = b; };
-        // auto mult_func  = [](Tp& a, const Tp& b, const Tp& c) { a = b * c; };
-        auto add_func = [](Tp& a, const Tp& b, const Tp& c) { a = b + c; };
-        auto fma_func = [](Tp& a, const Tp& b, const Tp& c) { a = a * b + c; };
+        // (function objects instead of lambdas so that ops_kernel can dispatch to the
+        // explicitly vectorized kernels in simd.hpp)
+        auto store_func = store_op{};
+        // auto mult_func  = mult_op{};
+        auto add_func = add_op{};
+        auto fma_func = fma_op{};
 
         // set bytes per element
         _counter.bytes_per_element = sizeof(Tp);
@@ -92,6 +92,10 @@ struct exec_params
     uint64_t block_size      = 32;
     uint64_t shmem_size      = 0;
 
+    // vectorization used by the CPU kernels
+    uint64_t    simd_width = 0;         // width (in bits) of the kernel operations
+    std::string simd_isa   = "scalar";  // instruction set of the kernel
+
     template <typename Archive>
     void serialize(Archive& ar, const unsigned int)
     {
@@ -101,7 +105,9 @@ struct exec_params
            cereal::make_nvp("nproc", nproc), cereal::make_nvp("nstreams", nstreams),
            cereal::make_nvp("grid_size", grid_size),
            cereal::make_nvp("block_size", block_size),
-           cereal::make_nvp("shmem_size", shmem_size));
+           cereal::make_nvp("shmem_size", shmem_size),
+           cereal::make_nvp("simd_width", simd_width),
+           cereal::make_nvp("simd_isa", simd_isa));
     }
 
     friend std::ostream& operator<<(std::ostream& os, const exec_params& obj)
@@ -115,7 +121,9 @@ struct exec_params
            << "nstreams = " << obj.nstreams << ", "
            << "grid_size = " << obj.grid_size << ", "
            << "block_size = " << obj.block_size << ", "
-           << "shmem_size = " << obj.shmem_size;
+           << "shmem_size = " << obj.shmem_size << ", "
+           << "simd_width = " << obj.simd_width << ", "
+           << "simd_isa = " << obj.simd_isa;
         os << ss.str();
         return os;
     }
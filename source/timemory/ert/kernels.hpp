@@ -35,6 +35,7 @@
 #include "timemory/components/cuda/backends.hpp"
 #include "timemory/ert/counter.hpp"
 #include "timemory/ert/data.hpp"
+#include "timemory/ert/simd.hpp"
 #include "timemory/mpl/apply.hpp"
 #include "timemory/settings/declaration.hpp"
 #include "timemory/utility/macros.hpp"
@@ -65,6 +66,11 @@ template <size_t Nrep, typename DeviceT, typename Intp, typename Tp, typename Op
 void
 ops_kernel(Intp ntrials, Intp nsize, Tp* A, OpsFuncT&& ops_func, StoreFuncT&& store_func)
 {
+    // use the explicitly vectorized kernel (selected at runtime) when one is available
+    if(simd::is_supported<Tp, OpsFuncT>::value &&
+       simd::fma_kernel<Nrep>(ntrials, nsize, A))
+        return;
+
     // divide by two here because macros halve, e.g. ERT_FLOP == 4 means 2 calls
     constexpr size_t NUM_REP = Nrep / 2;
     constexpr size_t MOD_REP = Nrep % 2;
@@ -236,6 +242,11 @@ ops_main(counter<DeviceT, Tp, CounterT>& _counter, OpsFuncT&& ops_func,
             }
 
             auto _itr_params = _counter.params;
+            if(!is_gpu)
+            {
+                _itr_params.simd_width = simd::get_width<Tp, OpsFuncT>();
+                _itr_params.simd_isa   = simd::get_name<Tp, OpsFuncT>();
+            }
 
             if(is_gpu)
             {
@@ -0,0 +1,468 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/** \file timemory/ert/simd.hpp
+ * \headerfile timemory/ert/simd.hpp "timemory/ert/simd.hpp"
+ * Provides explicitly vectorized CPU kernels for ERT. The instruction set is selected
+ * at runtime (cpuid) so that the peaks do not depend on the flags the application was
+ * compiled with.
+ *
+ */
+
+#pragma once
+
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#if(defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__)) && \
+    !defined(__NVCC__) && !defined(__CUDA_ARCH__) && !defined(__INTEL_COMPILER)
+#    define TIMEMORY_ERT_SIMD_X86
+#    include <immintrin.h>
+#    define TIMEMORY_ERT_SIMD_TARGET(...) __attribute__((target(__VA_ARGS__)))
+#elif defined(__aarch64__) && defined(__ARM_NEON) && !defined(__NVCC__) &&               \
+    !defined(__CUDA_ARCH__)
+#    define TIMEMORY_ERT_SIMD_NEON
+#    include <arm_neon.h>
+#endif
+
+namespace tim
+{
+namespace ert
+{
+//--------------------------------------------------------------------------------------//
+//
+//      Operations executed by the kernels. These are named types (instead of lambdas)
+//      so that the CPU kernel can recognize the FMA operation and dispatch to the
+//      vectorized implementation
+//
+//--------------------------------------------------------------------------------------//
+
+struct store_op
+{
+    template <typename Tp>
+    void operator()(Tp& a, const Tp& b) const
+    {
+        a = b;
+    }
+};
+
+struct add_op
+{
+    template <typename Tp>
+    void operator()(Tp& a, const Tp& b, const Tp& c) const
+    {
+        a = b + c;
+    }
+};
+
+struct mult_op
+{
+    template <typename Tp>
+    void operator()(Tp& a, const Tp& b, const Tp& c) const
+    {
+        a = b * c;
+    }
+};
+
+struct fma_op
+{
+    template <typename Tp>
+    void operator()(Tp& a, const Tp& b, const Tp& c) const
+    {
+        a = a * b + c;
+    }
+};
+
+namespace simd
+{
+//--------------------------------------------------------------------------------------//
+//
+//      Instruction set selection
+//
+//--------------------------------------------------------------------------------------//
+
+enum class isa : short
+{
+    scalar = 0,
+    sse    = 1,
+    avx    = 2,
+    avx2   = 3,
+    avx512 = 4,
+    neon   = 5
+};
+
+//--------------------------------------------------------------------------------------//
+/// query the CPU for the widest supported instruction set
+inline isa
+detect()
+{
+#if defined(TIMEMORY_ERT_SIMD_X86)
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512f"))
+        return isa::avx512;
+    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return isa::avx2;
+    if(__builtin_cpu_supports("avx"))
+        return isa::avx;
+    if(__builtin_cpu_supports("sse2"))
+        return isa::sse;
+    return isa::scalar;
+#elif defined(TIMEMORY_ERT_SIMD_NEON)
+    return isa::neon;
+#else
+    return isa::scalar;
+#endif
+}
+
+//--------------------------------------------------------------------------------------//
+/// returns true if the instruction set can be executed on this CPU
+inline bool
+is_available(isa _isa)
+{
+    static const isa _max = detect();
+    switch(_isa)
+    {
+        case isa::scalar: return true;
+        case isa::neon: return (_max == isa::neon);
+        case isa::sse:
+        case isa::avx:
+        case isa::avx2:
+        case isa::avx512:
+            return (_max != isa::neon && static_cast<short>(_isa) <=
+                                             static_cast<short>(_max));
+    }
+    return false;
+}
+
+//--------------------------------------------------------------------------------------//
+/// the instruction set used by the kernels (assign to override)
+inline isa&
+get_isa()
+{
+    static isa _instance = detect();
+    return _instance;
+}
+
+//--------------------------------------------------------------------------------------//
+
+inline const char*
+get_isa_name(isa _isa = get_isa())
+{
+    switch(_isa)
+    {
+        case isa::scalar: return "scalar";
+        case isa::sse: return "sse";
+        case isa::avx: return "avx";
+        case isa::avx2: return "avx2";
+        case isa::avx512: return "avx512";
+        case isa::neon: return "neon";
+    }
+    return "scalar";
+}
+
+//--------------------------------------------------------------------------------------//
+/// convert a string (e.g. from TIMEMORY_ERT_SIMD_ISA) to an instruction set. Returns
+/// the detected instruction set for an empty or unrecognized string
+inline isa
+from_string(std::string _str)
+{
+    for(auto& itr : _str)
+        itr = tolower(itr);
+    if(_str == "scalar" || _str == "none" || _str == "off")
+        return isa::scalar;
+    if(_str == "sse" || _str == "sse2")
+        return isa::sse;
+    if(_str == "avx")
+        return isa::avx;
+    if(_str == "avx2")
+        return isa::avx2;
+    if(_str == "avx512" || _str == "avx512f")
+        return isa::avx512;
+    if(_str == "neon")
+        return isa::neon;
+    return detect();
+}
+
+//--------------------------------------------------------------------------------------//
+/// width of the vector registers (in bits) for the instruction set
+inline uint64_t
+get_vector_width(isa _isa = get_isa())
+{
+    switch(_isa)
+    {
+        case isa::scalar: return 0;
+        case isa::sse: return 128;
+        case isa::avx: return 256;
+        case isa::avx2: return 256;
+        case isa::avx512: return 512;
+        case isa::neon: return 128;
+    }
+    return 0;
+}
+
+//--------------------------------------------------------------------------------------//
+/// vectorized kernels are provided for FMA on float and double
+template <typename Tp, typename OpsFuncT>
+struct is_supported
+: std::integral_constant<bool, (std::is_same<Tp, float>::value ||
+                                std::is_same<Tp, double>::value) &&
+                                   std::is_same<typename std::decay<OpsFuncT>::type,
+                                                fma_op>::value>
+{};
+
+//--------------------------------------------------------------------------------------//
+/// the width (in bits) of the operations performed by the CPU kernel for a given
+/// data type and operation
+template <typename Tp, typename OpsFuncT>
+uint64_t
+get_width()
+{
+    if(!is_supported<Tp, OpsFuncT>::value || get_isa() == isa::scalar)
+        return 8 * sizeof(Tp);
+    return get_vector_width();
+}
+
+//--------------------------------------------------------------------------------------//
+/// the instruction set used by the CPU kernel for a given data type and operation
+template <typename Tp, typename OpsFuncT>
+std::string
+get_name()
+{
+    if(!is_supported<Tp, OpsFuncT>::value)
+        return get_isa_name(isa::scalar);
+    return get_isa_name();
+}
+
+//--------------------------------------------------------------------------------------//
+//
+//      Kernel body: each iteration over the working set processes four independent
+//      vectors so that the FMA latency is hidden, then falls back to single vectors
+//      and finally a scalar remainder. The number of FMAs per element matches the
+//      scalar kernel: (Nrep / 2) + (Nrep % 2).
+//
+//--------------------------------------------------------------------------------------//
+
+#define TIMEMORY_ERT_SIMD_KERNEL_BODY(Tp, VecT, LANES, SET1, LOADU, STOREU, FMA)         \
+    constexpr size_t NUM_FMA = (Nrep / 2) + (Nrep % 2);                                  \
+    constexpr Intp   NLANES  = LANES;                                                    \
+    constexpr Intp   NBLOCK  = 4 * NLANES;                                               \
+    const Intp       nblock  = nsize - (nsize % NBLOCK);                                 \
+    const Intp       nvector = nsize - (nsize % NLANES);                                 \
+    Tp               alpha   = static_cast<Tp>(0.5);                                     \
+    for(Intp j = 0; j < ntrials; ++j)                                                    \
+    {                                                                                    \
+        const VecT valpha = SET1(alpha);                                                 \
+        Intp       i      = 0;                                                           \
+        for(; i < nblock; i += NBLOCK)                                                   \
+        {                                                                                \
+            const VecT a0 = LOADU(A + i);                                                \
+            const VecT a1 = LOADU(A + i + NLANES);                                       \
+            const VecT a2 = LOADU(A + i + 2 * NLANES);                                   \
+            const VecT a3 = LOADU(A + i + 3 * NLANES);                                   \
+            VecT       b0 = SET1(static_cast<Tp>(0.8));                                  \
+            VecT       b1 = b0;                                                          \
+            VecT       b2 = b0;                                                          \
+            VecT       b3 = b0;                                                          \
+            for(size_t k = 0; k < NUM_FMA; ++k)                                          \
+            {                                                                            \
+                b0 = FMA(b0, a0, valpha);                                                \
+                b1 = FMA(b1, a1, valpha);                                                \
+                b2 = FMA(b2, a2, valpha);                                                \
+                b3 = FMA(b3, a3, valpha);                                                \
+            }                                                                            \
+            STOREU(A + i, b0);                                                           \
+            STOREU(A + i + NLANES, b1);                                                  \
+            STOREU(A + i + 2 * NLANES, b2);                                              \
+            STOREU(A + i + 3 * NLANES, b3);                                              \
+        }                                                                                \
+        for(; i < nvector; i += NLANES)                                                  \
+        {                                                                                \
+            const VecT a0 = LOADU(A + i);                                                \
+            VecT       b0 = SET1(static_cast<Tp>(0.8));                                  \
+            for(size_t k = 0; k < NUM_FMA; ++k)                                          \
+                b0 = FMA(b0, a0, valpha);                                                \
+            STOREU(A + i, b0);                                                           \
+        }                                                                                \
+        for(; i < nsize; ++i)                                                            \
+        {                                                                                \
+            Tp beta = static_cast<Tp>(0.8);                                              \
+            for(size_t k = 0; k < NUM_FMA; ++k)                                          \
+                beta = beta * A[i] + alpha;                                              \
+            A[i] = beta;                                                                 \
+        }                                                                                \
+        alpha *= static_cast<Tp>(1.0 - 1.0e-8);                                          \
+    }
+
+namespace kernels
+{
+#if defined(TIMEMORY_ERT_SIMD_X86)
+
+// SSE2 and AVX do not provide FMA so the multiply and add are issued separately
+#    define TIMEMORY_ERT_SSE_FMA_PS(a, b, c) _mm_add_ps(_mm_mul_ps(a, b), c)
+#    define TIMEMORY_ERT_SSE_FMA_PD(a, b, c) _mm_add_pd(_mm_mul_pd(a, b), c)
+#    define TIMEMORY_ERT_AVX_FMA_PS(a, b, c) _mm256_add_ps(_mm256_mul_ps(a, b), c)
+#    define TIMEMORY_ERT_AVX_FMA_PD(a, b, c) _mm256_add_pd(_mm256_mul_pd(a, b), c)
+
+template <size_t Nrep, typename Intp>
+TIMEMORY_ERT_SIMD_TARGET("sse2")
+void sse(Intp ntrials, Intp nsize, float* A)
+{
+    TIMEMORY_ERT_SIMD_KERNEL_BODY(float, __m128, 4, _mm_set1_ps, _mm_loadu_ps,
+                                  _mm_storeu_ps, TIMEMORY_ERT_SSE_FMA_PS)
+}
+
+template <size_t Nrep, typename Intp>
+TIMEMORY_ERT_SIMD_TARGET("sse2")
+void sse(Intp ntrials, Intp nsize, double* A)
+{
+    TIMEMORY_ERT_SIMD_KERNEL_BODY(double, __m128d, 2, _mm_set1_pd, _mm_loadu_pd,
+                                  _mm_storeu_pd, TIMEMORY_ERT_SSE_FMA_PD)
+}
+
+template <size_t Nrep, typename Intp>
+TIMEMORY_ERT_SIMD_TARGET("avx")
+void avx(Intp ntrials, Intp nsize, float* A)
+{
+    TIMEMORY_ERT_SIMD_KERNEL_BODY(float, __m256, 8, _mm256_set1_ps, _mm256_loadu_ps,
+                                  _mm256_storeu_ps, TIMEMORY_ERT_AVX_FMA_PS)
+}
+
+template <size_t Nrep, typename Intp>
+TIMEMORY_ERT_SIMD_TARGET("avx")
+void avx(Intp ntrials, Intp nsize, double* A)
+{
+    TIMEMORY_ERT_SIMD_KERNEL_BODY(double, __m256d, 4, _mm256_set1_pd, _mm256_loadu_pd,
+                                  _mm256_storeu_pd, TIMEMORY_ERT_AVX_FMA_PD)
+}
+
+template <size_t Nrep, typename Intp>
+TIMEMORY_ERT_SIMD_TARGET("avx2,fma")
+void avx2(Intp ntrials, Intp nsize, float* A)
+{
+    TIMEMORY_ERT_SIMD_KERNEL_BODY(float, __m256, 8, _mm256_set1_ps, _mm256_loadu_ps,
+                                  _mm256_storeu_ps, _mm256_fmadd_ps)
+}
+
+template <size_t Nrep, typename Intp>
+TIMEMORY_ERT_SIMD_TARGET("avx2,fma")
+void avx2(Intp ntrials, Intp nsize, double* A)
+{
+    TIMEMORY_ERT_SIMD_KERNEL_BODY(double, __m256d, 4, _mm256_set1_pd, _mm256_loadu_pd,
+                                  _mm256_storeu_pd, _mm256_fmadd_pd)
+}
+
+template <size_t Nrep, typename Intp>
+TIMEMORY_ERT_SIMD_TARGET("avx512f")
+void avx512(Intp ntrials, Intp nsize, float* A)
+{
+    TIMEMORY_ERT_SIMD_KERNEL_BODY(float, __m512, 16, _mm512_set1_ps, _mm512_loadu_ps,
+                                  _mm512_storeu_ps, _mm512_fmadd_ps)
+}
+
+template <size_t Nrep, typename Intp>
+TIMEMORY_ERT_SIMD_TARGET("avx512f")
+void avx512(Intp ntrials, Intp nsize, double* A)
+{
+    TIMEMORY_ERT_SIMD_KERNEL_BODY(double, __m512d, 8, _mm512_set1_pd, _mm512_loadu_pd,
+                                  _mm512_storeu_pd, _mm512_fmadd_pd)
+}
+
+#    undef TIMEMORY_ERT_SSE_FMA_PS
+#    undef TIMEMORY_ERT_SSE_FMA_PD
+#    undef TIMEMORY_ERT_AVX_FMA_PS
+#    undef TIMEMORY_ERT_AVX_FMA_PD
+
+#elif defined(TIMEMORY_ERT_SIMD_NEON)
+
+// vfmaq computes c + a * b so reorder the arguments to match a * b + c
+#    define TIMEMORY_ERT_NEON_FMA_F32(a, b, c) vfmaq_f32(c, a, b)
+#    define TIMEMORY_ERT_NEON_FMA_F64(a, b, c) vfmaq_f64(c, a, b)
+
+template <size_t Nrep, typename Intp>
+void
+neon(Intp ntrials, Intp nsize, float* A)
+{
+    TIMEMORY_ERT_SIMD_KERNEL_BODY(float, float32x4_t, 4, vdupq_n_f32, vld1q_f32,
+                                  vst1q_f32, TIMEMORY_ERT_NEON_FMA_F32)
+}
+
+template <size_t Nrep, typename Intp>
+void
+neon(Intp ntrials, Intp nsize, double* A)
+{
+    TIMEMORY_ERT_SIMD_KERNEL_BODY(double, float64x2_t, 2, vdupq_n_f64, vld1q_f64,
+                                  vst1q_f64, TIMEMORY_ERT_NEON_FMA_F64)
+}
+
+#    undef TIMEMORY_ERT_NEON_FMA_F32
+#    undef TIMEMORY_ERT_NEON_FMA_F64
+
+#endif
+}  // namespace kernels
+
+#undef TIMEMORY_ERT_SIMD_KERNEL_BODY
+
+//--------------------------------------------------------------------------------------//
+/// execute the vectorized FMA kernel for the selected instruction set. Returns false
+/// if no vectorized kernel is available (caller should use the scalar kernel)
+template <size_t Nrep, typename Intp, typename Tp,
+          typename std::enable_if<(std::is_same<Tp, float>::value ||
+                                   std::is_same<Tp, double>::value),
+                                  int>::type = 0>
+bool
+fma_kernel(Intp ntrials, Intp nsize, Tp* A)
+{
+    switch(get_isa())
+    {
+#if defined(TIMEMORY_ERT_SIMD_X86)
+        case isa::sse: kernels::sse<Nrep>(ntrials, nsize, A); return true;
+        case isa::avx: kernels::avx<Nrep>(ntrials, nsize, A); return true;
+        case isa::avx2: kernels::avx2<Nrep>(ntrials, nsize, A); return true;
+        case isa::avx512: kernels::avx512<Nrep>(ntrials, nsize, A); return true;
+#elif defined(TIMEMORY_ERT_SIMD_NEON)
+        case isa::neon: kernels::neon<Nrep>(ntrials, nsize, A); return true;
+#endif
+        default: break;
+    }
+    return false;
+}
+
+//--------------------------------------------------------------------------------------//
+
+template <size_t Nrep, typename Intp, typename Tp,
+          typename std::enable_if<!(std::is_same<Tp, float>::value ||
+                                    std::is_same<Tp, double>::value),
+                                  int>::type = 0>
+bool
+fma_kernel(Intp, Intp, Tp*)
+{
+    return false;
+}
+
+}  // namespace simd
+}  // namespace ert
+}  // namespace tim
@@ -79,6 +79,25 @@ public:
     using finalizer_void_t = std::multimap<void*, finalizer_func_t>;
     using filemap_t        = std::map<string_t, std::map<string_t, std::set<string_t>>>;
 
+    /// \enum output_stage
+    /// \brief The stages of the output generated during finalization when
+    /// TIMEMORY_FINALIZE_THREADS > 1. The 'prepare', 'gather', and 'report' stages are
+    /// invoked serially, in the same order on every rank (they may contain MPI
+    /// collectives), and the 'convert' and 'write' stages are invoked concurrently
+    /// for the different component types
+    enum class output_stage : short
+    {
+        prepare = 0,  // merge the thread-data and invoke the finalization routines
+        convert,      // convert the call-graph into the result nodes
+        gather,       // distributed (MPI/UPC++) collection of the result nodes
+        write,        // generate the reports and write the output files
+        report        // console output, plotting, etc.
+    };
+
+    using output_func_t = std::function<void(output_stage)>;
+    using output_pair_t = std::pair<std::string, output_func_t>;
+    using output_list_t = std::deque<output_pair_t>;
+
 public:
     // Constructor and Destructors
     manager();
@@ -97,6 +116,8 @@ public:
     void add_cleanup(const std::string&, Func&&);
     template <typename StackFunc, typename FinalFunc>
     void add_finalizer(const std::string&, StackFunc&&, FinalFunc&&, bool);
+    template <typename Func>
+    void add_output_stages(const std::string&, Func&&);
     void remove_cleanup(const std::string&);
     void remove_finalizer(const std::string&);
     void cleanup(const std::string&);
@@ -234,6 +255,7 @@ protected:
 protected:
     // protected functions
     string_t get_prefix() const;
+    void     finalize_output();
 
 private:
     /// notifies that it is finalizing
@@ -257,6 +279,7 @@ private:
     finalizer_list_t       m_master_finalizers  = {};
     finalizer_list_t       m_worker_finalizers  = {};
     finalizer_void_t       m_pointer_fini       = {};
+    output_list_t          m_output_stages      = {};
     filemap_t              m_output_files       = {};
 
 private:
@@ -274,8 +297,8 @@ private:
         std::atomic<int32_t>      thread_count{ 0 };
         bool                      use_exit_hook = true;
         pointer_t                 master_instance;
-        bool&                     debug   = settings::debug();
-        int&                      verbose = settings::verbose();
+        const bool&               debug   = settings::debug();
+        const int&                verbose = settings::verbose();
         std::shared_ptr<settings> config  = settings::shared_instance<TIMEMORY_API>();
     };
 
@@ -369,6 +392,23 @@ manager::add_finalizer(const std::string& _key, StackFunc&& _stack_func,
     }
 }
 //
+//----------------------------------------------------------------------------------//
+//
+template <typename Func>
+void
+manager::add_output_stages(const std::string& _key, Func&& _func)
+{
+    for(auto itr = m_output_stages.begin(); itr != m_output_stages.end(); ++itr)
+    {
+        if(itr->first == _key)
+        {
+            m_output_stages.erase(itr);
+            break;
+        }
+    }
+    m_output_stages.push_back(output_pair_t{ _key, std::forward<Func>(_func) });
+}
+//
 //--------------------------------------------------------------------------------------//
 //
 template <typename Tp>
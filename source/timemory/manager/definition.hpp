@@ -53,6 +53,7 @@
 #    include "timemory/mpl/type_traits.hpp"
 #    include "timemory/settings/declaration.hpp"
 #    include "timemory/utility/macros.hpp"
+#    include "timemory/utility/utility.hpp"
 //
 
 #    include <algorithm>
@@ -60,7 +61,9 @@
 #    include <fstream>
 #    include <iosfwd>
 #    include <memory>
+#    include <mutex>
 #    include <string>
+#    include <thread>
 #    include <utility>
 #    include <vector>
 
@@ -245,6 +248,9 @@ manager::finalize()
     //
     // finalize workers first
     _finalize(m_worker_finalizers);
+    // generate the output of the master instances concurrently (if enabled). The
+    // master finalizers will not re-generate the output
+    finalize_output();
     // finalize masters second
     _finalize(m_master_finalizers);
 
@@ -274,6 +280,69 @@ manager::finalize()
 //----------------------------------------------------------------------------------//
 //
 TIMEMORY_MANAGER_LINKAGE(void)
+manager::finalize_output()
+{
+    auto _nthreads =
+        std::min<size_t>(settings::finalize_threads(), m_output_stages.size());
+    if(_nthreads <= 1 || !settings::auto_output())
+    {
+        m_output_stages.clear();
+        return;
+    }
+
+    if(f_debug())
+        PRINT_HERE("generating the output of %i components with %i threads",
+                   (int) m_output_stages.size(), (int) _nthreads);
+
+    // same order as the finalizers: most recent additions first
+    std::reverse(m_output_stages.begin(), m_output_stages.end());
+
+    auto _invoke = [](output_pair_t& _entry, output_stage _stage) {
+        try
+        {
+            _entry.second(_stage);
+        } catch(std::exception& e)
+        {
+            fprintf(stderr, "[%s]> Error generating the output of %s: %s\n",
+                    __FUNCTION__, _entry.first.c_str(), e.what());
+        }
+    };
+
+    // the stages which may contain collectives are invoked in the same order everywhere
+    auto _serial = [&](output_stage _stage) {
+        for(auto& itr : m_output_stages)
+            _invoke(itr, _stage);
+    };
+
+    // the calling thread participates so only (nthreads - 1) threads are created. The
+    // workers never access the thread-local manager/storage instances
+    auto _parallel = [&](output_stage _stage) {
+        std::atomic<size_t> _idx{ 0 };
+        auto                _worker = [&]() {
+            size_t i = 0;
+            while((i = _idx++) < m_output_stages.size())
+                _invoke(m_output_stages.at(i), _stage);
+        };
+        std::vector<std::thread> _threads{};
+        for(size_t i = 1; i < _nthreads; ++i)
+            _threads.emplace_back(_worker);
+        _worker();
+        for(auto& itr : _threads)
+            itr.join();
+    };
+
+    _serial(output_stage::prepare);
+    _parallel(output_stage::convert);
+    _serial(output_stage::gather);
+    _parallel(output_stage::write);
+    _serial(output_stage::report);
+
+    m_output_stages.clear();
+}
+//
+//----------------------------------------------------------------------------------//
+//
+TIMEMORY_MANAGER_LINKAGE(void)
 manager::exit_hook()
 {
     if(f_debug())
@@ -467,6 +536,8 @@ TIMEMORY_MANAGER_LINKAGE(void)
 manager::add_file_output(const string_t& _category, const string_t& _label,
                          const string_t& _file)
 {
+    // the output files may be written concurrently, see finalize_output()
+    std::unique_lock<std::recursive_mutex> _lk(type_mutex<filemap_t>());
     m_output_files[_category][_label].insert(_file);
 }
 //
@@ -509,6 +580,15 @@ manager::remove_finalizer(const std::string& _key)
     _remove_finalizer(m_worker_cleanup);
     _remove_finalizer(m_master_finalizers);
     _remove_finalizer(m_worker_finalizers);
+
+    for(auto itr = m_output_stages.begin(); itr != m_output_stages.end(); ++itr)
+    {
+        if(itr->first == _key)
+        {
+            m_output_stages.erase(itr);
+            break;
+        }
+    }
 }
 //
 //----------------------------------------------------------------------------------//
@@ -632,8 +712,8 @@ extern "C"
             return;
         }
 
-        auto _debug   = tim::settings::debug();
-        auto _verbose = tim::settings::verbose();
+        bool _debug   = tim::settings::debug();
+        int  _verbose = tim::settings::verbose();
 
         if(_debug || _verbose > 3)
             printf("[%s]> initializing manager...\n", __FUNCTION__);
@@ -486,6 +486,19 @@ struct pointer_convert<InTuple<In...>, OutTuple<Out...>>
     using type = OutTuple<add_pointer_t<In>...>;
 };
 
+//--------------------------------------------------------------------------------------//
+//  uninitialized storage suitably sized and aligned for each (pointed-to) type
+//
+template <typename In>
+struct inline_storage;
+
+template <template <typename...> class InTuple, typename... In>
+struct inline_storage<InTuple<In...>>
+{
+    using type = std::tuple<typename std::aligned_storage<
+        sizeof(remove_pointer_t<In>), alignof(remove_pointer_t<In>)>::type...>;
+};
+
 }  // namespace impl
 
 //======================================================================================//
@@ -563,6 +576,9 @@ using pointer_convert_t = typename impl::pointer_convert<T, U>::type;
 template <typename T>
 using unwrap_t = typename impl::unwrapper<T>::type;
 
+template <typename T>
+using inline_storage_t = typename impl::inline_storage<T>::type;
+
 //======================================================================================//
 
 namespace mpl
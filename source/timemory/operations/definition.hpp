@@ -48,6 +48,7 @@
 #include "timemory/operations/types/finalize/get.hpp"
 #include "timemory/operations/types/finalize/merge.hpp"
 #include "timemory/operations/types/finalize/mpi_get.hpp"
+#include "timemory/operations/types/finalize/mpi_imbalance.hpp"
 #include "timemory/operations/types/finalize/print.hpp"
 #include "timemory/operations/types/finalize/upc_get.hpp"
 #include "timemory/operations/types/fini.hpp"
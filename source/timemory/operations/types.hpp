@@ -36,6 +36,7 @@
 #include "timemory/storage/types.hpp"
 #include "timemory/variadic/types.hpp"
 
+#include <cstdio>
 #include <functional>
 #include <iosfwd>
 
@@ -432,6 +433,80 @@ struct mpi_get;
 //--------------------------------------------------------------------------------------//
 //
 template <typename Type, bool has_data>
+struct mpi_imbalance;
+//
+//--------------------------------------------------------------------------------------//
+//
+/// the value of a region across the ranks. The mean is over the ranks which have the
+/// region
+struct imbalance_region
+{
+    std::string label  = {};
+    int64_t     ranks  = 0;
+    double      min    = 0.0;
+    double      max    = 0.0;
+    double      sum    = 0.0;
+    int64_t     argmin = -1;  // fastest rank
+    int64_t     argmax = -1;  // slowest rank
+
+    double mean() const { return (ranks > 0) ? (sum / ranks) : 0.0; }
+    double ratio() const { return (mean() > 0.0) ? (max / mean()) : 1.0; }
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+/// \struct tim::operation::finalize::output_scope
+/// \brief The set of ranks whose data is combined into one set of output files: all
+/// the ranks (default), the ranks on the same node (TIMEMORY_MPI_OUTPUT_PER_NODE) or a
+/// single rank (TIMEMORY_MPI_OUTPUT_PER_RANK). The index of the node or rank is added
+/// to the file names when the output is not combined across all the ranks
+struct output_scope
+{
+    int32_t     rank  = dmp::rank();  // rank within the set, zero writes the output
+    int32_t     size  = dmp::size();  // number of ranks in the set
+    int32_t     index = -1;           // index of the node or rank in the file names
+    std::string tag   = {};           // appended to the label in the file names
+
+    std::string compose_output_filename(const std::string& _label,
+                                        const std::string& _ext) const
+    {
+        return settings::compose_output_filename(_label + tag, _ext, (index >= 0),
+                                                 index);
+    }
+
+    std::string compose_input_filename(const std::string& _label,
+                                       const std::string& _ext) const
+    {
+        return settings::compose_input_filename(_label + tag, _ext, (index >= 0), index);
+    }
+
+    /// must be called by all the ranks
+    static output_scope get()
+    {
+        output_scope _scope{};
+        if(!mpi::is_initialized())
+            return _scope;
+        if(settings::mpi_output_per_rank())
+        {
+            _scope.rank  = 0;
+            _scope.size  = 1;
+            _scope.index = mpi::rank();
+        }
+        else if(settings::mpi_output_per_node())
+        {
+            auto _comm   = mpi::get_node_comm();
+            _scope.rank  = mpi::rank(_comm);
+            _scope.size  = mpi::size(_comm);
+            _scope.index = mpi::get_node_id();
+            _scope.tag   = "_node";
+        }
+        return _scope;
+    }
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+template <typename Type, bool has_data>
 struct upc_get;
 //
 //--------------------------------------------------------------------------------------//
@@ -513,21 +588,35 @@ struct TIMEMORY_OPERATIONS_DLL print
     virtual void print_text(const std::string& fname, stream_type stream);
     virtual void print_plot(const std::string& fname, const std::string suffix);
 
+    /// when the output is deferred, the informational messages are buffered until
+    /// flush_messages() so that concurrently generated output is not interleaved
+    void add_file_output(const std::string& category, const std::string& fname);
+    void flush_messages();
+    template <typename... Args>
+    void print_message(const char* fmt, Args... args);
+
     auto get_label() const { return label; }
     auto get_text_output_name() const { return text_outfname; }
     auto get_json_output_name() const { return json_outfname; }
     auto get_json_input_name() const { return json_inpfname; }
     auto get_text_diff_name() const { return text_diffname; }
     auto get_json_diff_name() const { return json_diffname; }
+    auto get_binary_output_name() const { return binary_outfname; }
+    auto get_binary_diff_name() const { return binary_diffname; }
+    auto get_imbalance_output_name() const { return imbalance_outfname; }
+    auto get_update() const { return update; }
+    bool is_output_rank() const { return !(node_init && scope.rank > 0); }
 
     void set_debug(bool v) { debug = v; }
     void set_update(bool v) { update = v; }
     void set_file_output(bool v) { file_output = v; }
     void set_text_output(bool v) { text_output = v; }
     void set_json_output(bool v) { json_output = v; }
+    void set_binary_output(bool v) { binary_output = v; }
     void set_dart_output(bool v) { dart_output = v; }
     void set_plot_output(bool v) { plot_output = v; }
     void set_verbose(int32_t v) { verbose = v; }
+    void set_deferred(bool v) { deferred = v; }
     void set_max_call_stack(int64_t v) { max_call_stack = v; }
 
     int64_t get_max_depth() const
@@ -541,10 +630,12 @@ protected:
     bool    debug          = settings::debug();
     bool    update         = true;
     bool    json_forced    = false;
+    bool    deferred       = false;
     bool    file_output    = settings::file_output();
     bool    cout_output    = settings::cout_output();
     bool    json_output    = (settings::json_output() || json_forced) && file_output;
     bool    text_output    = settings::text_output() && file_output;
+    bool    binary_output  = settings::binary_output() && file_output;
     bool    dart_output    = settings::dart_output();
     bool    plot_output    = settings::plot_output() && json_output;
     bool    flame_output   = settings::flamegraph_output() && file_output;
@@ -556,21 +647,40 @@ protected:
     int64_t max_call_stack = settings::max_depth();
 
 protected:
-    int64_t     data_concurrency  = 1;
-    int64_t     input_concurrency = 1;
-    std::string label             = "";
-    std::string description       = "";
-    std::string text_outfname     = "";
-    std::string json_outfname     = "";
-    std::string json_inpfname     = "";
-    std::string text_diffname     = "";
-    std::string json_diffname     = "";
-    stream_type data_stream       = stream_type{};
-    stream_type diff_stream       = stream_type{};
+    int64_t      data_concurrency   = 1;
+    int64_t      input_concurrency  = 1;
+    std::string  label              = "";
+    std::string  description        = "";
+    std::string  text_outfname      = "";
+    std::string  json_outfname      = "";
+    std::string  json_inpfname      = "";
+    std::string  text_diffname      = "";
+    std::string  json_diffname      = "";
+    std::string  binary_outfname    = "";
+    std::string  binary_diffname    = "";
+    std::string  imbalance_outfname = "";
+    stream_type  data_stream        = stream_type{};
+    stream_type  diff_stream        = stream_type{};
+    std::string  messages           = "";
+    output_scope scope              = {};
 };
 //
 //--------------------------------------------------------------------------------------//
 //
+template <typename... Args>
+void
+print::print_message(const char* fmt, Args... args)
+{
+    char _buffer[4096];
+    snprintf(_buffer, sizeof(_buffer), fmt, args...);
+    if(deferred)
+        messages += _buffer;
+    else
+        printf("%s", _buffer);
+}
+//
+//--------------------------------------------------------------------------------------//
+//
 }  // namespace base
 //
 //--------------------------------------------------------------------------------------//
@@ -614,18 +724,49 @@ struct print<Tp, true> : public base::print
         else
             setup();
 
-        if(node_init && node_rank > 0)
+        if(!is_output_rank())
             return;
 
+        print_files();
+        print_report();
+    }
+
+    /// write the output files
+    virtual void print_files()
+    {
         if(file_output)
         {
             if(json_output)
                 print_json(json_outfname, node_results, data_concurrency);
             if(text_output)
                 print_text(text_outfname, data_stream);
-            if(plot_output)
-                print_plot(json_outfname, "");
+            if(binary_output)
+                print_binary(binary_outfname, node_results, data_concurrency);
+            if(!node_imbalance.empty())
+                print_imbalance(imbalance_outfname);
+        }
+
+        if(!node_input.empty() && !node_delta.empty() && settings::diff_output())
+        {
+            if(file_output)
+            {
+                if(json_output)
+                    print_json(json_diffname, node_delta, data_concurrency);
+                if(text_output)
+                    print_text(text_diffname, diff_stream);
+                if(binary_output)
+                    print_binary(binary_diffname, node_delta, data_concurrency);
+            }
         }
+    }
+
+    /// console output, plotting, and the custom callback
+    virtual void print_report()
+    {
+        flush_messages();
+
+        if(file_output && plot_output)
+            print_plot(json_outfname, "");
 
         if(cout_output)
             print_cout(data_stream);
@@ -637,24 +778,17 @@ struct print<Tp, true> : public base::print
 
         if(!node_input.empty() && !node_delta.empty() && settings::diff_output())
         {
-            if(file_output)
+            if(file_output && plot_output)
             {
-                if(json_output)
-                    print_json(json_diffname, node_delta, data_concurrency);
-                if(text_output)
-                    print_text(text_diffname, diff_stream);
-                if(plot_output)
+                std::stringstream ss;
+                ss << "Difference vs. " << json_inpfname;
+                if(input_concurrency != data_concurrency)
                 {
-                    std::stringstream ss;
-                    ss << "Difference vs. " << json_inpfname;
-                    if(input_concurrency != data_concurrency)
-                    {
-                        auto delta_conc = (data_concurrency - input_concurrency);
-                        ss << " with " << delta_conc << " "
-                           << ((delta_conc > 0) ? "more" : "less") << "threads";
-                    }
-                    print_plot(json_diffname, ss.str());
+                    auto delta_conc = (data_concurrency - input_concurrency);
+                    ss << " with " << delta_conc << " "
+                       << ((delta_conc > 0) ? "more" : "less") << "threads";
                 }
+                print_plot(json_diffname, ss.str());
             }
 
             if(cout_output)
@@ -668,7 +802,11 @@ struct print<Tp, true> : public base::print
 
     virtual void update_data();
     virtual void setup();
+    virtual void gather();
+    virtual void process();
+    virtual void print_flamegraph();
     virtual void read_json();
+    virtual void read_binary();
 
     virtual void print_dart();
     virtual void print_custom()
@@ -684,10 +822,14 @@ struct print<Tp, true> : public base::print
 
     void write_stream(stream_type& stream, result_type& results);
     void print_json(const std::string& fname, result_type& results, int64_t concurrency);
+    void print_binary(const std::string& fname, result_type& results,
+                      int64_t concurrency);
+    void print_imbalance(const std::string& fname);
     auto get_data() const { return data; }
     auto get_node_results() const { return node_results; }
     auto get_node_input() const { return node_input; }
     auto get_node_delta() const { return node_delta; }
+    auto get_node_imbalance() const { return node_imbalance; }
 
     template <typename Archive>
     void print_metadata(true_type, Archive& ar, const Tp& obj);
@@ -707,11 +849,12 @@ struct print<Tp, true> : public base::print
     }
 
 protected:
-    storage_type* data         = nullptr;
-    callback_type callback     = get_default_callback();
-    result_type   node_results = {};
-    result_type   node_input   = {};
-    result_type   node_delta   = {};
+    storage_type*                 data           = nullptr;
+    callback_type                 callback       = get_default_callback();
+    result_type                   node_results   = {};
+    result_type                   node_input     = {};
+    result_type                   node_delta     = {};
+    std::vector<imbalance_region> node_imbalance = {};
 };
 //
 //--------------------------------------------------------------------------------------//
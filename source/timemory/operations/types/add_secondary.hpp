@@ -48,8 +48,8 @@ namespace operation
 /// but should be another node entry in the graph. These types
 /// must provide a get_secondary() member function and that member function
 /// must return a pair-wise iterable container, e.g. std::map, of types:
-///     - std::string
-///     - value_type
+///     - std::string or the hash of a label registered with add_hash_id
+///     - value_type or the component type
 ///
 //
 //--------------------------------------------------------------------------------------//
@@ -69,12 +69,10 @@ struct add_secondary
     add_secondary(Storage* _storage, Iterator _itr, const Up& _rhs)
     {
         if(!trait::runtime_enabled<Tp>::get() || _storage == nullptr ||
-           !settings::add_secondary())
+           !settings::hot().add_secondary)
             return;
 
-        using secondary_data_t = std::tuple<Iterator, const string_t&, value_type>;
-        for(const auto& _data : _rhs.get_secondary())
-            _storage->append(secondary_data_t{ _itr, _data.first, _data.second });
+        append(_storage, _itr, _rhs);
     }
 
     //----------------------------------------------------------------------------------//
@@ -105,14 +103,67 @@ private:
         -> decltype(_rhs.get_secondary(), void())
     {
         if(!trait::runtime_enabled<Tp>::get() || _storage == nullptr ||
-           !settings::add_secondary())
+           !settings::hot().add_secondary)
             return;
 
-        using secondary_data_t = std::tuple<Iterator, const string_t&, value_type>;
+        append(_storage, _itr, _rhs);
+    }
+
+    //----------------------------------------------------------------------------------//
+    //  The keys of the secondary data are either a label or the hash of a label
+    //  which was registered via add_hash_id. If the secondary data is an instance
+    //  of the component, any secondary data of that instance is appended as a child
+    //
+    template <typename Storage, typename Iterator, typename Up>
+    static void append(Storage* _storage, Iterator _itr, const Up& _rhs)
+    {
         for(const auto& _data : _rhs.get_secondary())
-            _storage->append(secondary_data_t{ _itr, _data.first, _data.second });
+        {
+            using key_type  = decay_t<decltype(_data.first)>;
+            using data_type = decay_t<decltype(_data.second)>;
+            using arg_type  = conditional_t<std::is_same<key_type, string_t>::value,
+                                           const string_t&, hash_result_type>;
+            using val_type =
+                conditional_t<std::is_same<data_type, type>::value, type, value_type>;
+            using secondary_data_t = std::tuple<Iterator, arg_type, val_type>;
+
+            register_label(_storage, _rhs, _data.first, 0);
+            auto _nitr =
+                _storage->append(secondary_data_t{ _itr, _data.first, _data.second });
+            recurse(_storage, _nitr, _data.second, 0);
+        }
     }
 
+    //  hashed keys may have been created on another thread so the label is registered
+    //  in the hash-ids of the storage before the entry is appended
+    template <typename Storage, typename Up>
+    static auto register_label(Storage* _storage, const Up&, hash_result_type _key, int)
+        -> decltype(Up::get_secondary_label(_key), void())
+    {
+        const auto& _hash_ids = _storage->get_hash_ids();
+        if(_hash_ids->find(_key) != _hash_ids->end())
+            return;
+        auto _label = Up::get_secondary_label(_key);
+        if(!_label.empty())
+            _storage->add_hash_id(_label);
+    }
+
+    template <typename Storage, typename Up, typename Key>
+    static void register_label(Storage*, const Up&, const Key&, long)
+    {}
+
+    template <typename Storage, typename Iterator>
+    static auto recurse(Storage* _storage, Iterator _itr, const type& _rhs, int)
+        -> decltype(_rhs.get_secondary(), void())
+    {
+        if(!_rhs.get_secondary().empty())
+            append(_storage, _itr, _rhs);
+    }
+
+    template <typename Storage, typename Iterator, typename Vp>
+    static void recurse(Storage*, Iterator, const Vp&, long)
+    {}
+
     //----------------------------------------------------------------------------------//
     //  If the component does not have a get_secondary() member function
     //
@@ -128,7 +179,7 @@ private:
     auto sfinae(Up& _obj, int, Args&&... args)
         -> decltype(_obj.add_secondary(std::forward<Args>(args)...), void())
     {
-        if(!trait::runtime_enabled<Tp>::get() || !settings::add_secondary())
+        if(!trait::runtime_enabled<Tp>::get() || !settings::hot().add_secondary)
             return;
 
         _obj.add_secondary(std::forward<Args>(args)...);
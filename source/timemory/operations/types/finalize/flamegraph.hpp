@@ -75,10 +75,11 @@ flamegraph<Type>::flamegraph(storage_type* _data, std::string _label)
     // auto node_size        = dmp::size();
     dmp::barrier();
     auto node_rank    = dmp::rank();
+    auto node_scope   = output_scope::get();
     auto node_results = _data->dmp_get();
     dmp::barrier();
 
-    if(node_rank != 0 || node_results.empty())
+    if(node_scope.rank != 0 || node_results.empty())
         return;
 
     result_type results;
@@ -96,7 +97,7 @@ flamegraph<Type>::flamegraph(storage_type* _data, std::string _label)
     using policy_type = policy::output_archive<Archive, api::native_tag>;
 
     auto outfname =
-        settings::compose_output_filename(_label + std::string(".flamegraph"), ".json");
+        node_scope.compose_output_filename(_label + std::string(".flamegraph"), ".json");
 
     if(outfname.length() > 0)
     {
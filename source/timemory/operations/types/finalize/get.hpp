@@ -32,6 +32,7 @@
 #include "timemory/operations/declaration.hpp"
 #include "timemory/operations/macros.hpp"
 #include "timemory/operations/types.hpp"
+#include "timemory/utility/overhead.hpp"
 
 namespace tim
 {
@@ -55,6 +56,14 @@ struct get<Type, true>
     using hierarchy_type           = typename storage_type::uintvector_t;
 
     get(storage_type&, result_type&);
+
+private:
+    template <typename Up = Type, enable_if_t<overhead::is_compensated<Up>(), int> = 0>
+    static void compensate(result_type&);
+
+    template <typename Up = Type, enable_if_t<!overhead::is_compensated<Up>(), int> = 0>
+    static void compensate(result_type&)
+    {}
 };
 //
 //--------------------------------------------------------------------------------------//
@@ -218,8 +227,13 @@ get<Type, true>::get(storage_type& data, result_type& ret)
             for(const auto& itr : data.graph())
                 _min = std::min<int64_t>(_min, itr.depth());
 
+            // the region recorded by the overhead calibration is ignored
+            bool _calibrated = overhead::get_calibration().valid;
+
             for(auto itr = data.graph().begin(); itr != data.graph().end(); ++itr)
             {
+                if(_calibrated && itr->id() == overhead::get_hash())
+                    continue;
                 if(itr->depth() > _min)
                 {
                     auto _depth     = itr->depth() - (_min + 1);
@@ -251,6 +265,13 @@ get<Type, true>::get(storage_type& data, result_type& ret)
             }
         }
 
+        // the nested start/stop pairs and the exclusive values are computed while the
+        // list is in pre-order: the merge appends the new children of a collapsed
+        // duplicate at the end and adds the exclusive values of the duplicates
+        if(settings::overhead_compensation())
+            compensate(_list);
+        node::compute_exclusive(_list);
+
         result_type _combined;
         operation::finalize::merge<Type, true>(_combined, _list);
         return _combined;
@@ -261,6 +282,56 @@ get<Type, true>::get(storage_type& data, result_type& ret)
 //
 //--------------------------------------------------------------------------------------//
 //
+template <typename Type>
+template <typename Up, enable_if_t<overhead::is_compensated<Up>(), int>>
+void
+get<Type, true>::compensate(result_type& _nodes)
+{
+    using value_type = typename Type::value_type;
+
+    auto _per_call = overhead::get_per_call<Type>();
+    if(!(_per_call > 0.0))
+        return;
+
+    // the number of start/stop pairs nested below each node (pre-order array): when a
+    // node is popped (i.e. its sub-tree is complete), the laps of the node and of its
+    // descendants are added to the parent, which is the top of the stack
+    std::vector<uint64_t> _nested(_nodes.size(), 0);
+    std::vector<size_t>   _stack{};
+
+    auto _pop = [&]() {
+        auto _idx = _stack.back();
+        _stack.pop_back();
+        if(!_stack.empty())
+            _nested[_stack.back()] += _nested[_idx] + _nodes[_idx].data().get_laps();
+    };
+
+    for(size_t i = 0; i < _nodes.size(); ++i)
+    {
+        while(!_stack.empty() && _nodes[_stack.back()].depth() >= _nodes[i].depth())
+            _pop();
+        _stack.emplace_back(i);
+    }
+    while(!_stack.empty())
+        _pop();
+
+    // the accumulated value is corrected for the pairs nested in all the laps and the
+    // value of the last lap for the average number of pairs nested in a lap
+    for(size_t i = 0; i < _nodes.size(); ++i)
+    {
+        if(_nested[i] == 0)
+            continue;
+        auto& _obj  = _nodes[i].data();
+        auto  _laps = std::max<int64_t>(_obj.get_laps(), 1);
+        auto  _corr = static_cast<value_type>(_nested[i] * _per_call);
+        auto  _last = static_cast<value_type>(_nested[i] * _per_call / _laps);
+        _obj.accum -= std::min<value_type>(_obj.accum, _corr);
+        _obj.value -= std::min<value_type>(_obj.value, _last);
+    }
+}
+//
+//--------------------------------------------------------------------------------------//
+//
 }  // namespace finalize
 }  // namespace operation
 }  // namespace tim
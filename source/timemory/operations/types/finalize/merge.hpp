@@ -33,6 +33,9 @@
 #include "timemory/operations/macros.hpp"
 #include "timemory/operations/types.hpp"
 
+#include <cstdint>
+#include <unordered_map>
+
 namespace tim
 {
 namespace operation
@@ -179,14 +182,31 @@ merge<Type, true>::merge(result_type& dst, const result_type& src)
     };
 
     //--------------------------------------------------------------------------//
+    //  the entries of the destination are indexed by the hash, rolling hash, and
+    //  depth so finding an equivalent entry is not a linear search
+    //
+    auto _key = [](const result_node& _v) {
+        return _v.hash() ^ (_v.rolling_hash() * 0x9e3779b97f4a7c15ULL) ^
+               static_cast<uint64_t>(_v.depth());
+    };
+
+    std::unordered_multimap<uint64_t, size_t> _index{};
+    _index.reserve(dst.size() + src.size());
+    for(size_t i = 0; i < dst.size(); ++i)
+        _index.emplace(_key(dst.at(i)), i);
+
+    //--------------------------------------------------------------------------//
+    //  returns the first equivalent entry in the destination
     //
     auto _exists = [&](const result_node& _lhs) {
-        for(auto itr = dst.begin(); itr != dst.end(); ++itr)
+        auto _range = _index.equal_range(_key(_lhs));
+        auto _idx   = dst.size();
+        for(auto itr = _range.first; itr != _range.second; ++itr)
         {
-            if(_equiv(_lhs, *itr))
-                return itr;
+            if(itr->second < _idx && _equiv(_lhs, dst.at(itr->second)))
+                _idx = itr->second;
         }
-        return dst.end();
+        return dst.begin() + _idx;
     };
 
     //--------------------------------------------------------------------------//
@@ -200,12 +220,14 @@ merge<Type, true>::merge(result_type& dst, const result_type& src)
             // auto val  = itr;
             // val.tid() = std::numeric_limits<uint16_t>::max();
             // dst.emplace_back(val);
+            _index.emplace(_key(itr), dst.size());
             dst.emplace_back(itr);
         }
         else
         {
             citr->data() += itr.data();
             citr->data().plus(itr.data());
+            citr->exclusive() += itr.exclusive();
             citr->stats() += itr.stats();
         }
     }
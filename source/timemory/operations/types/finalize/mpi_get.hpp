@@ -33,6 +33,8 @@
 #include "timemory/operations/macros.hpp"
 #include "timemory/operations/types.hpp"
 
+#include <cstring>
+
 namespace tim
 {
 namespace operation
@@ -92,10 +94,16 @@ mpi_get<Type, true>::mpi_get(storage_type& data, distrib_type& results)
     if(settings::debug())
         PRINT_HERE("%s", "timemory using MPI");
 
-    // not yet implemented
-    // auto comm =
-    //    (settings::mpi_output_per_node()) ? mpi::get_node_comm() : mpi::comm_world_v;
-    auto comm = mpi::comm_world_v;
+    // with per-rank output there is nothing to aggregate
+    if(settings::mpi_output_per_rank())
+    {
+        results = distrib_type(1, data.get());
+        return;
+    }
+
+    // with per-node output, the ranks are aggregated onto the first rank of each node
+    bool _per_node = settings::mpi_output_per_node();
+    auto comm      = (_per_node) ? mpi::get_node_comm() : mpi::comm_world_v;
     mpi::barrier(comm);
 
     int comm_rank = mpi::rank(comm);
@@ -147,7 +155,43 @@ mpi_get<Type, true>::mpi_get(storage_type& data, distrib_type& results)
     auto ret     = data.get();
     auto str_ret = send_serialize(ret);
 
-    if(comm_rank == 0)
+    if(_per_node)
+    {
+        //
+        //  Every rank on the node copies the serialization into its segment of a shared
+        //  memory window and the root rank of the node reads the segments in place
+        //
+        mpi::win_t _win  = {};
+        char*      _base = nullptr;
+        mpi::win_allocate_shared(str_ret.size(), comm, &_base, &_win);
+        mpi::win_fence(_win);
+        if(!str_ret.empty())
+            std::memcpy(_base, str_ret.data(), str_ret.size());
+        mpi::win_fence(_win);
+
+        if(comm_rank == 0)
+        {
+            for(int i = 1; i < comm_size; ++i)
+            {
+                size_t _size = 0;
+                char*  _ptr  = nullptr;
+                mpi::win_shared_query(_win, i, &_size, &_ptr);
+                if(settings::debug())
+                    printf("[SHMEM: %i]> reading %i (%llu bytes)\n", comm_rank, i,
+                           (unsigned long long) _size);
+                results[i] = recv_serialize(std::string(_ptr, _size));
+            }
+            results[comm_rank] = ret;
+        }
+        else
+        {
+            results = distrib_type(1, ret);
+        }
+
+        // collective so the segments are not released before the root rank is done
+        mpi::win_free(&_win);
+    }
+    else if(comm_rank == 0)
     {
         //
         //  The root rank receives data from all non-root ranks and reports all data
@@ -213,7 +257,7 @@ mpi_get<Type, true>::mpi_get(storage_type& data, distrib_type& results)
                        comm_rank, init_size, fini_size, comm_size);
         }
     }
-    else if(settings::node_count() > 0 && comm_rank == 0)
+    else if(settings::node_count() > 0 && comm_rank == 0 && !_per_node)
     {
         // calculate some size parameters
         int32_t nmod  = comm_size % settings::node_count();
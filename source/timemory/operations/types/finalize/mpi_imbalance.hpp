@@ -0,0 +1,394 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+/**
+ * \file timemory/operations/types/finalize/mpi_imbalance.hpp
+ * \brief Definition of the cross-rank load-imbalance summary which replaces the gather
+ * of the full call-graphs when TIMEMORY_MPI_IMBALANCE is enabled
+ */
+
+#pragma once
+
+#include "timemory/operations/declaration.hpp"
+#include "timemory/operations/macros.hpp"
+#include "timemory/operations/types.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace tim
+{
+namespace operation
+{
+namespace finalize
+{
+//
+//--------------------------------------------------------------------------------------//
+//
+/// the element of the dense per-region arrays which are reduced across the ranks. A
+/// rank without the region contributes an element with a count of zero
+struct imbalance_reduction
+{
+    double  min    = 0.0;
+    double  max    = 0.0;
+    double  sum    = 0.0;
+    int64_t count  = 0;
+    int64_t argmin = -1;
+    int64_t argmax = -1;
+
+    static void combine(const imbalance_reduction& _in, imbalance_reduction& _inout)
+    {
+        if(_in.count == 0)
+            return;
+        if(_inout.count == 0)
+        {
+            _inout = _in;
+            return;
+        }
+        // ties are resolved to the lowest rank so the result does not depend on the
+        // order of the reduction
+        if(_in.min < _inout.min || (_in.min == _inout.min && _in.argmin < _inout.argmin))
+        {
+            _inout.min    = _in.min;
+            _inout.argmin = _in.argmin;
+        }
+        if(_in.max > _inout.max || (_in.max == _inout.max && _in.argmax < _inout.argmax))
+        {
+            _inout.max    = _in.max;
+            _inout.argmax = _in.argmax;
+        }
+        _inout.sum += _in.sum;
+        _inout.count += _in.count;
+    }
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+template <typename Type>
+struct mpi_imbalance<Type, true>
+{
+    static constexpr bool has_data = true;
+    using this_type                = mpi_imbalance<Type, has_data>;
+    using storage_type             = impl::storage<Type, has_data>;
+    using result_type              = typename storage_type::result_array_t;
+    using result_node              = typename storage_type::result_node;
+    using report_type              = std::vector<imbalance_region>;
+
+    /// collective over the ranks: \param results are the results of this rank and the
+    /// report is only assigned on rank zero
+    mpi_imbalance(const result_type& results, report_type& report);
+
+    /// whether the value of the component is a single number
+    static constexpr bool is_supported() { return supported<Type>(0); }
+
+    /// writes the report sorted by the max/mean ratio
+    static void write(std::ostream& os, const report_type& report);
+
+private:
+    template <typename Up>
+    static constexpr auto supported(int)
+        -> decltype(static_cast<double>(std::declval<const Up&>().get()), bool())
+    {
+        return true;
+    }
+
+    template <typename Up>
+    static constexpr bool supported(long)
+    {
+        return false;
+    }
+
+    template <typename Up>
+    static auto get_value(const Up& _obj, int)
+        -> decltype(static_cast<double>(_obj.get()))
+    {
+        return static_cast<double>(_obj.get());
+    }
+
+    template <typename Up>
+    static double get_value(const Up&, long)
+    {
+        return 0.0;
+    }
+
+    // identifies a region across ranks (the prefix is not used since it may contain the
+    // rank)
+    static uint64_t get_key(const result_node& _v)
+    {
+        return _v.hash() ^ (_v.rolling_hash() * 0x9e3779b97f4a7c15ULL) ^
+               static_cast<uint64_t>(_v.depth());
+    }
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+template <typename Type>
+struct mpi_imbalance<Type, false>
+{
+    static constexpr bool has_data = false;
+    using this_type                = mpi_imbalance<Type, has_data>;
+
+    template <typename... Tp>
+    mpi_imbalance(Tp&&...)
+    {}
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+template <typename Type>
+mpi_imbalance<Type, true>::mpi_imbalance(const result_type& results, report_type& report)
+{
+    report.clear();
+    if(!is_supported())
+        return;
+
+    // sum the entries of the region on this rank (e.g. different threads) in the
+    // order of the keys
+    std::map<uint64_t, std::pair<double, std::string>> _local{};
+    for(const auto& itr : results)
+    {
+        auto _value = get_value(itr.data(), 0);
+        auto _ret   = _local.emplace(get_key(itr), std::make_pair(_value, itr.prefix()));
+        if(!_ret.second)
+            _ret.first->second.first += _value;
+    }
+
+    for(auto& itr : _local)
+    {
+        for(auto& citr : itr.second.second)
+        {
+            if(citr == '\n')
+                citr = ' ';
+        }
+    }
+
+    int comm_rank = 0;
+    int comm_size = 1;
+#if defined(TIMEMORY_USE_MPI)
+    auto comm = mpi::comm_world_v;
+    if(mpi::is_initialized())
+    {
+        comm_rank = mpi::rank(comm);
+        comm_size = mpi::size(comm);
+    }
+#endif
+
+    //------------------------------------------------------------------------------//
+    //  the global region index: the sorted union of the keys of every rank and the
+    //  lowest rank which has the region
+    //
+    std::vector<uint64_t> _keys{};
+    _keys.reserve(_local.size());
+    for(const auto& itr : _local)
+        _keys.emplace_back(itr.first);
+
+    std::map<uint64_t, int> _owner{};
+    if(comm_size == 1)
+    {
+        for(const auto& itr : _keys)
+            _owner.emplace(itr, 0);
+    }
+#if defined(TIMEMORY_USE_MPI)
+    else
+    {
+        int              _nkeys = static_cast<int>(_keys.size());
+        std::vector<int> _counts(comm_size, 0);
+        std::vector<int> _displs(comm_size, 0);
+        mpi::allgather(&_nkeys, 1, MPI_INT, _counts.data(), 1, MPI_INT, comm);
+        for(int i = 1; i < comm_size; ++i)
+            _displs.at(i) = _displs.at(i - 1) + _counts.at(i - 1);
+
+        std::vector<uint64_t> _all(_displs.back() + _counts.back());
+        mpi::allgatherv(_keys.data(), _nkeys, MPI_UINT64_T, _all.data(), _counts.data(),
+                        _displs.data(), MPI_UINT64_T, comm);
+
+        // the ranks are visited in order so the first insertion is the lowest rank
+        for(int i = 0; i < comm_size; ++i)
+        {
+            for(int j = 0; j < _counts.at(i); ++j)
+                _owner.emplace(_all.at(_displs.at(i) + j), i);
+        }
+    }
+#endif
+
+    //------------------------------------------------------------------------------//
+    //  the dense per-region arrays reduced in a single reduction
+    //
+    std::vector<imbalance_reduction> _send(_owner.size());
+    std::vector<imbalance_reduction> _recv(_owner.size());
+    {
+        size_t i = 0;
+        for(const auto& itr : _owner)
+        {
+            auto litr = _local.find(itr.first);
+            if(litr != _local.end())
+            {
+                auto _value = litr->second.first;
+                _send.at(i) = { _value, _value, _value, 1, comm_rank, comm_rank };
+            }
+            ++i;
+        }
+    }
+
+    if(comm_size == 1)
+    {
+        _recv = _send;
+    }
+#if defined(TIMEMORY_USE_MPI)
+    else if(!_send.empty())
+    {
+        struct reduction_op
+        {
+            static void apply(void* _in, void* _inout, int* _len, MPI_Datatype*)
+            {
+                auto* _lhs = static_cast<imbalance_reduction*>(_in);
+                auto* _rhs = static_cast<imbalance_reduction*>(_inout);
+                for(int i = 0; i < *_len; ++i)
+                    imbalance_reduction::combine(_lhs[i], _rhs[i]);
+            }
+        };
+
+        MPI_Datatype _type;
+        MPI_Op       _op;
+        MPI_Type_contiguous(sizeof(imbalance_reduction), MPI_BYTE, &_type);
+        MPI_Type_commit(&_type);
+        MPI_Op_create(&reduction_op::apply, 1, &_op);
+        mpi::reduce(_send.data(), _recv.data(), static_cast<int>(_send.size()), _type,
+                    _op, 0, comm);
+        MPI_Op_free(&_op);
+        MPI_Type_free(&_type);
+    }
+#endif
+
+    //------------------------------------------------------------------------------//
+    //  the labels of the regions which rank zero does not have are sent by the lowest
+    //  rank which has the region
+    //
+    std::vector<std::string> _labels(_owner.size());
+    {
+        size_t i = 0;
+        for(const auto& itr : _owner)
+        {
+            if(itr.second == comm_rank)
+                _labels.at(i) = _local.at(itr.first).second;
+            ++i;
+        }
+    }
+
+#if defined(TIMEMORY_USE_MPI)
+    if(comm_size > 1)
+    {
+        std::vector<std::vector<size_t>> _owned(comm_size);
+        {
+            size_t i = 0;
+            for(const auto& itr : _owner)
+                _owned.at(itr.second).emplace_back(i++);
+        }
+
+        if(comm_rank == 0)
+        {
+            for(int r = 1; r < comm_size; ++r)
+            {
+                if(_owned.at(r).empty())
+                    continue;
+                std::string _str{};
+                mpi::recv(_str, r, 0, comm);
+                std::istringstream _iss(_str);
+                for(auto i : _owned.at(r))
+                    std::getline(_iss, _labels.at(i));
+            }
+        }
+        else if(!_owned.at(comm_rank).empty())
+        {
+            std::stringstream _ss{};
+            for(auto i : _owned.at(comm_rank))
+                _ss << _labels.at(i) << '\n';
+            mpi::send(_ss.str(), 0, 0, comm);
+        }
+    }
+#endif
+
+    if(comm_rank != 0)
+        return;
+
+    report.reserve(_recv.size());
+    for(size_t i = 0; i < _recv.size(); ++i)
+    {
+        const auto& itr = _recv.at(i);
+        report.emplace_back(imbalance_region{ _labels.at(i), itr.count, itr.min, itr.max,
+                                              itr.sum, itr.argmin, itr.argmax });
+    }
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+template <typename Type>
+void
+mpi_imbalance<Type, true>::write(std::ostream& os, const report_type& report)
+{
+    std::vector<const imbalance_region*> _sorted{};
+    _sorted.reserve(report.size());
+    size_t _width = 6;
+    for(const auto& itr : report)
+    {
+        _sorted.emplace_back(&itr);
+        _width = std::max<size_t>(_width, itr.label.length());
+    }
+    std::stable_sort(_sorted.begin(), _sorted.end(),
+                     [](const imbalance_region* _lhs, const imbalance_region* _rhs) {
+                         return _lhs->ratio() > _rhs->ratio();
+                     });
+
+    auto _units = Type::get_display_unit();
+    os << "# " << Type::get_label() << " load imbalance across ranks";
+    if(!_units.empty())
+        os << " [" << _units << "]";
+    os << "\n# the mean is over the ranks which have the region\n";
+    os << std::setw(_width) << std::left << "REGION" << std::right << std::setw(10)
+       << "MAX/MEAN" << std::setw(14) << "MIN" << std::setw(14) << "MEAN"
+       << std::setw(14) << "MAX" << std::setw(8) << "RANKS" << std::setw(10)
+       << "FASTEST" << std::setw(10) << "SLOWEST"
+       << "\n";
+    for(const auto* itr : _sorted)
+    {
+        os << std::setw(_width) << std::left << itr->label << std::right << std::fixed
+           << std::setprecision(3) << std::setw(10) << itr->ratio()
+           << std::setprecision(6) << std::setw(14) << itr->min << std::setw(14)
+           << itr->mean() << std::setw(14) << itr->max << std::setw(8) << itr->ranks
+           << std::setw(10) << itr->argmin << std::setw(10) << itr->argmax << "\n";
+    }
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+}  // namespace finalize
+}  // namespace operation
+}  // namespace tim
@@ -37,6 +37,8 @@
 #include "timemory/operations/types.hpp"
 #include "timemory/plotting/declaration.hpp"
 #include "timemory/settings/declaration.hpp"
+#include "timemory/storage/binary.hpp"
+#include "timemory/utility/overhead.hpp"
 
 #include <cstdint>
 #include <fstream>
@@ -62,7 +64,7 @@ namespace finalize
 TIMEMORY_OPERATIONS_LINKAGE(void)
 base::print::print_plot(const std::string& outfname, const std::string suffix)
 {
-    if(node_rank == 0)
+    if(is_output_rank())
     {
         auto plot_label = label;
         if(!suffix.empty())
@@ -102,10 +104,10 @@ base::print::print_text(const std::string& outfname, stream_type stream)
         std::ofstream fout(outfname.c_str());
         if(fout)
         {
-            printf("[%s]|%i> Outputting '%s'...\n", label.c_str(), node_rank,
-                   outfname.c_str());
+            print_message("[%s]|%i> Outputting '%s'...\n", label.c_str(), node_rank,
+                          outfname.c_str());
             write(fout, stream);
-            manager::instance()->add_text_output(label, outfname);
+            add_file_output("text", outfname);
         }
         else
         {
@@ -117,6 +119,28 @@ base::print::print_text(const std::string& outfname, stream_type stream)
 //
 //--------------------------------------------------------------------------------------//
 //
+TIMEMORY_OPERATIONS_LINKAGE(void)
+base::print::add_file_output(const std::string& _category, const std::string& _fname)
+{
+    // deferred output is generated on threads which must not create a thread-local
+    // manager instance
+    auto _manager = (deferred) ? manager::master_instance() : manager::instance();
+    if(_manager)
+        _manager->add_file_output(_category, label, _fname);
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+TIMEMORY_OPERATIONS_LINKAGE(void)
+base::print::flush_messages()
+{
+    if(!messages.empty())
+        printf("%s", messages.c_str());
+    messages.clear();
+}
+//
+//--------------------------------------------------------------------------------------//
+//
 #endif  // !defined(TIMEMORY_USE_EXTERN) || defined(TIMEMORY_OPERATIONS_SOURCE)
 //
 //--------------------------------------------------------------------------------------//
@@ -155,8 +179,8 @@ print<Tp, true>::setup()
         }
     }
 
-    auto file_exists = [](const std::string& fname) {
-        std::cout << "Checking for existing input at " << fname << "...\n";
+    auto file_exists = [&](const std::string& fname) {
+        print_message("Checking for existing input at %s...\n", fname.c_str());
         std::ifstream inpf(fname.c_str());
         auto          success = inpf.is_open();
         inpf.close();
@@ -168,17 +192,24 @@ print<Tp, true>::setup()
     auto is_pretty_json =
         std::is_same<trait::output_archive_t<Tp>, cereal::PrettyJSONOutputArchive>::value;
     auto fext       = (is_minimal_json || is_pretty_json) ? ".json" : ".xml";
+    auto bext       = binary::get_extension();
     auto extensions = tim::delimit(settings::input_extensions(), ",; ");
 
-    json_outfname = settings::compose_output_filename(label, fext);
-    text_outfname = settings::compose_output_filename(label, ".txt");
+    json_outfname   = scope.compose_output_filename(label, fext);
+    text_outfname   = scope.compose_output_filename(label, ".txt");
+    binary_outfname = scope.compose_output_filename(label, bext);
+    if(!node_imbalance.empty())
+        imbalance_outfname = scope.compose_output_filename(label, ".imbalance.txt");
 
     if(settings::diff_output())
     {
         extensions.insert(extensions.begin(), fext);
+        // prefer the binary input when binary output is enabled (much faster to load)
+        if(binary_output)
+            extensions.insert(extensions.begin(), bext);
         for(auto itr : extensions)
         {
-            auto inpfname = settings::compose_input_filename(label, itr);
+            auto inpfname = scope.compose_input_filename(label, itr);
             if(file_exists(inpfname))
             {
                 json_inpfname = inpfname;
@@ -189,18 +220,31 @@ print<Tp, true>::setup()
 
     if(!json_inpfname.empty())
     {
-        auto dext     = std::string(".diff") + fext;
-        json_diffname = settings::compose_output_filename(label, dext);
-        text_diffname = settings::compose_output_filename(label, ".diff.txt");
-        printf("difference filenames: '%s' and '%s'\n", json_diffname.c_str(),
-               text_diffname.c_str());
+        auto dext       = std::string(".diff") + fext;
+        auto bdext      = std::string(".diff") + bext;
+        json_diffname   = scope.compose_output_filename(label, dext);
+        text_diffname   = scope.compose_output_filename(label, ".diff.txt");
+        binary_diffname = scope.compose_output_filename(label, bdext);
+        print_message("difference filenames: '%s' and '%s'\n", json_diffname.c_str(),
+                      text_diffname.c_str());
     }
 
     if(!(file_output && text_output) && !cout_output)
         return;
 
     write_stream(data_stream, node_results);
-    data_stream->set_banner(description);
+    if(overhead::is_applied<Tp>())
+    {
+        std::stringstream ss;
+        ss << description << " [overhead compensation: " << std::setprecision(1)
+           << std::fixed << (overhead::get_calibration().per_call * 1.0e9)
+           << " ns per nested start/stop]";
+        data_stream->set_banner(ss.str());
+    }
+    else
+    {
+        data_stream->set_banner(description);
+    }
 
     if(node_delta.size() > 0)
     {
@@ -232,13 +276,16 @@ print<Tp, true>::write_stream(stream_type& stream, result_type& result_array)
     using get_return_type = decltype(std::declval<const Tp>().get());
     using compute_type    = math::compute<get_return_type>;
 
-    auto_lock_t slk(type_mutex<decltype(std::cout)>(), std::defer_lock);
+    // the streams of different components may be generated concurrently
+    auto_lock_t slk(type_mutex<this_type>(), std::defer_lock);
     if(!slk.owns_lock())
         slk.lock();
 
     auto result = get_flattened(result_array);
+
     for(auto itr = result.begin(); itr != result.end(); ++itr)
     {
+        auto  _idx       = std::distance(result.begin(), itr);
         auto& itr_obj    = (*itr)->data();
         auto& itr_prefix = (*itr)->prefix();
         auto& itr_depth  = (*itr)->depth();
@@ -247,55 +294,20 @@ print<Tp, true>::write_stream(stream_type& stream, result_type& result_array)
         if(itr_depth < 0 || itr_depth > get_max_depth())
             continue;
 
-        // counts the number of non-exclusive values
-        int64_t nexclusive = 0;
-        // the sum of the exclusive values
-        get_return_type exclusive_values{};
-
-        // if we are not at the bottom of the call stack (i.e. completely
-        // inclusive)
+        // the sum of the values of the direct children is the inclusive value minus
+        // the exclusive value. The nodes at the bottom of the call stack are
+        // completely inclusive
+        decay_t<get_return_type> _child_values{};
         if(itr_depth < max_depth)
         {
-            // get the next iteration
-            auto eitr = itr;
-            std::advance(eitr, 1);
-            // counts the number of non-exclusive values
-            nexclusive = 0;
-            // the sum of the exclusive values
-            exclusive_values = get_return_type{};
-            // continue while not at end of graph until first sibling is
-            // encountered
-            if(eitr != result.end())
-            {
-                auto eitr_depth = (*eitr)->depth();
-                while(eitr_depth != itr_depth)
-                {
-                    auto& eitr_obj = (*eitr)->data();
-
-                    // if one level down, this is an exclusive value
-                    if(eitr_depth == itr_depth + 1)
-                    {
-                        // if first exclusive value encountered: assign; else: combine
-                        if(nexclusive == 0)
-                            exclusive_values = eitr_obj.get();
-                        else
-                            compute_type::plus(exclusive_values, eitr_obj.get());
-                        // increment. beyond 0 vs. 1, this value plays no role
-                        ++nexclusive;
-                    }
-                    // increment iterator for next while check
-                    ++eitr;
-                    if(eitr == result.end())
-                        break;
-                    eitr_depth = (*eitr)->depth();
-                }
-            }
+            _child_values = itr_obj.get();
+            compute_type::minus(_child_values, (*itr)->exclusive().get());
         }
 
-        auto itr_self  = compute_type::percent_diff(exclusive_values, itr_obj.get());
+        auto itr_self  = compute_type::percent_diff(_child_values, itr_obj.get());
         auto itr_stats = (*itr)->stats();
 
-        bool _first = std::distance(result.begin(), itr) == 0;
+        bool _first = (_idx == 0);
         if(_first)
             operation::print_header<Tp>(itr_obj, *(stream.get()), itr_stats);
 
@@ -311,24 +323,56 @@ print<Tp, true>::write_stream(stream_type& stream, result_type& result_array)
 template <typename Tp>
 void
 print<Tp, true>::update_data()
+{
+    gather();
+    process();
+    print_flamegraph();
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+template <typename Tp>
+void
+print<Tp, true>::gather()
 {
     dmp::barrier();
     node_init        = dmp::is_initialized();
     node_rank        = dmp::rank();
     node_size        = dmp::size();
-    node_results     = data->dmp_get();
+    if(settings::mpi_imbalance() && mpi::is_initialized() &&
+       mpi_imbalance<Tp, true>::is_supported())
+    {
+        // only the per-region summary is reduced across the ranks so the output of the
+        // root rank only has the data of the root rank
+        node_results = result_type(1, data->get());
+        mpi_imbalance<Tp, true>(node_results.front(), node_imbalance);
+    }
+    else
+    {
+        // the ranks which are combined into the output of this rank, i.e. all of the
+        // ranks, the ranks on this node, or only this rank
+        scope        = output_scope::get();
+        node_results = data->dmp_get();
+    }
     data_concurrency = data->instance_count().load();
     dmp::barrier();
 
     if(settings::debug())
         printf("[%s]|%i> dmp results size: %i\n", label.c_str(), node_rank,
                (int) node_results.size());
-
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+template <typename Tp>
+void
+print<Tp, true>::process()
+{
     setup();
 
     read_json();
 
-    if(node_input.size() > 0 && node_rank == 0)
+    if(node_input.size() > 0 && is_output_rank())
     {
         using input_type = decay_t<decltype(node_input)>;
         using value_type = typename input_type::value_type;
@@ -389,7 +433,14 @@ print<Tp, true>::update_data()
         printf("\n");
     }
 #endif
-
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+template <typename Tp>
+void
+print<Tp, true>::print_flamegraph()
+{
     if(flame_output)
         operation::finalize::flamegraph<Tp>(data, label);
 }
@@ -442,9 +493,9 @@ print<Tp, true>::print_json(const std::string& outfname, result_type& results,
             auto fext = outfname.substr(outfname.find_last_of(".") + 1);
             if(fext.empty())
                 fext = "unknown";
-            manager::instance()->add_file_output(fext, label, outfname);
-            printf("[%s]|%i> Outputting '%s'...\n", label.c_str(), node_rank,
-                   outfname.c_str());
+            add_file_output(fext, outfname);
+            print_message("[%s]|%i> Outputting '%s'...\n", label.c_str(), node_rank,
+                          outfname.c_str());
 
             // ensure write final block during destruction before the file is closed
             auto oa = policy_type::get(ofs);
@@ -469,6 +520,9 @@ print<Tp, true>::print_json(const std::string& outfname, result_type& results,
                     (*oa)(cereal::make_nvp("concurrency", concurrency));
                     print_metadata(bool_type{}, *oa, results.at(i).front().data());
                     Tp::extra_serialization(*oa, 1);
+                    if(overhead::is_applied<Tp>())
+                        (*oa)(cereal::make_nvp("overhead_compensation",
+                                               overhead::get_calibration()));
                     save(*oa, results.at(i));
 
                     oa->finishNode();
@@ -487,6 +541,74 @@ print<Tp, true>::print_json(const std::string& outfname, result_type& results,
 //
 template <typename Tp>
 void
+print<Tp, true>::print_binary(const std::string& outfname, result_type& results,
+                              int64_t concurrency)
+{
+    if(outfname.empty())
+        return;
+
+    binary::writer _writer{};
+    _writer.add_metadata("label", label);
+    _writer.add_metadata("description", Tp::get_description());
+    _writer.add_metadata("type", demangle<Tp>());
+    _writer.add_metadata("concurrency", std::to_string(concurrency));
+    _writer.add_metadata("num_ranks", std::to_string(results.size()));
+    if(overhead::is_applied<Tp>())
+    {
+        const auto& _calib = overhead::get_calibration();
+        _writer.add_metadata("overhead_per_call_ns",
+                             std::to_string(_calib.per_call * 1.0e9));
+        _writer.add_metadata("overhead_bundle", _calib.bundle);
+    }
+
+    for(uint64_t i = 0; i < results.size(); ++i)
+    {
+        if(results.at(i).empty())
+            continue;
+        binary::save(_writer, i, results.at(i));
+    }
+
+    if(_writer.write(outfname))
+    {
+        add_file_output("binary", outfname);
+        print_message("[%s]|%i> Outputting '%s'...\n", label.c_str(), node_rank,
+                      outfname.c_str());
+    }
+    else
+    {
+        fprintf(stderr, "[storage<%s>::%s @ %i]|%i> Error opening '%s'...\n",
+                label.c_str(), __FUNCTION__, __LINE__, node_rank, outfname.c_str());
+    }
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+template <typename Tp>
+void
+print<Tp, true>::print_imbalance(const std::string& outfname)
+{
+    if(outfname.empty())
+        return;
+
+    std::ofstream ofs(outfname.c_str());
+    if(ofs)
+    {
+        print_message("[%s]|%i> Outputting '%s'...\n", label.c_str(), node_rank,
+                      outfname.c_str());
+        mpi_imbalance<Tp, true>::write(ofs, node_imbalance);
+        add_file_output("text", outfname);
+    }
+    else
+    {
+        fprintf(stderr, "[storage<%s>::%s @ %i]|%i> Error opening '%s'...\n",
+                label.c_str(), __FUNCTION__, __LINE__, node_rank, outfname.c_str());
+    }
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+template <typename Tp>
+void
 print<Tp, true>::print_dart()
 {
     using strvector_t = std::vector<std::string>;
@@ -536,13 +658,21 @@ print<Tp, true>::read_json()
     using policy_type = policy::input_archive_t<Tp>;
     // using bool_type   = typename trait::array_serialization<Tp>::type;
 
+    auto _ext = binary::get_extension();
+    if(json_inpfname.length() > _ext.length() &&
+       json_inpfname.substr(json_inpfname.length() - _ext.length()) == _ext)
+    {
+        read_binary();
+        return;
+    }
+
     if(json_inpfname.length() > 0)
     {
         std::ifstream ifs(json_inpfname.c_str());
         if(ifs)
         {
-            printf("[%s]|%i> Reading '%s'...\n", label.c_str(), node_rank,
-                   json_inpfname.c_str());
+            print_message("[%s]|%i> Reading '%s'...\n", label.c_str(), node_rank,
+                          json_inpfname.c_str());
 
             size_t num_ranks = 0;
             // ensure write final block during destruction before the file is closed
@@ -592,6 +722,44 @@ print<Tp, true>::read_json()
 //
 //--------------------------------------------------------------------------------------//
 //
+template <typename Tp>
+void
+print<Tp, true>::read_binary()
+{
+    if(json_inpfname.empty())
+        return;
+
+    print_message("[%s]|%i> Reading '%s'...\n", label.c_str(), node_rank,
+                  json_inpfname.c_str());
+
+    try
+    {
+        binary::reader _reader{ json_inpfname };
+
+        auto _conc = _reader.get_metadata("concurrency");
+        if(!_conc.empty())
+            input_concurrency = std::stoll(_conc);
+
+        uint64_t _num_ranks = 0;
+        for(uint64_t i = 0; i < _reader.num_tables(); ++i)
+            _num_ranks = std::max<uint64_t>(_num_ranks, _reader.get_table(i).rank() + 1);
+
+        node_input.resize(_num_ranks);
+        for(uint64_t i = 0; i < _reader.num_tables(); ++i)
+        {
+            auto _table = _reader.get_table(i);
+            binary::load(_table, node_input.at(_table.rank()));
+        }
+    } catch(std::exception& e)
+    {
+        node_input.clear();
+        fprintf(stderr, "[%s]> Error reading input file '%s': %s\n", label.c_str(),
+                json_inpfname.c_str(), e.what());
+    }
+}
+//
+//--------------------------------------------------------------------------------------//
+//
 }  // namespace finalize
 }  // namespace operation
 }  // namespace tim
@@ -160,7 +160,8 @@ public:
                     Func&& _callback = [](pid_t, int, int) { return true; });
 
     template <typename Func = std::function<bool(pid_t, int, int)>>
-    static int wait(int _verbose = settings::verbose(), bool _debug = settings::debug(),
+    static int wait(int _verbose = settings::hot().verbose,
+                    bool _debug = settings::hot().debug,
                     Func&& _callback = [](pid_t, int, int) { return true; })
     {
         return wait(process::get_target_id(), _verbose, _debug,
@@ -245,7 +246,7 @@ template <template <typename...> class CompT, size_t N, typename... Types>
 void
 sampler<CompT<Types...>, N>::execute(int signum)
 {
-    if(settings::debug())
+    if(settings::hot().debug)
         printf("[pid=%i][tid=%i][%s]> sampling...\n", (int) process::get_id(),
                (int) threading::get_id(), demangle<this_type>().c_str());
 
@@ -273,7 +274,7 @@ template <template <typename...> class CompT, size_t N, typename... Types>
 void
 sampler<CompT<Types...>, N>::execute(int signum, siginfo_t*, void*)
 {
-    if(settings::debug())
+    if(settings::hot().debug)
         printf("[pid=%i][tid=%i][%s]> sampling...\n", (int) process::get_id(),
                (int) threading::get_id(), demangle<this_type>().c_str());
 
@@ -502,7 +503,7 @@ sampler<CompT<Types...>, N>::set_delay(const double& fdelay)
     get_persistent_data().m_freq = fdelay;
     int delay_sec                = double(fdelay * units::usec) / units::usec;
     int delay_usec               = int(fdelay * units::usec) % units::usec;
-    if(settings::debug() || settings::verbose() > 0)
+    if(settings::hot().debug || settings::hot().verbose > 0)
     {
         fprintf(stderr, "sampler delay     : %i sec + %i usec\n", delay_sec, delay_usec);
     }
@@ -520,7 +521,7 @@ sampler<CompT<Types...>, N>::set_frequency(const double& ffreq)
     get_persistent_data().m_freq = ffreq;
     int freq_sec                 = double(ffreq * units::usec) / units::usec;
     int freq_usec                = int(ffreq * units::usec) % units::usec;
-    if(settings::debug() || settings::verbose() > 0)
+    if(settings::hot().debug || settings::hot().verbose > 0)
     {
         fprintf(stderr, "sampler frequency     : %i sec + %i usec\n", freq_sec,
                 freq_usec);
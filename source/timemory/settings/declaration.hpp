@@ -88,6 +88,108 @@ struct TIMEMORY_SETTINGS_DLL settings
     settings& operator=(const settings&) = default;
     settings& operator=(settings&&) = default;
 
+    //----------------------------------------------------------------------------------//
+    /// \struct tim::settings::hot_settings
+    /// \brief Thread-local copy of the settings which are read on every measurement
+    /// (see \ref settings::hot). It fits in a single cache-line
+    ///
+    struct alignas(64) hot_settings
+    {
+        uint64_t epoch             = 0;
+        int      verbose           = 0;
+        bool     enabled           = false;
+        bool     debug             = false;
+        bool     add_secondary     = true;
+        bool     destructor_report = false;
+    };
+
+    /// the settings which are read in the hot paths (bundle construction, start/stop,
+    /// gotcha wrappers, etc.). The copy of the calling thread is refreshed when the
+    /// epoch has changed so, in the common case, reading a value is a load from the
+    /// thread-local copy and a load of the epoch
+    static const hot_settings& hot() TIMEMORY_VISIBILITY("default");
+
+    /// incremented whenever a setting in \ref hot_settings has been modified
+    static std::atomic<uint64_t>& get_epoch() TIMEMORY_VISIBILITY("default");
+
+    /// invalidates the thread-local copies of the hot settings. Must be called after
+    /// the new value was stored so that a refresh cannot observe the old value
+    static void update_epoch() { get_epoch().fetch_add(1, std::memory_order_acq_rel); }
+
+    //----------------------------------------------------------------------------------//
+    /// \struct tim::settings::hot_reference
+    /// \brief Returned by the accessors of the settings in \ref hot_settings in lieu of
+    /// a reference. Reading the value has no side-effect and assigning a value (incl.
+    /// the compound assignments and increments) stores it and then calls
+    /// \ref update_epoch. Use get() where a `Tp` is deduced (e.g. std::max, printf)
+    ///
+#define TIMEMORY_HOT_REFERENCE_ASSIGN_OPERATOR(OP)                                       \
+    template <typename Up>                                                               \
+    hot_reference& operator OP(const Up& _val)                                           \
+    {                                                                                    \
+        m_value OP _val;                                                                 \
+        update_epoch();                                                                  \
+        return *this;                                                                    \
+    }
+
+    template <typename Tp>
+    struct hot_reference
+    {
+        explicit hot_reference(Tp& _val)
+        : m_value(_val)
+        {}
+
+        hot_reference(const hot_reference&) = default;
+
+        hot_reference& operator=(const Tp& _val)
+        {
+            m_value = _val;
+            update_epoch();
+            return *this;
+        }
+
+        hot_reference& operator=(const hot_reference& rhs)
+        {
+            return (*this = rhs.get());
+        }
+
+        TIMEMORY_HOT_REFERENCE_ASSIGN_OPERATOR(+=)
+        TIMEMORY_HOT_REFERENCE_ASSIGN_OPERATOR(-=)
+        TIMEMORY_HOT_REFERENCE_ASSIGN_OPERATOR(*=)
+        TIMEMORY_HOT_REFERENCE_ASSIGN_OPERATOR(/=)
+        TIMEMORY_HOT_REFERENCE_ASSIGN_OPERATOR(%=)
+        TIMEMORY_HOT_REFERENCE_ASSIGN_OPERATOR(&=)
+        TIMEMORY_HOT_REFERENCE_ASSIGN_OPERATOR(|=)
+        TIMEMORY_HOT_REFERENCE_ASSIGN_OPERATOR(^=)
+        TIMEMORY_HOT_REFERENCE_ASSIGN_OPERATOR(<<=)
+        TIMEMORY_HOT_REFERENCE_ASSIGN_OPERATOR(>>=)
+
+        hot_reference& operator++() { return (*this += 1); }
+        hot_reference& operator--() { return (*this -= 1); }
+
+        Tp operator++(int)
+        {
+            Tp _prev = m_value;
+            ++(*this);
+            return _prev;
+        }
+
+        Tp operator--(int)
+        {
+            Tp _prev = m_value;
+            --(*this);
+            return _prev;
+        }
+
+        operator const Tp&() const { return m_value; }
+        const Tp& get() const { return m_value; }
+
+    private:
+        Tp& m_value;
+    };
+
+#undef TIMEMORY_HOT_REFERENCE_ASSIGN_OPERATOR
+
     //==================================================================================//
     //
     //                  GENERAL SETTINGS THAT APPLY TO MULTIPLE COMPONENTS
@@ -97,9 +199,9 @@ struct TIMEMORY_SETTINGS_DLL settings
     // logical settings
     TIMEMORY_MEMBER_STATIC_ACCESSOR(bool, suppress_parsing, "TIMEMORY_SUPPRESS_PARSING",
                                     "Disable parsing environment", false)
-    TIMEMORY_MEMBER_STATIC_ACCESSOR(bool, enabled, "TIMEMORY_ENABLED",
-                                    "Activation state of timemory",
-                                    TIMEMORY_DEFAULT_ENABLED)
+    TIMEMORY_MEMBER_STATIC_HOT_ACCESSOR(bool, enabled, "TIMEMORY_ENABLED",
+                                        "Activation state of timemory",
+                                        TIMEMORY_DEFAULT_ENABLED)
     TIMEMORY_MEMBER_STATIC_ACCESSOR(bool, auto_output, "TIMEMORY_AUTO_OUTPUT",
                                     "Generate output at application termination", true)
     TIMEMORY_MEMBER_STATIC_ACCESSOR(bool, cout_output, "TIMEMORY_COUT_OUTPUT",
@@ -110,6 +212,8 @@ struct TIMEMORY_SETTINGS_DLL settings
                                     "Write text output files", true)
     TIMEMORY_MEMBER_STATIC_ACCESSOR(bool, json_output, "TIMEMORY_JSON_OUTPUT",
                                     "Write json output files", true)
+    TIMEMORY_MEMBER_STATIC_ACCESSOR(bool, binary_output, "TIMEMORY_BINARY_OUTPUT",
+                                    "Write compact, columnar binary output files", false)
     TIMEMORY_MEMBER_STATIC_ACCESSOR(bool, dart_output, "TIMEMORY_DART_OUTPUT",
                                     "Write dart measurements for CDash", false)
     TIMEMORY_MEMBER_STATIC_ACCESSOR(
@@ -128,10 +232,10 @@ struct TIMEMORY_SETTINGS_DLL settings
         "Write a json output for flamegraph visualization (use chrome://tracing)", true)
 
     // general settings
-    TIMEMORY_MEMBER_STATIC_ACCESSOR(int, verbose, "TIMEMORY_VERBOSE", "Verbosity level",
-                                    0)
-    TIMEMORY_MEMBER_STATIC_ACCESSOR(bool, debug, "TIMEMORY_DEBUG", "Enable debug output",
-                                    false)
+    TIMEMORY_MEMBER_STATIC_HOT_ACCESSOR(int, verbose, "TIMEMORY_VERBOSE",
+                                        "Verbosity level", 0)
+    TIMEMORY_MEMBER_STATIC_HOT_ACCESSOR(bool, debug, "TIMEMORY_DEBUG",
+                                        "Enable debug output", false)
     TIMEMORY_MEMBER_STATIC_ACCESSOR(bool, banner, "TIMEMORY_BANNER",
                                     "Notify about tim::manager creation and destruction",
                                     (get_env<bool>("TIMEMORY_LIBRARY_CTOR", true)))
@@ -151,6 +255,11 @@ struct TIMEMORY_SETTINGS_DLL settings
                                     "TIMEMORY_COLLAPSE_PROCESSES",
                                     "Enable/disable combining process-specific data",
                                     true)
+    TIMEMORY_MEMBER_STATIC_ACCESSOR(
+        uint64_t, finalize_threads, "TIMEMORY_FINALIZE_THREADS",
+        "Number of threads used to convert and write the output of the components "
+        "during finalization (values <= 1 generate the output serially)",
+        1)
     TIMEMORY_MEMBER_STATIC_ACCESSOR(uint16_t, max_depth, "TIMEMORY_MAX_DEPTH",
                                     "Set the maximum depth of label hierarchy reporting",
                                     std::numeric_limits<uint16_t>::max())
@@ -263,9 +372,24 @@ struct TIMEMORY_SETTINGS_DLL settings
         bool, stack_clearing, "TIMEMORY_STACK_CLEARING",
         "Enable/disable stopping any markers still running during finalization", true)
 
-    TIMEMORY_MEMBER_STATIC_ACCESSOR(
+    TIMEMORY_MEMBER_STATIC_HOT_ACCESSOR(
         bool, add_secondary, "TIMEMORY_ADD_SECONDARY",
         "Enable/disable components adding secondary (child) entries", true)
+    TIMEMORY_MEMBER_STATIC_ACCESSOR(
+        string_t, live_socket, "TIMEMORY_LIVE_SOCKET",
+        "Path of a Unix domain socket serving snapshots of the running process (see "
+        "also: timemory-live)",
+        "")
+    TIMEMORY_MEMBER_STATIC_ACCESSOR(
+        uint64_t, checkpoint_interval, "TIMEMORY_CHECKPOINT_INTERVAL",
+        "Seconds between the incremental checkpoints of the running process (see also: "
+        "timemory-checkpoint)",
+        0)
+    TIMEMORY_MEMBER_STATIC_ACCESSOR(
+        int32_t, checkpoint_signal, "TIMEMORY_CHECKPOINT_SIGNAL",
+        "Signal number which triggers an incremental checkpoint, e.g. 10 for SIGUSR1 on "
+        "Linux (see also: TIMEMORY_CHECKPOINT_INTERVAL)",
+        0)
 
     TIMEMORY_MEMBER_STATIC_ACCESSOR(size_t, throttle_count, "TIMEMORY_THROTTLE_COUNT",
                                     "Minimum number of laps before throttling", 10000)
@@ -276,6 +400,12 @@ struct TIMEMORY_SETTINGS_DLL settings
         "throttling",
         10000)
 
+    TIMEMORY_MEMBER_STATIC_ACCESSOR(
+        bool, overhead_compensation, "TIMEMORY_OVERHEAD_COMPENSATION",
+        "Subtract the calibrated cost of the nested start/stop pairs from the inclusive "
+        "values of the timing components",
+        false)
+
     //==================================================================================//
     //
     //                          COMPONENT SETTINGS
@@ -374,6 +504,24 @@ struct TIMEMORY_SETTINGS_DLL settings
                                     "TIMEMORY_MPI_INIT and TIMEMORY_MPI_THREAD)",
                                     "")
 
+    /// reduce a per-region summary instead of gathering the call-graphs of every rank
+    TIMEMORY_MEMBER_STATIC_ACCESSOR(
+        bool, mpi_imbalance, "TIMEMORY_MPI_IMBALANCE",
+        "Only reduce a per-region load-imbalance summary across the ranks instead of "
+        "gathering the call-graph of every rank",
+        false)
+
+    /// each rank writes its own output files
+    TIMEMORY_MEMBER_STATIC_ACCESSOR(bool, mpi_output_per_rank,
+                                    "TIMEMORY_MPI_OUTPUT_PER_RANK",
+                                    "Generate MPI output per-rank (skip aggregation)",
+                                    false)
+
+    /// the ranks on a node are aggregated in shared memory and one rank per node writes
+    TIMEMORY_MEMBER_STATIC_ACCESSOR(bool, mpi_output_per_node,
+                                    "TIMEMORY_MPI_OUTPUT_PER_NODE",
+                                    "Aggregate MPI output per-node", false)
+
     //----------------------------------------------------------------------------------//
     //      UPC++
     //----------------------------------------------------------------------------------//
@@ -427,6 +575,32 @@ struct TIMEMORY_SETTINGS_DLL settings
         int, papi_overflow, "TIMEMORY_PAPI_OVERFLOW",
         "Value at which PAPI hw counters trigger an overflow callback", 0)
 
+    //----------------------------------------------------------------------------------//
+    //      perf_event_open
+    //----------------------------------------------------------------------------------//
+
+    /// perf_event hardware/software counters
+    TIMEMORY_MEMBER_STATIC_ACCESSOR(
+        string_t, perf_events, "TIMEMORY_PERF_EVENTS",
+        "perf_event_open events to collect, e.g. 'cycles,instructions,r01c7' (see "
+        "also: perf list)",
+        "")
+
+    /// read perf_event counters from user-space with rdpmc when possible
+    TIMEMORY_MEMBER_STATIC_ACCESSOR(
+        bool, perf_rdpmc, "TIMEMORY_PERF_RDPMC",
+        "Read perf_event counters with rdpmc via the mmap page when available", true)
+
+    //----------------------------------------------------------------------------------//
+    //      NUMA
+    //----------------------------------------------------------------------------------//
+
+    /// maximum number of pages queried per snapshot by numa_locality
+    TIMEMORY_MEMBER_STATIC_ACCESSOR(
+        uint64_t, numa_max_pages, "TIMEMORY_NUMA_MAX_PAGES",
+        "Maximum number of pages sampled per snapshot by the numa_locality component",
+        1024)
+
     //----------------------------------------------------------------------------------//
     //      CUDA / CUPTI
     //----------------------------------------------------------------------------------//
@@ -604,6 +778,38 @@ struct TIMEMORY_SETTINGS_DLL settings
         string_t, ert_skip_ops, "TIMEMORY_ERT_SKIP_OPS",
         "Skip these number of ops (i.e. ERT_FLOPS) when were set at compile time", "")
 
+    /// set the instruction set of the vectorized CPU kernels
+    TIMEMORY_MEMBER_STATIC_ACCESSOR(
+        string_t, ert_simd_isa, "TIMEMORY_ERT_SIMD_ISA",
+        "Instruction set used by the ERT CPU kernels (scalar, sse, avx, avx2, avx512, "
+        "neon). Empty == detected at runtime",
+        "")
+
+    /// enable the persistent cache of ERT results
+    TIMEMORY_MEMBER_STATIC_ACCESSOR(
+        bool, ert_cache, "TIMEMORY_ERT_CACHE",
+        "Load/store the ERT results from/to a cache keyed by the CPU, ERT settings, and "
+        "compiler signature",
+        true)
+
+    /// directory of the persistent ERT cache
+    TIMEMORY_MEMBER_STATIC_ACCESSOR(
+        string_t, ert_cache_path, "TIMEMORY_ERT_CACHE_PATH",
+        "Directory of the ERT cache. Empty == ${XDG_CACHE_HOME:-${HOME}/.cache}/timemory",
+        "")
+
+    /// force the ERT to run and overwrite the cached results
+    TIMEMORY_MEMBER_STATIC_ACCESSOR(bool, ert_cache_refresh, "TIMEMORY_ERT_CACHE_REFRESH",
+                                    "Ignore any cached ERT results and regenerate them",
+                                    false)
+
+    /// age after which the cached ERT results are flagged as stale
+    TIMEMORY_MEMBER_STATIC_ACCESSOR(
+        uint64_t, ert_cache_max_age, "TIMEMORY_ERT_CACHE_MAX_AGE",
+        "Age (in seconds) after which cached ERT results are flagged as stale "
+        "(0 == never)",
+        7 * 24 * 60 * 60)
+
     //----------------------------------------------------------------------------------//
     //      Craypat
     //----------------------------------------------------------------------------------//
@@ -613,6 +819,17 @@ struct TIMEMORY_SETTINGS_DLL settings
                                     "Configure the CrayPAT categories to collect",
                                     get_env<std::string>("PAT_RT_PERFCTR", ""))
 
+    //----------------------------------------------------------------------------------//
+    //      Memory allocations
+    //----------------------------------------------------------------------------------//
+
+    /// mean number of bytes between the allocations sampled by malloc_gotcha
+    TIMEMORY_MEMBER_STATIC_ACCESSOR(
+        uint64_t, heap_sample_rate, "TIMEMORY_HEAP_SAMPLE_RATE",
+        "Mean number of bytes between the allocations sampled by malloc_gotcha "
+        "(0 == every allocation)",
+        512 * 1024)
+
     //----------------------------------------------------------------------------------//
     //      Signals
     //----------------------------------------------------------------------------------//
@@ -650,7 +867,7 @@ struct TIMEMORY_SETTINGS_DLL settings
     //----------------------------------------------------------------------------------//
 
     /// default setting for auto_{list,tuple,hybrid} "report_at_exit" member variable
-    TIMEMORY_MEMBER_STATIC_ACCESSOR(
+    TIMEMORY_MEMBER_STATIC_HOT_ACCESSOR(
         bool, destructor_report, "TIMEMORY_DESTRUCTOR_REPORT",
         "Configure default setting for auto_{list,tuple,hybrid} to write to stdout during"
         " destruction of the bundle",
@@ -762,6 +979,38 @@ settings::instance()
 //
 //----------------------------------------------------------------------------------//
 //
+inline std::atomic<uint64_t>&
+settings::get_epoch()
+{
+    // starts at one so that a default-constructed hot_settings is always refreshed
+    static std::atomic<uint64_t> _instance{ 1 };
+    return _instance;
+}
+//
+//----------------------------------------------------------------------------------//
+//
+inline const settings::hot_settings&
+settings::hot()
+{
+    static thread_local hot_settings _instance{};
+    auto _epoch = get_epoch().load(std::memory_order_acquire);
+    if(_instance.epoch != _epoch)
+    {
+        if(auto* _settings = instance())
+        {
+            _instance.verbose           = _settings->m__verbose;
+            _instance.enabled           = _settings->m__enabled;
+            _instance.debug             = _settings->m__debug;
+            _instance.add_secondary     = _settings->m__add_secondary;
+            _instance.destructor_report = _settings->m__destructor_report;
+        }
+        _instance.epoch = _epoch;
+    }
+    return _instance;
+}
+//
+//----------------------------------------------------------------------------------//
+//
 template <size_t Idx>
 int64_t
 settings::indent_width(int64_t _w)
@@ -804,24 +1053,26 @@ void
 settings::serialize(Archive& ar, const unsigned int)
 {
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_SUPPRESS_PARSING", suppress_parsing)
-    TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_ENABLED", enabled)
+    TIMEMORY_SETTINGS_TRY_CATCH_HOT_NVP("TIMEMORY_ENABLED", enabled)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_AUTO_OUTPUT", auto_output)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_COUT_OUTPUT", cout_output)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_FILE_OUTPUT", file_output)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_TEXT_OUTPUT", text_output)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_JSON_OUTPUT", json_output)
+    TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_BINARY_OUTPUT", binary_output)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_DART_OUTPUT", dart_output)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_TIME_OUTPUT", time_output)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_PLOT_OUTPUT", plot_output)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_DIFF_OUTPUT", diff_output)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_FLAMEGRAPH_OUTPUT", flamegraph_output)
-    TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_VERBOSE", verbose)
-    TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_DEBUG", debug)
+    TIMEMORY_SETTINGS_TRY_CATCH_HOT_NVP("TIMEMORY_VERBOSE", verbose)
+    TIMEMORY_SETTINGS_TRY_CATCH_HOT_NVP("TIMEMORY_DEBUG", debug)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_BANNER", banner)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_FLAT_PROFILE", flat_profile)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_TIMELINE_PROFILE", timeline_profile)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_COLLAPSE_THREADS", collapse_threads)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_COLLAPSE_PROCESSES", collapse_processes)
+    TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_FINALIZE_THREADS", finalize_threads)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_MAX_DEPTH", max_depth)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_TIME_FORMAT", time_format)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_PRECISION", precision)
@@ -848,9 +1099,14 @@ settings::serialize(Archive& ar, const unsigned int)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_MAX_THREAD_BOOKMARKS", max_thread_bookmarks)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_TARGET_PID", target_pid)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_STACK_CLEARING", stack_clearing)
-    TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_ADD_SECONDARY", add_secondary)
+    TIMEMORY_SETTINGS_TRY_CATCH_HOT_NVP("TIMEMORY_ADD_SECONDARY", add_secondary)
+    TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_LIVE_SOCKET", live_socket)
+    TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_CHECKPOINT_INTERVAL", checkpoint_interval)
+    TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_CHECKPOINT_SIGNAL", checkpoint_signal)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_THROTTLE_COUNT", throttle_count)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_THROTTLE_VALUE", throttle_value)
+    TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_OVERHEAD_COMPENSATION",
+                                    overhead_compensation)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_GLOBAL_COMPONENTS", global_components)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_TUPLE_COMPONENTS", tuple_components)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_LIST_COMPONENTS", list_components)
@@ -863,6 +1119,9 @@ settings::serialize(Archive& ar, const unsigned int)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_MPI_FINALIZE", mpi_finalize)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_MPI_THREAD", mpi_thread)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_MPI_THREAD_TYPE", mpi_thread_type)
+    TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_MPI_IMBALANCE", mpi_imbalance)
+    TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_MPI_OUTPUT_PER_RANK", mpi_output_per_rank)
+    TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_MPI_OUTPUT_PER_NODE", mpi_output_per_node)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_UPCXX_INIT", upcxx_init)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_UPCXX_FINALIZE", upcxx_finalize)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_PAPI_MULTIPLEXING", papi_multiplexing)
@@ -871,6 +1130,9 @@ settings::serialize(Archive& ar, const unsigned int)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_PAPI_EVENTS", papi_events)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_PAPI_ATTACH", papi_attach)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_PAPI_OVERFLOW", papi_overflow)
+    TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_PERF_EVENTS", perf_events)
+    TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_PERF_RDPMC", perf_rdpmc)
+    TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_NUMA_MAX_PAGES", numa_max_pages)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_CUDA_EVENT_BATCH_SIZE",
                                     cuda_event_batch_size)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_NVTX_MARKER_DEVICE_SYNC",
@@ -909,13 +1171,19 @@ settings::serialize(Archive& ar, const unsigned int)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_ERT_MAX_DATA_SIZE_GPU",
                                     ert_max_data_size_gpu)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_ERT_SKIP_OPS", ert_skip_ops)
+    TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_ERT_SIMD_ISA", ert_simd_isa)
+    TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_ERT_CACHE", ert_cache)
+    TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_ERT_CACHE_PATH", ert_cache_path)
+    TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_ERT_CACHE_REFRESH", ert_cache_refresh)
+    TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_ERT_CACHE_MAX_AGE", ert_cache_max_age)
+    TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_HEAP_SAMPLE_RATE", heap_sample_rate)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_ALLOW_SIGNAL_HANDLER", allow_signal_handler)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_ENABLE_SIGNAL_HANDLER",
                                     enable_signal_handler)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_ENABLE_ALL_SIGNALS", enable_all_signals)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_DISABLE_ALL_SIGNALS", disable_all_signals)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_NODE_COUNT", node_count)
-    TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_DESTRUCTOR_REPORT", destructor_report)
+    TIMEMORY_SETTINGS_TRY_CATCH_HOT_NVP("TIMEMORY_DESTRUCTOR_REPORT", destructor_report)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_PYTHON_EXE", python_exe)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_COMMAND_LINE", command_line)
     TIMEMORY_SETTINGS_TRY_CATCH_NVP("TIMEMORY_ENVIRONMENT", environment)
@@ -241,6 +241,7 @@ settings::parse()
             std::cerr << "Executing parse callback for: " << itr.first << std::endl;
         itr.second();
     }
+    update_epoch();
 }
 //
 //----------------------------------------------------------------------------------//
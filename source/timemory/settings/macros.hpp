@@ -109,6 +109,31 @@
 //
 //--------------------------------------------------------------------------------------//
 //
+#if !defined(TIMEMORY_MEMBER_STATIC_HOT_ACCESSOR)
+/// same as TIMEMORY_MEMBER_STATIC_ACCESSOR for the settings which are copied into the
+/// thread-local settings::hot() snapshot: the accessor returns a hot_reference so that
+/// reading the value has no side-effect and assigning a value invalidates the
+/// snapshots after the value is stored
+#    define TIMEMORY_MEMBER_STATIC_HOT_ACCESSOR(TYPE, FUNC, ENV_VAR, DESC, INIT)         \
+    public:                                                                              \
+        static hot_reference<TYPE> FUNC()                                                \
+        {                                                                                \
+            return hot_reference<TYPE>{ instance()->m__##FUNC };                         \
+        }                                                                                \
+                                                                                         \
+    private:                                                                             \
+        TYPE generate__##FUNC()                                                          \
+        {                                                                                \
+            auto _parse = []() { FUNC() = tim::get_env<TYPE>(ENV_VAR, FUNC()); };        \
+            get_setting_descriptions()[ENV_VAR] = DESC;                                  \
+            get_parse_callbacks()[ENV_VAR]      = _parse;                                \
+            return get_env<TYPE>(ENV_VAR, INIT);                                         \
+        }                                                                                \
+        TYPE m__##FUNC = generate__##FUNC();
+#endif
+//
+//--------------------------------------------------------------------------------------//
+//
 #if !defined(TIMEMORY_MEMBER_STATIC_REFERENCE)
 #    define TIMEMORY_MEMBER_STATIC_REFERENCE(TYPE, FUNC, ENV_VAR, DESC, GETTER, SETTER)  \
     public:                                                                              \
@@ -153,6 +178,21 @@
 //
 //--------------------------------------------------------------------------------------//
 //
+#if !defined(TIMEMORY_SETTINGS_TRY_CATCH_HOT_NVP)
+/// the value is assigned back through the hot_reference so that loading the settings
+/// invalidates the settings::hot() snapshots
+#    define TIMEMORY_SETTINGS_TRY_CATCH_HOT_NVP(ENV_VAR, FUNC)                           \
+        try                                                                              \
+        {                                                                                \
+            auto _VAL = FUNC().get();                                                    \
+            ar(cereal::make_nvp(ENV_VAR, _VAL));                                         \
+            FUNC() = _VAL;                                                               \
+        } catch(...)                                                                     \
+        {}
+#endif
+//
+//--------------------------------------------------------------------------------------//
+//
 #if !defined(TIMEMORY_SETTINGS_EXTERN_TEMPLATE)
 //
 #    if defined(TIMEMORY_SETTINGS_SOURCE)
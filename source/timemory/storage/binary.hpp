@@ -0,0 +1,934 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/** \file timemory/storage/binary.hpp
+ * \headerfile timemory/storage/binary.hpp "timemory/storage/binary.hpp"
+ * Compact, columnar binary format for the storage results. The file is laid out as:
+ *
+ *      file_header | string table | metadata | table headers | column headers | data
+ *
+ * where there is one table per rank and one column per field of the result nodes
+ * (hash, depth, tid, pid, laps, value, stats, etc.). The prefixes are stored once in
+ * the string table and referenced by offset. Columns of fixed-size rows are stored
+ * contiguously (64-byte aligned) so the reader can return pointers directly into the
+ * memory-mapped file; variable-size rows are stored as a blob + offset index.
+ *
+ * This header only depends on the standard library (and mmap) so that stand-alone
+ * tools can diff and merge the files without the component definitions.
+ *
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__unix) || defined(unix) ||                             \
+    (defined(__APPLE__) && defined(__MACH__))
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#    define TIMEMORY_BINARY_USE_MMAP
+#endif
+
+namespace tim
+{
+namespace binary
+{
+//
+//--------------------------------------------------------------------------------------//
+//
+static constexpr uint32_t format_version = 1;
+static constexpr uint32_t endian_marker  = 0x01020304;
+static constexpr uint64_t alignment      = 64;
+//
+inline const char*
+get_magic()
+{
+    return "TIMEMORY";
+}
+//
+inline std::string
+get_extension()
+{
+    return ".bin";
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+enum class elem_type : uint32_t
+{
+    opaque = 0,
+    boolean,
+    int8,
+    uint8,
+    int16,
+    uint16,
+    int32,
+    uint32,
+    int64,
+    uint64,
+    float32,
+    float64,
+    float128
+};
+//
+enum class column_kind : uint32_t
+{
+    fixed = 0,  // every row is 'stride' bytes
+    blob  = 1,  // rows are variable length, see column_header::index_offset
+};
+//
+inline const char*
+get_name(elem_type _type)
+{
+    switch(_type)
+    {
+        case elem_type::opaque: return "opaque";
+        case elem_type::boolean: return "bool";
+        case elem_type::int8: return "int8";
+        case elem_type::uint8: return "uint8";
+        case elem_type::int16: return "int16";
+        case elem_type::uint16: return "uint16";
+        case elem_type::int32: return "int32";
+        case elem_type::uint32: return "uint32";
+        case elem_type::int64: return "int64";
+        case elem_type::uint64: return "uint64";
+        case elem_type::float32: return "float32";
+        case elem_type::float64: return "float64";
+        case elem_type::float128: return "float128";
+    }
+    return "unknown";
+}
+//
+inline size_t
+get_size(elem_type _type)
+{
+    switch(_type)
+    {
+        case elem_type::opaque: return 1;
+        case elem_type::boolean: return sizeof(bool);
+        case elem_type::int8:
+        case elem_type::uint8: return 1;
+        case elem_type::int16:
+        case elem_type::uint16: return 2;
+        case elem_type::int32:
+        case elem_type::uint32:
+        case elem_type::float32: return 4;
+        case elem_type::int64:
+        case elem_type::uint64:
+        case elem_type::float64: return 8;
+        case elem_type::float128: return sizeof(long double);
+    }
+    return 1;
+}
+//
+template <typename Tp>
+constexpr elem_type
+get_elem_type()
+{
+    using type = typename std::remove_cv<Tp>::type;
+    return (std::is_same<type, bool>::value)
+               ? elem_type::boolean
+               : (std::is_floating_point<type>::value)
+                     ? ((sizeof(type) == 4)
+                            ? elem_type::float32
+                            : (sizeof(type) == 8)
+                                  ? elem_type::float64
+                                  : (std::is_same<type, long double>::value)
+                                        ? elem_type::float128
+                                        : elem_type::opaque)
+                     : (std::is_integral<type>::value)
+                           ? ((sizeof(type) == 1)
+                                  ? ((std::is_signed<type>::value) ? elem_type::int8
+                                                                   : elem_type::uint8)
+                                  : (sizeof(type) == 2)
+                                        ? ((std::is_signed<type>::value)
+                                               ? elem_type::int16
+                                               : elem_type::uint16)
+                                        : (sizeof(type) == 4)
+                                              ? ((std::is_signed<type>::value)
+                                                     ? elem_type::int32
+                                                     : elem_type::uint32)
+                                              : ((std::is_signed<type>::value)
+                                                     ? elem_type::int64
+                                                     : elem_type::uint64))
+                           : elem_type::opaque;
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+//  On-disk structures. All offsets are relative to the start of the file and all
+//  strings are offsets into the string table
+//
+//--------------------------------------------------------------------------------------//
+//
+struct file_header
+{
+    char     magic[8]      = { 'T', 'I', 'M', 'E', 'M', 'O', 'R', 'Y' };
+    uint32_t version       = format_version;
+    uint32_t endian        = endian_marker;
+    uint64_t strtab_offset = 0;
+    uint64_t strtab_size   = 0;
+    uint64_t meta_offset   = 0;  // array of metadata_entry
+    uint64_t num_meta      = 0;
+    uint64_t table_offset  = 0;  // array of table_header
+    uint64_t num_tables    = 0;
+};
+//
+struct metadata_entry
+{
+    uint64_t key   = 0;
+    uint64_t value = 0;
+};
+//
+struct table_header
+{
+    uint64_t rank          = 0;
+    uint64_t num_rows      = 0;
+    uint64_t column_offset = 0;  // array of column_header
+    uint64_t num_columns   = 0;
+};
+//
+struct column_header
+{
+    uint64_t name         = 0;
+    uint32_t kind         = static_cast<uint32_t>(column_kind::fixed);
+    uint32_t type         = static_cast<uint32_t>(elem_type::opaque);
+    uint32_t count        = 0;  // number of elements per row (fixed)
+    uint32_t stride       = 0;  // number of bytes per row (fixed)
+    uint64_t data_offset  = 0;
+    uint64_t data_size    = 0;
+    uint64_t index_offset = 0;  // num_rows + 1 offsets into the data (blob)
+};
+//
+static_assert(sizeof(file_header) == 64, "Unexpected padding in file_header");
+static_assert(sizeof(table_header) == 32, "Unexpected padding in table_header");
+static_assert(sizeof(column_header) == 48, "Unexpected padding in column_header");
+//
+//--------------------------------------------------------------------------------------//
+//
+//  Describes how a value is stored in a column. Arithmetic values and fixed-size
+//  arrays/pairs of arithmetic values are stored in fixed-size rows, empty types are
+//  not stored, and everything else is a blob (serialized by the caller)
+//
+//--------------------------------------------------------------------------------------//
+//
+template <typename Tp, typename = void>
+struct column_traits
+{
+    static constexpr bool      is_empty = std::is_empty<Tp>::value;
+    static constexpr bool      is_fixed = false;
+    static constexpr elem_type type     = elem_type::opaque;
+    static constexpr uint32_t  count    = 0;
+};
+//
+template <typename Tp>
+struct column_traits<Tp, typename std::enable_if<std::is_arithmetic<Tp>::value>::type>
+{
+    static constexpr bool      is_empty = false;
+    static constexpr bool      is_fixed = true;
+    static constexpr elem_type type     = get_elem_type<Tp>();
+    static constexpr uint32_t  count    = 1;
+
+    static void write(char* _dst, const Tp& _val) { memcpy(_dst, &_val, sizeof(Tp)); }
+    static void read(const char* _src, Tp& _val) { memcpy(&_val, _src, sizeof(Tp)); }
+};
+//
+template <typename Tp, size_t N>
+struct column_traits<std::array<Tp, N>,
+                     typename std::enable_if<std::is_arithmetic<Tp>::value>::type>
+{
+    static constexpr bool      is_empty = (N == 0);
+    static constexpr bool      is_fixed = true;
+    static constexpr elem_type type     = get_elem_type<Tp>();
+    static constexpr uint32_t  count    = N;
+
+    static void write(char* _dst, const std::array<Tp, N>& _val)
+    {
+        memcpy(_dst, _val.data(), N * sizeof(Tp));
+    }
+    static void read(const char* _src, std::array<Tp, N>& _val)
+    {
+        memcpy(_val.data(), _src, N * sizeof(Tp));
+    }
+};
+//
+template <typename Tp>
+struct column_traits<std::pair<Tp, Tp>,
+                     typename std::enable_if<std::is_arithmetic<Tp>::value>::type>
+{
+    static constexpr bool      is_empty = false;
+    static constexpr bool      is_fixed = true;
+    static constexpr elem_type type     = get_elem_type<Tp>();
+    static constexpr uint32_t  count    = 2;
+
+    static void write(char* _dst, const std::pair<Tp, Tp>& _val)
+    {
+        memcpy(_dst, &_val.first, sizeof(Tp));
+        memcpy(_dst + sizeof(Tp), &_val.second, sizeof(Tp));
+    }
+    static void read(const char* _src, std::pair<Tp, Tp>& _val)
+    {
+        memcpy(&_val.first, _src, sizeof(Tp));
+        memcpy(&_val.second, _src + sizeof(Tp), sizeof(Tp));
+    }
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+//                                      WRITER
+//
+//--------------------------------------------------------------------------------------//
+//
+struct column
+{
+    std::string           name   = "";
+    column_kind           kind   = column_kind::fixed;
+    elem_type             type   = elem_type::opaque;
+    uint32_t              count  = 0;
+    uint32_t              stride = 0;
+    std::vector<char>     data   = {};
+    std::vector<uint64_t> index  = {};
+
+    size_t size() const
+    {
+        return (kind == column_kind::fixed) ? ((stride > 0) ? data.size() / stride : 0)
+                                            : ((index.empty()) ? 0 : index.size() - 1);
+    }
+
+    /// reserve space for a fixed-size column with the given number of rows and return
+    /// the pointer to the first row
+    char* resize(size_t _nrows)
+    {
+        data.resize(_nrows * stride, 0);
+        return data.data();
+    }
+
+    /// append a variable-length row
+    void push_back(const char* _data, size_t _size)
+    {
+        if(index.empty())
+            index.push_back(0);
+        data.insert(data.end(), _data, _data + _size);
+        index.push_back(data.size());
+    }
+
+    template <typename Tp>
+    static column make_fixed(const std::string& _name)
+    {
+        using traits_type = column_traits<Tp>;
+        static_assert(traits_type::is_fixed, "Column type is not fixed-size");
+        column _col{};
+        _col.name   = _name;
+        _col.kind   = column_kind::fixed;
+        _col.type   = traits_type::type;
+        _col.count  = traits_type::count;
+        _col.stride = traits_type::count * get_size(traits_type::type);
+        return _col;
+    }
+
+    static column make_fixed(const std::string& _name, elem_type _type, uint32_t _count,
+                             uint32_t _stride)
+    {
+        column _col{};
+        _col.name   = _name;
+        _col.kind   = column_kind::fixed;
+        _col.type   = _type;
+        _col.count  = _count;
+        _col.stride = _stride;
+        return _col;
+    }
+
+    static column make_blob(const std::string& _name)
+    {
+        column _col{};
+        _col.name  = _name;
+        _col.kind  = column_kind::blob;
+        _col.index = { 0 };
+        return _col;
+    }
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+struct table
+{
+    uint64_t            rank     = 0;
+    uint64_t            num_rows = 0;
+    std::vector<column> columns  = {};
+
+    column& add(column&& _col)
+    {
+        columns.emplace_back(std::move(_col));
+        return columns.back();
+    }
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+class writer
+{
+public:
+    using metadata_t = std::vector<std::pair<std::string, std::string>>;
+
+    writer()
+    {
+        // offset zero is always the empty string
+        m_strtab.push_back('\0');
+        m_strings.emplace(std::string{}, 0);
+    }
+
+    /// add a string to the string table (deduplicated) and return its offset
+    uint64_t add_string(const std::string& _str)
+    {
+        auto itr = m_strings.find(_str);
+        if(itr != m_strings.end())
+            return itr->second;
+        uint64_t _offset = m_strtab.size();
+        m_strtab.insert(m_strtab.end(), _str.begin(), _str.end());
+        m_strtab.push_back('\0');
+        m_strings.emplace(_str, _offset);
+        return _offset;
+    }
+
+    void add_metadata(const std::string& _key, const std::string& _value)
+    {
+        m_metadata.emplace_back(_key, _value);
+    }
+
+    table& add_table(uint64_t _rank, uint64_t _nrows)
+    {
+        m_tables.emplace_back(table{ _rank, _nrows, {} });
+        return m_tables.back();
+    }
+
+    std::vector<table>&       get_tables() { return m_tables; }
+    const std::vector<table>& get_tables() const { return m_tables; }
+    const metadata_t&         get_metadata() const { return m_metadata; }
+
+    /// write the file. Returns false if the file could not be opened or written
+    bool write(const std::string& _fname)
+    {
+        std::ofstream ofs(_fname.c_str(), std::ios::out | std::ios::binary);
+        if(!ofs)
+            return false;
+        return write(ofs);
+    }
+
+    bool write(std::ostream& os)
+    {
+        // make sure all the names are in the string table before computing the layout
+        std::vector<metadata_entry> _meta{};
+        for(const auto& itr : m_metadata)
+            _meta.push_back({ add_string(itr.first), add_string(itr.second) });
+        for(auto& titr : m_tables)
+            for(auto& citr : titr.columns)
+                add_string(citr.name);
+
+        auto _align = [](uint64_t _offset) {
+            return ((_offset + alignment - 1) / alignment) * alignment;
+        };
+
+        file_header _header{};
+        uint64_t    _offset = sizeof(file_header);
+
+        _header.strtab_offset = _offset;
+        _header.strtab_size   = m_strtab.size();
+        _offset               = _align(_offset + m_strtab.size());
+
+        _header.meta_offset = _offset;
+        _header.num_meta    = _meta.size();
+        _offset             = _align(_offset + _meta.size() * sizeof(metadata_entry));
+
+        _header.table_offset = _offset;
+        _header.num_tables   = m_tables.size();
+        _offset              = _align(_offset + m_tables.size() * sizeof(table_header));
+
+        std::vector<table_header>               _tables{};
+        std::vector<std::vector<column_header>> _columns{};
+        for(auto& titr : m_tables)
+        {
+            table_header _table{};
+            _table.rank          = titr.rank;
+            _table.num_rows      = titr.num_rows;
+            _table.column_offset = _offset;
+            _table.num_columns   = titr.columns.size();
+            _offset = _align(_offset + titr.columns.size() * sizeof(column_header));
+            _tables.emplace_back(_table);
+            _columns.emplace_back(std::vector<column_header>{});
+        }
+
+        for(size_t i = 0; i < m_tables.size(); ++i)
+        {
+            for(auto& citr : m_tables.at(i).columns)
+            {
+                if(citr.size() != m_tables.at(i).num_rows)
+                    return false;
+
+                column_header _column{};
+                _column.name        = add_string(citr.name);
+                _column.kind        = static_cast<uint32_t>(citr.kind);
+                _column.type        = static_cast<uint32_t>(citr.type);
+                _column.count       = citr.count;
+                _column.stride      = citr.stride;
+                _column.data_offset = _offset;
+                _column.data_size   = citr.data.size();
+                _offset             = _align(_offset + citr.data.size());
+                if(citr.kind == column_kind::blob)
+                {
+                    _column.index_offset = _offset;
+                    _offset = _align(_offset + citr.index.size() * sizeof(uint64_t));
+                }
+                _columns.at(i).emplace_back(_column);
+            }
+        }
+
+        // write everything in the same order as the layout
+        uint64_t _pos   = 0;
+        auto     _write = [&](const void* _data, uint64_t _size) {
+            os.write(static_cast<const char*>(_data), _size);
+            _pos += _size;
+        };
+        auto _pad = [&]() {
+            static const std::array<char, alignment> _zeros{};
+            auto                                     _npad = _align(_pos) - _pos;
+            if(_npad > 0)
+                _write(_zeros.data(), _npad);
+        };
+
+        _write(&_header, sizeof(file_header));
+        _write(m_strtab.data(), m_strtab.size());
+        _pad();
+        _write(_meta.data(), _meta.size() * sizeof(metadata_entry));
+        _pad();
+        _write(_tables.data(), _tables.size() * sizeof(table_header));
+        _pad();
+        for(const auto& itr : _columns)
+        {
+            _write(itr.data(), itr.size() * sizeof(column_header));
+            _pad();
+        }
+        for(const auto& titr : m_tables)
+        {
+            for(const auto& citr : titr.columns)
+            {
+                _write(citr.data.data(), citr.data.size());
+                _pad();
+                if(citr.kind == column_kind::blob)
+                {
+                    _write(citr.index.data(), citr.index.size() * sizeof(uint64_t));
+                    _pad();
+                }
+            }
+        }
+
+        return os.good() && _pos == _offset;
+    }
+
+private:
+    std::vector<char>                         m_strtab   = {};
+    std::unordered_map<std::string, uint64_t> m_strings  = {};
+    metadata_t                                m_metadata = {};
+    std::vector<table>                        m_tables   = {};
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+//                                      READER
+//
+//--------------------------------------------------------------------------------------//
+//
+/// read-only view of a file. Uses mmap when available and falls back to reading the
+/// entire file into memory
+class mapped_file
+{
+public:
+    mapped_file() = default;
+    explicit mapped_file(const std::string& _fname) { open(_fname); }
+    ~mapped_file() { close(); }
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    bool open(const std::string& _fname)
+    {
+        close();
+#if defined(TIMEMORY_BINARY_USE_MMAP)
+        int _fd = ::open(_fname.c_str(), O_RDONLY);
+        if(_fd < 0)
+            return false;
+        struct stat _stat;
+        if(fstat(_fd, &_stat) != 0 || _stat.st_size <= 0)
+        {
+            ::close(_fd);
+            return false;
+        }
+        m_size = static_cast<size_t>(_stat.st_size);
+        void* _addr = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, _fd, 0);
+        ::close(_fd);
+        if(_addr == MAP_FAILED)
+        {
+            m_size = 0;
+            return false;
+        }
+        m_data   = static_cast<const char*>(_addr);
+        m_mapped = true;
+        return true;
+#else
+        std::ifstream ifs(_fname.c_str(), std::ios::in | std::ios::binary);
+        if(!ifs)
+            return false;
+        ifs.seekg(0, std::ios::end);
+        auto _size = ifs.tellg();
+        ifs.seekg(0, std::ios::beg);
+        if(_size <= 0)
+            return false;
+        // use a 64-byte aligned buffer so that the columns are aligned
+        m_buffer.resize((static_cast<size_t>(_size) + alignment - 1) / alignment);
+        ifs.read(reinterpret_cast<char*>(m_buffer.data()), _size);
+        m_size = static_cast<size_t>(_size);
+        m_data = reinterpret_cast<const char*>(m_buffer.data());
+        return ifs.good();
+#endif
+    }
+
+    void close()
+    {
+#if defined(TIMEMORY_BINARY_USE_MMAP)
+        if(m_mapped && m_data)
+            munmap(const_cast<char*>(m_data), m_size);
+#endif
+        m_buffer.clear();
+        m_data   = nullptr;
+        m_size   = 0;
+        m_mapped = false;
+    }
+
+    const char* data() const { return m_data; }
+    size_t      size() const { return m_size; }
+    bool        is_mapped() const { return m_mapped; }
+
+private:
+    struct alignas(alignment) block
+    {
+        char data[alignment];
+    };
+
+    bool               m_mapped = false;
+    const char*        m_data   = nullptr;
+    size_t             m_size   = 0;
+    std::vector<block> m_buffer = {};
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+/// view of a single column of a table
+struct column_view
+{
+    const column_header* header = nullptr;
+    const char*          name   = "";
+    const char*          data   = nullptr;
+    const uint64_t*      index  = nullptr;
+    uint64_t             rows   = 0;
+
+    explicit operator bool() const { return header != nullptr; }
+
+    column_kind kind() const { return static_cast<column_kind>(header->kind); }
+    elem_type   type() const { return static_cast<elem_type>(header->type); }
+    uint32_t    count() const { return header->count; }
+    uint32_t    stride() const { return header->stride; }
+    uint64_t    size() const { return rows; }
+
+    /// pointer to the start of a row
+    const char* row(uint64_t i) const
+    {
+        return (kind() == column_kind::fixed) ? (data + i * stride()) : (data + index[i]);
+    }
+
+    /// number of bytes in a row
+    uint64_t row_size(uint64_t i) const
+    {
+        return (kind() == column_kind::fixed) ? stride() : (index[i + 1] - index[i]);
+    }
+
+    /// zero-copy access to fixed-size columns of arithmetic types
+    template <typename Tp>
+    const Tp* as() const
+    {
+        if(!header || kind() != column_kind::fixed || type() != get_elem_type<Tp>() ||
+           stride() != count() * sizeof(Tp))
+            return nullptr;
+        return reinterpret_cast<const Tp*>(data);
+    }
+
+    /// check whether the column stores values of type Tp
+    template <typename Tp>
+    bool holds() const
+    {
+        using traits_type = column_traits<Tp>;
+        if(!header)
+            return false;
+        if(traits_type::is_fixed)
+            return kind() == column_kind::fixed && type() == traits_type::type &&
+                   count() == traits_type::count && stride() == sizeof(Tp);
+        return kind() == column_kind::blob;
+    }
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+class reader;
+//
+/// view of the table for a single rank
+struct table_view
+{
+    const reader*        file    = nullptr;
+    const table_header*  header  = nullptr;
+    const column_header* columns = nullptr;
+
+    uint64_t rank() const { return header->rank; }
+    uint64_t size() const { return header->num_rows; }
+    uint64_t num_columns() const { return header->num_columns; }
+
+    inline column_view get_column(uint64_t i) const;
+    inline column_view find(const std::string& _name) const;
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+class reader
+{
+public:
+    reader() = default;
+    explicit reader(const std::string& _fname) { open(_fname); }
+
+    /// open and validate the file. Throws std::runtime_error on failure
+    void open(const std::string& _fname)
+    {
+        m_fname = _fname;
+        if(!m_file.open(_fname))
+            throw std::runtime_error("Unable to open binary file '" + _fname + "'");
+
+        auto _check = [&](bool _cond, const char* _msg) {
+            if(!_cond)
+                throw std::runtime_error("Invalid binary file '" + _fname + "': " + _msg);
+        };
+
+        _check(m_file.size() >= sizeof(file_header), "truncated header");
+        m_header = reinterpret_cast<const file_header*>(m_file.data());
+        _check(strncmp(m_header->magic, get_magic(), 8) == 0, "bad magic");
+        _check(m_header->endian == endian_marker, "endianness mismatch");
+        _check(m_header->version <= format_version, "unsupported version");
+        _check(in_bounds(m_header->strtab_offset, m_header->strtab_size) &&
+                   m_header->strtab_size > 0 &&
+                   m_file.data()[m_header->strtab_offset + m_header->strtab_size - 1] ==
+                       '\0',
+               "bad string table");
+        _check(in_bounds<metadata_entry>(m_header->meta_offset, m_header->num_meta),
+               "bad metadata");
+        _check(in_bounds<table_header>(m_header->table_offset, m_header->num_tables),
+               "bad table headers");
+
+        for(uint64_t i = 0; i < num_tables(); ++i)
+        {
+            auto _table = get_table(i);
+            auto _nrows = _table.size();
+            _check(in_bounds<column_header>(_table.header->column_offset,
+                                            _table.header->num_columns),
+                   "bad column headers");
+            for(uint64_t j = 0; j < _table.num_columns(); ++j)
+            {
+                const auto& _col = _table.columns[j];
+                _check(_col.name < m_header->strtab_size, "bad column name");
+                _check(_col.type <= static_cast<uint32_t>(elem_type::float128),
+                       "bad column type");
+                _check(in_bounds(_col.data_offset, _col.data_size), "bad column data");
+                if(_col.kind == static_cast<uint32_t>(column_kind::fixed))
+                {
+                    uint64_t _size = 0;
+                    _check(checked_multiply(_col.stride, _nrows, _size) &&
+                               _col.data_size == _size,
+                           "bad column size");
+                    // the rows are handed out as typed pointers
+                    auto _type = static_cast<elem_type>(_col.type);
+                    _check((_col.data_offset % get_size(_type)) == 0,
+                           "misaligned column data");
+                }
+                else
+                {
+                    _check(_col.kind == static_cast<uint32_t>(column_kind::blob),
+                           "bad column kind");
+                    // the rows are [index[i], index[i + 1]) so the offsets have to be
+                    // non-decreasing and the last one has to be the end of the data
+                    _check(_nrows < std::numeric_limits<uint64_t>::max() &&
+                               in_bounds<uint64_t>(_col.index_offset, _nrows + 1),
+                           "bad column index");
+                    auto _idx = reinterpret_cast<const uint64_t*>(m_file.data() +
+                                                                  _col.index_offset);
+                    for(uint64_t k = 0; k < _nrows; ++k)
+                        _check(_idx[k] <= _idx[k + 1], "bad column index");
+                    _check(_idx[_nrows] == _col.data_size, "bad column index");
+                }
+            }
+        }
+    }
+
+    const std::string& get_filename() const { return m_fname; }
+    const file_header& get_header() const { return *m_header; }
+    const char*        data() const { return m_file.data(); }
+
+    uint64_t num_tables() const { return m_header->num_tables; }
+
+    table_view get_table(uint64_t i) const
+    {
+        auto _offset = m_header->table_offset + i * sizeof(table_header);
+        auto _header = reinterpret_cast<const table_header*>(data() + _offset);
+        auto _column =
+            reinterpret_cast<const column_header*>(data() + _header->column_offset);
+        return table_view{ this, _header, _column };
+    }
+
+    /// get a string from the string table
+    const char* get_string(uint64_t _offset) const
+    {
+        return (_offset < m_header->strtab_size)
+                   ? (data() + m_header->strtab_offset + _offset)
+                   : "";
+    }
+
+    /// get a metadata value (empty if it does not exist)
+    std::string get_metadata(const std::string& _key) const
+    {
+        auto _meta = get_metadata_entries();
+        for(uint64_t i = 0; i < m_header->num_meta; ++i)
+        {
+            if(_key == get_string(_meta[i].key))
+                return get_string(_meta[i].value);
+        }
+        return std::string{};
+    }
+
+    std::vector<std::pair<std::string, std::string>> get_metadata() const
+    {
+        std::vector<std::pair<std::string, std::string>> _ret{};
+        auto _meta = get_metadata_entries();
+        for(uint64_t i = 0; i < m_header->num_meta; ++i)
+            _ret.emplace_back(get_string(_meta[i].key), get_string(_meta[i].value));
+        return _ret;
+    }
+
+private:
+    const metadata_entry* get_metadata_entries() const
+    {
+        return reinterpret_cast<const metadata_entry*>(data() + m_header->meta_offset);
+    }
+
+    bool in_bounds(uint64_t _offset, uint64_t _size) const
+    {
+        return _offset <= m_file.size() && _size <= m_file.size() - _offset;
+    }
+
+    /// an array of _count objects of type Tp at a suitably aligned offset
+    template <typename Tp>
+    bool in_bounds(uint64_t _offset, uint64_t _count) const
+    {
+        uint64_t _size = 0;
+        return (_offset % alignof(Tp)) == 0 &&
+               checked_multiply(_count, sizeof(Tp), _size) && in_bounds(_offset, _size);
+    }
+
+    static bool checked_multiply(uint64_t _lhs, uint64_t _rhs, uint64_t& _ret)
+    {
+        if(_lhs != 0 && _rhs > std::numeric_limits<uint64_t>::max() / _lhs)
+            return false;
+        _ret = _lhs * _rhs;
+        return true;
+    }
+
+private:
+    std::string        m_fname  = "";
+    mapped_file        m_file   = {};
+    const file_header* m_header = nullptr;
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+column_view
+table_view::get_column(uint64_t i) const
+{
+    const auto& _col = columns[i];
+    column_view _view{};
+    _view.header = &_col;
+    _view.name   = file->get_string(_col.name);
+    _view.data   = file->data() + _col.data_offset;
+    _view.rows   = size();
+    if(_col.kind == static_cast<uint32_t>(column_kind::blob))
+        _view.index = reinterpret_cast<const uint64_t*>(file->data() + _col.index_offset);
+    return _view;
+}
+//
+column_view
+table_view::find(const std::string& _name) const
+{
+    for(uint64_t i = 0; i < num_columns(); ++i)
+    {
+        if(_name == file->get_string(columns[i].name))
+            return get_column(i);
+    }
+    return column_view{};
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+/// minimal read-only streambuf over a block of memory. Used to deserialize blob rows
+/// directly from the mapped file without copying them
+struct memory_buffer : public std::streambuf
+{
+    memory_buffer(const char* _data, size_t _size)
+    {
+        auto _beg = const_cast<char*>(_data);
+        setg(_beg, _beg, _beg + _size);
+    }
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+}  // namespace binary
+}  // namespace tim
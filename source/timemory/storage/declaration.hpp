@@ -40,6 +40,9 @@
 #include "timemory/operations/types.hpp"
 #include "timemory/storage/graph.hpp"
 #include "timemory/storage/graph_data.hpp"
+#include "timemory/storage/in_flight.hpp"
+#include "timemory/storage/inbox.hpp"
+#include "timemory/storage/live.hpp"
 #include "timemory/storage/macros.hpp"
 #include "timemory/storage/node.hpp"
 #include "timemory/storage/types.hpp"
@@ -50,6 +53,7 @@
 
 #include <atomic>
 #include <cstdint>
+#include <memory>
 #include <tuple>
 #include <type_traits>
 #include <unordered_map>
@@ -214,9 +218,13 @@ public:
     using const_iterator = typename graph_type::const_iterator;
 
     template <typename Vp>
-    using secondary_data_t       = std::tuple<iterator, const std::string&, Vp>;
-    using iterator_hash_submap_t = uomap_t<int64_t, iterator>;
-    using iterator_hash_map_t    = uomap_t<int64_t, iterator_hash_submap_t>;
+    using secondary_data_t = std::tuple<iterator, const std::string&, Vp>;
+    template <typename Vp>
+    using hashed_secondary_data_t = std::tuple<iterator, hash_result_type, Vp>;
+    using iterator_hash_submap_t  = uomap_t<int64_t, iterator>;
+    using iterator_hash_map_t     = uomap_t<int64_t, iterator_hash_submap_t>;
+    using inbox_t                 = node::inbox<Type, iterator>;
+    using inbox_ptr_t             = std::shared_ptr<inbox_t>;
 
     friend class tim::manager;
     friend struct node::result<Type>;
@@ -294,27 +302,38 @@ public:
 
     const iterator_hash_map_t get_node_ids() const { return m_node_ids; }
 
-    void stack_push(Type* obj) { m_stack.insert(obj); }
+    void stack_push(Type* obj);
     void stack_pop(Type* obj);
 
     void insert_init();
 
     iterator insert(scope::config scope_data, const Type& obj, uint64_t hash_id);
 
-    // append a value to the the graph
+    // append a value or an instance to the graph
+    template <typename Vp>
+    iterator append(const secondary_data_t<Vp>& _secondary);
+
+    // append a value to the the graph with a pre-computed hash of the label
     template <typename Vp,
               enable_if_t<!(std::is_same<decay_t<Vp>, Type>::value), int> = 0>
-    iterator append(const secondary_data_t<Vp>& _secondary);
+    iterator append(const hashed_secondary_data_t<Vp>& _secondary);
 
-    // append an instance to the graph
+    // append an instance to the graph with a pre-computed hash of the label
     template <typename Vp, enable_if_t<(std::is_same<decay_t<Vp>, Type>::value), int> = 0>
-    iterator append(const secondary_data_t<Vp>& _secondary);
+    iterator append(const hashed_secondary_data_t<Vp>& _secondary);
 
     template <typename Archive>
     void serialize(Archive& ar, const unsigned int version);
 
     void add_sample(Type&& _obj) { m_samples.emplace_back(std::forward<Type>(_obj)); }
 
+    // measurements of the regions started on this thread which were stopped on another
+    // thread (see timemory/variadic/async_region.hpp). The inbox accepts posts from
+    // any thread, the other functions are called by the owning thread
+    inbox_ptr_t get_inbox() const { return m_inbox; }
+    void        async_drain();
+    void        async_apply(iterator _itr, const Type& _obj);
+
     auto&       get_samples() { return m_samples; }
     const auto& get_samples() const { return m_samples; }
 
@@ -338,6 +357,14 @@ private:
     void do_serialize(Archive& ar);
 
     void internal_print();
+    void internal_print(manager::output_stage);
+
+    // copies (up to live::nodes_per_pop nodes of) the graph into the snapshot for the
+    // pending live query and publishes the snapshot once the traversal is complete
+    void live_publish(bool _complete = false);
+
+    // applies the pending posts and makes subsequent posts fail
+    void async_close();
 
     graph_data_t&       _data();
     const graph_data_t& _data() const
@@ -350,9 +377,17 @@ private:
     uint64_t                   m_timeline_counter    = 1;
     mutable graph_data_t*      m_graph_data_instance = nullptr;
     iterator_hash_map_t        m_node_ids;
-    std::unordered_set<Type*>  m_stack;
+    node::in_flight<Type>      m_stack;
     std::shared_ptr<printer_t> m_printer;
     sample_array_t             m_samples;
+    bool                       m_output_staged = false;  // see manager::finalize_output
+    bool                       m_output_active = false;
+    bool                       m_result_cached = false;
+    result_array_t             m_result_cache  = {};
+    uint64_t                   m_live_epoch    = 0;
+    live::buffer_ptr_t         m_live_buffer   = {};
+    live::builder<iterator>    m_live          = {};
+    inbox_ptr_t                m_inbox         = std::make_shared<inbox_t>();
 };
 //
 //--------------------------------------------------------------------------------------//
@@ -361,24 +396,20 @@ template <typename Type>
 void
 storage<Type, true>::reset()
 {
+    // the pending posts and the regions which are still running refer to nodes which
+    // are erased so the inbox is closed (their posts fail and the measurements are
+    // recorded by the stopping thread) and replaced
+    m_inbox->close([](iterator, const Type&) {});
+    m_inbox = std::make_shared<inbox_t>();
+    // the snapshot being built refers to nodes which are erased. It is restarted on
+    // the next pop
+    m_live.cancel();
+    m_live_epoch = 0;
     // have the data graph erase all children of the head node
     if(m_graph_data_instance)
         m_graph_data_instance->reset();
     // erase all the cached iterators except for m_node_ids[0][0]
-    for(auto& ditr : m_node_ids)
-    {
-        auto _depth = ditr.first;
-        if(_depth != 0)
-            ditr.second.clear();
-        else
-        {
-            for(auto itr = ditr.second.begin(); itr != ditr.second.end(); ++itr)
-            {
-                if(itr->first != 0)
-                    ditr.second.erase(itr);
-            }
-        }
-    }
+    node::reset_ids(m_node_ids);
 }
 //
 //--------------------------------------------------------------------------------------//
@@ -420,9 +451,22 @@ storage<Type, true>::insert(scope::config scope_data, const Type& obj, uint64_t
 //--------------------------------------------------------------------------------------//
 //
 template <typename Type>
-template <typename Vp, enable_if_t<!(std::is_same<decay_t<Vp>, Type>::value), int>>
+template <typename Vp>
 typename storage<Type, true>::iterator
 storage<Type, true>::append(const secondary_data_t<Vp>& _secondary)
+{
+    // compute hash of prefix
+    auto _hash_id = add_hash_id(std::get<1>(_secondary));
+    return append(hashed_secondary_data_t<Vp>{ std::get<0>(_secondary), _hash_id,
+                                               std::get<2>(_secondary) });
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+template <typename Type>
+template <typename Vp, enable_if_t<!(std::is_same<decay_t<Vp>, Type>::value), int>>
+typename storage<Type, true>::iterator
+storage<Type, true>::append(const hashed_secondary_data_t<Vp>& _secondary)
 {
     insert_init();
 
@@ -431,8 +475,8 @@ storage<Type, true>::append(const secondary_data_t<Vp>& _secondary)
     if(!_data().graph().is_valid(_itr))
         return nullptr;
 
-    // compute hash of prefix
-    auto _hash_id = add_hash_id(std::get<1>(_secondary));
+    // hash of prefix. The label is expected to have been registered via add_hash_id
+    auto _hash_id = std::get<1>(_secondary);
     // compute hash w.r.t. parent iterator (so identical kernels from different
     // call-graph parents do not locate same iterator)
     auto _hash = _hash_id ^ _itr->id();
@@ -474,7 +518,7 @@ storage<Type, true>::append(const secondary_data_t<Vp>& _secondary)
 template <typename Type>
 template <typename Vp, enable_if_t<(std::is_same<decay_t<Vp>, Type>::value), int>>
 typename storage<Type, true>::iterator
-storage<Type, true>::append(const secondary_data_t<Vp>& _secondary)
+storage<Type, true>::append(const hashed_secondary_data_t<Vp>& _secondary)
 {
     insert_init();
 
@@ -483,8 +527,8 @@ storage<Type, true>::append(const secondary_data_t<Vp>& _secondary)
     if(!_data().graph().is_valid(_itr))
         return nullptr;
 
-    // compute hash of prefix
-    auto _hash_id = add_hash_id(std::get<1>(_secondary));
+    // hash of prefix. The label is expected to have been registered via add_hash_id
+    auto _hash_id = std::get<1>(_secondary);
     // compute hash w.r.t. parent iterator (so identical kernels from different
     // call-graph parents do not locate same iterator)
     auto _hash = _hash_id ^ _itr->id();
@@ -803,7 +847,7 @@ public:
     void serialize(Archive&, const unsigned int)
     {}
 
-    void stack_push(Type* obj) { m_stack.insert(obj); }
+    void stack_push(Type* obj);
     void stack_pop(Type* obj);
 
     std::shared_ptr<printer_t> get_printer() const { return m_printer; }
@@ -819,7 +863,7 @@ private:
     {}
 
 private:
-    std::unordered_set<Type*>  m_stack;
+    node::in_flight<Type>      m_stack;
     std::shared_ptr<printer_t> m_printer;
 };
 //
@@ -99,7 +99,7 @@ storage::storage(bool _is_master, int64_t _instance_id, const std::string& _labe
                    m_label.c_str());
     }
 
-    if(settings::debug())
+    if(settings::hot().debug)
         PRINT_HERE("%s: %i (%s)", "base::storage instance created", (int) m_instance_id,
                    m_label.c_str());
 }
@@ -108,7 +108,7 @@ storage::storage(bool _is_master, int64_t _instance_id, const std::string& _labe
 //
 TIMEMORY_STORAGE_LINKAGE storage::~storage()
 {
-    if(settings::debug())
+    if(settings::hot().debug)
         PRINT_HERE("%s: %i (%s)", "base::storage instance deleted", (int) m_instance_id,
                    m_label.c_str());
 }
@@ -326,7 +326,7 @@ template <typename Type>
 storage<Type, true>::storage()
 : base_type(singleton_t::is_master_thread(), instance_count()++, demangle<Type>())
 {
-    if(settings::debug())
+    if(settings::hot().debug)
         printf("[%s]> constructing @ %i...\n", m_label.c_str(), __LINE__);
 
     component::state<Type>::has_storage() = true;
@@ -352,6 +352,10 @@ storage<Type, true>::storage()
 
     get_shared_manager();
     m_printer = std::make_shared<printer_t>(Type::get_label(), this);
+    // registered up front so a live query waits for this instance to publish
+    m_live_buffer = live::add_buffer(m_thread_idx, Type::get_label(),
+                                     Type::get_display_unit(),
+                                     [this]() { live_publish(true); });
 }
 //
 //--------------------------------------------------------------------------------------//
@@ -361,9 +365,14 @@ storage<Type, true>::~storage()
 {
     component::state<Type>::has_storage() = false;
 
-    if(settings::debug())
+    if(settings::hot().debug)
         printf("[%s]> destructing @ %i...\n", m_label.c_str(), __LINE__);
 
+    if(m_live_buffer)
+        live::remove_buffer(m_live_buffer);
+
+    async_close();
+
     if(!m_is_master)
         singleton_t::master_instance()->merge(this);
 
@@ -379,7 +388,7 @@ storage<Type, true>::initialize()
 {
     if(m_initialized)
         return;
-    if(settings::debug())
+    if(settings::hot().debug)
         printf("[%s]> initializing...\n", m_label.c_str());
     m_initialized = true;
 }
@@ -396,7 +405,7 @@ storage<Type, true>::finalize()
     if(!m_initialized)
         return;
 
-    if(settings::debug())
+    if(settings::hot().debug)
         PRINT_HERE("[%s]> finalizing...", m_label.c_str());
 
     m_finalized            = true;
@@ -413,7 +422,7 @@ storage<Type, true>::finalize()
     if(m_is_master && m_global_init)
         fini_t(upcast, operation::mode_constant<operation::fini_mode::global>{});
 
-    if(settings::debug())
+    if(settings::hot().debug)
         PRINT_HERE("[%s]> finalizing...", m_label.c_str());
 }
 //
@@ -423,8 +432,8 @@ template <typename Type>
 void
 storage<Type, true>::stack_clear()
 {
-    using Base                       = typename Type::base_type;
-    std::unordered_set<Type*> _stack = m_stack;
+    using Base  = typename Type::base_type;
+    auto _stack = m_stack.get();
     if(settings::stack_clearing())
         for(auto& itr : _stack)
         {
@@ -599,11 +608,111 @@ storage<Type, true>::pop()
 //
 template <typename Type>
 void
+storage<Type, true>::stack_push(Type* obj)
+{
+    using Base = typename Type::base_type;
+    m_stack.push(obj, static_cast<Base*>(obj)->in_flight_idx);
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+template <typename Type>
+void
 storage<Type, true>::stack_pop(Type* obj)
 {
-    auto itr = m_stack.find(obj);
-    if(itr != m_stack.end())
-        m_stack.erase(itr);
+    using Base = typename Type::base_type;
+    m_stack.pop(obj, static_cast<Base*>(obj)->in_flight_idx);
+    if(!m_inbox->empty())
+        async_drain();
+    if(m_live.active || live::is_requested(m_live_epoch))
+        live_publish();
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+template <typename Type>
+void
+storage<Type, true>::async_drain()
+{
+    m_inbox->drain([this](iterator _itr, const Type& _obj) { async_apply(_itr, _obj); });
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+template <typename Type>
+void
+storage<Type, true>::async_close()
+{
+    m_inbox->close([this](iterator _itr, const Type& _obj) { async_apply(_itr, _obj); });
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+template <typename Type>
+void
+storage<Type, true>::async_apply(iterator _itr, const Type& _obj)
+{
+    auto& _node = _itr->obj();
+    _node += _obj;
+    _node.plus(_obj);
+    operation::add_secondary<Type>(this, _itr, _obj);
+    operation::add_statistics<Type>(_obj, _itr->stats());
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+template <typename Type>
+void
+storage<Type, true>::live_publish(bool _complete)
+{
+    // the snapshot is built from scratch when it is requested by the owning thread
+    if(_complete)
+        m_live.cancel();
+
+    if(!m_live.active)
+    {
+        // a query made while the snapshot is built is served by the next snapshot
+        m_live_epoch = live::requested_epoch().load(std::memory_order_acquire);
+        m_live.data.clear();
+        m_live.rolling.clear();
+        if(!m_graph_data_instance || _data().graph().empty())
+        {
+            live::publish(*m_live_buffer, m_live.data, m_live.labels, m_live_epoch);
+            return;
+        }
+        m_live.active = true;
+        m_live.itr    = _data().graph().begin();
+        // the head node is the first node of the pre-order traversal and is skipped
+        m_live.head = m_live.itr->depth();
+    }
+
+    auto&  _graph = _data().graph();
+    auto&  _itr   = m_live.itr;
+    size_t _n     = 0;
+    for(; _itr != _graph.end() && (_complete || _n < live::nodes_per_pop); ++_itr, ++_n)
+    {
+        if(_itr->depth() <= m_live.head)
+            continue;
+        auto _depth = static_cast<int64_t>(_itr->depth() - (m_live.head + 1));
+        auto _id    = _itr->id();
+        m_live.rolling.resize(_depth + 1, 0);
+        m_live.rolling.at(_depth) = _id;
+        if(_depth > 0)
+            m_live.rolling.at(_depth) += m_live.rolling.at(_depth - 1);
+        // the label of a hash is only resolved the first time it is published
+        if(m_live.labeled.insert(_id).second)
+            m_live.labels.emplace_back(_id, get_prefix(*_itr));
+        m_live.data.emplace_back(live::node_data{ _id, m_live.rolling.at(_depth), _depth,
+                                                  _itr->obj().get_laps(),
+                                                  live::get_value(_itr->obj()) });
+    }
+
+    // resumed on the next pop
+    if(_itr != _graph.end())
+        return;
+
+    m_live.active = false;
+    live::publish(*m_live_buffer, m_live.data, m_live.labels, m_live_epoch);
 }
 //
 //--------------------------------------------------------------------------------------//
@@ -777,7 +886,12 @@ void
 storage<Type, true>::merge(this_type* itr)
 {
     if(itr)
+    {
+        // the async regions which stop after this point are recorded by the thread
+        // which stops them
+        itr->async_close();
         operation::finalize::merge<Type, true>(*this, *itr);
+    }
 }
 //
 //--------------------------------------------------------------------------------------//
@@ -797,6 +911,15 @@ template <typename Type>
 typename storage<Type, true>::result_array_t
 storage<Type, true>::get()
 {
+    // converted ahead of time by the concurrent output generation
+    if(m_result_cached)
+    {
+        m_result_cached = false;
+        return std::move(m_result_cache);
+    }
+
+    async_drain();
+
     result_array_t _ret;
     operation::finalize::get<Type, true>(*this, _ret);
     return _ret;
@@ -832,6 +955,10 @@ storage<Type, true>::internal_print()
 {
     base::storage::stop_profiler();
 
+    // the output was already generated by the staged (concurrent) output generation
+    if(m_output_staged)
+        return;
+
     if(!m_initialized && !m_finalized)
         return;
 
@@ -888,6 +1015,93 @@ storage<Type, true>::internal_print()
 //
 template <typename Type>
 void
+storage<Type, true>::internal_print(manager::output_stage _stage)
+{
+    using output_stage = manager::output_stage;
+
+    if(!singleton_t::is_master(this) || !settings::auto_output())
+        return;
+
+    switch(_stage)
+    {
+        case output_stage::prepare:
+        {
+            base::storage::stop_profiler();
+
+            if(!m_initialized && !m_finalized)
+                return;
+
+            m_output_staged = true;
+
+            merge();
+            finalize();
+
+            if(!trait::runtime_enabled<Type>::get() || !m_graph_data_instance ||
+               _data().graph().size() <= 1)
+            {
+                instance_count().store(0);
+                return;
+            }
+
+            if(!m_printer)
+                m_printer.reset(new printer_t(Type::get_label(), this));
+
+            if(m_manager)
+                m_manager->add_entries(this->size());
+
+            m_output_active = true;
+            m_printer->set_deferred(true);
+            break;
+        }
+        case output_stage::convert:
+        {
+            if(!m_output_active || !m_printer->get_update())
+                return;
+            m_result_cache  = get();
+            m_result_cached = true;
+            break;
+        }
+        case output_stage::gather:
+        {
+            if(m_output_active && m_printer->get_update())
+                m_printer->gather();
+            // never used if there was not a distributed collection
+            m_result_cached = false;
+            m_result_cache.clear();
+            break;
+        }
+        case output_stage::write:
+        {
+            if(!m_output_active)
+                return;
+            if(m_printer->get_update())
+                m_printer->process();
+            else
+                m_printer->setup();
+            if(m_printer->is_output_rank())
+                m_printer->print_files();
+            break;
+        }
+        case output_stage::report:
+        {
+            if(!m_output_active)
+                return;
+            m_printer->set_deferred(false);
+            if(m_printer->get_update())
+                m_printer->print_flamegraph();
+            if(m_printer->is_output_rank())
+                m_printer->print_report();
+            m_output_active = false;
+            instance_count().store(0);
+            break;
+        }
+    }
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+template <typename Type>
+void
 storage<Type, true>::get_shared_manager()
 {
     using func_t = std::function<void()>;
@@ -915,8 +1129,8 @@ storage<Type, true>::get_shared_manager()
             auto _instance = this_type::get_singleton();
             if(_instance)
             {
-                auto _debug_v = settings::debug();
-                auto _verb_v  = settings::verbose();
+                auto _debug_v = settings::hot().debug;
+                auto _verb_v  = settings::hot().verbose;
                 if(_debug_v || _verb_v > 1)
                     PRINT_HERE("[%s] %s", demangle<Type>().c_str(),
                                "calling _instance->reset(this)");
@@ -942,6 +1156,16 @@ storage<Type, true>::get_shared_manager()
 
         m_manager->add_finalizer(demangle<Type>(), std::move(_cleanup),
                                  std::move(_finalize), _is_master);
+
+        if(_is_master)
+        {
+            m_manager->add_output_stages(
+                demangle<Type>(), [](manager::output_stage _stage) {
+                    auto _instance = this_type::noninit_master_instance();
+                    if(_instance)
+                        _instance->internal_print(_stage);
+                });
+        }
     }
 }
 //
@@ -956,7 +1180,7 @@ template <typename Type>
 storage<Type, false>::storage()
 : base_type(singleton_t::is_master_thread(), instance_count()++, demangle<Type>())
 {
-    if(settings::debug())
+    if(settings::hot().debug)
         printf("[%s]> constructing @ %i...\n", m_label.c_str(), __LINE__);
     get_shared_manager();
     component::state<Type>::has_storage() = true;
@@ -969,7 +1193,7 @@ template <typename Type>
 storage<Type, false>::~storage()
 {
     component::state<Type>::has_storage() = false;
-    if(settings::debug())
+    if(settings::hot().debug)
         printf("[%s]> destructing @ %i...\n", m_label.c_str(), __LINE__);
 }
 //
@@ -979,8 +1203,8 @@ template <typename Type>
 void
 storage<Type, false>::stack_clear()
 {
-    using Base                       = typename Type::base_type;
-    std::unordered_set<Type*> _stack = m_stack;
+    using Base  = typename Type::base_type;
+    auto _stack = m_stack.get();
     for(auto& itr : _stack)
     {
         static_cast<Base*>(itr)->stop();
@@ -997,7 +1221,7 @@ storage<Type, false>::initialize()
     if(m_initialized)
         return;
 
-    if(settings::debug())
+    if(settings::hot().debug)
         printf("[%s]> initializing...\n", m_label.c_str());
 
     m_initialized = true;
@@ -1028,7 +1252,7 @@ storage<Type, false>::finalize()
     if(!m_initialized)
         return;
 
-    if(settings::debug())
+    if(settings::hot().debug)
         printf("[%s]> finalizing...\n", m_label.c_str());
 
     using fini_t = operation::fini<Type>;
@@ -1054,13 +1278,20 @@ storage<Type, false>::finalize()
 //
 template <typename Type>
 void
+storage<Type, false>::stack_push(Type* obj)
+{
+    using Base = typename Type::base_type;
+    m_stack.push(obj, static_cast<Base*>(obj)->in_flight_idx);
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+template <typename Type>
+void
 storage<Type, false>::stack_pop(Type* obj)
 {
-    auto itr = m_stack.find(obj);
-    if(itr != m_stack.end())
-    {
-        m_stack.erase(itr);
-    }
+    using Base = typename Type::base_type;
+    m_stack.pop(obj, static_cast<Base*>(obj)->in_flight_idx);
 }
 //
 //--------------------------------------------------------------------------------------//
@@ -1121,8 +1352,8 @@ storage<Type, false>::get_shared_manager()
             auto _instance = this_type::get_singleton();
             if(_instance)
             {
-                auto _debug_v = settings::debug();
-                auto _verb_v  = settings::verbose();
+                auto _debug_v = settings::hot().debug;
+                auto _verb_v  = settings::hot().verbose;
                 if(_debug_v || _verb_v > 1)
                     PRINT_HERE("[%s] %s", demangle<Type>().c_str(),
                                "calling _instance->reset(this)");
@@ -0,0 +1,163 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+/**
+ * \file timemory/storage/in_flight.hpp
+ * \brief Record of the components in a storage instance which have been inserted into
+ * the call-graph and not popped
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//--------------------------------------------------------------------------------------//
+//
+namespace tim
+{
+namespace node
+{
+//
+//--------------------------------------------------------------------------------------//
+//
+/// \struct tim::node::in_flight_index
+/// \brief Index of the slot of a component in \ref in_flight. The slot belongs to the
+/// object which was pushed so a copy or a moved-to object starts without a slot and
+/// an assignment keeps the slot of the destination
+///
+struct in_flight_index
+{
+    using index_type                 = int32_t;
+    static constexpr index_type npos = -1;
+
+    in_flight_index()  = default;
+    ~in_flight_index() = default;
+    in_flight_index(const in_flight_index&) noexcept {}
+    in_flight_index(in_flight_index&&) noexcept {}
+    in_flight_index& operator=(const in_flight_index&) noexcept { return *this; }
+    in_flight_index& operator=(in_flight_index&&) noexcept { return *this; }
+
+    index_type value = npos;
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+/// \class tim::node::in_flight
+/// \brief Slot array of the components which were pushed onto the call-graph of a
+/// (thread-local) storage instance and not popped. A component keeps the index of its
+/// slot so push and pop are O(1) and, once the slots have grown to the maximum number
+/// of components in-flight at one time, neither allocates. A slot is only released
+/// by the object which was pushed into it and copies of an in-flight component do not
+/// inherit the index (see \ref in_flight_index). The released slots are re-used in
+/// LIFO order so nested regions occupy the slots like a stack.
+///
+template <typename Tp>
+class in_flight
+{
+public:
+    using index_type                 = in_flight_index::index_type;
+    static constexpr index_type npos = in_flight_index::npos;
+
+    in_flight()                 = default;
+    ~in_flight()                = default;
+    in_flight(const in_flight&) = delete;
+    in_flight(in_flight&&)      = delete;
+    in_flight& operator=(const in_flight&) = delete;
+    in_flight& operator=(in_flight&&) = delete;
+
+    /// assigns a slot to \param _obj and stores the index of the slot in \param _idx.
+    /// Pushing an object which is already in-flight is a no-op
+    void push(Tp* _obj, in_flight_index& _idx)
+    {
+        if(contains(_obj, _idx.value))
+            return;
+        if(m_free.empty())
+        {
+            _idx.value = static_cast<index_type>(m_slots.size());
+            m_slots.emplace_back(_obj);
+        }
+        else
+        {
+            _idx.value = m_free.back();
+            m_free.pop_back();
+            m_slots[_idx.value] = _obj;
+        }
+        ++m_size;
+    }
+
+    /// releases the slot of \param _obj. No-op if \param _obj is not in-flight
+    void pop(Tp* _obj, in_flight_index& _idx)
+    {
+        if(!contains(_obj, _idx.value))
+            return;
+        m_slots[_idx.value] = nullptr;
+        m_free.emplace_back(_idx.value);
+        _idx.value = npos;
+        --m_size;
+    }
+
+    bool contains(const Tp* _obj, index_type _idx) const
+    {
+        return (_idx >= 0 && static_cast<size_t>(_idx) < m_slots.size() &&
+                m_slots[_idx] == _obj);
+    }
+
+    bool   empty() const { return (m_size == 0); }
+    size_t size() const { return m_size; }
+
+    /// the objects in-flight in descending slot order, i.e. the inner-most of nested
+    /// regions first
+    std::vector<Tp*> get() const
+    {
+        std::vector<Tp*> _v{};
+        _v.reserve(m_size);
+        for(auto itr = m_slots.rbegin(); itr != m_slots.rend(); ++itr)
+        {
+            if(*itr)
+                _v.emplace_back(*itr);
+        }
+        return _v;
+    }
+
+    /// releases every slot. The capacity is retained
+    void clear()
+    {
+        m_slots.clear();
+        m_free.clear();
+        m_size = 0;
+    }
+
+private:
+    size_t                  m_size = 0;
+    std::vector<Tp*>        m_slots{};
+    std::vector<index_type> m_free{};
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+}  // namespace node
+}  // namespace tim
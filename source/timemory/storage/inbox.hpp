@@ -0,0 +1,173 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+/**
+ * \file timemory/storage/inbox.hpp
+ * \brief Lock-free inbox of a storage instance for the measurements of the regions
+ * which were started on the thread owning the storage and stopped on another thread
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+//--------------------------------------------------------------------------------------//
+//
+namespace tim
+{
+namespace node
+{
+//
+//--------------------------------------------------------------------------------------//
+//
+/// \class tim::node::inbox
+/// \brief Multiple-producer, single-consumer list of (call-graph node, value) pairs.
+/// Any thread posts with a compare-and-swap on the head of an intrusive list and the
+/// consumer takes the whole list with one exchange so there is no ABA problem. Once
+/// the inbox is closed (the storage instance is merged or destroyed) a post fails and
+/// the producer has to record the value elsewhere. The inbox is shared with the
+/// producers so it out-lives the storage instance.
+///
+template <typename Tp, typename IterT>
+class inbox
+{
+public:
+    struct entry
+    {
+        IterT  target = {};
+        Tp     value  = {};
+        entry* next   = nullptr;
+    };
+
+    inbox()             = default;
+    inbox(const inbox&) = delete;
+    inbox(inbox&&)      = delete;
+    inbox& operator=(const inbox&) = delete;
+    inbox& operator=(inbox&&) = delete;
+
+    ~inbox() { release(m_head.exchange(closed(), std::memory_order_acquire)); }
+
+    /// posts \param _value for the node \param _target. Returns false if the inbox
+    /// is closed
+    bool post(IterT _target, const Tp& _value)
+    {
+        auto* _entry = new entry{ _target, _value, nullptr };
+        auto* _head  = m_head.load(std::memory_order_relaxed);
+        do
+        {
+            if(_head == closed())
+            {
+                delete _entry;
+                return false;
+            }
+            _entry->next = _head;
+        } while(!m_head.compare_exchange_weak(_head, _entry, std::memory_order_release,
+                                              std::memory_order_relaxed));
+        return true;
+    }
+
+    /// whether there is nothing to consume. A single load so it can be checked on
+    /// the hot path of the consumer
+    bool empty() const
+    {
+        auto* _head = m_head.load(std::memory_order_relaxed);
+        return (_head == nullptr || _head == closed());
+    }
+
+    bool is_closed() const
+    {
+        return (m_head.load(std::memory_order_relaxed) == closed());
+    }
+
+    /// invokes \param _func with the node and the value of each entry in the order
+    /// they were posted and returns the number of entries
+    template <typename FuncT>
+    size_t drain(FuncT&& _func)
+    {
+        auto* _head = m_head.load(std::memory_order_relaxed);
+        do
+        {
+            if(_head == nullptr || _head == closed())
+                return 0;
+        } while(!m_head.compare_exchange_weak(_head, nullptr, std::memory_order_acquire,
+                                              std::memory_order_relaxed));
+        return consume(_head, std::forward<FuncT>(_func));
+    }
+
+    /// drains the inbox and makes subsequent posts fail
+    template <typename FuncT>
+    size_t close(FuncT&& _func)
+    {
+        auto* _head = m_head.exchange(closed(), std::memory_order_acquire);
+        return consume(_head, std::forward<FuncT>(_func));
+    }
+
+private:
+    static entry* closed()
+    {
+        static entry _instance{};
+        return &_instance;
+    }
+
+    template <typename FuncT>
+    static size_t consume(entry* _head, FuncT&& _func)
+    {
+        if(_head == closed())
+            return 0;
+        // the list is in LIFO order
+        entry* _prev = nullptr;
+        while(_head)
+        {
+            auto* _next = _head->next;
+            _head->next = _prev;
+            _prev       = _head;
+            _head       = _next;
+        }
+        size_t _n = 0;
+        for(; _prev; ++_n)
+        {
+            _func(_prev->target, _prev->value);
+            auto* _next = _prev->next;
+            delete _prev;
+            _prev = _next;
+        }
+        return _n;
+    }
+
+    static void release(entry* _head)
+    {
+        consume(_head, [](IterT, const Tp&) {});
+    }
+
+private:
+    std::atomic<entry*> m_head{ nullptr };
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+}  // namespace node
+}  // namespace tim
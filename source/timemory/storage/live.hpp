@@ -0,0 +1,318 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+/**
+ * \file timemory/storage/live.hpp
+ * \brief Snapshots of the call-graphs of the storage instances which are published by
+ * the thread owning the storage when a live query is pending (see
+ * timemory/utility/live_server.hpp)
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace tim
+{
+namespace live
+{
+//
+//--------------------------------------------------------------------------------------//
+//
+/// the maximum number of nodes of the call-graph copied into a snapshot per pop. A
+/// larger call-graph is copied over several pops so a query never stalls a thread
+/// for the length of a full traversal
+static constexpr size_t nodes_per_pop = 256;
+//
+//--------------------------------------------------------------------------------------//
+//
+/// a node of the call-graph of a storage instance
+struct entry
+{
+    uint64_t    hash         = 0;
+    uint64_t    rolling_hash = 0;
+    int64_t     depth        = 0;
+    int64_t     laps         = 0;
+    double      value        = 0.0;
+    std::string label        = {};
+};
+//
+/// a node of the call-graph as published by the owning thread. The label is resolved
+/// from the hash by the reader (see \ref buffer::labels)
+struct node_data
+{
+    uint64_t hash         = 0;
+    uint64_t rolling_hash = 0;
+    int64_t  depth        = 0;
+    int64_t  laps         = 0;
+    double   value        = 0.0;
+};
+//
+using label_vec_t = std::vector<std::pair<uint64_t, std::string>>;
+//
+//--------------------------------------------------------------------------------------//
+//
+/// \struct tim::live::buffer
+/// \brief The published snapshot of one storage instance. The owning thread builds the
+/// snapshot into its own (back) buffer and swaps it with \ref data under the lock so
+/// the reader only holds the lock for the swap, never while the graph is traversed.
+/// The label of every hash is only published once
+///
+struct buffer
+{
+    using refresh_func_t = std::function<void()>;
+    using label_map_t    = std::unordered_map<uint64_t, std::string>;
+
+    std::mutex             mutex{};
+    uint64_t               epoch     = 0;  // epoch of the query the data was taken for
+    int64_t                tid       = 0;
+    std::string            component = {};
+    std::string            units     = {};
+    std::vector<node_data> data      = {};
+    label_map_t            labels    = {};
+    std::thread::id        owner     = std::this_thread::get_id();
+    refresh_func_t         refresh   = {};  // publishes immediately, owning thread only
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+/// \struct tim::live::builder
+/// \brief The snapshot a storage instance is building. The traversal of the call-graph
+/// is resumed from \ref itr on the next pop when the budget of a pop is exhausted
+///
+template <typename IterT>
+struct builder
+{
+    bool                         active  = false;
+    int64_t                      head    = 0;   // depth of the head of the graph
+    IterT                        itr     = {};  // next node of the traversal
+    std::vector<uint64_t>        rolling = {};  // rolling hash at each depth
+    std::vector<node_data>       data    = {};
+    std::unordered_set<uint64_t> labeled = {};  // hashes with a published label
+    label_vec_t                  labels  = {};  // labels not published yet
+
+    void cancel()
+    {
+        active = false;
+        rolling.clear();
+        data.clear();
+    }
+};
+//
+using buffer_ptr_t = std::shared_ptr<buffer>;
+//
+//--------------------------------------------------------------------------------------//
+//
+/// incremented by the server for every query. Zero while no query has been made so
+/// the check in the hot path is a single relaxed load which never succeeds
+inline std::atomic<uint64_t>&
+requested_epoch()
+{
+    static std::atomic<uint64_t> _instance{ 0 };
+    return _instance;
+}
+//
+/// returns true when a query was made after \param _epoch, i.e. the storage has not
+/// published a snapshot for the latest query
+inline bool
+is_requested(uint64_t _epoch)
+{
+    return requested_epoch().load(std::memory_order_relaxed) != _epoch;
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+/// the buffers of every storage instance
+struct registry
+{
+    std::mutex                mutex{};
+    std::vector<buffer_ptr_t> buffers = {};
+};
+//
+inline registry&
+get_registry()
+{
+    static auto* _instance = new registry{};
+    return *_instance;
+}
+//
+/// creates and registers the buffer of a storage instance when it is constructed
+inline buffer_ptr_t
+add_buffer(int64_t _tid, std::string _component, std::string _units,
+           buffer::refresh_func_t _refresh = {})
+{
+    auto _buffer       = std::make_shared<buffer>();
+    _buffer->tid       = _tid;
+    _buffer->component = std::move(_component);
+    _buffer->units     = std::move(_units);
+    _buffer->refresh   = std::move(_refresh);
+    auto&                       _registry = get_registry();
+    std::lock_guard<std::mutex> _lk(_registry.mutex);
+    _registry.buffers.emplace_back(_buffer);
+    return _buffer;
+}
+//
+/// unregisters the buffer of a storage instance which is destroyed. The data of a
+/// worker thread is merged into the storage of the master thread at that point
+inline void
+remove_buffer(const buffer_ptr_t& _buffer)
+{
+    auto&                       _registry = get_registry();
+    std::lock_guard<std::mutex> _lk(_registry.mutex);
+    auto&                       _buffers = _registry.buffers;
+    for(auto itr = _buffers.begin(); itr != _buffers.end(); ++itr)
+    {
+        if(*itr == _buffer)
+        {
+            _buffers.erase(itr);
+            break;
+        }
+    }
+}
+//
+/// swaps the snapshot built by the owning thread into the published buffer and moves
+/// the new labels into the label map of the buffer
+inline void
+publish(buffer& _buffer, std::vector<node_data>& _data, label_vec_t& _labels,
+        uint64_t _epoch)
+{
+    std::lock_guard<std::mutex> _lk(_buffer.mutex);
+    std::swap(_buffer.data, _data);
+    for(auto& itr : _labels)
+        _buffer.labels.emplace(itr.first, std::move(itr.second));
+    _labels.clear();
+    _buffer.epoch = _epoch;
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+/// a published entry with the information of the buffer it was published in
+struct row
+{
+    std::string component = {};
+    std::string units     = {};
+    int64_t     tid       = 0;
+    entry       value     = {};
+    bool        stale     = false;  // not published for the latest query
+};
+//
+/// requests a new epoch and collects the snapshots published within \param _timeout
+/// msec. The buffers owned by the calling thread are published immediately since the
+/// calling thread cannot pop while it waits. \param _published and \param _total are
+/// the number of buffers which published a snapshot for the query and the number of
+/// registered buffers
+inline std::vector<row>
+collect(int64_t _timeout, uint64_t& _epoch, size_t& _published, size_t& _total)
+{
+    _epoch = requested_epoch().fetch_add(1, std::memory_order_acq_rel) + 1;
+
+    auto _get_buffers = []() {
+        auto&                       _registry = get_registry();
+        std::lock_guard<std::mutex> _lk(_registry.mutex);
+        return _registry.buffers;
+    };
+
+    for(auto& itr : _get_buffers())
+    {
+        if(itr->owner == std::this_thread::get_id() && itr->refresh)
+            itr->refresh();
+    }
+
+    std::vector<buffer_ptr_t> _buffers{};
+    auto _end = std::chrono::steady_clock::now() + std::chrono::milliseconds(_timeout);
+    do
+    {
+        _buffers   = _get_buffers();
+        _published = 0;
+        for(auto& itr : _buffers)
+        {
+            std::lock_guard<std::mutex> _lk(itr->mutex);
+            if(itr->epoch >= _epoch)
+                ++_published;
+        }
+        if(_published == _buffers.size())
+            break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    } while(std::chrono::steady_clock::now() < _end);
+
+    _total = _buffers.size();
+    std::vector<row> _rows{};
+    for(auto& itr : _buffers)
+    {
+        std::lock_guard<std::mutex> _lk(itr->mutex);
+        for(const auto& ditr : itr->data)
+        {
+            auto  _litr  = itr->labels.find(ditr.hash);
+            auto  _label = (_litr != itr->labels.end()) ? _litr->second : std::string{};
+            entry _entry{ ditr.hash, ditr.rolling_hash, ditr.depth, ditr.laps,
+                          ditr.value, std::move(_label) };
+            _rows.emplace_back(row{ itr->component, itr->units, itr->tid,
+                                    std::move(_entry), itr->epoch < _epoch });
+        }
+    }
+    return _rows;
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+/// the value of a component reported in the live view: the value returned by get()
+/// when it is convertible to a double, otherwise zero (only the laps are reported)
+template <typename Tp>
+auto
+get_value(const Tp& _obj, int) -> decltype(static_cast<double>(_obj.get()))
+{
+    return static_cast<double>(_obj.get());
+}
+//
+template <typename Tp>
+double
+get_value(const Tp&, long)
+{
+    return 0.0;
+}
+//
+template <typename Tp>
+double
+get_value(const Tp& _obj)
+{
+    return get_value(_obj, 0);
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+}  // namespace live
+}  // namespace tim
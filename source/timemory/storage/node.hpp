@@ -28,9 +28,15 @@
 #include "timemory/backends/threading.hpp"
 #include "timemory/mpl/type_traits.hpp"
 #include "timemory/mpl/types.hpp"
+#include "timemory/storage/binary.hpp"
 #include "timemory/utility/serializer.hpp"
 
+#include <cereal/archives/binary.hpp>
+
 #include <cstdint>
+#include <istream>
+#include <sstream>
+#include <stdexcept>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -56,7 +62,7 @@ struct data
     using stats_type   = typename stats_policy::statistics_type;
     using node_type   = std::tuple<uint64_t, Tp, int64_t, stats_type, uint16_t, uint16_t>;
     using result_type = std::tuple<uint64_t, Tp, string_t, int64_t, uint64_t,
-                                   uintvector_t, stats_type, uint16_t, uint16_t>;
+                                   uintvector_t, stats_type, uint16_t, uint16_t, Tp>;
 };
 //
 //--------------------------------------------------------------------------------------//
@@ -130,6 +136,7 @@ struct result : public data<Tp>::result_type
     stats_type&   stats() { return std::get<6>(*this); }
     uint16_t&     tid() { return std::get<7>(*this); }
     uint16_t&     pid() { return std::get<8>(*this); }
+    Tp&           exclusive() { return std::get<9>(*this); }
 
     const uint64_t&     hash() const { return std::get<0>(*this); }
     const Tp&           data() const { return std::get<1>(*this); }
@@ -140,6 +147,7 @@ struct result : public data<Tp>::result_type
     const stats_type&   stats() const { return std::get<6>(*this); }
     const uint16_t&     tid() const { return std::get<7>(*this); }
     const uint16_t&     pid() const { return std::get<8>(*this); }
+    const Tp&           exclusive() const { return std::get<9>(*this); }
 
     uint64_t&       id() { return std::get<0>(*this); }
     const uint64_t& id() const { return std::get<0>(*this); }
@@ -158,6 +166,7 @@ struct result : public data<Tp>::result_type
     this_type& operator-=(const this_type& rhs)
     {
         data() -= rhs.data();
+        exclusive() -= rhs.exclusive();
         stats() -= rhs.stats();
         return *this;
     }
@@ -165,6 +174,50 @@ struct result : public data<Tp>::result_type
 //
 //--------------------------------------------------------------------------------------//
 //
+/// computes the exclusive (self) value of every node in a pre-order array of results,
+/// i.e. the inclusive value minus the inclusive values of the direct children, in a
+/// single pass. The stack holds the most recent node at each depth so the parent of a
+/// node is the top of the stack after the deeper (completed) nodes are popped
+template <typename Tp>
+void
+compute_exclusive(std::vector<result<Tp>>& _nodes)
+{
+    std::vector<result<Tp>*> _stack{};
+    for(auto& itr : _nodes)
+    {
+        itr.exclusive() = itr.data();
+        while(!_stack.empty() && _stack.back()->depth() >= itr.depth())
+            _stack.pop_back();
+        if(!_stack.empty() && _stack.back()->depth() + 1 == itr.depth())
+            _stack.back()->exclusive() -= itr.data();
+        _stack.emplace_back(&itr);
+    }
+}
+//
+/// erases the cached iterators of the nodes of a call-graph which is reset except for
+/// the head of the graph (hash zero at depth zero). The map of a depth is never
+/// modified while it is iterated
+template <typename MapT>
+void
+reset_ids(MapT& _node_ids)
+{
+    for(auto& ditr : _node_ids)
+    {
+        auto& _ids  = ditr.second;
+        auto  _head = (ditr.first == 0) ? _ids.find(0) : _ids.end();
+        if(_head == _ids.end())
+        {
+            _ids.clear();
+            continue;
+        }
+        auto _itr = _head->second;
+        _ids.clear();
+        _ids.emplace(0, _itr);
+    }
+}
+//
+//--------------------------------------------------------------------------------------//
+//
 //                              Definitions
 //
 //--------------------------------------------------------------------------------------//
@@ -223,7 +276,8 @@ template <typename Tp>
 result<Tp>::result(uint64_t _hash, const Tp& _data, const string_t& _prefix,
                    int64_t _depth, uint64_t _rolling, const uintvector_t& _hierarchy,
                    const stats_type& _stats, uint16_t _tid, uint16_t _pid)
-: base_type(_hash, _data, _prefix, _depth, _rolling, _hierarchy, _stats, _tid, _pid)
+: base_type(_hash, _data, _prefix, _depth, _rolling, _hierarchy, _stats, _tid, _pid,
+            _data)
 {}
 //
 //--------------------------------------------------------------------------------------//
@@ -251,7 +305,8 @@ save(Archive& ar, const tim::node::result<Tp>& r)
        cereal::make_nvp("depth", r.depth()),
        cereal::make_nvp("entry", r.data()),
        cereal::make_nvp("stats", r.stats()),
-       cereal::make_nvp("rolling_hash", r.rolling_hash()));
+       cereal::make_nvp("rolling_hash", r.rolling_hash()),
+       cereal::make_nvp("exclusive", r.exclusive()));
     // clang-format on
     // ar(cereal::make_nvp("hierarchy", r.hierarchy()));
 }
@@ -271,6 +326,14 @@ load(Archive& ar, tim::node::result<Tp>& r)
        cereal::make_nvp("rolling_hash", r.rolling_hash()));
     // clang-format on
     // ar(cereal::make_nvp("hierarchy", r.hierarchy()));
+    // output from older versions does not provide the exclusive value
+    try
+    {
+        ar(cereal::make_nvp("exclusive", r.exclusive()));
+    } catch(...)
+    {
+        r.exclusive() = r.data();
+    }
 }
 //
 //--------------------------------------------------------------------------------------//
@@ -323,3 +386,321 @@ struct specialize<Archive, tim::node::result<Tp>,
 }  // namespace cereal
 //
 //--------------------------------------------------------------------------------------//
+//
+//                              Binary (columnar) format
+//
+//--------------------------------------------------------------------------------------//
+//
+namespace tim
+{
+namespace binary
+{
+//
+//--------------------------------------------------------------------------------------//
+//
+template <typename Tp, bool IsFixed = column_traits<Tp>::is_fixed,
+          bool IsEmpty = column_traits<Tp>::is_empty>
+struct value_column;
+//
+/// values with a fixed-size binary representation are written in place
+template <typename Tp>
+struct value_column<Tp, true, false>
+{
+    static column make(const std::string& _name, uint64_t _nrows)
+    {
+        auto _col = column::make_fixed<Tp>(_name);
+        _col.resize(_nrows);
+        return _col;
+    }
+
+    static void write(column& _col, uint64_t _row, const Tp& _val)
+    {
+        column_traits<Tp>::write(_col.data.data() + _row * _col.stride, _val);
+    }
+
+    static void read(const column_view& _col, uint64_t _row, Tp& _val)
+    {
+        column_traits<Tp>::read(_col.row(_row), _val);
+    }
+};
+//
+/// everything else is serialized with the cereal binary archive
+template <typename Tp>
+struct value_column<Tp, false, false>
+{
+    static column make(const std::string& _name, uint64_t)
+    {
+        return column::make_blob(_name);
+    }
+
+    static void write(column& _col, uint64_t, const Tp& _val)
+    {
+        std::stringstream ss;
+        {
+            cereal::BinaryOutputArchive oa(ss);
+            oa(_val);
+        }
+        auto _str = ss.str();
+        _col.push_back(_str.data(), _str.size());
+    }
+
+    static void read(const column_view& _col, uint64_t _row, Tp& _val)
+    {
+        memory_buffer _buffer(_col.row(_row), _col.row_size(_row));
+        std::istream  _is(&_buffer);
+        cereal::BinaryInputArchive ia(_is);
+        ia(_val);
+    }
+};
+//
+/// empty types are not stored
+template <typename Tp, bool IsFixed>
+struct value_column<Tp, IsFixed, true>
+{
+    static column make(const std::string& _name, uint64_t)
+    {
+        return column::make_fixed(_name, elem_type::opaque, 0, 0);
+    }
+    static void write(column&, uint64_t, const Tp&) {}
+    static void read(const column_view&, uint64_t, Tp&) {}
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+/// writes the cells of a table. The columns are created on first use and, since every
+/// row visits the fields in the same order, the lookup is almost always the next column
+class table_writer
+{
+public:
+    table_writer(writer& _writer, table& _table)
+    : m_writer(_writer)
+    , m_table(_table)
+    {}
+
+    void begin_row() { m_cursor = 0; }
+
+    template <typename Tp>
+    void set(const std::string& _name, uint64_t _row, const Tp& _val)
+    {
+        using value_type = decay_t<Tp>;
+        if(column_traits<value_type>::is_empty)
+            return;
+        value_column<value_type>::write(get<value_type>(_name), _row, _val);
+    }
+
+    uint64_t add_string(const std::string& _str) { return m_writer.add_string(_str); }
+
+private:
+    template <typename Tp>
+    column& get(const std::string& _name)
+    {
+        auto& _columns = m_table.columns;
+        if(m_cursor < _columns.size() && _columns.at(m_cursor).name == _name)
+            return _columns.at(m_cursor++);
+        for(size_t i = 0; i < _columns.size(); ++i)
+        {
+            if(_columns.at(i).name == _name)
+            {
+                m_cursor = i + 1;
+                return _columns.at(i);
+            }
+        }
+        m_cursor = _columns.size() + 1;
+        return m_table.add(value_column<Tp>::make(_name, m_table.num_rows));
+    }
+
+private:
+    writer& m_writer;
+    table&  m_table;
+    size_t  m_cursor = 0;
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+/// reads the cells of a table. Missing columns leave the value unmodified
+class table_reader
+{
+public:
+    table_reader(const table_view& _table)
+    : m_table(_table)
+    {
+        for(uint64_t i = 0; i < _table.num_columns(); ++i)
+            m_columns.emplace_back(_table.get_column(i));
+    }
+
+    void begin_row() { m_cursor = 0; }
+
+    template <typename Tp>
+    void get(const std::string& _name, uint64_t _row, Tp& _val)
+    {
+        if(column_traits<Tp>::is_empty)
+            return;
+        auto _col = find(_name);
+        if(!_col)
+            return;
+        if(!_col->holds<Tp>())
+        {
+            throw std::runtime_error("Column '" + _name + "' in '" +
+                                     m_table.file->get_filename() +
+                                     "' does not match the expected data type");
+        }
+        value_column<Tp>::read(*_col, _row, _val);
+    }
+
+    std::string get_string(uint64_t _offset) const
+    {
+        return m_table.file->get_string(_offset);
+    }
+
+private:
+    const column_view* find(const std::string& _name)
+    {
+        if(m_cursor < m_columns.size() && _name == m_columns.at(m_cursor).name)
+            return &m_columns.at(m_cursor++);
+        for(size_t i = 0; i < m_columns.size(); ++i)
+        {
+            if(_name == m_columns.at(i).name)
+            {
+                m_cursor = i + 1;
+                return &m_columns.at(i);
+            }
+        }
+        return nullptr;
+    }
+
+private:
+    table_view               m_table;
+    std::vector<column_view> m_columns = {};
+    size_t                   m_cursor  = 0;
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+/// invokes a function with the name and value of every field of an object which
+/// serializes itself as a list of cereal::make_nvp(...), e.g. tim::statistics
+template <typename FuncT>
+struct field_visitor
+{
+    FuncT& func;
+
+    template <typename... Args>
+    void operator()(Args&&... _args)
+    {
+        TIMEMORY_FOLD_EXPRESSION(func(_args.name, _args.value));
+    }
+};
+//
+template <typename Tp, typename FuncT>
+void
+visit_fields(Tp& _obj, FuncT&& _func)
+{
+    field_visitor<FuncT> _visitor{ _func };
+    _obj.serialize(_visitor, 0);
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+/// add the result nodes of a rank as a new table
+template <typename Tp>
+void
+save(writer& _writer, uint64_t _rank, const std::vector<node::result<Tp>>& _nodes)
+{
+    using stats_type = typename node::result<Tp>::stats_type;
+
+    auto&        _table = _writer.add_table(_rank, _nodes.size());
+    table_writer _tw(_writer, _table);
+
+    for(uint64_t i = 0; i < _nodes.size(); ++i)
+    {
+        const auto& itr = _nodes.at(i);
+        const auto& obj = itr.data();
+
+        _tw.begin_row();
+        _tw.set("hash", i, itr.hash());
+        _tw.set("rolling_hash", i, itr.rolling_hash());
+        _tw.set("prefix", i, _tw.add_string(itr.prefix()));
+        _tw.set("depth", i, itr.depth());
+        _tw.set("tid", i, itr.tid());
+        _tw.set("pid", i, itr.pid());
+        _tw.set("is_transient", i, obj.get_is_transient());
+        _tw.set("laps", i, obj.get_laps());
+        _tw.set("value", i, obj.get_value());
+        _tw.set("accum", i, obj.get_accum());
+        _tw.set("last", i, obj.get_last());
+        _tw.set("exclusive.value", i, itr.exclusive().get_value());
+        _tw.set("exclusive.accum", i, itr.exclusive().get_accum());
+
+        stats_type _stats = itr.stats();
+        visit_fields(_stats, [&](const char* _name, const auto& _val) {
+            _tw.set(std::string("stats.") + _name, i, _val);
+        });
+    }
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+/// load the result nodes from the table of a rank
+template <typename Tp>
+void
+load(const table_view& _table, std::vector<node::result<Tp>>& _nodes)
+{
+    using value_type = typename Tp::value_type;
+    using accum_type = decay_t<decltype(std::declval<Tp>().get_accum())>;
+    using last_type  = decay_t<decltype(std::declval<Tp>().get_last())>;
+
+    table_reader _tr(_table);
+    _nodes.resize(_table.size(), node::result<Tp>{});
+
+    for(uint64_t i = 0; i < _nodes.size(); ++i)
+    {
+        auto& itr     = _nodes.at(i);
+        auto& obj     = itr.data();
+        bool  _trans  = false;
+        auto  _laps   = int64_t{ 0 };
+        auto  _prefix = uint64_t{ 0 };
+        auto  _value  = value_type{};
+        auto  _accum  = accum_type{};
+        auto  _last   = last_type{};
+
+        _tr.begin_row();
+        _tr.get("hash", i, itr.hash());
+        _tr.get("rolling_hash", i, itr.rolling_hash());
+        _tr.get("prefix", i, _prefix);
+        _tr.get("depth", i, itr.depth());
+        _tr.get("tid", i, itr.tid());
+        _tr.get("pid", i, itr.pid());
+        _tr.get("is_transient", i, _trans);
+        _tr.get("laps", i, _laps);
+        _tr.get("value", i, _value);
+        _tr.get("accum", i, _accum);
+        _tr.get("last", i, _last);
+
+        visit_fields(itr.stats(), [&](const char* _name, auto& _val) {
+            _tr.get(std::string("stats.") + _name, i, _val);
+        });
+
+        itr.prefix() = _tr.get_string(_prefix);
+        obj.set_is_transient(_trans);
+        obj.set_laps(_laps);
+        obj.set_value(std::move(_value));
+        obj.set_accum(std::move(_accum));
+        obj.set_last(std::move(_last));
+
+        // tables written by older versions do not have the exclusive columns
+        auto& _excl   = itr.exclusive();
+        auto  _evalue = obj.get_value();
+        auto  _eaccum = obj.get_accum();
+        _tr.get("exclusive.value", i, _evalue);
+        _tr.get("exclusive.accum", i, _eaccum);
+        _excl = obj;
+        _excl.set_value(std::move(_evalue));
+        _excl.set_accum(std::move(_eaccum));
+    }
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+}  // namespace binary
+}  // namespace tim
+//
+//--------------------------------------------------------------------------------------//
@@ -77,9 +77,11 @@
     component::gpu_roofline_flops,              \
     component::gpu_roofline_hp_flops,           \
     component::gpu_roofline_sp_flops,           \
+    component::io_gotcha,                       \
     component::kernel_mode_time,                \
     component::likwid_marker,                   \
     component::likwid_nvmarker,                 \
+    component::lock_gotcha,                     \
     component::malloc_gotcha,                   \
     component::monotonic_clock,                 \
     component::monotonic_raw_clock,             \
@@ -91,12 +93,14 @@
     component::num_msg_sent,                    \
     component::num_signals,                     \
     component::num_swap,                        \
+    component::numa_locality,                   \
     component::nvtx_marker,                     \
     component::ompt_native_handle,              \
     component::page_rss,                        \
     component::papi_array_t,                    \
     component::papi_vector,                     \
     component::peak_rss,                        \
+    component::perf_counters,                   \
     component::priority_context_switch,         \
     component::process_cpu_clock,               \
     component::process_cpu_util,                \
@@ -0,0 +1,469 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/**
+ * \file timemory/utility/checkpoint.hpp
+ * \brief Periodic incremental checkpoints of the call-graphs of a running process
+ * (see TIMEMORY_CHECKPOINT_INTERVAL, TIMEMORY_CHECKPOINT_SIGNAL, and the
+ * timemory-checkpoint tool)
+ */
+
+#pragma once
+
+#include "timemory/storage/live.hpp"
+#include "timemory/utility/types.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tim
+{
+namespace checkpoint
+{
+//
+//--------------------------------------------------------------------------------------//
+//
+//  The checkpoint file is append-only:
+//
+//      file_header
+//      record_header, strings, rows
+//      record_header, strings, rows
+//      ...
+//
+//  Every record holds the change of every row since the previous record so a truncated
+//  file (e.g. a job killed during a write) loses at most the last record. Strings are
+//  numbered in the order they are first written and a record only holds the strings
+//  which were not written by a previous record (uint32_t length followed by the
+//  characters). A row which is not published anymore (e.g. the storage of a thread
+//  which exited was merged into the master thread) is written with the negated value
+//  so the sum of the records is always the state of the latest record.
+//
+//--------------------------------------------------------------------------------------//
+//
+static constexpr uint32_t format_version = 1;
+static constexpr uint32_t endian_marker  = 0x01020304;
+static constexpr uint32_t record_marker  = 0x54504B43;  // "CKPT"
+//
+struct file_header
+{
+    char     magic[8] = { 'T', 'I', 'M', 'C', 'K', 'P', 'T', '\0' };
+    uint32_t version  = format_version;
+    uint32_t endian   = endian_marker;
+};
+//
+struct record_header
+{
+    uint32_t marker      = record_marker;
+    uint32_t num_strings = 0;
+    uint64_t index       = 0;
+    int64_t  timestamp   = 0;  // nanoseconds since the unix epoch
+    uint64_t num_rows    = 0;
+};
+//
+struct row_data
+{
+    uint32_t component    = 0;  // string ids
+    uint32_t units        = 0;
+    uint32_t label        = 0;
+    uint32_t reserved     = 0;
+    int64_t  tid          = 0;
+    int64_t  depth        = 0;
+    uint64_t rolling_hash = 0;
+    int64_t  laps         = 0;
+    double   value        = 0.0;
+};
+//
+static_assert(sizeof(file_header) == 16, "Unexpected padding in file_header");
+static_assert(sizeof(record_header) == 32, "Unexpected padding in record_header");
+static_assert(sizeof(row_data) == 56, "Unexpected padding in row_data");
+//
+//--------------------------------------------------------------------------------------//
+//
+/// a record read from a checkpoint file with the strings resolved
+struct record
+{
+    struct row
+    {
+        std::string component    = {};
+        std::string units        = {};
+        std::string label        = {};
+        int64_t     tid          = 0;
+        int64_t     depth        = 0;
+        uint64_t    rolling_hash = 0;
+        int64_t     laps         = 0;
+        double      value        = 0.0;
+    };
+
+    uint64_t         index     = 0;
+    int64_t          timestamp = 0;
+    std::vector<row> rows      = {};
+};
+//
+/// reads every complete record of a checkpoint file. Throws if the file cannot be
+/// opened or is not a checkpoint file
+inline std::vector<record>
+read(const std::string& _fname)
+{
+    std::ifstream ifs(_fname.c_str(), std::ios::in | std::ios::binary);
+    if(!ifs)
+        throw std::runtime_error("Error opening '" + _fname + "'");
+
+    file_header _file{};
+    file_header _expected{};
+    if(!ifs.read(reinterpret_cast<char*>(&_file), sizeof(_file)) ||
+       memcmp(_file.magic, _expected.magic, sizeof(_file.magic)) != 0)
+        throw std::runtime_error("'" + _fname + "' is not a checkpoint file");
+    if(_file.version != format_version || _file.endian != endian_marker)
+        throw std::runtime_error("'" + _fname +
+                                 "' has an unsupported version or byte order");
+
+    std::vector<record>      _records{};
+    std::vector<std::string> _strings{};
+    record_header            _header{};
+    while(ifs.read(reinterpret_cast<char*>(&_header), sizeof(_header)))
+    {
+        if(_header.marker != record_marker)
+            break;
+
+        // the strings of an incomplete record are discarded with the record
+        auto _nstrings = _strings.size();
+        bool _complete = true;
+        for(uint32_t i = 0; i < _header.num_strings && _complete; ++i)
+        {
+            uint32_t _len = 0;
+            _complete     = static_cast<bool>(
+                ifs.read(reinterpret_cast<char*>(&_len), sizeof(_len)));
+            std::string _str(_len, '\0');
+            _complete = _complete && (_len == 0 || ifs.read(&_str[0], _len));
+            _strings.emplace_back(std::move(_str));
+        }
+
+        record _record{ _header.index, _header.timestamp, {} };
+        for(uint64_t i = 0; i < _header.num_rows && _complete; ++i)
+        {
+            row_data _row{};
+            _complete = static_cast<bool>(
+                ifs.read(reinterpret_cast<char*>(&_row), sizeof(_row)));
+            if(!_complete || _row.component >= _strings.size() ||
+               _row.units >= _strings.size() || _row.label >= _strings.size())
+            {
+                _complete = false;
+                break;
+            }
+            _record.rows.emplace_back(record::row{
+                _strings.at(_row.component), _strings.at(_row.units),
+                _strings.at(_row.label), _row.tid, _row.depth, _row.rolling_hash,
+                _row.laps, _row.value });
+        }
+
+        if(!_complete)
+        {
+            _strings.resize(_nstrings);
+            break;
+        }
+        _records.emplace_back(std::move(_record));
+    }
+    return _records;
+}
+//
+/// sums the rows of the records in [\param _begin, \param _end) in the order the rows
+/// first appear. The sum of all the records is the state of the latest record and the
+/// sum of the records after the first N is the change after the first N records
+inline std::vector<record::row>
+accumulate(const std::vector<record>& _records, size_t _begin = 0,
+           size_t _end = std::numeric_limits<size_t>::max())
+{
+    using key_type = std::tuple<std::string, int64_t, int64_t, uint64_t, std::string>;
+
+    std::vector<record::row>   _rows{};
+    std::map<key_type, size_t> _index{};
+    for(size_t i = _begin; i < std::min(_end, _records.size()); ++i)
+    {
+        for(const auto& itr : _records.at(i).rows)
+        {
+            auto _key = key_type{ itr.component, itr.tid, itr.depth, itr.rolling_hash,
+                                  itr.label };
+            auto _idx = _index.find(_key);
+            if(_idx == _index.end())
+            {
+                _index.emplace(_key, _rows.size());
+                _rows.emplace_back(itr);
+            }
+            else
+            {
+                _rows.at(_idx->second).laps += itr.laps;
+                _rows.at(_idx->second).value += itr.value;
+            }
+        }
+    }
+    return _rows;
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+/// \class tim::checkpoint::writer
+/// \brief Appends a record to the checkpoint file every interval and/or when the
+/// signal is received. The snapshots are published by the thread owning each storage
+/// instance over its next pops (see timemory/storage/live.hpp): a pop copies at most
+/// live::nodes_per_pop nodes and the labels are resolved by the writer thread.
+///
+class writer
+{
+public:
+    static writer& instance()
+    {
+        static auto* _instance = new writer{};
+        return *_instance;
+    }
+
+    ~writer() { stop(); }
+
+    writer(const writer&) = delete;
+    writer(writer&&)      = delete;
+    writer& operator=(const writer&) = delete;
+    writer& operator=(writer&&) = delete;
+
+    bool        is_running() const { return m_running.load(); }
+    std::string get_filename() const { return m_fname; }
+
+    /// truncates the file and starts the thread writing the checkpoints. An interval
+    /// of zero only writes a checkpoint when the signal is received (a signal of zero)
+    bool start(const std::string& _fname, uint64_t _interval, int _signal = 0,
+               int64_t _timeout = 100)
+    {
+        std::lock_guard<std::mutex> _lk(m_mutex);
+        if(m_running.load())
+            return true;
+
+        {
+            std::lock_guard<std::mutex> _wlk(m_write_mutex);
+            m_ofs.open(_fname.c_str(),
+                       std::ios::out | std::ios::binary | std::ios::trunc);
+            if(!m_ofs)
+            {
+                fprintf(stderr, "[timemory]> Error opening checkpoint file '%s'\n",
+                        _fname.c_str());
+                return false;
+            }
+            file_header _header{};
+            m_ofs.write(reinterpret_cast<const char*>(&_header), sizeof(_header));
+            m_ofs.flush();
+            m_fname   = _fname;
+            m_index   = 0;
+            m_timeout = _timeout;
+            m_strings.clear();
+            m_previous.clear();
+        }
+
+#if !defined(_WINDOWS)
+        if(_signal > 0)
+        {
+            struct sigaction _action;
+            memset(&_action, 0, sizeof(_action));
+            _action.sa_handler = &writer::signal_handler;
+            _action.sa_flags   = SA_RESTART;
+            sigemptyset(&_action.sa_mask);
+            sigaction(_signal, &_action, nullptr);
+        }
+#else
+        consume_parameters(_signal);
+#endif
+
+        m_running.store(true);
+        m_thread = std::thread(&writer::execute, this, _interval);
+        return true;
+    }
+
+    /// stops the thread and writes a final checkpoint (the storage instances owned by
+    /// the calling thread are included so this is called from the master thread at
+    /// finalization)
+    void stop()
+    {
+        std::lock_guard<std::mutex> _lk(m_mutex);
+        if(!m_running.load())
+            return;
+        m_running.store(false);
+        if(m_thread.joinable())
+            m_thread.join();
+        write();
+        std::lock_guard<std::mutex> _wlk(m_write_mutex);
+        m_ofs.close();
+    }
+
+    /// collects the published snapshots and appends the change since the previous
+    /// checkpoint. Returns the number of rows written
+    size_t write()
+    {
+        std::lock_guard<std::mutex> _lk(m_write_mutex);
+        if(!m_ofs.is_open())
+            return 0;
+
+        uint64_t _epoch     = 0;
+        size_t   _published = 0;
+        size_t   _total     = 0;
+        auto     _rows      = live::collect(m_timeout, _epoch, _published, _total);
+        auto     _now       = std::chrono::system_clock::now().time_since_epoch();
+
+        record_header _header{};
+        _header.index = m_index++;
+        _header.timestamp =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(_now).count();
+
+        std::vector<std::string> _new_strings{};
+        auto                     _get_id = [&](const std::string& _str) {
+            auto itr = m_strings.find(_str);
+            if(itr != m_strings.end())
+                return itr->second;
+            auto _id = static_cast<uint32_t>(m_strings.size());
+            m_strings.emplace(_str, _id);
+            _new_strings.emplace_back(_str);
+            return _id;
+        };
+
+        data_t                _current{};
+        std::vector<row_data> _data{};
+        for(const auto& itr : _rows)
+        {
+            row_data _row{};
+            _row.component    = _get_id(itr.component);
+            _row.units        = _get_id(itr.units);
+            _row.label        = _get_id(itr.value.label);
+            _row.tid          = itr.tid;
+            _row.depth        = itr.value.depth;
+            _row.rolling_hash = itr.value.rolling_hash;
+            _row.laps         = itr.value.laps;
+            _row.value        = itr.value.value;
+
+            auto _key = get_key(_row);
+            _current.emplace(_key, _row);
+            auto pitr = m_previous.find(_key);
+            if(pitr != m_previous.end())
+            {
+                _row.laps -= pitr->second.laps;
+                _row.value -= pitr->second.value;
+            }
+            if(_row.laps != 0 || _row.value != 0.0)
+                _data.emplace_back(_row);
+        }
+
+        // rows which are not published anymore are removed
+        for(const auto& itr : m_previous)
+        {
+            if(_current.find(itr.first) != _current.end())
+                continue;
+            auto _row = itr.second;
+            _row.laps *= -1;
+            _row.value *= -1.0;
+            _data.emplace_back(_row);
+        }
+
+        _header.num_strings = static_cast<uint32_t>(_new_strings.size());
+        _header.num_rows    = _data.size();
+        m_ofs.write(reinterpret_cast<const char*>(&_header), sizeof(_header));
+        for(const auto& itr : _new_strings)
+        {
+            auto _len = static_cast<uint32_t>(itr.length());
+            m_ofs.write(reinterpret_cast<const char*>(&_len), sizeof(_len));
+            m_ofs.write(itr.data(), _len);
+        }
+        if(!_data.empty())
+            m_ofs.write(reinterpret_cast<const char*>(_data.data()),
+                        _data.size() * sizeof(row_data));
+        m_ofs.flush();
+
+        m_previous = std::move(_current);
+        return _data.size();
+    }
+
+private:
+    writer() = default;
+
+    // component, tid, depth, rolling hash, label
+    using key_type = std::tuple<uint32_t, int64_t, int64_t, uint64_t, uint32_t>;
+    using data_t   = std::map<key_type, row_data>;
+
+    static key_type get_key(const row_data& _row)
+    {
+        return key_type{ _row.component, _row.tid, _row.depth, _row.rolling_hash,
+                         _row.label };
+    }
+
+    static std::atomic<bool>& get_signaled()
+    {
+        static std::atomic<bool> _instance{ false };
+        return _instance;
+    }
+
+    static void signal_handler(int) { get_signaled().store(true); }
+
+    void execute(uint64_t _interval)
+    {
+        using clock_type = std::chrono::steady_clock;
+        auto _next       = clock_type::now() + std::chrono::seconds(_interval);
+        while(m_running.load())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            bool _signaled = get_signaled().exchange(false);
+            bool _expired  = (_interval > 0 && clock_type::now() >= _next);
+            if(!_signaled && !_expired)
+                continue;
+            write();
+            _next = clock_type::now() + std::chrono::seconds(_interval);
+        }
+    }
+
+private:
+    std::atomic<bool>                         m_running{ false };
+    uint64_t                                  m_index   = 0;
+    int64_t                                   m_timeout = 100;
+    std::string                               m_fname{};
+    std::ofstream                             m_ofs{};
+    std::thread                               m_thread{};
+    std::mutex                                m_mutex{};
+    std::mutex                                m_write_mutex{};
+    std::unordered_map<std::string, uint32_t> m_strings{};
+    data_t                                    m_previous{};
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+}  // namespace checkpoint
+}  // namespace tim
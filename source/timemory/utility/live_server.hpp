@@ -0,0 +1,390 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/**
+ * \file timemory/utility/live_server.hpp
+ * \brief Serves snapshots of the call-graphs of a running process over a Unix domain
+ * socket (see TIMEMORY_LIVE_SOCKET and the timemory-live tool)
+ */
+
+#pragma once
+
+#include "timemory/storage/live.hpp"
+
+#if !defined(_WINDOWS)
+
+#    include <algorithm>
+#    include <atomic>
+#    include <cerrno>
+#    include <chrono>
+#    include <cstdint>
+#    include <cstdio>
+#    include <cstring>
+#    include <map>
+#    include <mutex>
+#    include <sstream>
+#    include <string>
+#    include <thread>
+#    include <tuple>
+#    include <vector>
+
+#    include <poll.h>
+#    include <sys/socket.h>
+#    include <sys/stat.h>
+#    include <sys/un.h>
+#    include <unistd.h>
+
+namespace tim
+{
+namespace live
+{
+//
+//--------------------------------------------------------------------------------------//
+//
+/// \class tim::live::server
+/// \brief Accepts connections on a Unix domain socket and answers one request per
+/// connection. A request is a single line:
+///
+///     snapshot [timeout_msec]
+///     delta [timeout_msec]
+///
+/// The server increments \ref requested_epoch and waits (up to the timeout, default
+/// 100 msec, at most \ref max_timeout msec) for the storage instances to publish a
+/// snapshot from their owning thread on the next pop. A thread which does not pop
+/// within the timeout reports its last published snapshot and its rows are marked as
+/// stale. "delta" reports the change since the previous query made on this server.
+///
+/// The response is a header line starting with '#' followed by one tab-separated row
+/// per node:
+///
+///     component  tid  depth  laps  value  units  stale  label
+///
+class server
+{
+public:
+    static server& instance()
+    {
+        static auto* _instance = new server{};
+        return *_instance;
+    }
+
+    /// the upper bound of the timeout requested by a client (msec)
+    static constexpr int64_t max_timeout = 10000;
+    /// the time allowed for a client to send the request and read the response (msec)
+    static constexpr int64_t io_timeout = 1000;
+    /// requests longer than this are truncated
+    static constexpr size_t max_request_length = 256;
+
+    ~server() { stop(); }
+
+    server(const server&) = delete;
+    server(server&&)      = delete;
+    server& operator=(const server&) = delete;
+    server& operator=(server&&) = delete;
+
+    bool is_running() const { return m_running.load(); }
+
+    /// binds the socket and starts the thread serving the requests
+    bool start(const std::string& _path)
+    {
+        std::lock_guard<std::mutex> _lk(m_mutex);
+        if(m_running.load())
+            return true;
+
+        sockaddr_un _addr{};
+        if(_path.empty() || _path.length() >= sizeof(_addr.sun_path))
+        {
+            fprintf(stderr, "[timemory]> invalid live socket path: '%s'\n",
+                    _path.c_str());
+            return false;
+        }
+
+        m_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if(m_fd < 0)
+        {
+            perror("[timemory]> live socket");
+            return false;
+        }
+
+        _addr.sun_family = AF_UNIX;
+        strncpy(_addr.sun_path, _path.c_str(), sizeof(_addr.sun_path) - 1);
+        if(!remove_stale(_addr))
+        {
+            ::close(m_fd);
+            m_fd = -1;
+            return false;
+        }
+        if(::bind(m_fd, reinterpret_cast<sockaddr*>(&_addr), sizeof(_addr)) != 0 ||
+           ::listen(m_fd, 8) != 0)
+        {
+            perror("[timemory]> live socket");
+            ::close(m_fd);
+            m_fd = -1;
+            return false;
+        }
+
+        m_path = _path;
+        m_running.store(true);
+        m_thread = std::thread(&server::execute, this);
+        return true;
+    }
+
+    /// stops the thread serving the requests and removes the socket
+    void stop()
+    {
+        std::lock_guard<std::mutex> _lk(m_mutex);
+        if(!m_running.load())
+            return;
+        m_running.store(false);
+        if(m_thread.joinable())
+            m_thread.join();
+        ::close(m_fd);
+        ::unlink(m_path.c_str());
+        m_fd = -1;
+        m_path.clear();
+    }
+
+    /// the response to a request (exposed for testing)
+    std::string query(const std::string& _request)
+    {
+        std::string _mode    = "snapshot";
+        int64_t     _timeout = 100;
+        std::istringstream _iss(_request);
+        _iss >> _mode >> _timeout;
+        if(_mode != "snapshot" && _mode != "delta")
+            return "# error: unknown request '" + _mode + "'\n";
+        if(_timeout < 0)
+            _timeout = 0;
+        else if(_timeout > max_timeout)
+            _timeout = max_timeout;
+        return (_mode == "delta") ? get_delta(_timeout) : get_snapshot(_timeout);
+    }
+
+private:
+    server() = default;
+
+    // the key of a row for the delta: component, tid, depth, rolling hash, label
+    using key_t  = std::tuple<std::string, int64_t, int64_t, uint64_t, std::string>;
+    using data_t = std::map<key_t, std::pair<int64_t, double>>;
+
+    using clock_type = std::chrono::steady_clock;
+
+    // a file at the path is only removed if it is a socket nobody is listening on
+    // (i.e. left behind by a previous run)
+    static bool remove_stale(const sockaddr_un& _addr)
+    {
+        struct stat _st
+        {};
+        if(::lstat(_addr.sun_path, &_st) != 0)
+            return true;
+        if(!S_ISSOCK(_st.st_mode))
+        {
+            fprintf(stderr,
+                    "[timemory]> live socket path '%s' exists and is not a socket\n",
+                    _addr.sun_path);
+            return false;
+        }
+        int _fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if(_fd < 0)
+            return false;
+        auto _ret = ::connect(_fd, reinterpret_cast<const sockaddr*>(&_addr),
+                              sizeof(_addr));
+        ::close(_fd);
+        if(_ret == 0)
+        {
+            fprintf(stderr, "[timemory]> live socket '%s' is in use by another process\n",
+                    _addr.sun_path);
+            return false;
+        }
+        ::unlink(_addr.sun_path);
+        return true;
+    }
+
+    // waits until the connection is ready for the events or the deadline has passed
+    static bool wait_for(int _conn, short _events, clock_type::time_point _deadline)
+    {
+        while(true)
+        {
+            auto _remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                  _deadline - clock_type::now())
+                                  .count();
+            if(_remaining <= 0)
+                return false;
+            pollfd _pfd{};
+            _pfd.fd     = _conn;
+            _pfd.events = _events;
+            auto _ret   = ::poll(&_pfd, 1, static_cast<int>(_remaining));
+            if(_ret < 0 && errno == EINTR)
+                continue;
+            return (_ret > 0 && (_pfd.revents & _events) != 0);
+        }
+    }
+
+    // reads up to the first newline. A client which does not send a complete request
+    // before the deadline gets the response to the partial request
+    static std::string read_request(int _conn, clock_type::time_point _deadline)
+    {
+        std::string _request{};
+        char        _buffer[64];
+        while(_request.length() < max_request_length &&
+              wait_for(_conn, POLLIN, _deadline))
+        {
+            auto _n = ::recv(_conn, _buffer, sizeof(_buffer), MSG_DONTWAIT);
+            if(_n < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK))
+                continue;
+            if(_n <= 0)
+                break;
+            auto _end = std::find(_buffer, _buffer + _n, '\n');
+            _request.append(_buffer, _end);
+            if(_end != _buffer + _n)
+                break;
+        }
+        if(_request.length() > max_request_length)
+            _request.resize(max_request_length);
+        return _request;
+    }
+
+    // a client which closed the connection must not raise SIGPIPE in the application
+    // and a client which does not read must not block the server past the deadline
+    static void write_response(int _conn, const std::string& _response,
+                               clock_type::time_point _deadline)
+    {
+#    if defined(MSG_NOSIGNAL)
+        constexpr int _flags = MSG_NOSIGNAL | MSG_DONTWAIT;
+#    else
+        constexpr int _flags = MSG_DONTWAIT;
+        int           _one   = 1;
+        ::setsockopt(_conn, SOL_SOCKET, SO_NOSIGPIPE, &_one, sizeof(_one));
+#    endif
+        auto _offset = size_t{ 0 };
+        while(_offset < _response.length() && wait_for(_conn, POLLOUT, _deadline))
+        {
+            auto _n = ::send(_conn, _response.data() + _offset,
+                             _response.length() - _offset, _flags);
+            if(_n < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK))
+                continue;
+            if(_n <= 0)
+                break;
+            _offset += static_cast<size_t>(_n);
+        }
+    }
+
+    void execute()
+    {
+        while(m_running.load())
+        {
+            pollfd _pfd{};
+            _pfd.fd     = m_fd;
+            _pfd.events = POLLIN;
+            // wake up periodically to check whether the server was stopped
+            if(::poll(&_pfd, 1, 100) <= 0 || (_pfd.revents & POLLIN) == 0)
+                continue;
+            int _conn = ::accept(m_fd, nullptr, nullptr);
+            if(_conn < 0)
+                continue;
+
+            auto _timeout  = std::chrono::milliseconds{ int64_t{ io_timeout } };
+            auto _request  = read_request(_conn, clock_type::now() + _timeout);
+            auto _response = query(_request);
+            write_response(_conn, _response, clock_type::now() + _timeout);
+            ::close(_conn);
+        }
+    }
+
+    std::string get_snapshot(int64_t _timeout)
+    {
+        std::lock_guard<std::mutex> _lk(m_query_mutex);
+        uint64_t                    _epoch     = 0;
+        size_t                      _published = 0;
+        size_t                      _total     = 0;
+        auto                        _rows = collect(_timeout, _epoch, _published, _total);
+        return format("snapshot", _rows, _epoch, _published, _total, nullptr);
+    }
+
+    std::string get_delta(int64_t _timeout)
+    {
+        std::lock_guard<std::mutex> _lk(m_query_mutex);
+        uint64_t                    _epoch     = 0;
+        size_t                      _published = 0;
+        size_t                      _total     = 0;
+        auto                        _rows = collect(_timeout, _epoch, _published, _total);
+        data_t                      _current{};
+        auto _ret = format("delta", _rows, _epoch, _published, _total, &_current);
+        m_previous = std::move(_current);
+        return _ret;
+    }
+
+    std::string format(const char* _mode, const std::vector<row>& _rows,
+                       uint64_t _epoch, size_t _published, size_t _total,
+                       data_t* _current)
+    {
+        std::stringstream ss;
+        ss << "# timemory live " << _mode << " epoch=" << _epoch
+           << " published=" << _published << "/" << _total << "\n";
+        for(const auto& itr : _rows)
+        {
+            auto _laps  = itr.value.laps;
+            auto _value = itr.value.value;
+            if(_current)
+            {
+                auto _key = key_t{ itr.component, itr.tid, itr.value.depth,
+                                   itr.value.rolling_hash, itr.value.label };
+                (*_current)[_key] = { _laps, _value };
+                auto pitr         = m_previous.find(_key);
+                if(pitr != m_previous.end())
+                {
+                    _laps -= pitr->second.first;
+                    _value -= pitr->second.second;
+                }
+            }
+            auto _label = itr.value.label;
+            for(auto& c : _label)
+            {
+                if(c == '\t' || c == '\n')
+                    c = ' ';
+            }
+            ss << itr.component << '\t' << itr.tid << '\t' << itr.value.depth << '\t'
+               << _laps << '\t' << _value << '\t' << itr.units << '\t'
+               << ((itr.stale) ? 1 : 0) << '\t' << _label << '\n';
+        }
+        return ss.str();
+    }
+
+private:
+    std::atomic<bool> m_running{ false };
+    int               m_fd = -1;
+    std::string       m_path{};
+    std::thread       m_thread{};
+    std::mutex        m_mutex{};
+    std::mutex        m_query_mutex{};
+    data_t            m_previous{};
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+}  // namespace live
+}  // namespace tim
+
+#endif
@@ -0,0 +1,215 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+/**
+ * \file timemory/utility/overhead.hpp
+ * \brief Calibration of the instrumentation overhead of a bundle which is subtracted
+ * from the inclusive values of the timing components during finalization (see
+ * TIMEMORY_OVERHEAD_COMPENSATION)
+ */
+
+#pragma once
+
+#include "timemory/hash/types.hpp"
+#include "timemory/mpl/type_traits.hpp"
+#include "timemory/settings/declaration.hpp"
+#include "timemory/utility/serializer.hpp"
+#include "timemory/utility/utility.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+namespace tim
+{
+namespace overhead
+{
+//
+//--------------------------------------------------------------------------------------//
+//
+//  Every start/stop of a child region is counted in the inclusive value of the parent
+//  (and of every other ancestor), i.e. the parent is inflated by the number of nested
+//  start/stop pairs times the cost of one pair. The cost of an empty start/stop of the
+//  bundle used for the instrumentation is measured once and the inclusive value of
+//  every region is reduced by the number of nested pairs times this cost when the
+//  results are collected.
+//
+//--------------------------------------------------------------------------------------//
+//
+struct calibration
+{
+    bool        valid    = false;
+    double      per_call = 0.0;  // seconds per start/stop pair
+    uint64_t    samples  = 0;
+    std::string bundle   = {};
+
+    template <typename Archive>
+    void save(Archive& ar, const unsigned int) const
+    {
+        ar(cereal::make_nvp("per_call_ns", per_call * 1.0e9),
+           cereal::make_nvp("samples", samples), cereal::make_nvp("bundle", bundle));
+    }
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+inline calibration&
+get_calibration() TIMEMORY_VISIBILITY("default");
+//
+inline calibration&
+get_calibration()
+{
+    static calibration _instance{};
+    return _instance;
+}
+//
+//--------------------------------------------------------------------------------------//
+/// the label of the region recorded during the calibration. It is excluded from the
+/// results
+inline const std::string&
+get_label()
+{
+    static std::string _instance = "timemory-overhead-calibration";
+    return _instance;
+}
+//
+inline uint64_t
+get_hash()
+{
+    static uint64_t _instance = add_hash_id(get_label());
+    return _instance;
+}
+//
+//--------------------------------------------------------------------------------------//
+/// whether the values of the component are compensated, i.e. it is a timing component
+/// with a scalar value in units of Tp::ratio_t
+template <typename Tp, typename = typename Tp::ratio_t>
+constexpr bool
+is_compensated(int)
+{
+    return trait::is_timing_category<Tp>::value &&
+           std::is_arithmetic<typename Tp::value_type>::value;
+}
+//
+template <typename Tp>
+constexpr bool
+is_compensated(long)
+{
+    return false;
+}
+//
+template <typename Tp>
+constexpr bool
+is_compensated()
+{
+    return is_compensated<Tp>(0);
+}
+//
+//--------------------------------------------------------------------------------------//
+/// whether the values of the component are compensated in this run
+template <typename Tp>
+bool
+is_applied()
+{
+    return is_compensated<Tp>() && settings::overhead_compensation() &&
+           get_calibration().valid;
+}
+//
+//--------------------------------------------------------------------------------------//
+/// the calibrated cost of a start/stop pair in the units of the value of Tp
+template <typename Tp, typename Ratio = typename Tp::ratio_t>
+double
+get_per_call()
+{
+    const auto& _calib = get_calibration();
+    if(!_calib.valid)
+        return 0.0;
+    return _calib.per_call * Ratio::den / Ratio::num;
+}
+//
+//--------------------------------------------------------------------------------------//
+/// measures the cost of an empty start/stop, i.e. a call of _func(get_label()) which
+/// starts and stops a region with the label, including the insertion into the
+/// call-graph. The minimum over several batches is used so that a preemption during
+/// the calibration does not inflate the result
+template <typename FuncT>
+calibration&
+calibrate(const std::string& _name, FuncT&& _func, uint64_t _samples = 1000)
+{
+    constexpr uint64_t _nbatch = 5;
+
+    auto&       _calib = get_calibration();
+    const auto& _label = get_label();
+    auto        _nsamp = std::max<uint64_t>(_samples / _nbatch, 1);
+    auto        _best  = std::numeric_limits<double>::max();
+
+    // the first start/stop creates the storage and the node in the call-graph
+    _func(_label);
+
+    for(uint64_t i = 0; i < _nbatch; ++i)
+    {
+        auto _beg = std::chrono::steady_clock::now();
+        for(uint64_t j = 0; j < _nsamp; ++j)
+            _func(_label);
+        auto _end = std::chrono::steady_clock::now();
+        auto _dur = std::chrono::duration<double>(_end - _beg).count();
+        _best     = std::min<double>(_best, _dur / _nsamp);
+    }
+
+    _calib.valid    = true;
+    _calib.per_call = _best;
+    _calib.samples  = _nbatch * _nsamp;
+    _calib.bundle   = _name;
+
+    if(settings::debug() || settings::verbose() > 1)
+        PRINT_HERE("calibrated overhead of '%s' : %.1f ns per start/stop",
+                   _calib.bundle.c_str(), _calib.per_call * 1.0e9);
+
+    return _calib;
+}
+//
+//--------------------------------------------------------------------------------------//
+/// measures the cost of an empty start/stop of BundleT
+template <typename BundleT>
+calibration&
+calibrate(uint64_t _samples = 1000)
+{
+    return calibrate(
+        demangle<BundleT>(),
+        [](const std::string& _label) {
+            BundleT _obj{ _label };
+            _obj.start();
+            _obj.stop();
+        },
+        _samples);
+}
+//
+//--------------------------------------------------------------------------------------//
+//
+}  // namespace overhead
+}  // namespace tim
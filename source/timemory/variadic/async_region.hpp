@@ -0,0 +1,233 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+/**
+ * \file timemory/variadic/async_region.hpp
+ * \brief Region which is started on one thread and stopped on any thread
+ */
+
+#pragma once
+
+#include "timemory/backends/threading.hpp"
+#include "timemory/hash/declaration.hpp"
+#include "timemory/mpl/type_traits.hpp"
+#include "timemory/operations/types.hpp"
+#include "timemory/settings/declaration.hpp"
+#include "timemory/storage/declaration.hpp"
+#include "timemory/utility/types.hpp"
+
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <utility>
+
+namespace tim
+{
+//
+//--------------------------------------------------------------------------------------//
+//
+/// \class tim::async_region
+/// \brief Handle for a region of task-based or coroutine code which may be stopped on
+/// a different thread than the one which started it (thread pools, std::async, TBB
+/// tasks, coroutines resumed on another thread). The storage is thread-local so
+/// start() inserts the node at the current call-path of the starting thread, without
+/// making it the parent of the regions started afterwards, and keeps the node and the
+/// inbox of that thread's storage. stop() may be called on any thread: the measurement
+/// is posted to the lock-free inbox and the starting thread adds it to the node the
+/// next time it pops a component or when its storage is merged, so neither thread
+/// waits for the other. If the storage of the starting thread was already merged, the
+/// measurement is recorded at the current call-path of the stopping thread.
+///
+/// The components must have storage and should not measure the calling thread, e.g.
+/// wall_clock is meaningful across threads but thread_cpu_clock is not.
+///
+/// \code{.cpp}
+/// tim::async_region<wall_clock> _region{ "load" };
+/// _region.start();
+/// pool.submit([_region = std::move(_region)]() mutable {
+///     load();
+///     _region.stop();
+/// });
+/// \endcode
+///
+template <typename... Types>
+class async_region
+{
+    static_assert(sizeof...(Types) > 0, "async_region requires at least one component");
+
+    template <typename Tp>
+    struct slot
+    {
+        static_assert(implements_storage<Tp>::value,
+                      "async_region requires components with storage");
+
+        using storage_type = storage<Tp>;
+        using iterator     = typename storage_type::iterator;
+        using inbox_ptr_t  = typename storage_type::inbox_ptr_t;
+
+        Tp          obj    = {};
+        iterator    target = {};
+        inbox_ptr_t inbox  = {};
+    };
+
+    using data_type     = std::tuple<slot<Types>...>;
+    using sequence_type = std::make_index_sequence<sizeof...(Types)>;
+
+public:
+    using this_type = async_region<Types...>;
+
+    async_region() = default;
+
+    explicit async_region(const std::string& _key,
+                          scope::config      _scope = scope::get_default())
+    : m_scope{ _scope }
+    , m_hash{ add_hash_id(_key) }
+    {}
+
+    explicit async_region(hash_result_type _hash,
+                          scope::config    _scope = scope::get_default())
+    : m_scope{ _scope }
+    , m_hash{ _hash }
+    {}
+
+    /// a region which is still running is stopped by the destroying thread
+    ~async_region() { stop(); }
+
+    async_region(const async_region&) = delete;
+    async_region& operator=(const async_region&) = delete;
+
+    async_region(async_region&& rhs) noexcept
+    : m_running{ std::exchange(rhs.m_running, false) }
+    , m_scope{ rhs.m_scope }
+    , m_hash{ rhs.m_hash }
+    , m_tid{ rhs.m_tid }
+    , m_data{ std::move(rhs.m_data) }
+    {}
+
+    async_region& operator=(async_region&& rhs) noexcept
+    {
+        if(this != &rhs)
+        {
+            stop();
+            m_running = std::exchange(rhs.m_running, false);
+            m_scope   = rhs.m_scope;
+            m_hash    = rhs.m_hash;
+            m_tid     = rhs.m_tid;
+            m_data    = std::move(rhs.m_data);
+        }
+        return *this;
+    }
+
+    /// inserts the nodes on the calling thread and starts the components
+    this_type& start()
+    {
+        if(m_running || m_hash == 0 || !settings::hot().enabled)
+            return *this;
+        m_running = true;
+        m_tid     = threading::get_id();
+        start(sequence_type{});
+        return *this;
+    }
+
+    /// stops the components and attributes the measurement to the nodes inserted by
+    /// start(). May be called on any thread
+    this_type& stop()
+    {
+        if(!m_running)
+            return *this;
+        m_running = false;
+        stop(sequence_type{});
+        return *this;
+    }
+
+    bool             is_running() const { return m_running; }
+    hash_result_type hash() const { return m_hash; }
+    int64_t          get_tid() const { return m_tid; }
+
+    /// the component of the given index, e.g. for the value after stop()
+    template <size_t Idx>
+    const auto& get() const
+    {
+        return std::get<Idx>(m_data).obj;
+    }
+
+private:
+    template <size_t... Idx>
+    void start(std::index_sequence<Idx...>)
+    {
+        TIMEMORY_FOLD_EXPRESSION(start(std::get<Idx>(m_data)));
+    }
+
+    template <size_t... Idx>
+    void stop(std::index_sequence<Idx...>)
+    {
+        bool _same_thread = (threading::get_id() == m_tid);
+        TIMEMORY_FOLD_EXPRESSION(stop(std::get<Idx>(m_data), _same_thread));
+    }
+
+    template <typename Tp>
+    void start(slot<Tp>& _slot)
+    {
+        auto _storage = slot<Tp>::storage_type::instance();
+        _slot.obj     = Tp{};
+        _slot.target  = _storage->insert(m_scope, _slot.obj, m_hash);
+        // later regions on this thread are not children of the async region
+        if(!m_scope.is_flat())
+            _storage->pop();
+        _slot.inbox = _storage->get_inbox();
+        operation::start<Tp>{ _slot.obj };
+    }
+
+    template <typename Tp>
+    void stop(slot<Tp>& _slot, bool _same_thread)
+    {
+        operation::stop<Tp>{ _slot.obj };
+        auto _inbox = std::move(_slot.inbox);
+        if(_inbox && _inbox->post(_slot.target, _slot.obj))
+        {
+            // the inbox belongs to the storage of this thread
+            if(_same_thread)
+                slot<Tp>::storage_type::instance()->async_drain();
+        }
+        else
+        {
+            auto _storage = slot<Tp>::storage_type::instance();
+            _storage->async_apply(_storage->insert(m_scope, Tp{}, m_hash), _slot.obj);
+            if(!m_scope.is_flat())
+                _storage->pop();
+        }
+    }
+
+private:
+    bool             m_running = false;
+    scope::config    m_scope   = scope::get_default();
+    hash_result_type m_hash    = 0;
+    int64_t          m_tid     = -1;
+    data_type        m_data    = {};
+};
+//
+//--------------------------------------------------------------------------------------//
+//
+}  // namespace tim
@@ -111,21 +111,21 @@ public:
 
     template <typename Init = initializer_type>
     explicit auto_bundle(const string_t&, scope::config = scope::get_default(),
-                         bool report_at_exit = settings::destructor_report(),
+                         bool report_at_exit = settings::hot().destructor_report,
                          const Init&         = this_type::get_initializer());
 
     template <typename Init = initializer_type>
     explicit auto_bundle(const captured_location_t&, scope::config = scope::get_default(),
-                         bool report_at_exit = settings::destructor_report(),
+                         bool report_at_exit = settings::hot().destructor_report,
                          const Init&         = this_type::get_initializer());
 
     template <typename Init = initializer_type>
     explicit auto_bundle(size_t, scope::config = scope::get_default(),
-                         bool report_at_exit = settings::destructor_report(),
+                         bool report_at_exit = settings::hot().destructor_report,
                          const Init&         = this_type::get_initializer());
 
     explicit auto_bundle(component_type& tmp, scope::config = scope::get_default(),
-                         bool            report_at_exit = settings::destructor_report());
+                         bool report_at_exit = settings::hot().destructor_report);
 
     template <typename Init, typename Arg, typename... Args>
     auto_bundle(const string_t&, bool store, scope::config _scope, const Init&, Arg&&,
@@ -344,7 +344,7 @@ template <typename Tag, typename... Types>
 template <typename... T, typename Init>
 auto_bundle<Tag, Types...>::auto_bundle(const string_t& key, quirk::config<T...>,
                                         const Init&     init_func)
-: m_enabled(settings::enabled())
+: m_enabled(settings::hot().enabled)
 , m_report_at_exit(quirk_config<quirk::exit_report, T...>::value)
 , m_temporary(m_enabled ? component_type(key, m_enabled,
                                          quirk_config<quirk::flat_scope, T...>::value)
@@ -368,7 +368,7 @@ template <typename Tag, typename... Types>
 template <typename... T, typename Init>
 auto_bundle<Tag, Types...>::auto_bundle(const captured_location_t& loc,
                                         quirk::config<T...>, const Init& init_func)
-: m_enabled(settings::enabled())
+: m_enabled(settings::hot().enabled)
 , m_report_at_exit(quirk_config<quirk::exit_report, T...>::value)
 , m_temporary(m_enabled ? component_type(loc, m_enabled,
                                          quirk_config<quirk::flat_scope, T...>::value)
@@ -392,7 +392,7 @@ template <typename Tag, typename... Types>
 template <typename Init>
 auto_bundle<Tag, Types...>::auto_bundle(const string_t& key, scope::config _scope,
                                         bool report_at_exit, const Init& init_func)
-: m_enabled(settings::enabled())
+: m_enabled(settings::hot().enabled)
 , m_report_at_exit(report_at_exit || quirk_config<quirk::exit_report>::value)
 , m_temporary(m_enabled ? component_type(key, m_enabled, _scope) : component_type{})
 , m_reference_object(nullptr)
@@ -412,7 +412,7 @@ template <typename Init>
 auto_bundle<Tag, Types...>::auto_bundle(const captured_location_t& loc,
                                         scope::config _scope, bool report_at_exit,
                                         const Init& init_func)
-: m_enabled(settings::enabled())
+: m_enabled(settings::hot().enabled)
 , m_report_at_exit(report_at_exit || quirk_config<quirk::exit_report>::value)
 , m_temporary(m_enabled ? component_type(loc, m_enabled, _scope) : component_type{})
 , m_reference_object(nullptr)
@@ -431,7 +431,7 @@ template <typename Tag, typename... Types>
 template <typename Init>
 auto_bundle<Tag, Types...>::auto_bundle(size_t hash, scope::config _scope,
                                         bool report_at_exit, const Init& init_func)
-: m_enabled(settings::enabled())
+: m_enabled(settings::hot().enabled)
 , m_report_at_exit(report_at_exit || quirk_config<quirk::exit_report>::value)
 , m_temporary(m_enabled ? component_type(hash, m_enabled, _scope) : component_type{})
 , m_reference_object(nullptr)
@@ -467,8 +467,8 @@ template <typename Init, typename Arg, typename... Args>
 auto_bundle<Tag, Types...>::auto_bundle(const string_t& key, bool store,
                                         scope::config _scope, const Init& init_func,
                                         Arg&& arg, Args&&... args)
-: m_enabled(store && settings::enabled())
-, m_report_at_exit(settings::destructor_report() ||
+: m_enabled(store && settings::hot().enabled)
+, m_report_at_exit(settings::hot().destructor_report ||
                    quirk_config<quirk::exit_report>::value)
 , m_temporary(m_enabled ? component_type(key, m_enabled, _scope) : component_type{})
 , m_reference_object(nullptr)
@@ -488,8 +488,8 @@ template <typename Init, typename Arg, typename... Args>
 auto_bundle<Tag, Types...>::auto_bundle(const captured_location_t& loc, bool store,
                                         scope::config _scope, const Init& init_func,
                                         Arg&& arg, Args&&... args)
-: m_enabled(store && settings::enabled())
-, m_report_at_exit(settings::destructor_report() ||
+: m_enabled(store && settings::hot().enabled)
+, m_report_at_exit(settings::hot().destructor_report ||
                    quirk_config<quirk::exit_report>::value)
 , m_temporary(m_enabled ? component_type(loc, m_enabled, _scope) : component_type{})
 , m_reference_object(nullptr)
@@ -508,8 +508,8 @@ template <typename Tag, typename... Types>
 template <typename Init, typename Arg, typename... Args>
 auto_bundle<Tag, Types...>::auto_bundle(size_t hash, bool store, scope::config _scope,
                                         const Init& init_func, Arg&& arg, Args&&... args)
-: m_enabled(store && settings::enabled())
-, m_report_at_exit(settings::destructor_report() ||
+: m_enabled(store && settings::hot().enabled)
+, m_report_at_exit(settings::hot().destructor_report ||
                    quirk_config<quirk::exit_report>::value)
 , m_temporary(m_enabled ? component_type(hash, m_enabled, _scope) : component_type{})
 , m_reference_object(nullptr)
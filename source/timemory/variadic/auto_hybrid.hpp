@@ -91,21 +91,21 @@ public:
 public:
     template <typename FuncT = initializer_type>
     explicit auto_hybrid(const string_t&, scope::config = scope::get_default(),
-                         bool         report_at_exit = settings::destructor_report(),
+                         bool         report_at_exit = settings::hot().destructor_report,
                          const FuncT& _func          = this_type::get_initializer());
 
     template <typename FuncT = initializer_type>
     explicit auto_hybrid(const captured_location_t&, scope::config = scope::get_default(),
-                         bool         report_at_exit = settings::destructor_report(),
+                         bool         report_at_exit = settings::hot().destructor_report,
                          const FuncT& _func          = this_type::get_initializer());
 
     template <typename FuncT = initializer_type>
     explicit auto_hybrid(size_t, scope::config = scope::get_default(),
-                         bool         report_at_exit = settings::destructor_report(),
+                         bool         report_at_exit = settings::hot().destructor_report,
                          const FuncT& _func          = this_type::get_initializer());
 
     explicit auto_hybrid(component_type& tmp, scope::config = scope::get_default(),
-                         bool            report_at_exit = settings::destructor_report());
+                         bool report_at_exit = settings::hot().destructor_report);
 
     ~auto_hybrid();
 
@@ -300,7 +300,7 @@ template <typename FuncT>
 auto_hybrid<CompTuple, CompList>::auto_hybrid(const string_t& object_tag,
                                               scope::config _scope, bool report_at_exit,
                                               const FuncT& _func)
-: m_enabled(settings::enabled())
+: m_enabled(settings::hot().enabled)
 , m_report_at_exit(report_at_exit)
 , m_temporary(m_enabled ? component_type(object_tag, m_enabled, _scope)
                         : component_type{})
@@ -320,7 +320,7 @@ template <typename FuncT>
 auto_hybrid<CompTuple, CompList>::auto_hybrid(const captured_location_t& object_loc,
                                               scope::config _scope, bool report_at_exit,
                                               const FuncT& _func)
-: m_enabled(settings::enabled())
+: m_enabled(settings::hot().enabled)
 , m_report_at_exit(report_at_exit)
 , m_temporary(m_enabled ? component_type(object_loc, m_enabled, _scope)
                         : component_type{})
@@ -339,7 +339,7 @@ template <typename CompTuple, typename CompList>
 template <typename FuncT>
 auto_hybrid<CompTuple, CompList>::auto_hybrid(size_t _hash, scope::config _scope,
                                               bool report_at_exit, const FuncT& _func)
-: m_enabled(settings::enabled())
+: m_enabled(settings::hot().enabled)
 , m_report_at_exit(report_at_exit)
 , m_temporary(m_enabled ? component_type(_hash, m_enabled, _scope) : component_type{})
 , m_reference_object(nullptr)
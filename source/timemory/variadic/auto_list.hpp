@@ -82,33 +82,30 @@ public:
     //
     static auto& get_initializer()
     {
-        static auto env_enum = enumerate_components(
-            tim::delimit(tim::get_env<string_t>("TIMEMORY_AUTO_LIST_INIT", "")));
-
-        static initializer_type _instance = [=](this_type& cl) {
-            ::tim::initialize(cl, env_enum);
-        };
+        using list_init_t = typename component_type::template list_initializer<this_type>;
+        static initializer_type _instance = list_init_t(enumerate_components(
+            tim::delimit(tim::get_env<string_t>("TIMEMORY_AUTO_LIST_INIT", ""))));
         return _instance;
     }
 
 public:
     template <typename Func = initializer_type>
     explicit auto_list(const string_t&, scope::config = scope::get_default(),
-                       bool report_at_exit = settings::destructor_report(),
+                       bool report_at_exit = settings::hot().destructor_report,
                        const Func&         = get_initializer());
 
     template <typename Func = initializer_type>
     explicit auto_list(const captured_location_t&, scope::config = scope::get_default(),
-                       bool report_at_exit = settings::destructor_report(),
+                       bool report_at_exit = settings::hot().destructor_report,
                        const Func&         = get_initializer());
 
     template <typename Func = initializer_type>
     explicit auto_list(size_t, scope::config = scope::get_default(),
-                       bool report_at_exit = settings::destructor_report(),
+                       bool report_at_exit = settings::hot().destructor_report,
                        const Func&         = get_initializer());
 
     explicit auto_list(component_type& tmp, scope::config = scope::get_default(),
-                       bool            report_at_exit = settings::destructor_report());
+                       bool report_at_exit = settings::hot().destructor_report);
     ~auto_list();
 
     // copy and move
@@ -287,14 +284,14 @@ template <typename... Types>
 template <typename Func>
 auto_list<Types...>::auto_list(const string_t& key, scope::config _scope,
                                bool report_at_exit, const Func& _func)
-: m_enabled(settings::enabled())
+: m_enabled(settings::hot().enabled)
 , m_report_at_exit(report_at_exit)
 , m_temporary(m_enabled ? component_type(key, m_enabled, _scope) : component_type{})
 , m_reference_object(nullptr)
 {
     if(m_enabled)
     {
-        _func(*this);
+        m_temporary.apply_initializer(*this, _func);
         m_temporary.start();
     }
 }
@@ -305,14 +302,14 @@ template <typename... Types>
 template <typename Func>
 auto_list<Types...>::auto_list(const captured_location_t& loc, scope::config _scope,
                                bool report_at_exit, const Func& _func)
-: m_enabled(settings::enabled())
+: m_enabled(settings::hot().enabled)
 , m_report_at_exit(report_at_exit)
 , m_temporary(m_enabled ? component_type(loc, m_enabled, _scope) : component_type{})
 , m_reference_object(nullptr)
 {
     if(m_enabled)
     {
-        _func(*this);
+        m_temporary.apply_initializer(*this, _func);
         m_temporary.start();
     }
 }
@@ -323,14 +320,14 @@ template <typename... Types>
 template <typename Func>
 auto_list<Types...>::auto_list(size_t _hash, scope::config _scope, bool report_at_exit,
                                const Func& _func)
-: m_enabled(settings::enabled())
+: m_enabled(settings::hot().enabled)
 , m_report_at_exit(report_at_exit)
 , m_temporary(m_enabled ? component_type(_hash, m_enabled, _scope) : component_type{})
 , m_reference_object(nullptr)
 {
     if(m_enabled)
     {
-        _func(*this);
+        m_temporary.apply_initializer(*this, _func);
         m_temporary.start();
     }
 }
@@ -116,21 +116,21 @@ public:
 
     template <typename Init = initializer_type>
     explicit auto_tuple(const string_t&, scope::config = scope::get_default(),
-                        bool report_at_exit = settings::destructor_report(),
+                        bool report_at_exit = settings::hot().destructor_report,
                         const Init&         = this_type::get_initializer());
 
     template <typename Init = initializer_type>
     explicit auto_tuple(const captured_location_t&, scope::config = scope::get_default(),
-                        bool report_at_exit = settings::destructor_report(),
+                        bool report_at_exit = settings::hot().destructor_report,
                         const Init&         = this_type::get_initializer());
 
     template <typename Init = initializer_type>
     explicit auto_tuple(size_t, scope::config = scope::get_default(),
-                        bool report_at_exit = settings::destructor_report(),
+                        bool report_at_exit = settings::hot().destructor_report,
                         const Init&         = this_type::get_initializer());
 
     explicit auto_tuple(component_type& tmp, scope::config = scope::get_default(),
-                        bool            report_at_exit = settings::destructor_report());
+                        bool report_at_exit = settings::hot().destructor_report);
 
     template <typename Init, typename Arg, typename... Args>
     auto_tuple(const string_t&, bool store, scope::config _scope, const Init&, Arg&&,
@@ -327,7 +327,7 @@ template <typename... Types>
 template <typename... T, typename Init>
 auto_tuple<Types...>::auto_tuple(const string_t& key, quirk::config<T...>,
                                  const Init&     init_func)
-: m_enabled(settings::enabled())
+: m_enabled(settings::hot().enabled)
 , m_report_at_exit(quirk_config<quirk::exit_report, T...>::value)
 , m_temporary(m_enabled ? component_type(key, m_enabled,
                                          quirk_config<quirk::flat_scope, T...>::value)
@@ -351,7 +351,7 @@ template <typename... Types>
 template <typename... T, typename Init>
 auto_tuple<Types...>::auto_tuple(const captured_location_t& loc, quirk::config<T...>,
                                  const Init&                init_func)
-: m_enabled(settings::enabled())
+: m_enabled(settings::hot().enabled)
 , m_report_at_exit(quirk_config<quirk::exit_report, T...>::value)
 , m_temporary(m_enabled ? component_type(loc, m_enabled,
                                          quirk_config<quirk::flat_scope, T...>::value)
@@ -375,7 +375,7 @@ template <typename... Types>
 template <typename Init>
 auto_tuple<Types...>::auto_tuple(const string_t& key, scope::config _scope,
                                  bool report_at_exit, const Init& init_func)
-: m_enabled(settings::enabled())
+: m_enabled(settings::hot().enabled)
 , m_report_at_exit(report_at_exit || quirk_config<quirk::exit_report>::value)
 , m_temporary(m_enabled ? component_type(key, m_enabled, _scope) : component_type{})
 , m_reference_object(nullptr)
@@ -394,7 +394,7 @@ template <typename... Types>
 template <typename Init>
 auto_tuple<Types...>::auto_tuple(const captured_location_t& loc, scope::config _scope,
                                  bool report_at_exit, const Init& init_func)
-: m_enabled(settings::enabled())
+: m_enabled(settings::hot().enabled)
 , m_report_at_exit(report_at_exit || quirk_config<quirk::exit_report>::value)
 , m_temporary(m_enabled ? component_type(loc, m_enabled, _scope) : component_type{})
 , m_reference_object(nullptr)
@@ -413,7 +413,7 @@ template <typename... Types>
 template <typename Init>
 auto_tuple<Types...>::auto_tuple(size_t hash, scope::config _scope, bool report_at_exit,
                                  const Init& init_func)
-: m_enabled(settings::enabled())
+: m_enabled(settings::hot().enabled)
 , m_report_at_exit(report_at_exit || quirk_config<quirk::exit_report>::value)
 , m_temporary(m_enabled ? component_type(hash, m_enabled, _scope) : component_type{})
 , m_reference_object(nullptr)
@@ -448,8 +448,8 @@ template <typename... Types>
 template <typename Init, typename Arg, typename... Args>
 auto_tuple<Types...>::auto_tuple(const string_t& key, bool store, scope::config _scope,
                                  const Init& init_func, Arg&& arg, Args&&... args)
-: m_enabled(store && settings::enabled())
-, m_report_at_exit(settings::destructor_report() ||
+: m_enabled(store && settings::hot().enabled)
+, m_report_at_exit(settings::hot().destructor_report ||
                    quirk_config<quirk::exit_report>::value)
 , m_temporary(m_enabled ? component_type(key, m_enabled, _scope) : component_type{})
 , m_reference_object(nullptr)
@@ -469,8 +469,8 @@ template <typename Init, typename Arg, typename... Args>
 auto_tuple<Types...>::auto_tuple(const captured_location_t& loc, bool store,
                                  scope::config _scope, const Init& init_func, Arg&& arg,
                                  Args&&... args)
-: m_enabled(store && settings::enabled())
-, m_report_at_exit(settings::destructor_report() ||
+: m_enabled(store && settings::hot().enabled)
+, m_report_at_exit(settings::hot().destructor_report ||
                    quirk_config<quirk::exit_report>::value)
 , m_temporary(m_enabled ? component_type(loc, m_enabled, _scope) : component_type{})
 , m_reference_object(nullptr)
@@ -489,8 +489,8 @@ template <typename... Types>
 template <typename Init, typename Arg, typename... Args>
 auto_tuple<Types...>::auto_tuple(size_t hash, bool store, scope::config _scope,
                                  const Init& init_func, Arg&& arg, Args&&... args)
-: m_enabled(store && settings::enabled())
-, m_report_at_exit(settings::destructor_report() ||
+: m_enabled(store && settings::hot().enabled)
+, m_report_at_exit(settings::hot().destructor_report ||
                    quirk_config<quirk::exit_report>::value)
 , m_temporary(m_enabled ? component_type(hash, m_enabled, _scope) : component_type{})
 , m_reference_object(nullptr)
@@ -175,9 +175,9 @@ private:
     };
 
 public:
-    explicit base_bundle(uint64_t _hash = 0, bool _store = settings::enabled(),
+    explicit base_bundle(uint64_t _hash = 0, bool _store = settings::hot().enabled,
                          scope::config _scope = scope::get_default())
-    : m_store(_store && settings::enabled())
+    : m_store(_store && settings::hot().enabled)
     , m_is_pushed(false)
     , m_scope(_scope + get_scope_config())
     , m_laps(0)
@@ -186,7 +186,7 @@ public:
 
     template <typename... T>
     explicit base_bundle(uint64_t hash, bool store, quirk::config<T...>)
-    : m_store(store && settings::enabled())
+    : m_store(store && settings::hot().enabled)
     , m_is_pushed(false)
     , m_scope(get_scope_config<T...>())
     , m_laps(0)
@@ -195,7 +195,7 @@ public:
 
     template <typename... T>
     explicit base_bundle(uint64_t hash, quirk::config<T...>)
-    : m_store(settings::enabled())
+    : m_store(settings::hot().enabled)
     , m_is_pushed(false)
     , m_scope(get_scope_config<T...>())
     , m_laps(0)
@@ -47,7 +47,7 @@ template <typename Tag, typename... Types>
 component_bundle<Tag, Types...>::component_bundle()
 {
     apply_v::set_value(m_data, nullptr);
-    // if(settings::enabled())
+    // if(settings::hot().enabled)
     //    init_storage();
 }
 
@@ -58,7 +58,7 @@ template <typename... T, typename Func>
 component_bundle<Tag, Types...>::component_bundle(const string_t&     key,
                                                   quirk::config<T...> config,
                                                   const Func&         init_func)
-: bundle_type(((settings::enabled()) ? add_hash_id(key) : 0), quirk::config<T...>{})
+: bundle_type(((settings::hot().enabled) ? add_hash_id(key) : 0), quirk::config<T...>{})
 , m_data(invoke::construct<data_type, Tag>(key, config))
 {
     apply_v::set_value(m_data, nullptr);
@@ -106,7 +106,7 @@ template <typename Func>
 component_bundle<Tag, Types...>::component_bundle(const string_t& key, const bool& store,
                                                   scope::config _scope,
                                                   const Func&   init_func)
-: bundle_type((settings::enabled()) ? add_hash_id(key) : 0, store,
+: bundle_type((settings::hot().enabled) ? add_hash_id(key) : 0, store,
               _scope + scope::config(quirk_config<quirk::flat_scope>::value,
                                      quirk_config<quirk::timeline_scope>::value,
                                      quirk_config<quirk::tree_scope>::value))
@@ -143,7 +143,7 @@ public:
                 for(auto& itr : _tag)
                     itr = toupper(itr);
                 auto env_var = string_t("TIMEMORY_") + _tag + "_COMPONENTS";
-                if(settings::debug() || settings::verbose() > 0)
+                if(settings::hot().debug || settings::hot().verbose > 0)
                     PRINT_HERE("%s is using environment variable: '%s'",
                                demangle<this_type>().c_str(), env_var.c_str());
 
@@ -454,7 +454,7 @@ public:
         T*& _obj = std::get<index_of<T*, data_type>::value>(m_data);
         if(!_obj)
         {
-            if(settings::debug())
+            if(settings::hot().debug)
             {
                 printf("[component_bundle::init]> initializing type '%s'...\n",
                        demangle(typeid(T).name()).c_str());
@@ -465,7 +465,7 @@ public:
         else
         {
             static std::atomic<int> _count(0);
-            if((settings::verbose() > 1 || settings::debug()) && _count++ == 0)
+            if((settings::hot().verbose > 1 || settings::hot().debug) && _count++ == 0)
             {
                 std::string _id = demangle(typeid(T).name());
                 printf("[component_bundle::init]> skipping re-initialization of type"
@@ -44,7 +44,7 @@ namespace tim
 template <typename... Types>
 component_list<Types...>::component_list()
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
         init_storage();
     apply_v::set_value(m_data, nullptr);
 }
@@ -55,14 +55,14 @@ template <typename... Types>
 template <typename FuncT>
 component_list<Types...>::component_list(const string_t& key, const bool& store,
                                          scope::config _scope, const FuncT& _func)
-: bundle_type((settings::enabled()) ? add_hash_id(key) : 0, store, _scope)
+: bundle_type((settings::hot().enabled) ? add_hash_id(key) : 0, store, _scope)
 , m_data(data_type{})
 {
     apply_v::set_value(m_data, nullptr);
-    if(settings::enabled())
+    if(settings::hot().enabled)
     {
         init_storage();
-        _func(*this);
+        apply_initializer(*this, _func);
         set_prefix(get_hash_ids()->find(m_hash)->second);
         invoke::set_scope(m_data, m_scope);
     }
@@ -79,10 +79,10 @@ component_list<Types...>::component_list(const captured_location_t& loc,
 , m_data(data_type{})
 {
     apply_v::set_value(m_data, nullptr);
-    if(settings::enabled())
+    if(settings::hot().enabled)
     {
         init_storage();
-        _func(*this);
+        apply_initializer(*this, _func);
         set_prefix(loc.get_hash());
         invoke::set_scope(m_data, m_scope);
     }
@@ -98,10 +98,10 @@ component_list<Types...>::component_list(size_t _hash, const bool& store,
 , m_data(data_type{})
 {
     apply_v::set_value(m_data, nullptr);
-    if(settings::enabled())
+    if(settings::hot().enabled)
     {
         init_storage();
-        _func(*this);
+        apply_initializer(*this, _func);
         set_prefix(_hash);
         invoke::set_scope(m_data, m_scope);
     }
@@ -114,7 +114,7 @@ component_list<Types...>::~component_list()
 {
     stop();
     // DEBUG_PRINT_HERE("%s", "deleting components");
-    apply_v::access<operation_t<operation::generic_deleter>>(m_data);
+    destroy_slots(make_index_sequence<num_slots>{});
 }
 
 //--------------------------------------------------------------------------------------//
@@ -124,7 +124,7 @@ component_list<Types...>::component_list(const this_type& rhs)
 : bundle_type(rhs)
 {
     apply_v::set_value(m_data, nullptr);
-    apply_v::access2<operation_t<operation::copy>>(m_data, rhs.m_data);
+    copy_slots(rhs, make_index_sequence<num_slots>{});
 }
 
 //--------------------------------------------------------------------------------------//
@@ -136,8 +136,35 @@ component_list<Types...>::operator=(const this_type& rhs)
     if(this != &rhs)
     {
         bundle_type::operator=(rhs);
-        invoke::destroy(m_data);
-        apply_v::access<operation_t<operation::copy>>(m_data);
+        destroy_slots(make_index_sequence<num_slots>{});
+        copy_slots(rhs, make_index_sequence<num_slots>{});
+    }
+    return *this;
+}
+
+//--------------------------------------------------------------------------------------//
+// the components live inside the object so they are move-constructed into the slots
+// of this object and the slots of the source are released
+//
+template <typename... Types>
+component_list<Types...>::component_list(this_type&& rhs)
+: bundle_type(std::move(rhs))
+{
+    apply_v::set_value(m_data, nullptr);
+    move_slots(rhs, make_index_sequence<num_slots>{});
+}
+
+//--------------------------------------------------------------------------------------//
+//
+template <typename... Types>
+component_list<Types...>&
+component_list<Types...>::operator=(this_type&& rhs)
+{
+    if(this != &rhs)
+    {
+        bundle_type::operator=(std::move(rhs));
+        destroy_slots(make_index_sequence<num_slots>{});
+        move_slots(rhs, make_index_sequence<num_slots>{});
     }
     return *this;
 }
@@ -406,6 +433,135 @@ component_list<Types...>::set_prefix(size_t _hash) const
         invoke::set_prefix(m_data, _hash, itr->second);
 }
 
+//--------------------------------------------------------------------------------------//
+//
+template <typename... Types>
+typename component_list<Types...>::resolved_initializer
+component_list<Types...>::resolve(const std::vector<TIMEMORY_COMPONENT>& _components)
+{
+    resolved_initializer _resolved{};
+    this_type            _tmp{};
+    // while the recorder is set, init<T>() only marks the slot in the mask
+    auto* _prev    = get_recorder();
+    get_recorder() = &_resolved;
+    ::tim::initialize(_tmp, _components);
+    get_recorder() = _prev;
+    return _resolved;
+}
+
+//--------------------------------------------------------------------------------------//
+//
+template <typename... Types>
+template <typename BundleT, typename FuncT>
+void
+component_list<Types...>::apply_initializer(BundleT& _obj, const FuncT& _func)
+{
+    _func(_obj);
+}
+
+//--------------------------------------------------------------------------------------//
+//
+template <typename... Types>
+template <typename BundleT>
+void
+component_list<Types...>::apply_initializer(
+    BundleT& _obj, const std::function<void(BundleT&)>& _func)
+{
+    using list_init_t = list_initializer<BundleT>;
+    auto* _init       = _func.template target<list_init_t>();
+    if(_init && !_init->resolved.replay)
+        apply_mask(_init->resolved.mask);
+    else
+        _func(_obj);
+}
+
+//--------------------------------------------------------------------------------------//
+//
+template <typename... Types>
+void
+component_list<Types...>::apply_mask(const active_type& _mask)
+{
+    if(_mask.any())
+        apply_mask(_mask, make_index_sequence<num_slots>{});
+}
+
+//--------------------------------------------------------------------------------------//
+//
+template <typename... Types>
+template <size_t... Idx>
+void
+component_list<Types...>::apply_mask(const active_type& _mask, index_sequence<Idx...>)
+{
+    TIMEMORY_FOLD_EXPRESSION((_mask.test(Idx) && !std::get<Idx>(m_data))
+                                 ? (emplace<Idx>(), set_prefix(std::get<Idx>(m_data)))
+                                 : (void) 0);
+}
+
+//--------------------------------------------------------------------------------------//
+//
+template <typename... Types>
+template <size_t... Idx>
+void
+component_list<Types...>::copy_slots(const this_type& rhs, index_sequence<Idx...>)
+{
+    TIMEMORY_FOLD_EXPRESSION((std::get<Idx>(rhs.m_data))
+                                 ? emplace<Idx>(*std::get<Idx>(rhs.m_data))
+                                 : (void) 0);
+}
+
+//--------------------------------------------------------------------------------------//
+//
+template <typename... Types>
+template <size_t... Idx>
+void
+component_list<Types...>::move_slots(this_type& rhs, index_sequence<Idx...>)
+{
+    TIMEMORY_FOLD_EXPRESSION((std::get<Idx>(rhs.m_data))
+                                 ? (emplace<Idx>(std::move(*std::get<Idx>(rhs.m_data))),
+                                    rhs.template destroy<Idx>())
+                                 : (void) 0);
+}
+
+//--------------------------------------------------------------------------------------//
+//
+template <typename... Types>
+template <size_t... Idx>
+void
+component_list<Types...>::destroy_slots(index_sequence<Idx...>)
+{
+    TIMEMORY_FOLD_EXPRESSION(destroy<Idx>());
+}
+
+//--------------------------------------------------------------------------------------//
+//
+template <typename... Types>
+template <size_t Idx, typename... Args>
+void
+component_list<Types...>::emplace(Args&&... args)
+{
+    using type  = remove_pointer_t<decay_t<std::tuple_element_t<Idx, data_type>>>;
+    void* _slot = static_cast<void*>(&std::get<Idx>(m_slots));
+
+    std::get<Idx>(m_data) = new(_slot) type(std::forward<Args>(args)...);
+    m_active.set(Idx);
+}
+
+//--------------------------------------------------------------------------------------//
+//
+template <typename... Types>
+template <size_t Idx>
+void
+component_list<Types...>::destroy()
+{
+    using type = remove_pointer_t<decay_t<std::tuple_element_t<Idx, data_type>>>;
+    if(m_active.test(Idx))
+    {
+        std::get<Idx>(m_data)->~type();
+        m_active.reset(Idx);
+    }
+    std::get<Idx>(m_data) = nullptr;
+}
+
 //--------------------------------------------------------------------------------------//
 //
 template <typename... Types>
@@ -47,13 +47,16 @@
 #include "timemory/variadic/functional.hpp"
 #include "timemory/variadic/types.hpp"
 
+#include <bitset>
 #include <cstdint>
 #include <cstdio>
 #include <fstream>
 #include <iomanip>
 #include <ios>
 #include <iostream>
+#include <new>
 #include <string>
+#include <vector>
 
 //======================================================================================//
 
@@ -106,23 +109,58 @@ public:
     using type             = convert_t<tuple_type, component_list<>>;
     using initializer_type = std::function<void(this_type&)>;
 
+    // the components are constructed in-place within the slots and the bits of the
+    // active mask identify the slots which hold a live object
+    static constexpr size_t num_slots = std::tuple_size<data_type>::value;
+
+    using slot_type   = inline_storage_t<data_type>;
+    using active_type = std::bitset<num_slots>;
+
     static constexpr bool is_component      = false;
     static constexpr bool has_gotcha_v      = bundle_type::has_gotcha_v;
     static constexpr bool has_user_bundle_v = bundle_type::has_user_bundle_v;
 
+    //----------------------------------------------------------------------------------//
+    /// the result of running an initializer in "record" mode. When the initializer
+    /// only default-initializes types in the list, the mask is applied directly
+    /// to the slots instead of replaying the initializer for every instance
+    ///
+    struct resolved_initializer
+    {
+        bool        replay = false;
+        active_type mask   = {};
+    };
+
+    //----------------------------------------------------------------------------------//
+    /// the default initializer of the component_list and auto_list. The enumerated
+    /// components are resolved once (per configuration) when it is constructed
+    ///
+    template <typename BundleT>
+    struct list_initializer
+    {
+        explicit list_initializer(std::vector<TIMEMORY_COMPONENT> _components)
+        : components(std::move(_components))
+        , resolved(this_type::resolve(components))
+        {}
+
+        void operator()(BundleT& obj) const { ::tim::initialize(obj, components); }
+
+        std::vector<TIMEMORY_COMPONENT> components = {};
+        resolved_initializer            resolved   = {};
+    };
+
     //----------------------------------------------------------------------------------//
     //
     static auto& get_initializer()
     {
-        static auto env_enum = enumerate_components(
-            tim::delimit(tim::get_env<string_t>("TIMEMORY_COMPONENT_LIST_INIT", "")));
-
-        static initializer_type _instance = [=](this_type& cl) {
-            ::tim::initialize(cl, env_enum);
-        };
+        static initializer_type _instance =
+            list_initializer<this_type>(enumerate_components(tim::delimit(
+                tim::get_env<string_t>("TIMEMORY_COMPONENT_LIST_INIT", ""))));
         return _instance;
     }
 
+    static resolved_initializer resolve(const std::vector<TIMEMORY_COMPONENT>&);
+
 public:
     component_list();
 
@@ -146,8 +184,8 @@ public:
     //------------------------------------------------------------------------//
     //      Copy construct and assignment
     //------------------------------------------------------------------------//
-    component_list(component_list&&) = default;
-    component_list& operator=(component_list&&) = default;
+    component_list(component_list&& rhs);
+    component_list& operator=(component_list&& rhs);
 
     component_list(const component_list& rhs);
     component_list& operator=(const component_list& rhs);
@@ -465,21 +503,29 @@ public:
                     char> = 0>
     void init(Args&&... _args)
     {
-        T*& _obj = std::get<index_of<T*, data_type>::value>(m_data);
+        constexpr size_t idx = index_of<T*, data_type>::value;
+        if(get_recorder())
+        {
+            get_recorder()->mask.set(idx);
+            get_recorder()->replay |= (sizeof...(Args) > 0);
+            return;
+        }
+
+        T*& _obj = std::get<idx>(m_data);
         if(!_obj)
         {
-            if(settings::debug())
+            if(settings::hot().debug)
             {
                 printf("[component_list::init]> initializing type '%s'...\n",
                        demangle(typeid(T).name()).c_str());
             }
-            _obj = new T(std::forward<Args>(_args)...);
+            emplace<idx>(std::forward<Args>(_args)...);
             set_prefix(_obj);
         }
         else
         {
             static std::atomic<int> _count(0);
-            if((settings::verbose() > 1 || settings::debug()) && _count++ == 0)
+            if((settings::hot().verbose > 1 || settings::hot().debug) && _count++ == 0)
             {
                 std::string _id = demangle(typeid(T).name());
                 printf("[component_list::init]> skipping re-initialization of type"
@@ -500,6 +546,12 @@ public:
     void init(Args&&... args)
     {
         using bundle_t = decltype(std::get<0>(std::declval<user_bundle_types>()));
+        // the opaque objects are specific to each instance
+        if(get_recorder())
+        {
+            get_recorder()->replay = true;
+            return;
+        }
         this->init<bundle_t>();
         this->get<bundle_t>()->insert(
             component::factory::get_opaque<T>(m_scope, std::forward<Args>(args)...),
@@ -517,7 +569,7 @@ public:
     void init(Args&&...)
     {
         static std::atomic<int> _count(0);
-        if((settings::verbose() > 1 || settings::debug()) && _count++ == 0)
+        if((settings::hot().verbose > 1 || settings::hot().debug) && _count++ == 0)
         {
             PRINT_HERE("%s %s", "skipping init because type is unavailable or because",
                        "wrapper does not contain a user_bundle");
@@ -585,6 +637,12 @@ protected:
     const data_type& get_data() const;
     void             set_scope(scope::config);
 
+    template <typename BundleT, typename FuncT>
+    void apply_initializer(BundleT&, const FuncT&);
+    template <typename BundleT>
+    void apply_initializer(BundleT&, const std::function<void(BundleT&)>&);
+    void apply_mask(const active_type&);
+
     template <typename T>
     void set_prefix(T* obj) const;
     void set_prefix(const string_t&) const;
@@ -597,7 +655,30 @@ protected:
     using bundle_type::m_laps;
     using bundle_type::m_scope;
     using bundle_type::m_store;
-    mutable data_type m_data = data_type();
+    mutable data_type m_data   = data_type();
+    active_type       m_active = {};
+    slot_type         m_slots;
+
+private:
+    static resolved_initializer*& get_recorder()
+    {
+        static thread_local resolved_initializer* _instance = nullptr;
+        return _instance;
+    }
+
+    template <size_t Idx, typename... Args>
+    void emplace(Args&&...);
+    template <size_t Idx>
+    void destroy();
+
+    template <size_t... Idx>
+    void apply_mask(const active_type&, index_sequence<Idx...>);
+    template <size_t... Idx>
+    void copy_slots(const this_type&, index_sequence<Idx...>);
+    template <size_t... Idx>
+    void move_slots(this_type&, index_sequence<Idx...>);
+    template <size_t... Idx>
+    void destroy_slots(index_sequence<Idx...>);
 };
 
 //--------------------------------------------------------------------------------------//
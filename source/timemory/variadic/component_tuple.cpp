@@ -46,7 +46,7 @@ namespace tim
 template <typename... Types>
 component_tuple<Types...>::component_tuple()
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
         init_storage();
 }
 
@@ -57,10 +57,10 @@ template <typename... T, typename Func>
 component_tuple<Types...>::component_tuple(const string_t&     key,
                                            quirk::config<T...> config,
                                            const Func&         init_func)
-: bundle_type(((settings::enabled()) ? add_hash_id(key) : 0), quirk::config<T...>{})
+: bundle_type(((settings::hot().enabled) ? add_hash_id(key) : 0), quirk::config<T...>{})
 , m_data(invoke::construct<data_type>(key, config))
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
     {
         IF_CONSTEXPR(!quirk_config<quirk::no_store, T...>::value) { init_storage(); }
         IF_CONSTEXPR(!quirk_config<quirk::no_init, T...>::value) { init_func(*this); }
@@ -80,7 +80,7 @@ component_tuple<Types...>::component_tuple(const captured_location_t& loc,
 : bundle_type(loc.get_hash(), quirk::config<T...>{})
 , m_data(invoke::construct<data_type>(loc, config))
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
     {
         IF_CONSTEXPR(!quirk_config<quirk::no_store, T...>::value) { init_storage(); }
         IF_CONSTEXPR(!quirk_config<quirk::no_init, T...>::value) { init_func(*this); }
@@ -96,10 +96,10 @@ template <typename... Types>
 template <typename Func>
 component_tuple<Types...>::component_tuple(const string_t& key, const bool& store,
                                            scope::config _scope, const Func& init_func)
-: bundle_type((settings::enabled()) ? add_hash_id(key) : 0, store, _scope)
+: bundle_type((settings::hot().enabled) ? add_hash_id(key) : 0, store, _scope)
 , m_data(invoke::construct<data_type>(key, store, _scope))
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
     {
         if(store)
         {
@@ -122,7 +122,7 @@ component_tuple<Types...>::component_tuple(const captured_location_t& loc,
 : bundle_type(loc.get_hash(), store, _scope)
 , m_data(invoke::construct<data_type>(loc, store, _scope))
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
     {
         if(store)
         {
@@ -144,7 +144,7 @@ component_tuple<Types...>::component_tuple(size_t hash, const bool& store,
 : bundle_type(hash, store, _scope)
 , m_data(invoke::construct<data_type>(hash, store, _scope))
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
     {
         if(store)
         {
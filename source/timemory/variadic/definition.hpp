@@ -27,6 +27,7 @@
 #include "timemory/variadic/macros.hpp"
 #include "timemory/variadic/types.hpp"
 //
+#include "timemory/variadic/async_region.hpp"
 #include "timemory/variadic/auto_bundle.hpp"
 #include "timemory/variadic/auto_hybrid.hpp"
 #include "timemory/variadic/auto_list.hpp"
@@ -160,7 +160,7 @@ template <template <typename...> class OpT, typename ApiT = TIMEMORY_API,
 void
 invoke(TupleT<Tp...>& obj, Args&&... args)
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
         invoke_impl::invoke<OpT, ApiT>(obj, std::forward<Args>(args)...);
 }
 //
@@ -170,7 +170,7 @@ construct(Args&&... args)
 {
     IF_CONSTEXPR(trait::is_available<ApiT>::value)
     {
-        if(settings::enabled())
+        if(settings::hot().enabled)
         {
             TupleT obj;
             invoke_impl::construct(std::ref(obj).get(), std::forward<Args>(args)...);
@@ -193,7 +193,7 @@ template <typename ApiT = TIMEMORY_API, template <typename...> class TupleT,
 void
 start(TupleT<Tp...>& obj, Args&&... args)
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
     {
         using data_type        = std::tuple<Tp...>;
         using priority_types_t = impl::filter_false<negative_start_priority, data_type>;
@@ -218,7 +218,7 @@ template <typename ApiT = TIMEMORY_API, template <typename...> class TupleT,
 void
 stop(TupleT<Tp...>& obj, Args&&... args)
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
     {
         using data_type        = std::tuple<Tp...>;
         using priority_types_t = impl::filter_false<negative_stop_priority, data_type>;
@@ -243,7 +243,7 @@ template <typename ApiT = TIMEMORY_API, template <typename...> class TupleT,
 void
 mark_begin(TupleT<Tp...>& obj, Args&&... args)
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
         invoke_impl::invoke<operation::mark_begin, ApiT>(obj,
                                                          std::forward<Args>(args)...);
 }
@@ -253,7 +253,7 @@ template <typename ApiT = TIMEMORY_API, template <typename...> class TupleT,
 void
 mark_end(TupleT<Tp...>& obj, Args&&... args)
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
         invoke_impl::invoke<operation::mark_end, ApiT>(obj, std::forward<Args>(args)...);
 }
 //
@@ -262,7 +262,7 @@ template <typename ApiT = TIMEMORY_API, template <typename...> class TupleT,
 void
 store(TupleT<Tp...>& obj, Args&&... args)
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
         invoke_impl::invoke<operation::store, ApiT>(obj, std::forward<Args>(args)...);
 }
 //
@@ -271,7 +271,7 @@ template <typename ApiT = TIMEMORY_API, template <typename...> class TupleT,
 void
 reset(TupleT<Tp...>& obj, Args&&... args)
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
         invoke_impl::invoke<operation::reset, ApiT>(obj, std::forward<Args>(args)...);
 }
 //
@@ -280,7 +280,7 @@ template <typename ApiT = TIMEMORY_API, template <typename...> class TupleT,
 void
 record(TupleT<Tp...>& obj, Args&&... args)
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
         invoke_impl::invoke<operation::record, ApiT>(obj, std::forward<Args>(args)...);
 }
 //
@@ -289,7 +289,7 @@ template <typename ApiT = TIMEMORY_API, template <typename...> class TupleT,
 void
 measure(TupleT<Tp...>& obj, Args&&... args)
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
         invoke_impl::invoke<operation::measure, ApiT>(obj, std::forward<Args>(args)...);
 }
 //
@@ -298,7 +298,7 @@ template <typename ApiT = TIMEMORY_API, template <typename...> class TupleT,
 void
 push(TupleT<Tp...>& obj, Args&&... args)
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
         invoke_impl::invoke<operation::insert_node, ApiT>(obj,
                                                           std::forward<Args>(args)...);
 }
@@ -308,7 +308,7 @@ template <typename ApiT = TIMEMORY_API, template <typename...> class TupleT,
 void
 pop(TupleT<Tp...>& obj, Args&&... args)
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
         invoke_impl::invoke<operation::pop_node, ApiT>(obj, std::forward<Args>(args)...);
 }
 //
@@ -317,7 +317,7 @@ template <typename ApiT = TIMEMORY_API, template <typename...> class TupleT,
 void
 set_prefix(TupleT<Tp...>& obj, Args&&... args)
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
         invoke_impl::invoke<operation::set_prefix, ApiT>(obj,
                                                          std::forward<Args>(args)...);
 }
@@ -327,7 +327,7 @@ template <typename ApiT = TIMEMORY_API, template <typename...> class TupleT,
 void
 set_scope(TupleT<Tp...>& obj, Args&&... args)
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
         invoke_impl::invoke<operation::set_scope, ApiT>(obj, std::forward<Args>(args)...);
 }
 //
@@ -336,7 +336,7 @@ template <typename ApiT = TIMEMORY_API, template <typename...> class TupleT,
 void
 assemble(TupleT<Tp...>& obj, Args&&... args)
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
         invoke_impl::invoke<operation::assemble, ApiT>(obj, std::forward<Args>(args)...);
 }
 //
@@ -345,7 +345,7 @@ template <typename ApiT = TIMEMORY_API, template <typename...> class TupleT,
 void
 derive(TupleT<Tp...>& obj, Args&&... args)
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
         invoke_impl::invoke<operation::derive, ApiT>(obj, std::forward<Args>(args)...);
 }
 //
@@ -354,7 +354,7 @@ template <typename ApiT = TIMEMORY_API, template <typename...> class TupleT,
 void
 audit(TupleT<Tp...>& obj, Args&&... args)
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
         invoke_impl::invoke<operation::audit, ApiT>(obj, std::forward<Args>(args)...);
 }
 //
@@ -363,7 +363,7 @@ template <typename ApiT = TIMEMORY_API, template <typename...> class TupleT,
 void
 add_secondary(TupleT<Tp...>& obj, Args&&... args)
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
         invoke_impl::invoke<operation::add_secondary, ApiT>(obj,
                                                             std::forward<Args>(args)...);
 }
@@ -544,7 +544,7 @@ template <template <typename...> class TupleT, typename... Tp, typename... Args>
 void
 start(TupleT<Tp...>&& obj, Args&&... args)
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
         invoke_impl::start(std::forward<TupleT<Tp...>>(obj),
                            std::make_index_sequence<sizeof...(Tp)>{},
                            std::forward<Args>(args)...);
@@ -554,7 +554,7 @@ template <template <typename...> class TupleT, typename... Tp, typename... Args>
 void
 stop(TupleT<Tp...>&& obj, Args&&... args)
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
         invoke_impl::stop(std::forward<TupleT<Tp...>>(obj),
                           std::make_index_sequence<sizeof...(Tp)>{},
                           std::forward<Args>(args)...);
@@ -564,7 +564,7 @@ template <template <typename...> class TupleT, typename... Tp, typename... Args>
 void
 mark_begin(TupleT<Tp...>&& obj, Args&&... args)
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
         invoke_impl::mark_begin(std::forward<TupleT<Tp...>>(obj),
                                 std::make_index_sequence<sizeof...(Tp)>{},
                                 std::forward<Args>(args)...);
@@ -574,7 +574,7 @@ template <template <typename...> class TupleT, typename... Tp, typename... Args>
 void
 mark_end(TupleT<Tp...>&& obj, Args&&... args)
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
         invoke_impl::mark_end(std::forward<TupleT<Tp...>>(obj),
                               std::make_index_sequence<sizeof...(Tp)>{},
                               std::forward<Args>(args)...);
@@ -584,7 +584,7 @@ template <template <typename...> class TupleT, typename... Tp, typename... Args>
 void
 store(TupleT<Tp...>&& obj, Args&&... args)
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
         invoke_impl::store(std::forward<TupleT<Tp...>>(obj),
                            std::make_index_sequence<sizeof...(Tp)>{},
                            std::forward<Args>(args)...);
@@ -594,7 +594,7 @@ template <template <typename...> class TupleT, typename... Tp, typename... Args>
 void
 reset(TupleT<Tp...>&& obj, Args&&... args)
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
         invoke_impl::reset(std::forward<TupleT<Tp...>>(obj),
                            std::make_index_sequence<sizeof...(Tp)>{},
                            std::forward<Args>(args)...);
@@ -604,7 +604,7 @@ template <template <typename...> class TupleT, typename... Tp, typename... Args>
 void
 record(TupleT<Tp...>&& obj, Args&&... args)
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
         invoke_impl::record(std::forward<TupleT<Tp...>>(obj),
                             std::make_index_sequence<sizeof...(Tp)>{},
                             std::forward<Args>(args)...);
@@ -614,7 +614,7 @@ template <template <typename...> class TupleT, typename... Tp, typename... Args>
 void
 measure(TupleT<Tp...>&& obj, Args&&... args)
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
         invoke_impl::measure(std::forward<TupleT<Tp...>>(obj),
                              std::make_index_sequence<sizeof...(Tp)>{},
                              std::forward<Args>(args)...);
@@ -624,7 +624,7 @@ template <template <typename...> class TupleT, typename... Tp, typename... Args>
 void
 push(TupleT<Tp...>&& obj, Args&&... args)
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
         invoke_impl::push(std::forward<TupleT<Tp...>>(obj),
                           std::make_index_sequence<sizeof...(Tp)>{},
                           std::forward<Args>(args)...);
@@ -634,7 +634,7 @@ template <template <typename...> class TupleT, typename... Tp, typename... Args>
 void
 pop(TupleT<Tp...>&& obj, Args&&... args)
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
         invoke_impl::pop(std::forward<TupleT<Tp...>>(obj),
                          std::make_index_sequence<sizeof...(Tp)>{},
                          std::forward<Args>(args)...);
@@ -644,7 +644,7 @@ template <template <typename...> class TupleT, typename... Tp, typename... Args>
 void
 set_prefix(TupleT<Tp...>&& obj, Args&&... args)
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
         invoke_impl::set_prefix(std::forward<TupleT<Tp...>>(obj),
                                 std::make_index_sequence<sizeof...(Tp)>{},
                                 std::forward<Args>(args)...);
@@ -654,7 +654,7 @@ template <template <typename...> class TupleT, typename... Tp, typename... Args>
 void
 set_scope(TupleT<Tp...>&& obj, Args&&... args)
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
         invoke_impl::set_scope(std::forward<TupleT<Tp...>>(obj),
                                std::make_index_sequence<sizeof...(Tp)>{},
                                std::forward<Args>(args)...);
@@ -664,7 +664,7 @@ template <template <typename...> class TupleT, typename... Tp, typename... Args>
 void
 assemble(TupleT<Tp...>&& obj, Args&&... args)
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
         invoke_impl::assemble(std::forward<TupleT<Tp...>>(obj),
                               std::make_index_sequence<sizeof...(Tp)>{},
                               std::forward<Args>(args)...);
@@ -674,7 +674,7 @@ template <template <typename...> class TupleT, typename... Tp, typename... Args>
 void
 derive(TupleT<Tp...>&& obj, Args&&... args)
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
         invoke_impl::derive(std::forward<TupleT<Tp...>>(obj),
                             std::make_index_sequence<sizeof...(Tp)>{},
                             std::forward<Args>(args)...);
@@ -684,7 +684,7 @@ template <template <typename...> class TupleT, typename... Tp, typename... Args>
 void
 audit(TupleT<Tp...>&& obj, Args&&... args)
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
         invoke_impl::audit(std::forward<TupleT<Tp...>>(obj),
                            std::make_index_sequence<sizeof...(Tp)>{},
                            std::forward<Args>(args)...);
@@ -694,7 +694,7 @@ template <template <typename...> class TupleT, typename... Tp, typename... Args>
 void
 add_secondary(TupleT<Tp...>&& obj, Args&&... args)
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
         invoke_impl::add_secondary(std::forward<TupleT<Tp...>>(obj),
                                    std::make_index_sequence<sizeof...(Tp)>{},
                                    std::forward<Args>(args)...);
@@ -53,11 +53,11 @@ template <typename... T, typename Func>
 lightweight_tuple<Types...>::lightweight_tuple(const string_t&     key,
                                                quirk::config<T...> config,
                                                const Func&         init_func)
-: bundle_type(((settings::enabled()) ? add_hash_id(key) : 0), false,
+: bundle_type(((settings::hot().enabled) ? add_hash_id(key) : 0), false,
               quirk::config<T...>{})
 , m_data(invoke::construct<data_type>(key, config))
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
     {
         IF_CONSTEXPR(!quirk_config<quirk::no_init, T...>::value) { init_func(*this); }
         set_prefix(get_hash_ids()->find(m_hash)->second);
@@ -76,7 +76,7 @@ lightweight_tuple<Types...>::lightweight_tuple(const captured_location_t& loc,
 : bundle_type(loc.get_hash(), false, quirk::config<T...>{})
 , m_data(invoke::construct<data_type>(loc, config))
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
     {
         IF_CONSTEXPR(!quirk_config<quirk::no_init, T...>::value) { init_func(*this); }
         set_prefix(loc.get_hash());
@@ -94,7 +94,7 @@ lightweight_tuple<Types...>::lightweight_tuple(size_t _hash, quirk::config<T...>
 : bundle_type(_hash, false, quirk::config<T...>{})
 , m_data(invoke::construct<data_type>(_hash, config))
 {
-    if(settings::enabled())
+    if(settings::hot().enabled)
     {
         IF_CONSTEXPR(!quirk_config<quirk::no_init, T...>::value) { init_func(*this); }
         set_prefix(_hash);
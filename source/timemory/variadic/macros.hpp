@@ -179,17 +179,19 @@ using string = tim::apply<std::string>;
 //======================================================================================//
 
 #    define TIMEMORY_BLANK_POINTER(TYPE, ...)                                            \
-        TIMEMORY_CONDITIONAL_BLANK_MARKER(::tim::settings::enabled(), TYPE, __VA_ARGS__)
+        TIMEMORY_CONDITIONAL_BLANK_MARKER(::tim::settings::hot().enabled, TYPE,          \
+                                          __VA_ARGS__)
 
 //--------------------------------------------------------------------------------------//
 
 #    define TIMEMORY_BASIC_POINTER(TYPE, ...)                                            \
-        TIMEMORY_CONDITIONAL_BASIC_MARKER(::tim::settings::enabled(), TYPE, __VA_ARGS__)
+        TIMEMORY_CONDITIONAL_BASIC_MARKER(::tim::settings::hot().enabled, TYPE,          \
+                                          __VA_ARGS__)
 
 //--------------------------------------------------------------------------------------//
 
 #    define TIMEMORY_POINTER(TYPE, ...)                                                  \
-        TIMEMORY_CONDITIONAL_MARKER(::tim::settings::enabled(), TYPE, __VA_ARGS__)
+        TIMEMORY_CONDITIONAL_MARKER(::tim::settings::hot().enabled, TYPE, __VA_ARGS__)
 
 //======================================================================================//
 //
@@ -285,21 +287,21 @@ using string = tim::apply<std::string>;
 //--------------------------------------------------------------------------------------//
 
 #    define TIMEMORY_BLANK_RAW_POINTER(TYPE, ...)                                        \
-        (::tim::settings::enabled())                                                     \
+        (::tim::settings::hot().enabled)                                                 \
             ? new TYPE(TIMEMORY_INLINE_SOURCE_LOCATION(blank, __VA_ARGS__))              \
             : nullptr
 
 //--------------------------------------------------------------------------------------//
 
 #    define TIMEMORY_BASIC_RAW_POINTER(TYPE, ...)                                        \
-        (::tim::settings::enabled())                                                     \
+        (::tim::settings::hot().enabled)                                                 \
             ? new TYPE(TIMEMORY_INLINE_SOURCE_LOCATION(basic, __VA_ARGS__))              \
             : nullptr
 
 //--------------------------------------------------------------------------------------//
 
 #    define TIMEMORY_RAW_POINTER(TYPE, ...)                                              \
-        (::tim::settings::enabled())                                                     \
+        (::tim::settings::hot().enabled)                                                 \
             ? new TYPE(TIMEMORY_INLINE_SOURCE_LOCATION(full, __VA_ARGS__))               \
             : nullptr
 
@@ -96,13 +96,13 @@ extern "C"
 
     //==================================================================================//
 
-    int cxx_timemory_enabled(void) { return (tim::settings::enabled()) ? 1 : 0; }
+    int cxx_timemory_enabled(void) { return (tim::settings::hot().enabled) ? 1 : 0; }
 
     //==================================================================================//
 
     void* cxx_timemory_create_auto_timer(const char* timer_tag)
     {
-        if(!tim::settings::enabled())
+        if(!tim::settings::hot().enabled)
             return nullptr;
         std::string key_tag(timer_tag);
         auto*       obj = new auto_timer_t(key_tag);
@@ -115,7 +115,7 @@ extern "C"
     void* cxx_timemory_create_auto_tuple(const char* timer_tag, int num_components,
                                          const int* components)
     {
-        if(!tim::settings::enabled())
+        if(!tim::settings::hot().enabled)
             return nullptr;
         using namespace tim::component;
         std::string key_tag(timer_tag);
@@ -131,7 +131,7 @@ extern "C"
         std::vector<int> _components;
         for(int i = 0; i < num_components; ++i)
         {
-            if(tim::settings::debug())
+            if(tim::settings::hot().debug)
                 printf("[%s]> Adding component %i...\n", __FUNCTION__, components[i]);
             _components.push_back(components[i]);
         }
@@ -175,7 +175,7 @@ extern "C"
     const char* cxx_timemory_label(int _mode, int _line, const char* _func,
                                    const char* _file, const char* _extra)
     {
-        if(!tim::settings::enabled())
+        if(!tim::settings::hot().enabled)
             return "";
 
         if(_mode == 0)
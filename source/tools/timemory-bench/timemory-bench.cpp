@@ -0,0 +1,721 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+
+//
+//  Micro-benchmarks of the instrumentation hot paths. Each benchmark is run for a
+//  number of iterations which is increased until the measured time exceeds the
+//  minimum time and the output follows the JSON schema of Google Benchmark so the
+//  results of two releases can be compared with its tools/compare.py
+//
+
+#include "legacy_stream.hpp"
+
+#include "timemory/data/stream.hpp"
+#include "timemory/library.h"
+#include "timemory/timemory.hpp"
+#include "timemory/utility/argparse.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <regex>
+#include <streambuf>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+using namespace tim::component;
+using string_t     = std::string;
+using str_vec_t    = std::vector<string_t>;
+using hash_vec_t   = std::vector<tim::hash_result_type>;
+using storage_type = tim::storage<wall_clock>;
+using result_type  = typename storage_type::result_array_t;
+using distrib_type = typename storage_type::dmp_result_t;
+using merge_type   = tim::operation::finalize::merge<wall_clock, true>;
+using mpi_get_type = tim::operation::finalize::mpi_get<wall_clock, true>;
+
+static constexpr int64_t max_iterations = 1000000000;
+static volatile int64_t  bench_sink     = 0;
+
+//--------------------------------------------------------------------------------------//
+//  the time of an iteration is only accumulated between resume() and pause() so the
+//  setup of the iteration can be excluded
+//
+struct bench_state
+{
+    using clock_type = std::chrono::steady_clock;
+
+    int64_t iterations = 0;
+    int64_t arg        = 0;
+    double  real_time  = 0.0;
+    double  cpu_time   = 0.0;
+
+    // the cpu clock is read outside of the wall-clock interval because it is a syscall
+    void resume()
+    {
+        m_cpu  = std::clock();
+        m_real = clock_type::now();
+    }
+
+    void pause()
+    {
+        auto _real = clock_type::now();
+        auto _cpu  = std::clock();
+        real_time += std::chrono::duration<double>(_real - m_real).count();
+        cpu_time += static_cast<double>(_cpu - m_cpu) / CLOCKS_PER_SEC;
+    }
+
+private:
+    clock_type::time_point m_real = {};
+    std::clock_t           m_cpu  = 0;
+};
+
+//--------------------------------------------------------------------------------------//
+
+struct bench_result
+{
+    string_t name       = {};
+    int64_t  iterations = 0;
+    double   real_time  = 0.0;
+    double   cpu_time   = 0.0;
+};
+
+//--------------------------------------------------------------------------------------//
+//  a benchmark without arguments is run once with an argument of zero
+//
+struct benchmark
+{
+    using function_type = std::function<void(bench_state&)>;
+
+    string_t             name = {};
+    std::vector<int64_t> args = {};
+    function_type        func = {};
+};
+
+//--------------------------------------------------------------------------------------//
+
+std::vector<benchmark>&
+get_benchmarks()
+{
+    static std::vector<benchmark> _instance{};
+    return _instance;
+}
+
+//--------------------------------------------------------------------------------------//
+
+void
+add_benchmark(const string_t& _name, std::vector<int64_t> _args,
+              benchmark::function_type _func)
+{
+    get_benchmarks().emplace_back(benchmark{ _name, std::move(_args), std::move(_func) });
+}
+
+//--------------------------------------------------------------------------------------//
+//  the labels and hashes of the regions, N of them are cycled through
+//
+const str_vec_t&
+get_labels(int64_t _n)
+{
+    static std::map<int64_t, str_vec_t> _instance{};
+    auto&                               _labels = _instance[_n];
+    for(auto i = static_cast<int64_t>(_labels.size()); i < std::max<int64_t>(_n, 1); ++i)
+        _labels.emplace_back("timemory-bench/region-" + std::to_string(i));
+    return _labels;
+}
+
+const hash_vec_t&
+get_hashes(int64_t _n)
+{
+    static std::map<int64_t, hash_vec_t> _instance{};
+    auto&                                _hashes = _instance[_n];
+    if(_hashes.empty())
+    {
+        for(const auto& itr : get_labels(_n))
+            _hashes.emplace_back(tim::add_hash_id(itr));
+    }
+    return _hashes;
+}
+
+//======================================================================================//
+//
+//                                  Benchmarks
+//
+//======================================================================================//
+
+template <typename BundleT>
+void
+bundle_start_stop(bench_state& _state)
+{
+    const auto& _labels = get_labels(_state.arg);
+    size_t      _idx    = 0;
+
+    _state.resume();
+    for(int64_t i = 0; i < _state.iterations; ++i)
+    {
+        BundleT _obj{ _labels[_idx] };
+        _obj.start();
+        _obj.stop();
+        if(++_idx == _labels.size())
+            _idx = 0;
+    }
+    _state.pause();
+}
+
+//--------------------------------------------------------------------------------------//
+//  the auto bundles start at construction and stop at destruction
+//
+template <typename BundleT>
+void
+auto_bundle_scope(bench_state& _state)
+{
+    const auto& _labels = get_labels(_state.arg);
+    size_t      _idx    = 0;
+
+    _state.resume();
+    for(int64_t i = 0; i < _state.iterations; ++i)
+    {
+        BundleT _obj{ _labels[_idx] };
+        if(++_idx == _labels.size())
+            _idx = 0;
+    }
+    _state.pause();
+}
+
+//--------------------------------------------------------------------------------------//
+
+void
+hash_existing_key(bench_state& _state)
+{
+    const auto& _labels = get_labels(_state.arg);
+    size_t      _idx    = 0;
+    get_hashes(_state.arg);
+
+    _state.resume();
+    for(int64_t i = 0; i < _state.iterations; ++i)
+    {
+        bench_sink += tim::add_hash_id(_labels[_idx]);
+        if(++_idx == _labels.size())
+            _idx = 0;
+    }
+    _state.pause();
+}
+
+//--------------------------------------------------------------------------------------//
+
+void
+hash_new_key(bench_state& _state)
+{
+    static int64_t _count = 0;
+
+    str_vec_t _labels{};
+    _labels.reserve(_state.iterations);
+    for(int64_t i = 0; i < _state.iterations; ++i)
+        _labels.emplace_back("timemory-bench/new-key-" + std::to_string(_count++));
+
+    _state.resume();
+    for(const auto& itr : _labels)
+        bench_sink += tim::add_hash_id(itr);
+    _state.pause();
+}
+
+//--------------------------------------------------------------------------------------//
+//  the graph is reset afterwards because the timeline mode adds a node per insert
+//
+template <typename ScopeT>
+void
+storage_insert(bench_state& _state)
+{
+    constexpr bool _is_flat = std::is_same<ScopeT, tim::scope::flat>::value;
+    const auto&    _hashes  = get_hashes(_state.arg);
+    auto*          _storage = storage_type::instance();
+    size_t         _idx     = 0;
+    wall_clock     _obj{};
+
+    _state.resume();
+    for(int64_t i = 0; i < _state.iterations; ++i)
+    {
+        _storage->insert(ScopeT{}, _obj, _hashes[_idx]);
+        if(!_is_flat)
+            _storage->pop();
+        if(++_idx == _hashes.size())
+            _idx = 0;
+    }
+    _state.pause();
+
+    _storage->reset();
+}
+
+//--------------------------------------------------------------------------------------//
+
+void
+trace_push_pop(bench_state& _state)
+{
+    const auto& _labels = get_labels(_state.arg);
+    size_t      _idx    = 0;
+
+    _state.resume();
+    for(int64_t i = 0; i < _state.iterations; ++i)
+    {
+        timemory_push_trace(_labels[_idx].c_str());
+        timemory_pop_trace(_labels[_idx].c_str());
+        if(++_idx == _labels.size())
+            _idx = 0;
+    }
+    _state.pause();
+}
+
+//--------------------------------------------------------------------------------------//
+
+void
+region_push_pop(bench_state& _state)
+{
+    const auto& _labels = get_labels(_state.arg);
+    size_t      _idx    = 0;
+
+    _state.resume();
+    for(int64_t i = 0; i < _state.iterations; ++i)
+    {
+        timemory_push_region(_labels[_idx].c_str());
+        timemory_pop_region(_labels[_idx].c_str());
+        if(++_idx == _labels.size())
+            _idx = 0;
+    }
+    _state.pause();
+}
+
+//--------------------------------------------------------------------------------------//
+//  the storage holds N flat entries
+//
+storage_type::pointer
+populate(int64_t _n)
+{
+    auto*      _storage = storage_type::instance();
+    wall_clock _obj{};
+    _storage->reset();
+    for(const auto& itr : get_hashes(_n))
+        _storage->insert(tim::scope::flat{}, _obj, itr);
+    return _storage;
+}
+
+//--------------------------------------------------------------------------------------//
+//  every entry of the source has an equivalent entry in the destination
+//
+void
+finalize_merge(bench_state& _state)
+{
+    auto _src = populate(_state.arg)->get();
+    storage_type::instance()->reset();
+
+    for(int64_t i = 0; i < _state.iterations; ++i)
+    {
+        result_type _dst = _src;
+        _state.resume();
+        merge_type{ _dst, _src };
+        _state.pause();
+        bench_sink += _dst.size();
+    }
+}
+
+//--------------------------------------------------------------------------------------//
+
+void
+finalize_mpi_get(bench_state& _state)
+{
+    auto*        _storage = populate(_state.arg);
+    distrib_type _results{};
+
+    _state.resume();
+    for(int64_t i = 0; i < _state.iterations; ++i)
+        mpi_get_type{ *_storage, _results };
+    _state.pause();
+
+    bench_sink += _results.size();
+    _storage->reset();
+}
+
+//--------------------------------------------------------------------------------------//
+//  discards the report so only the formatting is measured
+//
+struct null_buffer : std::streambuf
+{
+    int_type        overflow(int_type c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+//--------------------------------------------------------------------------------------//
+//  a text report of N rows with the columns of operation::finalize::print is filled
+//  and written. The stream is either tim::utility::stream or the per-cell
+//  std::stringstream engine it replaced
+//
+template <typename StreamT>
+void
+report_text(bench_state& _state)
+{
+    auto         _fmt        = wall_clock::get_format_flags();
+    auto         _width      = wall_clock::get_width();
+    auto         _prec       = wall_clock::get_precision();
+    const auto&  _labels     = get_labels(_state.arg);
+    str_vec_t    _value_cols = { "SUM", "MEAN", "MIN", "MAX", "STDDEV" };
+    null_buffer  _buffer{};
+    std::ostream _os{ &_buffer };
+
+    for(int64_t i = 0; i < _state.iterations; ++i)
+    {
+        StreamT _stream{ '|', '-', _fmt, _width, _prec };
+
+        _state.resume();
+        write_header(_stream, "LABEL");
+        write_header(_stream, "COUNT");
+        write_header(_stream, "DEPTH");
+        write_header(_stream, "METRIC");
+        write_header(_stream, "UNITS");
+        for(const auto& itr : _value_cols)
+            write_header(_stream, itr, _fmt, _width, _prec);
+        write_header(_stream, "% SELF", std::ios_base::fixed, 5, 1);
+
+        int64_t _n = 0;
+        for(const auto& itr : _labels)
+        {
+            double _value = 1.0e-3 * static_cast<double>((_n * 7919) % 1000003);
+            write_entry(_stream, "LABEL", itr);
+            write_entry(_stream, "COUNT", _n + 1);
+            write_entry(_stream, "DEPTH", _n % 8);
+            write_entry(_stream, "METRIC", std::string{ "wall" });
+            write_entry(_stream, "UNITS", std::string{ "sec" });
+            write_entry(_stream, "SUM", _value);
+            write_entry(_stream, "MEAN", _value / (_n + 1));
+            write_entry(_stream, "MIN", 0.5 * _value / (_n + 1));
+            write_entry(_stream, "MAX", 2.0 * _value / (_n + 1));
+            write_entry(_stream, "STDDEV", 0.25 * _value);
+            write_entry(_stream, "% SELF", static_cast<double>(_n % 101));
+            _stream.add_row();
+            ++_n;
+        }
+        _os << _stream << std::flush;
+        _state.pause();
+    }
+}
+
+//--------------------------------------------------------------------------------------//
+
+#if defined(TIMEMORY_USE_GOTCHA)
+using gotcha_bundle_t = tim::component_tuple<wall_clock>;
+using rand_gotcha_t   = gotcha<1, gotcha_bundle_t>;
+using rand_wrapper_t  = tim::lightweight_tuple<rand_gotcha_t>;
+
+template <bool WrapV>
+void
+gotcha_call(bench_state& _state)
+{
+    rand_wrapper_t _wrapper{ "timemory-bench/gotcha" };
+    if(WrapV)
+        _wrapper.start();
+
+    _state.resume();
+    for(int64_t i = 0; i < _state.iterations; ++i)
+        bench_sink += rand();
+    _state.pause();
+
+    if(WrapV)
+        _wrapper.stop();
+}
+#endif
+
+//======================================================================================//
+//
+//                                  Runner
+//
+//======================================================================================//
+//  the number of iterations is grown the same way as Google Benchmark: by the
+//  predicted ratio to reach the minimum time plus 40% and at most ten-fold
+//
+bench_result
+run(const string_t& _name, const benchmark::function_type& _func, int64_t _arg,
+    double _min_time)
+{
+    bench_state _state{};
+    int64_t     _niter = 1;
+    while(true)
+    {
+        _state            = bench_state{};
+        _state.iterations = _niter;
+        _state.arg        = _arg;
+        _func(_state);
+
+        int64_t _next = 0;
+        if(_state.real_time < _min_time && _niter < max_iterations)
+        {
+            double _mult = (_state.real_time > 0.0) ? (1.4 * _min_time / _state.real_time)
+                                                    : 10.0;
+
+            _next = static_cast<int64_t>(_niter * std::min(_mult, 10.0));
+            _next = std::max<int64_t>(_next, _niter + 1);
+            _next = std::min<int64_t>(_next, max_iterations);
+        }
+#if defined(TIMEMORY_USE_MPI)
+        // the collective benchmarks have to run the same iterations on every rank
+        if(tim::mpi::is_initialized())
+            tim::mpi::bcast(&_next, 1, MPI_INT64_T, 0);
+#endif
+        if(_next == 0)
+            break;
+        _niter = _next;
+    }
+
+    auto _n = static_cast<double>(_niter);
+    return bench_result{ _name, _niter, 1.0e9 * _state.real_time / _n,
+                         1.0e9 * _state.cpu_time / _n };
+}
+
+//--------------------------------------------------------------------------------------//
+
+void
+print_console(const std::vector<bench_result>& _results, std::ostream& os)
+{
+    size_t _width = 9;
+    for(const auto& itr : _results)
+        _width = std::max(_width, itr.name.length());
+
+    os << std::left << std::setw(_width) << "Benchmark" << std::right << std::setw(16)
+       << "Time" << std::setw(16) << "CPU" << std::setw(14) << "Iterations" << '\n';
+    os << string_t(_width + 46, '-') << '\n';
+    os << std::fixed << std::setprecision(1);
+    for(const auto& itr : _results)
+    {
+        os << std::left << std::setw(_width) << itr.name << std::right << std::setw(13)
+           << itr.real_time << " ns" << std::setw(13) << itr.cpu_time << " ns"
+           << std::setw(14) << itr.iterations << '\n';
+    }
+}
+
+//--------------------------------------------------------------------------------------//
+
+void
+print_json(const std::vector<bench_result>& _results, const string_t& _exe,
+           std::ostream& os)
+{
+    auto _now = std::time(nullptr);
+    char _date[64];
+    std::strftime(_date, sizeof(_date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&_now));
+
+    os << "{\n  \"context\": {\n";
+    os << "    \"date\": \"" << _date << "\",\n";
+    os << "    \"executable\": \"" << _exe << "\",\n";
+    os << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+    os << "    \"mpi_size\": " << tim::mpi::size() << ",\n";
+    os << "    \"timemory_version\": \"" << TIMEMORY_VERSION_STRING << "\",\n";
+#if defined(NDEBUG)
+    os << "    \"library_build_type\": \"release\"\n";
+#else
+    os << "    \"library_build_type\": \"debug\"\n";
+#endif
+    os << "  },\n  \"benchmarks\": [";
+    os << std::setprecision(std::numeric_limits<double>::digits10 + 1);
+    for(size_t i = 0; i < _results.size(); ++i)
+    {
+        const auto& itr = _results.at(i);
+        os << ((i == 0) ? "\n" : ",\n") << "    {\n";
+        os << "      \"name\": \"" << itr.name << "\",\n";
+        os << "      \"run_name\": \"" << itr.name << "\",\n";
+        os << "      \"run_type\": \"iteration\",\n";
+        os << "      \"repetitions\": 1,\n";
+        os << "      \"repetition_index\": 0,\n";
+        os << "      \"threads\": 1,\n";
+        os << "      \"iterations\": " << itr.iterations << ",\n";
+        os << "      \"real_time\": " << itr.real_time << ",\n";
+        os << "      \"cpu_time\": " << itr.cpu_time << ",\n";
+        os << "      \"time_unit\": \"ns\"\n    }";
+    }
+    os << "\n  ]\n}\n";
+}
+
+//--------------------------------------------------------------------------------------//
+
+void
+add_benchmarks()
+{
+    std::vector<int64_t> _labels = { 1, 64 };
+    std::vector<int64_t> _sizes  = { 16, 256, 4096 };
+    std::vector<int64_t> _rows   = { 500000 };
+
+    using tim::api::native_tag;
+    add_benchmark("bundle/component_tuple", _labels,
+                  bundle_start_stop<tim::component_tuple<wall_clock>>);
+    add_benchmark("bundle/component_list", _labels,
+                  bundle_start_stop<tim::component_list<wall_clock>>);
+    add_benchmark("bundle/component_bundle", _labels,
+                  bundle_start_stop<tim::component_bundle<native_tag, wall_clock>>);
+    add_benchmark("bundle/lightweight_tuple", _labels,
+                  bundle_start_stop<tim::lightweight_tuple<wall_clock>>);
+    add_benchmark("bundle/auto_tuple", _labels,
+                  auto_bundle_scope<tim::auto_tuple<wall_clock>>);
+    add_benchmark("bundle/auto_list", _labels,
+                  auto_bundle_scope<tim::auto_list<wall_clock>>);
+    add_benchmark("bundle/auto_bundle", _labels,
+                  auto_bundle_scope<tim::auto_bundle<native_tag, wall_clock>>);
+    add_benchmark("hash/add_hash_id/existing", _labels, hash_existing_key);
+    add_benchmark("hash/add_hash_id/new", {}, hash_new_key);
+    add_benchmark("storage/insert/tree", _labels, storage_insert<tim::scope::tree>);
+    add_benchmark("storage/insert/flat", _labels, storage_insert<tim::scope::flat>);
+    add_benchmark("storage/insert/timeline", _labels,
+                  storage_insert<tim::scope::timeline>);
+    add_benchmark("library/push_pop_trace", _labels, trace_push_pop);
+    add_benchmark("library/push_pop_region", _labels, region_push_pop);
+#if defined(TIMEMORY_USE_GOTCHA)
+    add_benchmark("gotcha/rand/unwrapped", {}, gotcha_call<false>);
+    add_benchmark("gotcha/rand/wrapped", {}, gotcha_call<true>);
+#endif
+    add_benchmark("finalize/merge", _sizes, finalize_merge);
+    add_benchmark("finalize/mpi_get", _sizes, finalize_mpi_get);
+    add_benchmark("report/text/legacy", _rows, report_text<legacy::stream>);
+    add_benchmark("report/text/buffered", _rows, report_text<tim::utility::stream>);
+}
+
+//======================================================================================//
+
+int
+main(int argc, char** argv)
+{
+    tim::argparse::argument_parser parser("timemory-bench");
+
+    parser.enable_help();
+    parser.add_argument({ "-f", "--filter" }, "Only run the benchmarks matching a regex")
+        .count(1);
+    parser.add_argument({ "-l", "--list" }, "List the benchmarks").count(0);
+    parser
+        .add_argument({ "-t", "--min-time" },
+                      "Minimum seconds per benchmark (default: 0.1)")
+        .count(1);
+    parser.add_argument({ "--format" }, "Output format: console (default) or json")
+        .count(1)
+        .choices({ "console", "json" });
+    parser.add_argument({ "-o", "--output" }, "Also write JSON output to this file")
+        .count(1);
+
+    auto err = parser.parse(argc, argv);
+    if(err)
+        std::cerr << err << std::endl;
+
+    if(err || parser.exists("help"))
+    {
+        parser.print_help();
+        return (err) ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
+    auto _filter   = (parser.exists("filter")) ? parser.get<string_t>("filter") : ".*";
+    auto _min_time = (parser.exists("min-time")) ? parser.get<double>("min-time") : 0.1;
+    auto _format   = (parser.exists("format")) ? parser.get<string_t>("format")
+                                               : string_t{ "console" };
+    auto _output   = (parser.exists("output")) ? parser.get<string_t>("output") : "";
+
+    // nothing is written at finalization and the traces are never throttled
+    tim::set_env("TIMEMORY_BANNER", "OFF", 0);
+    tim::set_env("TIMEMORY_FILE_OUTPUT", "OFF", 0);
+    tim::set_env("TIMEMORY_COUT_OUTPUT", "OFF", 0);
+    tim::set_env("TIMEMORY_THROTTLE_VALUE", "0", 1);
+
+    tim::mpi::initialize(argc, argv);
+    tim::timemory_init(argc, argv);
+    timemory_set_default("wall_clock");
+    timemory_init_library(argc, argv);
+    timemory_trace_init("wall_clock", false, "timemory-bench");
+
+#if defined(TIMEMORY_USE_GOTCHA)
+    rand_gotcha_t::get_initializer() = []() {
+        TIMEMORY_C_GOTCHA(rand_gotcha_t, 0, rand);
+    };
+#endif
+    tim::component_list<wall_clock>::get_initializer() = [](auto& cl) {
+        cl.template initialize<wall_clock>();
+    };
+    tim::auto_list<wall_clock>::get_initializer() = [](auto& cl) {
+        cl.template initialize<wall_clock>();
+    };
+
+    add_benchmarks();
+
+    bool _print = (tim::mpi::rank() == 0);
+    int  _ret   = EXIT_SUCCESS;
+    try
+    {
+        std::regex                _regex{ _filter };
+        std::vector<bench_result> _results{};
+        for(const auto& itr : get_benchmarks())
+        {
+            auto _args = (itr.args.empty()) ? std::vector<int64_t>{ 0 } : itr.args;
+            for(const auto& aitr : _args)
+            {
+                auto _name = itr.name;
+                if(!itr.args.empty())
+                    _name += "/" + std::to_string(aitr);
+                if(!std::regex_search(_name, _regex))
+                    continue;
+                if(parser.exists("list"))
+                {
+                    if(_print)
+                        std::cout << _name << '\n';
+                    continue;
+                }
+                _results.emplace_back(run(_name, itr.func, aitr, _min_time));
+            }
+        }
+
+        if(_print && !_results.empty())
+        {
+            if(_format == "json")
+                print_json(_results, argv[0], std::cout);
+            else
+                print_console(_results, std::cout);
+
+            if(!_output.empty())
+            {
+                std::ofstream ofs{ _output };
+                if(!ofs)
+                    throw std::runtime_error("Error opening '" + _output + "'");
+                print_json(_results, argv[0], ofs);
+            }
+        }
+    } catch(std::exception& e)
+    {
+        std::cerr << "[timemory-bench]> Error: " << e.what() << std::endl;
+        _ret = EXIT_FAILURE;
+    }
+
+    storage_type::instance()->reset();
+    timemory_trace_finalize();
+    tim::dmp::finalize();
+    return _ret;
+}
@@ -0,0 +1,490 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//  Inspect, convert (to JSON), diff, and merge the binary (columnar) output files
+//  written when TIMEMORY_BINARY_OUTPUT is enabled
+//
+
+#include "timemory/storage/binary.hpp"
+#include "timemory/utility/argparse.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace tim::binary;
+using string_t  = std::string;
+using str_vec_t = std::vector<string_t>;
+using key_type  = std::tuple<uint64_t, uint64_t, int64_t, string_t>;
+
+enum class combine_op
+{
+    merge,
+    diff
+};
+
+//--------------------------------------------------------------------------------------//
+//  apply a function to every element of a fixed-size row after converting the element
+//  to a long double (floating point) or an int64_t/uint64_t (integral)
+//
+template <typename FuncT>
+void
+for_each_element(elem_type _type, uint32_t _count, const char* _data, FuncT&& _func)
+{
+    auto _size = get_size(_type);
+    for(uint32_t i = 0; i < _count; ++i)
+    {
+        const char* _ptr = _data + i * _size;
+        switch(_type)
+        {
+#define TIMEMORY_BINARY_ELEMENT(ENUM, TYPE)                                              \
+    case elem_type::ENUM:                                                                \
+    {                                                                                    \
+        TYPE _val{};                                                                     \
+        memcpy(&_val, _ptr, sizeof(TYPE));                                               \
+        _func(i, _val);                                                                  \
+        break;                                                                           \
+    }
+            TIMEMORY_BINARY_ELEMENT(boolean, bool)
+            TIMEMORY_BINARY_ELEMENT(int8, int8_t)
+            TIMEMORY_BINARY_ELEMENT(uint8, uint8_t)
+            TIMEMORY_BINARY_ELEMENT(int16, int16_t)
+            TIMEMORY_BINARY_ELEMENT(uint16, uint16_t)
+            TIMEMORY_BINARY_ELEMENT(int32, int32_t)
+            TIMEMORY_BINARY_ELEMENT(uint32, uint32_t)
+            TIMEMORY_BINARY_ELEMENT(int64, int64_t)
+            TIMEMORY_BINARY_ELEMENT(uint64, uint64_t)
+            TIMEMORY_BINARY_ELEMENT(float32, float)
+            TIMEMORY_BINARY_ELEMENT(float64, double)
+            TIMEMORY_BINARY_ELEMENT(float128, long double)
+#undef TIMEMORY_BINARY_ELEMENT
+            case elem_type::opaque: break;
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------//
+//  combine two rows of a fixed-size column element-wise into the destination
+//
+template <typename Tp>
+Tp
+combine_element(const string_t& _name, combine_op _op, Tp _lhs, Tp _rhs)
+{
+    if(_op == combine_op::merge)
+    {
+        if(_name == "stats.min")
+            return std::min(_lhs, _rhs);
+        if(_name == "stats.max")
+            return std::max(_lhs, _rhs);
+        if(_name == "last")
+            return _rhs;
+        return _lhs + _rhs;
+    }
+    if(_name == "last")
+        return _lhs;
+    return _lhs - _rhs;
+}
+
+inline bool
+combine_element(const string_t&, combine_op _op, bool _lhs, bool _rhs)
+{
+    return (_op == combine_op::merge) ? (_lhs || _rhs) : _lhs;
+}
+
+void
+combine_row(const string_t& _name, combine_op _op, const column_view& _col, char* _dst,
+            const char* _rhs)
+{
+    auto _size = get_size(_col.type());
+    for_each_element(_col.type(), _col.count(), _dst, [&](uint32_t i, auto _lhs) {
+        using type = decltype(_lhs);
+        type _rval{};
+        memcpy(&_rval, _rhs + i * _size, sizeof(type));
+        type _val = combine_element(_name, _op, _lhs, _rval);
+        memcpy(_dst + i * _size, &_val, sizeof(type));
+    });
+}
+
+//--------------------------------------------------------------------------------------//
+
+bool
+is_key_column(const string_t& _name)
+{
+    static const str_vec_t _keys = { "hash", "rolling_hash", "prefix", "depth",
+                                     "tid",  "pid",          "is_transient" };
+    return std::find(_keys.begin(), _keys.end(), _name) != _keys.end();
+}
+
+template <typename Tp>
+Tp
+get_value(const column_view& _col, uint64_t _row, Tp _default = Tp{})
+{
+    if(!_col || !_col.holds<Tp>())
+        return _default;
+    Tp _val{};
+    memcpy(&_val, _col.row(_row), sizeof(Tp));
+    return _val;
+}
+
+key_type
+get_key(const reader& _reader, const table_view& _table, uint64_t _row)
+{
+    return key_type{ get_value<uint64_t>(_table.find("hash"), _row),
+                     get_value<uint64_t>(_table.find("rolling_hash"), _row),
+                     get_value<int64_t>(_table.find("depth"), _row),
+                     _reader.get_string(
+                         get_value<uint64_t>(_table.find("prefix"), _row)) };
+}
+
+//--------------------------------------------------------------------------------------//
+
+void
+print_info(const reader& _reader, std::ostream& os)
+{
+    const auto& _header = _reader.get_header();
+    os << _reader.get_filename() << ":\n";
+    os << "    version    : " << _header.version << "\n";
+    os << "    tables     : " << _header.num_tables << "\n";
+    os << "    strings    : " << _header.strtab_size << " bytes\n";
+    for(const auto& itr : _reader.get_metadata())
+        os << "    " << std::setw(11) << std::left << itr.first << ": " << itr.second
+           << "\n";
+    for(uint64_t i = 0; i < _reader.num_tables(); ++i)
+    {
+        auto _table = _reader.get_table(i);
+        os << "    [rank " << _table.rank() << "] " << _table.size() << " rows, "
+           << _table.num_columns() << " columns\n";
+        for(uint64_t j = 0; j < _table.num_columns(); ++j)
+        {
+            auto _col = _table.get_column(j);
+            os << "        " << std::setw(20) << std::left << _col.name << " ";
+            if(_col.kind() == column_kind::fixed)
+                os << get_name(_col.type()) << "[" << _col.count() << "]";
+            else
+                os << "blob";
+            os << "\n";
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------//
+
+void
+print_json(const reader& _reader, std::ostream& os)
+{
+    auto _quote = [](const string_t& _str) {
+        std::stringstream ss;
+        ss << '"';
+        for(auto itr : _str)
+        {
+            if(itr == '"' || itr == '\\')
+                ss << '\\' << itr;
+            else if(static_cast<unsigned char>(itr) < 0x20)
+                ss << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                   << static_cast<int>(itr) << std::dec << std::setfill(' ');
+            else
+                ss << itr;
+        }
+        ss << '"';
+        return ss.str();
+    };
+
+    os << std::setprecision(std::numeric_limits<double>::max_digits10);
+    os << "{\n  \"timemory\": {\n    \"metadata\": {";
+    auto _meta = _reader.get_metadata();
+    for(size_t i = 0; i < _meta.size(); ++i)
+        os << ((i == 0) ? "\n" : ",\n") << "      " << _quote(_meta.at(i).first) << ": "
+           << _quote(_meta.at(i).second);
+    os << "\n    },\n    \"ranks\": [";
+    for(uint64_t i = 0; i < _reader.num_tables(); ++i)
+    {
+        auto _table = _reader.get_table(i);
+        os << ((i == 0) ? "\n" : ",\n") << "      {\n        \"rank\": " << _table.rank()
+           << ",\n        \"graph\": [";
+        for(uint64_t r = 0; r < _table.size(); ++r)
+        {
+            os << ((r == 0) ? "\n" : ",\n") << "          {";
+            for(uint64_t c = 0; c < _table.num_columns(); ++c)
+            {
+                auto    _col  = _table.get_column(c);
+                string_t _name = _col.name;
+                os << ((c == 0) ? " " : ", ") << _quote(_name) << ": ";
+                if(_name == "prefix")
+                {
+                    os << _quote(_reader.get_string(get_value<uint64_t>(_col, r)));
+                    continue;
+                }
+                if(_col.kind() != column_kind::fixed || _col.type() == elem_type::opaque)
+                {
+                    // blobs are serialized by the component and cannot be converted
+                    // without the component type
+                    os << "null";
+                    continue;
+                }
+                if(_col.count() != 1)
+                    os << "[";
+                for_each_element(_col.type(), _col.count(), _col.row(r),
+                                 [&](uint32_t e, auto _val) {
+                                     if(e > 0)
+                                         os << ", ";
+                                     os << +_val;
+                                 });
+                if(_col.count() != 1)
+                    os << "]";
+            }
+            os << " }";
+        }
+        os << "\n        ]\n      }";
+    }
+    os << "\n    ]\n  }\n}\n";
+}
+
+//--------------------------------------------------------------------------------------//
+//  combine (merge or diff) the tables of two files. Rows are matched by the hash,
+//  rolling hash, depth, and label. For a merge, the rows which only exist in the
+//  second file are appended
+//
+void
+combine(const reader& _lhs, const reader& _rhs, combine_op _op, writer& _writer)
+{
+    for(const auto& itr : _lhs.get_metadata())
+        _writer.add_metadata(itr.first, itr.second);
+
+    std::map<uint64_t, table_view> _rhs_tables{};
+    for(uint64_t i = 0; i < _rhs.num_tables(); ++i)
+        _rhs_tables.emplace(_rhs.get_table(i).rank(), _rhs.get_table(i));
+
+    for(uint64_t i = 0; i < _lhs.num_tables(); ++i)
+    {
+        auto _ltable = _lhs.get_table(i);
+        auto ritr    = _rhs_tables.find(_ltable.rank());
+
+        std::map<key_type, uint64_t> _rkeys{};
+        if(ritr != _rhs_tables.end())
+        {
+            for(uint64_t r = 0; r < ritr->second.size(); ++r)
+                _rkeys.emplace(get_key(_rhs, ritr->second, r), r);
+        }
+
+        // (lhs row, rhs row) pairs. A missing row is the max value
+        constexpr auto _npos = std::numeric_limits<uint64_t>::max();
+        std::vector<std::pair<uint64_t, uint64_t>> _rows{};
+        std::vector<bool> _rused((ritr != _rhs_tables.end()) ? ritr->second.size() : 0);
+        for(uint64_t r = 0; r < _ltable.size(); ++r)
+        {
+            auto kitr = _rkeys.find(get_key(_lhs, _ltable, r));
+            if(kitr != _rkeys.end())
+            {
+                _rows.emplace_back(r, kitr->second);
+                _rused.at(kitr->second) = true;
+            }
+            else if(_op == combine_op::merge)
+            {
+                _rows.emplace_back(r, _npos);
+            }
+        }
+        if(_op == combine_op::merge)
+        {
+            for(uint64_t r = 0; r < _rused.size(); ++r)
+            {
+                if(!_rused.at(r))
+                    _rows.emplace_back(_npos, r);
+            }
+        }
+
+        auto& _table = _writer.add_table(_ltable.rank(), _rows.size());
+        for(uint64_t c = 0; c < _ltable.num_columns(); ++c)
+        {
+            auto        _lcol = _ltable.get_column(c);
+            string_t    _name = _lcol.name;
+            column_view _rcol{};
+            if(ritr != _rhs_tables.end())
+            {
+                _rcol = ritr->second.find(_name);
+                if(_rcol && (_rcol.kind() != _lcol.kind() ||
+                             _rcol.type() != _lcol.type() ||
+                             _rcol.count() != _lcol.count()))
+                    throw std::runtime_error("column '" + _name +
+                                             "' has a different layout in '" +
+                                             _rhs.get_filename() + "'");
+            }
+
+            bool _combine = !is_key_column(_name);
+            if(_lcol.kind() == column_kind::blob)
+            {
+                auto& _col = _table.add(column::make_blob(_name));
+                for(const auto& ritr_row : _rows)
+                {
+                    bool _left = (ritr_row.first != _npos);
+                    if(!_left && !_rcol)
+                        throw std::runtime_error("column '" + _name +
+                                                 "' is missing in '" +
+                                                 _rhs.get_filename() + "'");
+                    if(_left && ritr_row.second != _npos && _combine && _rcol)
+                        throw std::runtime_error(
+                            "column '" + _name +
+                            "' is serialized by the component and cannot be combined");
+                    const auto& _src = (_left) ? _lcol : _rcol;
+                    auto        _row = (_left) ? ritr_row.first : ritr_row.second;
+                    _col.push_back(_src.row(_row), _src.row_size(_row));
+                }
+                continue;
+            }
+
+            auto& _col = _table.add(column::make_fixed(_name, _lcol.type(), _lcol.count(),
+                                                      _lcol.stride()));
+            char* _dst = _col.resize(_rows.size());
+            for(uint64_t r = 0; r < _rows.size(); ++r, _dst += _col.stride)
+            {
+                auto _lrow = _rows.at(r).first;
+                auto _rrow = _rows.at(r).second;
+                if(_lrow == _npos && !_rcol)
+                    throw std::runtime_error("column '" + _name + "' is missing in '" +
+                                             _rhs.get_filename() + "'");
+                if(_lrow != _npos)
+                    memcpy(_dst, _lcol.row(_lrow), _col.stride);
+                else
+                    memcpy(_dst, _rcol.row(_rrow), _col.stride);
+
+                if(_name == "prefix")
+                {
+                    // string table offsets must be remapped to the new string table
+                    const auto& _src = (_lrow != _npos) ? _lhs : _rhs;
+                    uint64_t    _off = 0;
+                    memcpy(&_off, _dst, sizeof(uint64_t));
+                    _off = _writer.add_string(_src.get_string(_off));
+                    memcpy(_dst, &_off, sizeof(uint64_t));
+                }
+                else if(_combine && _lrow != _npos && _rrow != _npos && _rcol)
+                {
+                    combine_row(_name, _op, _lcol, _dst, _rcol.row(_rrow));
+                }
+            }
+        }
+    }
+}
+
+//--------------------------------------------------------------------------------------//
+
+int
+main(int argc, char** argv)
+{
+    tim::argparse::argument_parser parser("timemory-binary");
+
+    parser.enable_help();
+    parser.add_argument({ "-i", "--input" }, "Input binary file(s)");
+    parser.add_argument({ "-o", "--output" }, "Output file (default: stdout)").count(1);
+    parser.add_argument({ "-I", "--info" }, "Print the header, metadata, and columns")
+        .count(0);
+    parser.add_argument({ "-j", "--json" }, "Convert the input file to JSON").count(0);
+    parser
+        .add_argument({ "-d", "--diff" },
+                      "Write the difference of two input files (first - second)")
+        .count(0);
+    parser.add_argument({ "-m", "--merge" }, "Write the sum of the input files").count(0);
+
+    auto err = parser.parse(argc, argv);
+    if(err)
+        std::cerr << err << std::endl;
+
+    if(err || parser.exists("help") || !parser.exists("input"))
+    {
+        parser.print_help();
+        return EXIT_FAILURE;
+    }
+
+    auto _inputs = parser.get<str_vec_t>("input");
+    auto _output = (parser.exists("output")) ? parser.get<string_t>("output") : "";
+
+    if(_inputs.empty())
+    {
+        std::cerr << "No input files were provided" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    try
+    {
+        if(parser.exists("diff") || parser.exists("merge"))
+        {
+            bool _diff = parser.exists("diff");
+            if(_output.empty())
+                throw std::runtime_error("--diff and --merge require an output file");
+            if(_inputs.size() < 2 || (_diff && _inputs.size() != 2))
+                throw std::runtime_error((_diff) ? "--diff requires two input files"
+                                                 : "--merge requires 2+ input files");
+
+            auto   _op     = (_diff) ? combine_op::diff : combine_op::merge;
+            reader _result{ _inputs.at(0) };
+            for(size_t i = 1; i < _inputs.size(); ++i)
+            {
+                reader _rhs{ _inputs.at(i) };
+                writer _writer{};
+                combine(_result, _rhs, _op, _writer);
+                // intermediate results of a merge are written to the output file and
+                // re-opened as the lhs of the next input
+                if(!_writer.write(_output))
+                    throw std::runtime_error("Error writing '" + _output + "'");
+                _result.open(_output);
+            }
+            std::cout << "[timemory-binary]> Outputting '" << _output << "'..."
+                      << std::endl;
+            return EXIT_SUCCESS;
+        }
+
+        std::ofstream ofs{};
+        if(!_output.empty())
+        {
+            ofs.open(_output.c_str());
+            if(!ofs)
+                throw std::runtime_error("Error opening '" + _output + "'");
+        }
+        std::ostream& os = (_output.empty()) ? std::cout : ofs;
+
+        for(const auto& itr : _inputs)
+        {
+            reader _reader{ itr };
+            if(parser.exists("json"))
+                print_json(_reader, os);
+            else
+                print_info(_reader, os);
+        }
+    } catch(std::exception& e)
+    {
+        std::cerr << "[timemory-binary]> Error: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
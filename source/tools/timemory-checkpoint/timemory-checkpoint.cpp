@@ -0,0 +1,220 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//  List the records of a checkpoint file written when TIMEMORY_CHECKPOINT_INTERVAL or
+//  TIMEMORY_CHECKPOINT_SIGNAL is set and rebuild the profile at the latest checkpoint
+//  or the change within a window of checkpoints
+//
+
+#include "timemory/utility/argparse.hpp"
+#include "timemory/utility/checkpoint.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace tim::checkpoint;
+using string_t  = std::string;
+using str_vec_t = std::vector<string_t>;
+using row_type  = record::row;
+
+//--------------------------------------------------------------------------------------//
+//  seconds of a record relative to the first record
+//
+double
+get_elapsed(const std::vector<record>& _records, size_t _idx)
+{
+    return 1.0e-9 * static_cast<double>(_records.at(_idx).timestamp -
+                                        _records.front().timestamp);
+}
+
+//--------------------------------------------------------------------------------------//
+//  index of the first record after the given number of seconds
+//
+size_t
+get_index(const std::vector<record>& _records, double _seconds)
+{
+    size_t i = 0;
+    while(i < _records.size() && get_elapsed(_records, i) <= _seconds)
+        ++i;
+    return i;
+}
+
+//--------------------------------------------------------------------------------------//
+//  sum the rows over the threads
+//
+std::vector<row_type>
+combine_threads(const std::vector<row_type>& _rows)
+{
+    using key_type = std::tuple<string_t, int64_t, uint64_t, string_t>;
+    std::vector<row_type>      _ret{};
+    std::map<key_type, size_t> _index{};
+    for(const auto& itr : _rows)
+    {
+        auto _key = key_type{ itr.component, itr.depth, itr.rolling_hash, itr.label };
+        auto _idx = _index.find(_key);
+        if(_idx == _index.end())
+        {
+            _index.emplace(_key, _ret.size());
+            _ret.emplace_back(itr);
+            _ret.back().tid = -1;
+        }
+        else
+        {
+            _ret.at(_idx->second).laps += itr.laps;
+            _ret.at(_idx->second).value += itr.value;
+        }
+    }
+    return _ret;
+}
+
+//--------------------------------------------------------------------------------------//
+
+void
+print_list(const std::vector<record>& _records, std::ostream& os)
+{
+    os << "# " << std::setw(6) << "index" << "  " << std::setw(12) << "elapsed [s]"
+       << "  " << std::setw(8) << "rows" << "\n";
+    for(size_t i = 0; i < _records.size(); ++i)
+    {
+        os << "  " << std::setw(6) << _records.at(i).index << "  " << std::setw(12)
+           << std::fixed << std::setprecision(3) << get_elapsed(_records, i) << "  "
+           << std::setw(8) << _records.at(i).rows.size() << "\n";
+    }
+}
+
+//--------------------------------------------------------------------------------------//
+
+void
+print_rows(const std::vector<row_type>& _rows, const string_t& _component,
+           std::ostream& os)
+{
+    os << "# component\ttid\tdepth\tlaps\tvalue\tunits\tlabel\n";
+    for(const auto& itr : _rows)
+    {
+        if(!_component.empty() && itr.component != _component)
+            continue;
+        // regions which did not change within the window
+        if(itr.laps == 0 && itr.value == 0.0)
+            continue;
+        os << itr.component << '\t' << itr.tid << '\t' << itr.depth << '\t' << itr.laps
+           << '\t' << std::setprecision(9) << itr.value << '\t' << itr.units << '\t'
+           << itr.label << '\n';
+    }
+}
+
+//--------------------------------------------------------------------------------------//
+
+int
+main(int argc, char** argv)
+{
+    tim::argparse::argument_parser parser("timemory-checkpoint");
+
+    parser.enable_help();
+    parser.add_argument({ "-i", "--input" }, "Input checkpoint file").count(1);
+    parser.add_argument({ "-o", "--output" }, "Output file (default: stdout)").count(1);
+    parser.add_argument({ "-l", "--list" }, "List the checkpoints").count(0);
+    parser
+        .add_argument({ "-b", "--begin" },
+                      "Exclude the checkpoints up to N seconds after the first one")
+        .count(1);
+    parser
+        .add_argument({ "-e", "--end" },
+                      "Exclude the checkpoints later than N seconds after the first one")
+        .count(1);
+    parser.add_argument({ "-c", "--component" }, "Only report this component").count(1);
+    parser.add_argument({ "-t", "--per-thread" }, "Do not sum the threads").count(0);
+
+    auto err = parser.parse(argc, argv);
+    if(err)
+        std::cerr << err << std::endl;
+
+    if(err || parser.exists("help") || !parser.exists("input"))
+    {
+        parser.print_help();
+        return EXIT_FAILURE;
+    }
+
+    auto _input     = parser.get<string_t>("input");
+    auto _output    = (parser.exists("output")) ? parser.get<string_t>("output") : "";
+    auto _component = (parser.exists("component")) ? parser.get<string_t>("component")
+                                                   : string_t{};
+
+    try
+    {
+        std::ofstream ofs{};
+        if(!_output.empty())
+        {
+            ofs.open(_output.c_str());
+            if(!ofs)
+                throw std::runtime_error("Error opening '" + _output + "'");
+        }
+        std::ostream& os = (_output.empty()) ? std::cout : ofs;
+
+        auto _records = read(_input);
+        if(_records.empty())
+            throw std::runtime_error("'" + _input + "' does not have any checkpoints");
+
+        if(parser.exists("list"))
+        {
+            print_list(_records, os);
+            return EXIT_SUCCESS;
+        }
+
+        // the window includes the records after the begin and up to the end
+        size_t _begin = 0;
+        size_t _end   = _records.size();
+        if(parser.exists("begin"))
+            _begin = get_index(_records, parser.get<double>("begin"));
+        if(parser.exists("end"))
+            _end = get_index(_records, parser.get<double>("end"));
+        if(_begin >= _end)
+            throw std::runtime_error("the window does not include any checkpoints");
+
+        auto _rows = accumulate(_records, _begin, _end);
+        if(!parser.exists("per-thread"))
+            _rows = combine_threads(_rows);
+
+        os << "# checkpoints " << _records.at(_begin).index << " to "
+           << _records.at(_end - 1).index << " (" << std::fixed << std::setprecision(3)
+           << get_elapsed(_records, _begin) << " to " << get_elapsed(_records, _end - 1)
+           << " seconds)\n";
+        os.unsetf(std::ios::floatfield);
+        print_rows(_rows, _component, os);
+    } catch(std::exception& e)
+    {
+        std::cerr << "[timemory-checkpoint]> Error: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,264 @@
+// MIT License
+//
+// Copyright (c) 2020, The Regents of the University of California,
+// through Lawrence Berkeley National Laboratory (subject to receipt of any
+// required approvals from the U.S. Dept. of Energy).  All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//  Query a running process which set TIMEMORY_LIVE_SOCKET for the hottest regions
+//  (see timemory/utility/live_server.hpp for the protocol)
+//
+
+#include "timemory/utility/argparse.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using string_t  = std::string;
+using str_vec_t = std::vector<string_t>;
+
+//--------------------------------------------------------------------------------------//
+//  a row of the response aggregated over the threads
+//
+struct row
+{
+    string_t component = {};
+    string_t units     = {};
+    string_t label     = {};
+    int64_t  depth     = 0;
+    int64_t  laps      = 0;
+    int64_t  threads   = 0;
+    double   value     = 0.0;
+    bool     stale     = false;
+};
+
+//--------------------------------------------------------------------------------------//
+//  send the request and read the response until the server closes the connection
+//
+string_t
+query(const string_t& _path, const string_t& _request)
+{
+    sockaddr_un _addr{};
+    if(_path.length() >= sizeof(_addr.sun_path))
+        throw std::runtime_error("socket path is too long: '" + _path + "'");
+
+    int _fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if(_fd < 0)
+        throw std::runtime_error(string_t("socket: ") + strerror(errno));
+
+    _addr.sun_family = AF_UNIX;
+    strncpy(_addr.sun_path, _path.c_str(), sizeof(_addr.sun_path) - 1);
+    if(::connect(_fd, reinterpret_cast<sockaddr*>(&_addr), sizeof(_addr)) != 0)
+    {
+        auto _err = string_t("connecting to '") + _path + "': " + strerror(errno);
+        ::close(_fd);
+        throw std::runtime_error(_err);
+    }
+
+    auto _msg    = _request + "\n";
+    auto _offset = size_t{ 0 };
+    while(_offset < _msg.length())
+    {
+        auto _n = ::write(_fd, _msg.data() + _offset, _msg.length() - _offset);
+        if(_n <= 0)
+            break;
+        _offset += static_cast<size_t>(_n);
+    }
+
+    string_t _response{};
+    char     _buffer[4096];
+    ssize_t  _n = 0;
+    while((_n = ::read(_fd, _buffer, sizeof(_buffer))) > 0)
+        _response.append(_buffer, static_cast<size_t>(_n));
+    ::close(_fd);
+    return _response;
+}
+
+//--------------------------------------------------------------------------------------//
+//  parse the rows and sum them over the threads
+//
+std::vector<row>
+aggregate(const string_t& _response, const string_t& _component)
+{
+    using key_type = std::tuple<string_t, string_t, int64_t>;
+    std::map<key_type, row> _rows{};
+    std::istringstream      _iss(_response);
+    string_t                _line{};
+    while(std::getline(_iss, _line))
+    {
+        if(_line.empty() || _line.front() == '#')
+            continue;
+        str_vec_t          _fields{};
+        std::istringstream _lss(_line);
+        string_t           _field{};
+        while(std::getline(_lss, _field, '\t'))
+            _fields.emplace_back(_field);
+        if(_fields.size() < 8)
+            continue;
+        if(!_component.empty() && _fields.at(0) != _component)
+            continue;
+
+        auto  _depth = std::stoll(_fields.at(2));
+        auto& _entry = _rows[key_type{ _fields.at(0), _fields.at(7), _depth }];
+        _entry.component = _fields.at(0);
+        _entry.units     = _fields.at(5);
+        _entry.label     = _fields.at(7);
+        _entry.depth     = _depth;
+        _entry.laps += std::stoll(_fields.at(3));
+        _entry.value += std::stod(_fields.at(4));
+        _entry.threads += 1;
+        _entry.stale = _entry.stale || _fields.at(6) == "1";
+    }
+
+    std::vector<row> _ret{};
+    for(auto& itr : _rows)
+        _ret.emplace_back(itr.second);
+    std::sort(_ret.begin(), _ret.end(), [](const row& _lhs, const row& _rhs) {
+        if(_lhs.component != _rhs.component)
+            return _lhs.component < _rhs.component;
+        return _lhs.value > _rhs.value;
+    });
+    return _ret;
+}
+
+//--------------------------------------------------------------------------------------//
+//  print the top N rows of each component
+//
+void
+print(const string_t& _response, const std::vector<row>& _rows, size_t _top)
+{
+    auto _header = _response.substr(0, _response.find('\n'));
+    std::cout << _header << "\n";
+
+    string_t _last{};
+    size_t   _count = 0;
+    for(const auto& itr : _rows)
+    {
+        if(itr.component != _last)
+        {
+            _last  = itr.component;
+            _count = 0;
+            std::cout << "\n"
+                      << std::setw(16) << std::right << itr.component << " ["
+                      << itr.units << "]   " << std::setw(10) << "laps"
+                      << "  threads  label\n";
+        }
+        if(_count++ >= _top)
+            continue;
+        std::cout << std::setw(16) << std::right << std::setprecision(6) << itr.value
+                  << std::string(itr.units.length() + 6, ' ') << std::setw(10)
+                  << itr.laps << "  " << std::setw(7) << itr.threads << "  "
+                  << std::string(2 * itr.depth, ' ') << itr.label
+                  << ((itr.stale) ? " (stale)" : "") << "\n";
+    }
+    std::cout << std::flush;
+}
+
+//--------------------------------------------------------------------------------------//
+
+int
+main(int argc, char** argv)
+{
+    tim::argparse::argument_parser parser("timemory-live");
+
+    parser.enable_help();
+    parser
+        .add_argument({ "-s", "--socket" },
+                      "Path of the socket (default: TIMEMORY_LIVE_SOCKET)")
+        .count(1);
+    parser.add_argument({ "-d", "--delta" }, "Report the change since the last query")
+        .count(0);
+    parser
+        .add_argument({ "-n", "--top" }, "Number of regions per component (default: 10)")
+        .count(1);
+    parser.add_argument({ "-c", "--component" }, "Only report this component").count(1);
+    parser
+        .add_argument({ "-i", "--interval" },
+                      "Repeat the query every N seconds until interrupted")
+        .count(1);
+    parser
+        .add_argument({ "-t", "--timeout" },
+                      "Milliseconds the threads are given to publish (default: 100)")
+        .count(1);
+    parser.add_argument({ "-r", "--raw" }, "Print the response of the server").count(0);
+
+    auto err = parser.parse(argc, argv);
+    if(err)
+        std::cerr << err << std::endl;
+
+    auto _env    = getenv("TIMEMORY_LIVE_SOCKET");
+    auto _socket = (parser.exists("socket")) ? parser.get<string_t>("socket")
+                                             : string_t((_env) ? _env : "");
+
+    if(err || parser.exists("help") || _socket.empty())
+    {
+        parser.print_help();
+        return EXIT_FAILURE;
+    }
+
+    auto _top       = (parser.exists("top")) ? parser.get<size_t>("top") : size_t{ 10 };
+    auto _component = (parser.exists("component")) ? parser.get<string_t>("component")
+                                                   : string_t{};
+    auto _interval  = (parser.exists("interval")) ? parser.get<double>("interval") : 0.0;
+    auto _timeout   = (parser.exists("timeout")) ? parser.get<int64_t>("timeout") : 100;
+    auto _request   = string_t((parser.exists("delta")) ? "delta" : "snapshot") + " " +
+                    std::to_string(_timeout);
+
+    try
+    {
+        do
+        {
+            auto _response = query(_socket, _request);
+            if(parser.exists("raw"))
+                std::cout << _response << std::flush;
+            else
+                print(_response, aggregate(_response, _component), _top);
+
+            if(_interval > 0.0)
+            {
+                std::cout << std::endl;
+                std::this_thread::sleep_for(std::chrono::duration<double>(_interval));
+            }
+        } while(_interval > 0.0);
+    } catch(std::exception& e)
+    {
+        std::cerr << "[timemory-live]> Error: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
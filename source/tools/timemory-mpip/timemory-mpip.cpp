@@ -29,7 +29,9 @@
 
 #include <memory>
 #include <set>
+#include <tuple>
 #include <unordered_map>
+#include <vector>
 
 using namespace tim::component;
 
@@ -150,8 +152,8 @@ struct mpi_comm_data : base<mpi_comm_data, void>
         MPI_Type_size(datatype, &size);
         tracker_t _t(_name);
         add(_t, count * size);
-        add_secondary(_t, TIMEMORY_JOIN("_", _name, "dst", dst), count * size,
-                      TIMEMORY_JOIN("_", _name, "dst", dst, "tag", tag));
+        add_secondary(add_secondary(_t, count * size, get_key(_name, "dst", dst)),
+                      count * size, get_key(_name, "dst", dst, "tag", tag));
     }
 
     // MPI_Recv
@@ -162,8 +164,8 @@ struct mpi_comm_data : base<mpi_comm_data, void>
         MPI_Type_size(datatype, &size);
         tracker_t _t(_name);
         add(_t, count * size);
-        add_secondary(_t, TIMEMORY_JOIN("_", _name, "dst", dst), count * size,
-                      TIMEMORY_JOIN("_", _name, "dst", dst, "tag", tag));
+        add_secondary(add_secondary(_t, count * size, get_key(_name, "dst", dst)),
+                      count * size, get_key(_name, "dst", dst, "tag", tag));
     }
 
     // MPI_Isend
@@ -174,8 +176,8 @@ struct mpi_comm_data : base<mpi_comm_data, void>
         MPI_Type_size(datatype, &size);
         tracker_t _t(_name);
         add(_t, count * size);
-        add_secondary(_t, TIMEMORY_JOIN("_", _name, "dst", dst), count * size,
-                      TIMEMORY_JOIN("_", _name, "dst", dst, "tag", tag));
+        add_secondary(add_secondary(_t, count * size, get_key(_name, "dst", dst)),
+                      count * size, get_key(_name, "dst", dst, "tag", tag));
     }
 
     // MPI_Irecv
@@ -186,8 +188,8 @@ struct mpi_comm_data : base<mpi_comm_data, void>
         MPI_Type_size(datatype, &size);
         tracker_t _t(_name);
         add(_t, count * size);
-        add_secondary(_t, TIMEMORY_JOIN("_", _name, "dst", dst), count * size,
-                      TIMEMORY_JOIN("_", _name, "dst", dst, "tag", tag));
+        add_secondary(add_secondary(_t, count * size, get_key(_name, "dst", dst)),
+                      count * size, get_key(_name, "dst", dst, "tag", tag));
     }
 
     // MPI_Bcast
@@ -196,7 +198,9 @@ struct mpi_comm_data : base<mpi_comm_data, void>
     {
         int size = 0;
         MPI_Type_size(datatype, &size);
-        add(_name, count * size, TIMEMORY_JOIN("_", _name, "root", root));
+        tracker_t _t(_name);
+        add(_t, count * size);
+        add_secondary(_t, count * size, get_key(_name, "root", root));
     }
 
     // MPI_Allreduce
@@ -205,7 +209,8 @@ struct mpi_comm_data : base<mpi_comm_data, void>
     {
         int size = 0;
         MPI_Type_size(datatype, &size);
-        add(_name, count * size);
+        tracker_t _t(_name);
+        add(_t, count * size);
     }
 
     // MPI_Sendrecv
@@ -219,10 +224,10 @@ struct mpi_comm_data : base<mpi_comm_data, void>
         MPI_Type_size(recvtype, &recv_size);
         tracker_t _t(_name);
         add(_t, sendcount * send_size + recvcount * recv_size);
-        add_secondary(_t, TIMEMORY_JOIN("_", _name, "send"), sendcount * send_size,
-                      TIMEMORY_JOIN("_", _name, "send", "tag", sendtag));
-        add_secondary(_t, TIMEMORY_JOIN("_", _name, "recv"), recvcount * recv_size,
-                      TIMEMORY_JOIN("_", _name, "recv", "tag", recvtag));
+        add_secondary(add_secondary(_t, sendcount * send_size, get_key(_name, "send")),
+                      sendcount * send_size, get_key(_name, "send", "tag", sendtag));
+        add_secondary(add_secondary(_t, recvcount * recv_size, get_key(_name, "recv")),
+                      recvcount * recv_size, get_key(_name, "recv", "tag", recvtag));
     }
 
     // MPI_Gather
@@ -236,12 +241,10 @@ struct mpi_comm_data : base<mpi_comm_data, void>
         MPI_Type_size(recvtype, &recv_size);
         tracker_t _t(_name);
         add(_t, sendcount * send_size + recvcount * recv_size);
-        tracker_t _r(TIMEMORY_JOIN("_", _name, "root", root));
-        add(_r, sendcount * send_size + recvcount * recv_size);
-        add_secondary(_r, TIMEMORY_JOIN("_", _name, "root", root, "send"),
-                      sendcount * send_size);
-        add_secondary(_r, TIMEMORY_JOIN("_", _name, "root", root, "recv"),
-                      recvcount * recv_size);
+        auto* _r = add_secondary(_t, sendcount * send_size + recvcount * recv_size,
+                                 get_key(_name, "root", root));
+        add_secondary(_r, sendcount * send_size, get_key(_name, "root", root, "send"));
+        add_secondary(_r, recvcount * recv_size, get_key(_name, "root", root, "recv"));
     }
 
     // MPI_Scatter
@@ -254,12 +257,10 @@ struct mpi_comm_data : base<mpi_comm_data, void>
         MPI_Type_size(recvtype, &recv_size);
         tracker_t _t(_name);
         add(_t, sendcount * send_size + recvcount * recv_size);
-        tracker_t _r(TIMEMORY_JOIN("_", _name, "root", root));
-        add(_r, sendcount * send_size + recvcount * recv_size);
-        add_secondary(_r, TIMEMORY_JOIN("_", _name, "root", root, "send"),
-                      sendcount * send_size);
-        add_secondary(_r, TIMEMORY_JOIN("_", _name, "root", root, "recv"),
-                      recvcount * recv_size);
+        auto* _r = add_secondary(_t, sendcount * send_size + recvcount * recv_size,
+                                 get_key(_name, "root", root));
+        add_secondary(_r, sendcount * send_size, get_key(_name, "root", root, "send"));
+        add_secondary(_r, recvcount * recv_size, get_key(_name, "root", root, "recv"));
     }
 
     // MPI_Alltoall
@@ -272,34 +273,63 @@ struct mpi_comm_data : base<mpi_comm_data, void>
         MPI_Type_size(recvtype, &recv_size);
         tracker_t _t(_name);
         add(_t, sendcount * send_size + recvcount * recv_size);
-        add_secondary(_t, TIMEMORY_JOIN("_", _name, "send"), sendcount * send_size);
-        add_secondary(_t, TIMEMORY_JOIN("_", _name, "recv"), recvcount * recv_size);
+        add_secondary(_t, sendcount * send_size, get_key(_name, "send"));
+        add_secondary(_t, recvcount * recv_size, get_key(_name, "recv"));
     }
 
 private:
-    template <typename... Args>
-    void add(tracker_t& _t, data_type value, Args&&... args)
+    using tracker_key_t = mpi_data_tracker_t::secondary_key_t;
+
+    void add(tracker_t& _t, data_type value) { _t.store(std::plus<data_type>{}, value); }
+
+    // returns the secondary entry so that nested secondary data can be added to it
+    mpi_data_tracker_t* add_secondary(tracker_t& _t, data_type value, tracker_key_t _key)
     {
-        _t.store(std::plus<data_type>{}, value);
-        TIMEMORY_FOLD_EXPRESSION(add_secondary(_t, std::forward<Args>(args), value));
+        if(!tim::settings::hot().add_secondary)
+            return nullptr;
+        return add_secondary(_t.get<mpi_data_tracker_t>(), value, _key);
     }
 
-    template <typename... Args>
-    void add(const std::string& _name, data_type value, Args&&... args)
+    mpi_data_tracker_t* add_secondary(mpi_data_tracker_t* _obj, data_type value,
+                                      tracker_key_t _key)
     {
-        tracker_t _t(_name);
-        add(_t, value, std::forward<Args>(args)...);
+        return (_obj) ? _obj->add_secondary(_key, std::plus<data_type>{}, value)
+                      : nullptr;
     }
 
+    // the label of the secondary data is only generated the first time a key is
+    // encountered on a thread, afterwards the key is resolved from the hash of the
+    // arguments. The hash only selects the bucket: the arguments are compared so that
+    // a collision cannot label a region with the key of a different region
     template <typename... Args>
-    void add_secondary(tracker_t&, const std::string& _name, data_type value,
-                       Args&&... args)
+    static tracker_key_t get_key(const std::string& _name, Args... args)
     {
-        if(tim::settings::add_secondary())
+        using args_t    = std::tuple<Args...>;
+        using entry_t   = std::tuple<std::string, args_t, tracker_key_t>;
+        using key_map_t = std::unordered_map<size_t, std::vector<entry_t>>;
+        static thread_local key_map_t _keys{};
+
+        size_t _hash = std::hash<std::string>{}(_name);
+        TIMEMORY_FOLD_EXPRESSION(_hash = hash_combine(_hash, args));
+
+        auto& _bucket = _keys[_hash];
+        for(const auto& itr : _bucket)
         {
-            tracker_t _s(_name);
-            add(_s, value, std::forward<Args>(args)...);
+            if(std::get<1>(itr) == std::tie(args...) && std::get<0>(itr) == _name)
+                return std::get<2>(itr);
         }
+
+        auto _label = TIMEMORY_JOIN("_", _name, args...);
+        auto _key   = mpi_data_tracker_t::get_secondary_key(_label);
+        _bucket.emplace_back(_name, args_t{ args... }, _key);
+        return _key;
+    }
+
+    // string literals are hashed by address
+    template <typename Tp>
+    static size_t hash_combine(size_t _lhs, Tp _rhs)
+    {
+        return _lhs ^ (std::hash<Tp>{}(_rhs) + 0x9e3779b9 + (_lhs << 6) + (_lhs >> 2));
     }
 };
 }  // namespace component
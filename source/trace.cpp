@@ -158,7 +158,7 @@ struct mpi_trace_gotcha : tim::component::base<mpi_trace_gotcha, void>
         if(!timemory_mpi_finalize_comm_keyval())
             return;
         auto lk                  = tim::trace::lock<tim::trace::library>();
-        auto _state              = tim::settings::enabled();
+        bool _state              = tim::settings::enabled();
         tim::settings::enabled() = false;
         int  comm_key            = 0;
         auto ret = MPI_Comm_create_keyval(MPI_NULL_COPY_FN, &timemory_trace_mpi_finalize,
@@ -462,7 +462,8 @@ extern "C"
         if(!lk)
             return;
 
-        if(!get_library_state()[0] || get_library_state()[1] || !tim::settings::enabled())
+        const auto& _hot = tim::settings::hot();
+        if(!get_library_state()[0] || get_library_state()[1] || !_hot.enabled)
             return;
 
         if(get_throttle()->count(id) > 0)
@@ -473,7 +474,7 @@ extern "C"
         if(_trace_map.empty())
             timemory_copy_hash_ids();
 
-        if(tim::settings::debug())
+        if(_hot.debug)
         {
             int64_t  n    = _trace_map[id].size();
             auto     itr  = tim::get_hash_ids()->find(id);
@@ -501,13 +502,13 @@ extern "C"
             return;
 
         auto& _trace_map = get_trace_map();
-        if(!tim::settings::enabled() && _trace_map.empty())
+        if(!tim::settings::hot().enabled && _trace_map.empty())
             return;
 
         int64_t ntotal = _trace_map[id].size();
         int64_t offset = ntotal - 1;
 
-        if(tim::settings::debug())
+        if(tim::settings::hot().debug)
         {
             auto     itr  = tim::get_hash_ids()->find(id);
             string_t name = (itr != tim::get_hash_ids()->end()) ? itr->second : "unknown";
@@ -545,7 +546,7 @@ extern "C"
             auto _accum = get_overhead()->at(id).first.get_accum() / _count;
             if(_accum < tim::settings::throttle_value())
             {
-                if(tim::settings::debug() || tim::settings::verbose() > 0)
+                if(tim::settings::hot().debug || tim::settings::hot().verbose > 0)
                 {
                     auto name = tim::get_hash_ids()->find(id)->second;
                     fprintf(
@@ -563,7 +564,7 @@ extern "C"
             else
             {
                 if(_accum < (10 * tim::settings::throttle_value()) &&
-                   (tim::settings::debug() || tim::settings::verbose() > 1))
+                   (tim::settings::hot().debug || tim::settings::hot().verbose > 1))
                 {
                     auto name = tim::get_hash_ids()->find(id)->second;
                     fprintf(
@@ -593,13 +594,13 @@ extern "C"
         uint64_t _hash = std::numeric_limits<uint64_t>::max();
         {
             auto lk = tim::trace::lock<tim::trace::library>();
-            if(tim::settings::debug())
+            if(tim::settings::hot().debug)
                 PRINT_HERE("rank = %i, pid = %i, thread = %i, name = %s",
                            tim::dmp::rank(), (int) tim::process::get_id(),
                            (int) tim::threading::get_id(), name);
 
             if(!get_library_state()[0] || get_library_state()[1] ||
-               !tim::settings::enabled())
+               !tim::settings::hot().enabled)
                 return;
 
             _hash = tim::add_hash_id(name);
@@ -716,6 +717,10 @@ extern "C"
             tim::env::configure<user_trace_bundle>("TIMEMORY_TRACE_COMPONENTS", args);
 
             tim::settings::parse();
+
+            // measure the cost of an empty start/stop of the configured bundle
+            if(tim::settings::overhead_compensation())
+                tim::overhead::calibrate<traceset_t>();
         }
         else
         {
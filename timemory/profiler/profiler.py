@@ -32,6 +32,11 @@ from collections import deque
 from ..libpytimemory import component_bundle
 from ..libpytimemory import settings
 
+try:
+    from ..libpytimemory import profiler as _native_profiler
+except ImportError:
+    _native_profiler = None
+
 __all__ = ["profile", "Profiler"]
 #
 #   Variables
@@ -51,6 +56,8 @@ _always_skipped_files = ["__init__.py"]
 _include_line = True
 _include_filepath = True
 _full_filepath = False
+_use_native = os.environ.get("TIMEMORY_PROFILER_NATIVE", "ON").upper() not in (
+    "OFF", "FALSE", "NO", "N", "0")
 
 
 def _default_functor():
@@ -151,12 +158,15 @@ class profile():
 
     #------------------------------------------------------------------------------------#
     #
-    def __init__(self, components=[], flat=False, timeline=False, *args, **kwargs):
+    def __init__(self, components=[], flat=False, timeline=False, native=None,
+                 *args, **kwargs):
         """
         Arguments:
             - components [list of strings]  : list of timemory components
             - flat [bool]                   : enable flat profiling
             - timeline [bool]               : enable timeline profiling
+            - native [bool]                 : use the C++ profiler callback
+                                              (default: TIMEMORY_PROFILER_NATIVE)
         """
         global _records
         global _include_line
@@ -176,12 +186,38 @@ class profile():
         self._use = (not _is_running and profile.is_enabled() is True)
         self._flat_profile = (settings.flat_profile or flat)
         self._timeline_profile = (settings.timeline_profile or timeline)
+        self._native = (_use_native if native is None else native) and \
+            _native_profiler is not None
         self.components = components + _components.split(",")
         if len(self.components) == 0:
             self.components += ["wall_clock"]
         os.environ["TIMEMORY_PROFILER_COMPONENTS"] = ",".join(self.components)
         print("USE = {}, COMPONENTS = {}".format(self._use, self.components))
 
+    #------------------------------------------------------------------------------------#
+    #
+    def _set_profiler(self):
+        """
+        Install either the native (C++) or the python profiler function
+        """
+        if self._native:
+            _native_profiler.configure(_include_line, _include_filepath,
+                                       _full_filepath, _always_skipped_functions,
+                                       _always_skipped_files + [__file__])
+            _native_profiler.start()
+        else:
+            sys.setprofile(_profiler_function)
+
+    #------------------------------------------------------------------------------------#
+    #
+    def _unset_profiler(self):
+        """
+        Remove the profiler function and restore the original
+        """
+        if self._native:
+            _native_profiler.stop()
+        sys.setprofile(self._original_profiler_function)
+
     #------------------------------------------------------------------------------------#
     #
     def start(self):
@@ -196,7 +232,7 @@ class profile():
             component_bundle.reset()
             component_bundle.configure(self.components, self._flat_profile,
                                        self._timeline_profile)
-            sys.setprofile(_profiler_function)
+            self._set_profiler()
 
     #------------------------------------------------------------------------------------#
     #
@@ -208,7 +244,7 @@ class profile():
 
         if self._use:
             _is_running = False
-            sys.setprofile(self._original_profiler_function)
+            self._unset_profiler()
 
     #------------------------------------------------------------------------------------#
     #
@@ -228,10 +264,10 @@ class profile():
         @wraps(func)
         def function_wrapper(*args, **kwargs):
             if self._use:
-                sys.setprofile(_profiler_function)
+                self._set_profiler()
             _ret = func(*args, **kwargs)
             if self._use:
-                sys.setprofile(self._original_profiler_function)
+                self._unset_profiler()
             return _ret
 
         _ret = function_wrapper
@@ -255,7 +291,7 @@ class profile():
             component_bundle.reset()
             component_bundle.configure(self.components, self._flat_profile,
                                        self._timeline_profile)
-            sys.setprofile(_profiler_function)
+            self._set_profiler()
 
     #------------------------------------------------------------------------------------#
     #
@@ -267,7 +303,7 @@ class profile():
 
         if self._use:
             _is_running = False
-            sys.setprofile(self._original_profiler_function)
+            self._unset_profiler()
 
         import traceback
         if exec_type is not None and exec_value is not None and exec_tb is not None:
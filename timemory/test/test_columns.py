@@ -0,0 +1,129 @@
+#!@PYTHON_EXECUTABLE@
+# MIT License
+#
+# Copyright (c) 2018, The Regents of the University of California,
+# through Lawrence Berkeley National Laboratory (subject to receipt of any
+# required approvals from the U.S. Dept. of Energy).  All rights reserved.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+
+from __future__ import absolute_import
+
+__author__ = "Jonathan Madsen"
+__copyright__ = "Copyright 2020, The Regents of the University of California"
+__credits__ = ["Jonathan Madsen"]
+__license__ = "MIT"
+__version__ = "@PROJECT_VERSION@"
+__maintainer__ = "Jonathan Madsen"
+__email__ = "jrmadsen@lbl.gov"
+__status__ = "Development"
+
+import unittest
+import numpy as np
+import timemory as tim
+from timemory.bundle import marker
+
+
+# --------------------------- helper functions ----------------------------------------- #
+# compute fibonacci
+def fibonacci(n):
+    return n if n < 2 else (fibonacci(n-1) + fibonacci(n-2))
+
+
+# -------------------------- Columns Tests set ---------------------------------------- #
+# Columns tests class
+class TimemoryColumnsTests(unittest.TestCase):
+    # setup class: timemory settings
+    @classmethod
+    def setUpClass(self):
+        tim.settings.verbose = 1
+        tim.settings.debug = False
+        tim.settings.json_output = False
+        tim.settings.mpi_thread = False
+        tim.settings.banner = False
+
+    # ---------------------------------------------------------------------------------- #
+    # test the columnar export
+    def test_columns(self):
+        """
+        columns
+        """
+        with marker(components=["wall_clock"], key=self.shortDescription()):
+            for i in range(3):
+                with marker(components=["wall_clock"], key="fibonacci"):
+                    fibonacci(15)
+
+        data = tim.get_columns(["wall"])
+        self.assertTrue("wall" in data)
+
+        entry = data["wall"]
+        cols = entry["columns"]
+        labels = entry["labels"]
+        nrows = len(cols["hash"])
+        self.assertTrue(nrows >= 2)
+
+        for key in ["parent", "depth", "tid", "pid", "laps", "label", "value",
+                    "accum", "exclusive"]:
+            self.assertEqual(len(cols[key]), nrows)
+            self.assertTrue(isinstance(cols[key], np.ndarray))
+
+        # the columns reference the buffers filled in C++
+        self.assertFalse(cols["hash"].flags["OWNDATA"])
+
+        # labels are indices into the string table
+        names = [labels[i] for i in cols["label"]]
+        self.assertTrue("columns" in names)
+        self.assertTrue("fibonacci" in names)
+
+        # the parent of the nested region is the outer region
+        idx = names.index("fibonacci")
+        parent = cols["parent"][idx]
+        self.assertTrue(parent >= 0)
+        self.assertEqual(names[parent], "columns")
+        self.assertEqual(cols["depth"][idx], cols["depth"][parent] + 1)
+        self.assertEqual(cols["laps"][idx], 3)
+
+        # the exclusive value of the outer region excludes the nested region
+        self.assertEqual(cols["exclusive"][idx], cols["value"][idx])
+        self.assertAlmostEqual(cols["exclusive"][parent],
+                               cols["value"][parent] - cols["value"][idx])
+
+    # ---------------------------------------------------------------------------------- #
+    # test filtering of the components
+    def test_filter(self):
+        """
+        filter
+        """
+        with marker(components=["wall_clock"], key=self.shortDescription()):
+            fibonacci(10)
+
+        data = tim.get_columns(["peak_rss"])
+        self.assertFalse("wall" in data)
+
+
+# ----------------------------- main test runner ---------------------------------------- #
+# main runner
+def run():
+    # run all tests
+    unittest.main()
+
+
+if __name__ == '__main__':
+    run()